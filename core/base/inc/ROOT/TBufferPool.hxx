@@ -0,0 +1,85 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBufferPool
+#define ROOT_TBufferPool
+
+#include "RtypesCore.h"
+
+#include <cstddef>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+\class ROOT::Internal::TBufferPool
+\ingroup Base
+
+Thread-local cache of the memory blocks backing TBuffer objects.
+
+When enabled, the I/O buffers created by TBuffer (and hence TBufferFile,
+TMessage, ...) draw their memory from a per-thread pool instead of
+allocating it with `new char[]`.  Blocks are grouped in size classes
+(four classes per power of two, from 512 bytes to 64 MB) and are put
+back in the pool of the releasing thread when the buffer is deleted or
+expanded, so that streaming many objects of similar size (TKey::WriteObject,
+THttpServer snapshots, TBufferMerger) does not go through malloc/memcpy
+for each of them.
+
+Blocks handed out by the pool are plain `new char[]` allocations. A buffer
+detached from its TBuffer is given back with TBuffer::FreeDetachedBuffer(),
+passing the capacity returned by TBuffer::DetachBuffer(); released with
+`delete []` it simply does not return to the pool and stays counted in use.
+The pool is bypassed while a TMapFile is updated, as the buffers must then
+be allocated in its shared memory. The pool does not record the size
+of the blocks: their owner (TBuffer keeps it in fPoolBlockSize) passes
+the capacity, GetBlockSize() of the requested size, to Release() and
+ReAlloc().
+
+The pool is disabled by default; enable it with TBufferPool::Enable().
+*/
+
+class TBufferPool {
+public:
+   /// Usage counters, summed over all threads.
+   struct Stats_t {
+      ULong64_t fRequests = 0;       ///< Number of blocks requested
+      ULong64_t fHits = 0;           ///< Number of requests served by a recycled block
+      ULong64_t fReleases = 0;       ///< Number of blocks given back to the pools
+      Long64_t  fBytesInUse = 0;     ///< Bytes currently held by buffers (approximate)
+      Long64_t  fPeakBytesInUse = 0; ///< Maximum of fBytesInUse
+      Long64_t  fBytesCached = 0;    ///< Bytes currently idle in the pools
+      Long64_t  fPeakBytesCached = 0;///< Maximum of fBytesCached
+
+      Double_t GetHitRate() const { return fRequests ? Double_t(fHits) / fRequests : 0.; }
+   };
+
+   static void     Enable(Bool_t enable = kTRUE);
+   static Bool_t   IsEnabled();
+
+   static void     SetMaxCachedBytes(Long64_t nbytes);
+   static Long64_t GetMaxCachedBytes();
+
+   static char    *Acquire(size_t size);
+   static void     Release(char *buf, size_t blocksize);
+   static char    *ReAlloc(char *ovp, size_t size, size_t oldsize, size_t &blocksize);
+   static char    *ReAllocChar(char *ovp, size_t size, size_t oldsize);
+   static void     Clear();
+
+   static size_t   GetBlockSize(size_t size);
+   static Stats_t  GetStats();
+   static void     ResetStats();
+   static void     Print();
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -50,11 +50,12 @@ protected:
    char            *fBufMax;        //End of buffer
    TObject         *fParent;        //Pointer to parent object owning this buffer
    ReAllocCharFun_t fReAllocFunc;   //! Realloc function to be used when extending the buffer.
+   Int_t            fPoolBlockSize; //! Capacity of fBuffer if it was drawn from the buffer pool, 0 otherwise
    CacheList_t      fCacheStack;    //Stack of pointers to the cache where to temporarily store the value of 'missing' data members
 
    // Default ctor
    TBuffer() : TObject(), fMode(0), fVersion(0), fBufSize(0), fBuffer(0),
-     fBufCur(0), fBufMax(0), fParent(0), fReAllocFunc(0), fCacheStack(0,(TVirtualArray*)0) {}
+     fBufCur(0), fBufMax(0), fParent(0), fReAllocFunc(0), fPoolBlockSize(0), fCacheStack(0,(TVirtualArray*)0) {}
 
    // TBuffer objects cannot be copied or assigned
    TBuffer(const TBuffer &);           // not implemented
@@ -90,7 +91,8 @@ public:
    TObject *GetParent()  const;
    char    *Buffer()     const { return fBuffer; }
    Int_t    BufferSize() const { return fBufSize; }
-   void     DetachBuffer() { fBuffer = 0; }
+   Int_t    DetachBuffer();
+   static void FreeDetachedBuffer(char *buf, Int_t poolBlockSize);
    Int_t    Length()     const { return (Int_t)(fBufCur - fBuffer); }
    void     Expand(Int_t newsize, Bool_t copy = kTRUE);  // expand buffer to newsize
    void     AutoExpand(Int_t size_needed);  // expand buffer to newsize
@@ -18,6 +18,8 @@ Buffer base class used for serializing objects.
 #include "TBuffer.h"
 #include "TClass.h"
 #include "TProcessID.h"
+#include "TStorage.h"
+#include "ROOT/TBufferPool.hxx"
 
 const Int_t  kExtraSpace        = 8;   // extra space at end of buffer (used for free block count)
 
@@ -32,6 +34,64 @@ static char *R__NoReAllocChar(char *, size_t, size_t)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate a buffer of size bytes, from the thread-local buffer pool
+/// if it is enabled (see ROOT::Internal::TBufferPool). blocksize is set
+/// to the capacity of the pool block, or to 0 if the buffer was allocated
+/// with new.
+///
+/// The pool is bypassed while a TMapFile is updated (gMmallocDesc is set):
+/// the buffer must then be allocated in the shared memory of the map file.
+
+static char *R__AllocBuffer(Int_t size, ReAllocCharFun_t &reallocfunc, Int_t &blocksize)
+{
+   if (ROOT::Internal::TBufferPool::IsEnabled() && !ROOT::Internal::gMmallocDesc) {
+      reallocfunc = ROOT::Internal::TBufferPool::ReAllocChar;
+      blocksize = ROOT::Internal::TBufferPool::GetBlockSize(size);
+      return ROOT::Internal::TBufferPool::Acquire(size);
+   }
+   reallocfunc = 0;
+   blocksize = 0;
+   return new char[size];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Free a buffer owned by a TBuffer, giving it back to the buffer pool
+/// if it was drawn from it (blocksize, its capacity, is not 0).
+
+static void R__FreeBuffer(char *buf, Int_t blocksize)
+{
+   if (blocksize > 0) {
+      ROOT::Internal::TBufferPool::Release(buf, blocksize);
+   } else {
+      delete [] buf;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give up the ownership of the buffer: the TBuffer no longer refers to it.
+/// Returns the capacity of the buffer if it was drawn from the buffer pool,
+/// 0 otherwise. The caller becomes responsible for the buffer and frees it
+/// with FreeDetachedBuffer(), passing the returned value.
+
+Int_t TBuffer::DetachBuffer()
+{
+   Int_t poolBlockSize = fPoolBlockSize;
+   fBuffer = 0;
+   fPoolBlockSize = 0;
+   return poolBlockSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Free a buffer detached from its TBuffer with DetachBuffer(), which
+/// returned poolBlockSize: a block drawn from the buffer pool is given back
+/// to it, any other buffer is deleted.
+
+void TBuffer::FreeDetachedBuffer(char *buf, Int_t poolBlockSize)
+{
+   R__FreeBuffer(buf, poolBlockSize);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create an I/O buffer object. Mode should be either TBuffer::kRead or
 /// TBuffer::kWrite. By default the I/O buffer has a size of
@@ -46,12 +106,13 @@ TBuffer::TBuffer(EMode mode)
 
    SetBit(kIsOwner);
 
-   fBuffer = new char[fBufSize+kExtraSpace];
+   ReAllocCharFun_t reallocfunc;
+   fBuffer = R__AllocBuffer(fBufSize+kExtraSpace, reallocfunc, fPoolBlockSize);
 
    fBufCur = fBuffer;
    fBufMax = fBuffer + fBufSize;
 
-   SetReAllocFunc( 0 );
+   SetReAllocFunc( reallocfunc );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,12 +129,13 @@ TBuffer::TBuffer(EMode mode, Int_t bufsiz)
 
    SetBit(kIsOwner);
 
-   fBuffer = new char[fBufSize+kExtraSpace];
+   ReAllocCharFun_t reallocfunc;
+   fBuffer = R__AllocBuffer(fBufSize+kExtraSpace, reallocfunc, fPoolBlockSize);
 
    fBufCur = fBuffer;
    fBufMax = fBuffer + fBufSize;
 
-   SetReAllocFunc( 0 );
+   SetReAllocFunc( reallocfunc );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +156,8 @@ TBuffer::TBuffer(EMode mode, Int_t bufsiz, void *buf, Bool_t adopt, ReAllocCharF
    fVersion  = 0;
    fParent   = 0;
 
+   fPoolBlockSize = 0;
+
    SetBit(kIsOwner);
 
    if (buf) {
@@ -106,7 +170,11 @@ TBuffer::TBuffer(EMode mode, Int_t bufsiz, void *buf, Bool_t adopt, ReAllocCharF
       if (fBufSize < kMinimalSize) {
          fBufSize = kMinimalSize;
       }
-      fBuffer = new char[fBufSize+kExtraSpace];
+      if (reallocfunc) {
+         fBuffer = new char[fBufSize+kExtraSpace];
+      } else {
+         fBuffer = R__AllocBuffer(fBufSize+kExtraSpace, reallocfunc, fPoolBlockSize);
+      }
    }
    fBufCur = fBuffer;
    fBufMax = fBuffer + fBufSize;
@@ -125,7 +193,7 @@ TBuffer::~TBuffer()
 {
    if (TestBit(kIsOwner)) {
       //printf("Deleting fBuffer=%lx\n", fBuffer);
-      delete [] fBuffer;
+      R__FreeBuffer(fBuffer, fPoolBlockSize);
    }
    fBuffer = 0;
    fParent = 0;
@@ -165,7 +233,8 @@ void TBuffer::AutoExpand(Int_t size_needed)
 void TBuffer::SetBuffer(void *buf, UInt_t newsiz, Bool_t adopt, ReAllocCharFun_t reallocfunc)
 {
    if (fBuffer && TestBit(kIsOwner))
-      delete [] fBuffer;
+      R__FreeBuffer(fBuffer, fPoolBlockSize);
+   fPoolBlockSize = 0;
 
    if (adopt)
       SetBit(kIsOwner);
@@ -204,12 +273,19 @@ void TBuffer::Expand(Int_t newsize, Bool_t copy)
    if ( (l > newsize) && copy ) {
       newsize = l;
    }
-   if ( (fMode&kWrite)!=0 ) {
-      fBuffer  = fReAllocFunc(fBuffer, newsize+kExtraSpace,
-                              copy ? fBufSize+kExtraSpace : 0);
+   const Int_t extra = (fMode&kWrite)!=0 ? kExtraSpace : 0;
+   if (fReAllocFunc == ROOT::Internal::TBufferPool::ReAllocChar) {
+      // Reallocate from the buffer pool knowing the capacity of the block
+      // (0 if it does not come from the pool), independently of the
+      // current mode of the buffer.
+      size_t blocksize = fPoolBlockSize;
+      fBuffer = ROOT::Internal::TBufferPool::ReAlloc(fBuffer, newsize+extra,
+                                                     copy ? fBufSize+extra : 0, blocksize);
+      fPoolBlockSize = blocksize;
    } else {
-      fBuffer  = fReAllocFunc(fBuffer, newsize,
-                              copy ? fBufSize : 0);
+      fBuffer  = fReAllocFunc(fBuffer, newsize+extra,
+                              copy ? fBufSize+extra : 0);
+      fPoolBlockSize = 0;
    }
    if (fBuffer == 0) {
       if (fReAllocFunc == TStorage::ReAllocChar) {
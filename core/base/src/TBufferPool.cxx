@@ -0,0 +1,355 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TBufferPool.hxx"
+
+#include "ThreadLocalStorage.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const size_t kMinBlockShift = 9;   // smallest block: 512 bytes
+const size_t kMaxBlockShift = 26;  // largest pooled block: 64 MB
+const size_t kSubClasses    = 4;   // size classes per power of two
+const Int_t  kNClasses      = 1 + (kMaxBlockShift - kMinBlockShift) * kSubClasses;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the smallest size class that can hold size bytes,
+/// or -1 if the request is too large to be pooled.
+
+Int_t SizeClass(size_t size)
+{
+   if (size <= (size_t(1) << kMinBlockShift))
+      return 0;
+   if (size > (size_t(1) << kMaxBlockShift))
+      return -1;
+   size_t n = size - 1;
+   size_t shift = kMinBlockShift;
+   while ((n >> (shift + 1)) != 0)
+      ++shift;
+   size_t step = (size_t(1) << shift) / kSubClasses;
+   size_t sub = (n - (size_t(1) << shift)) / step;
+   return 1 + (shift - kMinBlockShift) * kSubClasses + sub;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the block size of size class idx.
+
+size_t ClassSize(Int_t idx)
+{
+   if (idx == 0)
+      return size_t(1) << kMinBlockShift;
+   size_t shift = kMinBlockShift + (idx - 1) / kSubClasses;
+   size_t sub = (idx - 1) % kSubClasses;
+   size_t base = size_t(1) << shift;
+   return base + (sub + 1) * (base / kSubClasses);
+}
+
+std::atomic<bool>     gPoolEnabled(false);
+std::atomic<Long64_t> gMaxCachedBytes(Long64_t(64) << 20);
+
+struct TPoolCounters {
+   std::atomic<ULong64_t> fRequests;
+   std::atomic<ULong64_t> fHits;
+   std::atomic<ULong64_t> fReleases;
+   std::atomic<Long64_t>  fBytesInUse;
+   std::atomic<Long64_t>  fPeakBytesInUse;
+   std::atomic<Long64_t>  fBytesCached;
+   std::atomic<Long64_t>  fPeakBytesCached;
+};
+
+TPoolCounters gCounters = {{0}, {0}, {0}, {0}, {0}, {0}, {0}};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add delta to counter and keep track of its maximum in peak.
+
+void AddBytes(std::atomic<Long64_t> &counter, std::atomic<Long64_t> &peak, Long64_t delta)
+{
+   Long64_t value = counter.fetch_add(delta, std::memory_order_relaxed) + delta;
+   Long64_t prev = peak.load(std::memory_order_relaxed);
+   while (value > prev && !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+   }
+}
+
+/// Free lists of one thread, one per size class.
+class TThreadBufferPool {
+private:
+   std::vector<char *> fFree[kNClasses];
+   Long64_t fCached = 0; // bytes held in the free lists of this thread
+
+public:
+   ~TThreadBufferPool() { Clear(); }
+
+   char *Pop(Int_t idx)
+   {
+      std::vector<char *> &list = fFree[idx];
+      if (list.empty())
+         return nullptr;
+      char *buf = list.back();
+      list.pop_back();
+      Long64_t size = ClassSize(idx);
+      fCached -= size;
+      AddBytes(gCounters.fBytesCached, gCounters.fPeakBytesCached, -size);
+      return buf;
+   }
+
+   bool Push(Int_t idx, char *buf)
+   {
+      Long64_t size = ClassSize(idx);
+      if (fCached + size > gMaxCachedBytes.load(std::memory_order_relaxed))
+         return false;
+      fFree[idx].push_back(buf);
+      fCached += size;
+      AddBytes(gCounters.fBytesCached, gCounters.fPeakBytesCached, size);
+      return true;
+   }
+
+   void Clear()
+   {
+      for (Int_t idx = 0; idx < kNClasses; ++idx) {
+         for (auto buf : fFree[idx])
+            delete[] buf;
+         fFree[idx].clear();
+      }
+      AddBytes(gCounters.fBytesCached, gCounters.fPeakBytesCached, -fCached);
+      fCached = 0;
+   }
+};
+
+/// Deletes the pool of a thread when the thread exits and prevents
+/// it from being re-created during the thread tear down.
+struct TThreadBufferPoolGuard {
+   TThreadBufferPool *&fPool;
+   bool &fFinished;
+   TThreadBufferPoolGuard(TThreadBufferPool *&pool, bool &finished) : fPool(pool), fFinished(finished) {}
+   ~TThreadBufferPoolGuard()
+   {
+      delete fPool;
+      fPool = nullptr;
+      fFinished = true;
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the pool of the calling thread, or nullptr if the thread is
+/// being torn down.
+
+TThreadBufferPool *GetThreadPool()
+{
+   TTHREAD_TLS(TThreadBufferPool *) pool = nullptr;
+   TTHREAD_TLS(bool) finished = false;
+   if (!pool && !finished) {
+      pool = new TThreadBufferPool();
+      TTHREAD_TLS_DECL_ARG2(TThreadBufferPoolGuard, guard, pool, finished);
+      (void)guard;
+   }
+   return pool;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the use of the pool for newly created TBuffers.
+/// Buffers already drawing from the pool keep doing so until they are
+/// deleted.
+
+void TBufferPool::Enable(Bool_t enable)
+{
+   gPoolEnabled = enable;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if newly created TBuffers draw their memory from the pool.
+
+Bool_t TBufferPool::IsEnabled()
+{
+   return gPoolEnabled.load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum number of idle bytes each thread keeps in its pool.
+/// Blocks released beyond this limit are freed. The default is 64 MB.
+
+void TBufferPool::SetMaxCachedBytes(Long64_t nbytes)
+{
+   gMaxCachedBytes = nbytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the maximum number of idle bytes each thread keeps in its pool.
+
+Long64_t TBufferPool::GetMaxCachedBytes()
+{
+   return gMaxCachedBytes.load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size of the block the pool hands out for a request of
+/// size bytes.
+
+size_t TBufferPool::GetBlockSize(size_t size)
+{
+   Int_t idx = SizeClass(size);
+   return idx < 0 ? size : ClassSize(idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a block of at least size bytes, recycled from the pool of the
+/// calling thread if one of the right size class is available.
+
+char *TBufferPool::Acquire(size_t size)
+{
+   gCounters.fRequests.fetch_add(1, std::memory_order_relaxed);
+   Int_t idx = SizeClass(size);
+   if (idx < 0) {
+      AddBytes(gCounters.fBytesInUse, gCounters.fPeakBytesInUse, size);
+      return new char[size];
+   }
+   Long64_t blocksize = ClassSize(idx);
+   AddBytes(gCounters.fBytesInUse, gCounters.fPeakBytesInUse, blocksize);
+   if (TThreadBufferPool *pool = GetThreadPool()) {
+      if (char *buf = pool->Pop(idx)) {
+         gCounters.fHits.fetch_add(1, std::memory_order_relaxed);
+         return buf;
+      }
+   }
+   return new char[blocksize];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give back a block obtained from Acquire() or ReAlloc() to the pool of
+/// the calling thread. blocksize is the capacity of the block, i.e.
+/// GetBlockSize() of the size it was requested with.
+
+void TBufferPool::Release(char *buf, size_t blocksize)
+{
+   if (!buf)
+      return;
+   Int_t idx = SizeClass(blocksize);
+   if (idx < 0) {
+      AddBytes(gCounters.fBytesInUse, gCounters.fPeakBytesInUse, -Long64_t(blocksize));
+      delete[] buf;
+      return;
+   }
+   AddBytes(gCounters.fBytesInUse, gCounters.fPeakBytesInUse, -Long64_t(ClassSize(idx)));
+   TThreadBufferPool *pool = GetThreadPool();
+   if (pool && pool->Push(idx, buf)) {
+      gCounters.fReleases.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+   delete[] buf;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Resize the block ovp of capacity blocksize to size bytes, keeping its
+/// first oldsize bytes and zeroing the bytes from oldsize to size, like
+/// TStorage::ReAllocChar. The block is reused in place if size falls in
+/// its size class, otherwise the content is moved to a new block and the
+/// old one goes back to the pool. A blocksize of 0 means that ovp does not
+/// come from the pool: it is deleted. blocksize is updated to the capacity
+/// of the returned block.
+
+char *TBufferPool::ReAlloc(char *ovp, size_t size, size_t oldsize, size_t &blocksize)
+{
+   if (!ovp)
+      oldsize = 0;
+   if (blocksize && oldsize > blocksize)
+      oldsize = blocksize;
+   if (oldsize > size)
+      oldsize = size;
+   char *vp = ovp;
+   if (!ovp || GetBlockSize(size) != blocksize) {
+      vp = Acquire(size);
+      if (ovp) {
+         memcpy(vp, ovp, oldsize);
+         if (blocksize)
+            Release(ovp, blocksize);
+         else
+            delete[] ovp;
+      }
+      blocksize = GetBlockSize(size);
+   }
+   memset(vp + oldsize, 0, size - oldsize);
+   return vp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reallocation function with the signature of TStorage::ReAllocChar.
+/// Its address marks the TBuffers drawing from the pool, which reallocate
+/// their blocks with ReAlloc() since they know their capacity. Called
+/// directly, it returns a new pool block and deletes ovp, which is assumed
+/// not to come from the pool since its capacity is unknown.
+
+char *TBufferPool::ReAllocChar(char *ovp, size_t size, size_t oldsize)
+{
+   size_t blocksize = 0;
+   return ReAlloc(ovp, size, oldsize, blocksize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Free all the idle blocks held by the pool of the calling thread.
+
+void TBufferPool::Clear()
+{
+   if (TThreadBufferPool *pool = GetThreadPool())
+      pool->Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the usage counters of the pools of all threads.
+
+TBufferPool::Stats_t TBufferPool::GetStats()
+{
+   Stats_t stats;
+   stats.fRequests = gCounters.fRequests.load(std::memory_order_relaxed);
+   stats.fHits = gCounters.fHits.load(std::memory_order_relaxed);
+   stats.fReleases = gCounters.fReleases.load(std::memory_order_relaxed);
+   stats.fBytesInUse = gCounters.fBytesInUse.load(std::memory_order_relaxed);
+   stats.fPeakBytesInUse = gCounters.fPeakBytesInUse.load(std::memory_order_relaxed);
+   stats.fBytesCached = gCounters.fBytesCached.load(std::memory_order_relaxed);
+   stats.fPeakBytesCached = gCounters.fPeakBytesCached.load(std::memory_order_relaxed);
+   return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the request, hit and release counters and set the peaks to the
+/// current number of bytes in use and cached.
+
+void TBufferPool::ResetStats()
+{
+   gCounters.fRequests = 0;
+   gCounters.fHits = 0;
+   gCounters.fReleases = 0;
+   gCounters.fPeakBytesInUse = gCounters.fBytesInUse.load();
+   gCounters.fPeakBytesCached = gCounters.fBytesCached.load();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the usage counters of the pools.
+
+void TBufferPool::Print()
+{
+   Stats_t stats = GetStats();
+   printf("TBufferPool: %s\n", IsEnabled() ? "enabled" : "disabled");
+   printf("  requests      : %llu (hit rate %.1f%%)\n", stats.fRequests, 100. * stats.GetHitRate());
+   printf("  releases      : %llu\n", stats.fReleases);
+   printf("  bytes in use  : %lld (peak %lld)\n", stats.fBytesInUse, stats.fPeakBytesInUse);
+   printf("  bytes cached  : %lld (peak %lld)\n", stats.fBytesCached, stats.fPeakBytesCached);
+}
+
+} // namespace Internal
+} // namespace ROOT
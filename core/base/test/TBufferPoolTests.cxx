@@ -0,0 +1,219 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/TBufferPool.hxx"
+#include "TBufferFile.h"
+
+#include <cstring>
+#include <thread>
+
+using ROOT::Internal::TBufferPool;
+
+TEST(TBufferPool, BlockSize)
+{
+   EXPECT_EQ(512u, TBufferPool::GetBlockSize(1));
+   EXPECT_EQ(512u, TBufferPool::GetBlockSize(512));
+   EXPECT_EQ(640u, TBufferPool::GetBlockSize(513));
+   EXPECT_EQ(1024u, TBufferPool::GetBlockSize(1024));
+   EXPECT_EQ(1280u, TBufferPool::GetBlockSize(1032));
+   EXPECT_EQ(size_t(64) << 20, TBufferPool::GetBlockSize(size_t(64) << 20));
+   // Too large to be pooled.
+   EXPECT_EQ((size_t(64) << 20) + 1, TBufferPool::GetBlockSize((size_t(64) << 20) + 1));
+}
+
+TEST(TBufferPool, Recycle)
+{
+   TBufferPool::Clear();
+   TBufferPool::ResetStats();
+
+   char *buf = TBufferPool::Acquire(3000);
+   TBufferPool::Release(buf, 3000);
+   // Same size class: the block must be recycled.
+   char *again = TBufferPool::Acquire(2900);
+   EXPECT_EQ(buf, again);
+   TBufferPool::Release(again, 2900);
+
+   TBufferPool::Stats_t stats = TBufferPool::GetStats();
+   EXPECT_EQ(2u, stats.fRequests);
+   EXPECT_EQ(1u, stats.fHits);
+   EXPECT_DOUBLE_EQ(0.5, stats.GetHitRate());
+   EXPECT_EQ(Long64_t(TBufferPool::GetBlockSize(3000)), stats.fBytesCached);
+   EXPECT_EQ(Long64_t(TBufferPool::GetBlockSize(3000)), stats.fPeakBytesInUse);
+
+   TBufferPool::Clear();
+   EXPECT_EQ(0, TBufferPool::GetStats().fBytesCached);
+}
+
+TEST(TBufferPool, ReAlloc)
+{
+   TBufferPool::Clear();
+   TBufferPool::ResetStats();
+   char *buf = TBufferPool::Acquire(600);
+   size_t blocksize = TBufferPool::GetBlockSize(600);
+   strcpy(buf, "content");
+   // Growing within the size class keeps the block, and zeroes the extension.
+   memset(buf + 600, 1, 40);
+   EXPECT_EQ(buf, TBufferPool::ReAlloc(buf, 640, 600, blocksize));
+   EXPECT_EQ(TBufferPool::GetBlockSize(640), blocksize);
+   for (int i = 600; i < 640; ++i)
+      EXPECT_EQ(0, buf[i]);
+   char *bigger = TBufferPool::ReAlloc(buf, 5000, 640, blocksize);
+   EXPECT_STREQ("content", bigger);
+   EXPECT_EQ(TBufferPool::GetBlockSize(5000), blocksize);
+   for (int i = 640; i < 5000; ++i)
+      EXPECT_EQ(0, bigger[i]);
+   // Without copy the block is returned zeroed.
+   char *empty = TBufferPool::ReAlloc(bigger, 4000, 0, blocksize);
+   for (int i = 0; i < 4000; ++i)
+      EXPECT_EQ(0, empty[i]);
+   TBufferPool::Release(empty, blocksize);
+   EXPECT_EQ(0, TBufferPool::GetStats().fBytesInUse);
+   TBufferPool::Clear();
+}
+
+TEST(TBufferPool, ReAllocChar)
+{
+   TBufferPool::Clear();
+   TBufferPool::ResetStats();
+   // A block not coming from the pool is moved to a pool block.
+   char *buf = new char[100];
+   strcpy(buf, "content");
+   char *moved = TBufferPool::ReAllocChar(buf, 200, 100);
+   EXPECT_STREQ("content", moved);
+   for (int i = 100; i < 200; ++i)
+      EXPECT_EQ(0, moved[i]);
+   TBufferPool::Release(moved, TBufferPool::GetBlockSize(200));
+   EXPECT_EQ(0, TBufferPool::GetStats().fBytesInUse);
+   TBufferPool::Clear();
+}
+
+TEST(TBufferPool, MaxCachedBytes)
+{
+   Long64_t max = TBufferPool::GetMaxCachedBytes();
+   TBufferPool::Clear();
+   TBufferPool::SetMaxCachedBytes(1024);
+   char *buf = TBufferPool::Acquire(4096);
+   TBufferPool::Release(buf, 4096);
+   EXPECT_EQ(0, TBufferPool::GetStats().fBytesCached);
+   TBufferPool::SetMaxCachedBytes(max);
+}
+
+TEST(TBufferPool, OtherThread)
+{
+   TBufferPool::Clear();
+   char *buf = TBufferPool::Acquire(2048);
+   std::thread t([buf]() { TBufferPool::Release(buf, 2048); });
+   t.join();
+   // The block went to the pool of the other thread, which freed it on exit.
+   EXPECT_EQ(0, TBufferPool::GetStats().fBytesCached);
+}
+
+TEST(TBufferPool, TBufferFile)
+{
+   TBufferPool::Enable();
+   TBufferPool::Clear();
+   TBufferPool::ResetStats();
+   for (int i = 0; i < 10; ++i) {
+      TBufferFile buf(TBuffer::kWrite, 1000);
+      for (int j = 0; j < 1000; ++j)
+         buf << j;
+      EXPECT_EQ(4000, buf.Length());
+   }
+   TBufferPool::Enable(kFALSE);
+
+   TBufferPool::Stats_t stats = TBufferPool::GetStats();
+   EXPECT_LT(0u, stats.fHits);
+   EXPECT_EQ(0, stats.fBytesInUse);
+
+   // Buffers created with the pool disabled do not use it.
+   TBufferPool::ResetStats();
+   TBufferFile buf(TBuffer::kWrite, 1000);
+   EXPECT_EQ(0u, TBufferPool::GetStats().fRequests);
+   TBufferPool::Clear();
+}
+
+TEST(TBufferPool, TBufferModeSwitch)
+{
+   // The capacity of the block must not depend on the mode of the buffer
+   // when it is expanded or deleted.
+   TBufferPool::Enable();
+   TBufferPool::Clear();
+   TBufferPool::ResetStats();
+   {
+      TBufferFile buf(TBuffer::kWrite, 504); // 504 + 8 bytes: the largest block of the first size class
+      for (int i = 0; i < 20; ++i) {
+         if (i % 2)
+            buf.SetWriteMode();
+         else
+            buf.SetReadMode();
+         Int_t size = 504 + 136 * i;
+         buf.Expand(size, i % 3 != 0);
+         EXPECT_EQ(size, buf.BufferSize());
+         if (i % 3 == 0) {
+            for (Int_t j = 0; j < size; ++j)
+               ASSERT_EQ(0, buf.Buffer()[j]);
+         }
+         // Fill the whole buffer, including the extra space of the write mode.
+         memset(buf.Buffer(), 1, size + (buf.IsWriting() ? 8 : 0));
+      }
+      buf.SetReadMode();
+      buf.Expand(600, kFALSE);
+      buf.SetWriteMode();
+   }
+   TBufferPool::Enable(kFALSE);
+   EXPECT_EQ(0, TBufferPool::GetStats().fBytesInUse);
+   TBufferPool::Clear();
+   EXPECT_EQ(0, TBufferPool::GetStats().fBytesCached);
+}
+
+TEST(TBufferPool, TBufferGrowZeroes)
+{
+   TBufferPool::Enable();
+   TBufferPool::Clear();
+   {
+      TBufferFile buf(TBuffer::kWrite, 600);
+      memset(buf.Buffer(), 1, 608);
+      char *block = buf.Buffer();
+      // Within the size class: the block is kept, the content preserved
+      // and the extension zeroed.
+      buf.Expand(620);
+      EXPECT_EQ(block, buf.Buffer());
+      for (Int_t j = 0; j < 608; ++j)
+         ASSERT_EQ(1, buf.Buffer()[j]);
+      for (Int_t j = 608; j < 628; ++j)
+         ASSERT_EQ(0, buf.Buffer()[j]);
+   }
+   TBufferPool::Enable(kFALSE);
+   EXPECT_EQ(0, TBufferPool::GetStats().fBytesInUse);
+   TBufferPool::Clear();
+}
+
+TEST(TBufferPool, DetachBuffer)
+{
+   TBufferPool::Enable();
+   TBufferPool::Clear();
+   TBufferPool::ResetStats();
+   char *block;
+   Int_t blocksize;
+   {
+      TBufferFile buf(TBuffer::kWrite, 1000);
+      buf << 42;
+      block = buf.Buffer();
+      blocksize = buf.DetachBuffer();
+      EXPECT_EQ(nullptr, buf.Buffer());
+   }
+   TBufferPool::Enable(kFALSE);
+   EXPECT_EQ(Int_t(TBufferPool::GetBlockSize(1008)), blocksize);
+   // The detached block is still in use, until it is given back.
+   EXPECT_EQ(Long64_t(blocksize), TBufferPool::GetStats().fBytesInUse);
+   TBuffer::FreeDetachedBuffer(block, blocksize);
+   EXPECT_EQ(0, TBufferPool::GetStats().fBytesInUse);
+   EXPECT_EQ(1u, TBufferPool::GetStats().fReleases);
+
+   // Buffers not drawn from the pool are deleted.
+   TBufferFile buf(TBuffer::kWrite, 1000);
+   block = buf.Buffer();
+   blocksize = buf.DetachBuffer();
+   EXPECT_EQ(0, blocksize);
+   TBuffer::FreeDetachedBuffer(block, blocksize);
+   TBufferPool::Clear();
+}
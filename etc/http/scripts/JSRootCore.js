@@ -320,6 +320,24 @@
             var nkey = 2, p = 0;
             while (nkey<len) {
                if (ks[nkey][0]=="p") p = value[ks[nkey++]]; // position
+               if (ks[nkey]==='b') { // binary values coded as base64, little-endian
+                  var bin = atob(value[ks[nkey++]]), view = new DataView(new ArrayBuffer(bin.length));
+                  for (var k=0;k<bin.length;++k) view.setUint8(k, bin.charCodeAt(k));
+                  switch (value.$arr) {
+                     case "Bool" : for (var k=0;k<bin.length;++k) arr[p++] = view.getUint8(k) !== 0; break;
+                     case "Int8" : for (var k=0;k<bin.length;++k) arr[p++] = view.getInt8(k); break;
+                     case "Uint8" : for (var k=0;k<bin.length;++k) arr[p++] = view.getUint8(k); break;
+                     case "Int16" : for (var k=0;k<bin.length;k+=2) arr[p++] = view.getInt16(k, true); break;
+                     case "Uint16" : for (var k=0;k<bin.length;k+=2) arr[p++] = view.getUint16(k, true); break;
+                     case "Int32" : for (var k=0;k<bin.length;k+=4) arr[p++] = view.getInt32(k, true); break;
+                     case "Uint32" : for (var k=0;k<bin.length;k+=4) arr[p++] = view.getUint32(k, true); break;
+                     case "Int64" : for (var k=0;k<bin.length;k+=8) arr[p++] = view.getInt32(k+4, true)*0x100000000 + view.getUint32(k, true); break;
+                     case "Uint64" : for (var k=0;k<bin.length;k+=8) arr[p++] = view.getUint32(k+4, true)*0x100000000 + view.getUint32(k, true); break;
+                     case "Float32" : for (var k=0;k<bin.length;k+=4) arr[p++] = view.getFloat32(k, true); break;
+                     case "Float64" : for (var k=0;k<bin.length;k+=8) arr[p++] = view.getFloat64(k, true); break;
+                  }
+                  continue;
+               }
                if (ks[nkey][0]!=='v') throw new Error('Unexpected member ' + ks[nkey] + ' in array decoding');
                var v = value[ks[nkey++]]; // value
                if (typeof v === 'object') {
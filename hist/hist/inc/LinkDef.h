@@ -18,6 +18,7 @@
 
 
 
+#pragma link C++ class TArrayCompact-;
 #pragma link C++ class TAxis-;
 #pragma link C++ class TAxisModLab+;
 #pragma link C++ class TBinomialEfficiencyFitter+;
@@ -52,6 +53,7 @@
 #pragma link C++ class TGraphTime+;
 #pragma link C++ class TH1-;
 #pragma link C++ class TH1C+;
+#pragma link C++ class TH1Compact+;
 #pragma link C++ class TH1D+;
 #pragma link C++ class TH1F+;
 #pragma link C++ class TH1S+;
@@ -59,6 +61,7 @@
 #pragma link C++ class TH1K+;
 #pragma link C++ class TH2-;
 #pragma link C++ class TH2C-;
+#pragma link C++ class TH2Compact+;
 #pragma link C++ class TH2D-;
 #pragma link C++ class TH2F-;
 #pragma link C++ class TH2Poly+;
@@ -69,6 +72,7 @@
 #pragma link C++ class TH2I+;
 #pragma link C++ class TH3-;
 #pragma link C++ class TH3C-;
+#pragma link C++ class TH3Compact+;
 #pragma link C++ class TH3D-;
 #pragma link C++ class TH3F-;
 #pragma link C++ class TH3S-;
@@ -165,6 +165,9 @@ namespace ROOT {
          /// evaluate the partial derivative with respect to the parameter
          double DoParameterDerivative(const double *x, const double *p, unsigned int ipar) const;
 
+         /// evaluate the function at n points with the TF1 evaluation on arrays of points
+         void DoEvalParBatch(unsigned int n, const T * const *x, const double *p, T *result) const;
+
          bool fLinear;                 // flag for linear functions
          bool fPolynomial;             // flag for polynomial functions
          bool fOwnFunc;                 // flag to indicate we own the TF1 function pointer
@@ -235,6 +238,25 @@ namespace ROOT {
          return *this;
       }
 
+      template<class T>
+      void WrappedMultiTF1Templ<T>::DoEvalParBatch(unsigned int n, const T * const *x, const double *p, T *result) const
+      {
+         // evaluate one point at a time
+         std::vector<T> xx(fDim);
+         for (unsigned int i = 0; i < n; ++i) {
+            for (unsigned int j = 0; j < fDim; ++j)
+               xx[j] = x[j][i];
+            result[i] = DoEvalPar(xx.data(), p);
+         }
+      }
+
+      template<>
+      inline void WrappedMultiTF1Templ<double>::DoEvalParBatch(unsigned int n, const double * const *x, const double *p, double *result) const
+      {
+         // the TF1 evaluates all the points at once (in one loop compiled with the formula expression)
+         fFunc->EvalPar(n, x, result, p);
+      }
+
       template<class T>
       void  WrappedMultiTF1Templ<T>::ParameterGradient(const double *x, const double *par, double *grad) const
       {
@@ -242,8 +264,11 @@ namespace ROOT {
          //IMPORTANT NOTE: TF1::GradientPar returns 0 for fixed parameters to avoid computing useless derivatives
          //  BUT the TLinearFitter wants to have the derivatives also for fixed parameters.
          //  so in case of fLinear (or fPolynomial) a non-zero value will be returned for fixed parameters
+         //  (as well as when the analytic gradient of a formula is used)
 
          if (!fLinear) {
+            // use the analytic gradient of a formula when it is available
+            if (fFunc->AnalyticalGradientPar(x, grad, par)) return;
             // need to set parameter values
             fFunc->SetParameters(par);
             // no need to call InitArgs (it is called in TF1::GradientPar)
@@ -262,6 +287,8 @@ namespace ROOT {
          // evaluate the derivative of the function with respect to parameter ipar
          // see note above concerning the fixed parameters
          if (! fLinear) {
+            std::vector<double> grad(NPar());
+            if (fFunc->AnalyticalGradientPar(x, grad.data(), p)) return grad[ipar];
             fFunc->SetParameters(p);
             double prec = this->GetDerivPrecision();
             return fFunc->GradientPar(ipar, x, prec);
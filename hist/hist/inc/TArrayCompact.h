@@ -0,0 +1,116 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TArrayCompact
+#define ROOT_TArrayCompact
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TArrayCompact                                                        //
+//                                                                      //
+// Array of doubles stored in blocks of the narrowest type that holds   //
+// their values: nothing, 8, 16 or 32 bit unsigned integers or doubles. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TArray.h"
+
+#include <vector>
+
+class TArrayCompact : public TArray {
+
+public:
+   enum EBlockType { // Storage type of a block, in promotion order
+      kEmpty = 0,    // all values are zero, no storage
+      kUChar,        // 8 bit unsigned integers
+      kUShort,       // 16 bit unsigned integers
+      kUInt,         // 32 bit unsigned integers
+      kDouble        // doubles
+   };
+   enum {
+      kBlockBits = 12,              // log2 of the number of elements per block
+      kBlockSize = 1 << kBlockBits  // number of elements per block
+   };
+
+private:
+   std::vector<UChar_t> fTypes;  //! EBlockType of each block
+   std::vector<void *>  fBlocks; //! storage of each block, 0 for empty blocks
+
+   Int_t       GetBlockLength(Int_t block) const;
+   void        Promote(Int_t block, EBlockType type);
+   void        Store(Int_t i, Double_t v);
+
+public:
+   TArrayCompact();
+   TArrayCompact(Int_t n);
+   TArrayCompact(const TArrayCompact &array);
+   TArrayCompact &operator=(const TArrayCompact &rhs);
+   virtual    ~TArrayCompact();
+
+   void        AddAt(Double_t c, Int_t i);
+   Double_t    At(Int_t i) const;
+   Double_t    GetAt(Int_t i) const { return At(i); }
+   EBlockType  GetBlockType(Int_t block) const { return (EBlockType)fTypes[block]; }
+   Long64_t    GetMemorySize() const;
+   Int_t       GetNBlocks() const { return fTypes.size(); }
+   void        Increment(Int_t i);
+   void        Reset();
+   void        Set(Int_t n);
+   void        SetAt(Double_t v, Int_t i);
+
+   ClassDef(TArrayCompact,1)  //Array of doubles with compact, type promoting storage
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the value of element i.
+
+inline Double_t TArrayCompact::At(Int_t i) const
+{
+   if (!BoundsOk("TArrayCompact::At", i)) return 0;
+   const void *block = fBlocks[i >> kBlockBits];
+   const Int_t j = i & (kBlockSize - 1);
+   switch (fTypes[i >> kBlockBits]) {
+      case kUChar:  return ((const UChar_t *)block)[j];
+      case kUShort: return ((const UShort_t *)block)[j];
+      case kUInt:   return ((const UInt_t *)block)[j];
+      case kDouble: return ((const Double_t *)block)[j];
+      default:      return 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add 1 to element i. The block is promoted to a wider type if the
+/// incremented value does not fit in its type.
+
+inline void TArrayCompact::Increment(Int_t i)
+{
+   if (!BoundsOk("TArrayCompact::Increment", i)) return;
+   void *block = fBlocks[i >> kBlockBits];
+   const Int_t j = i & (kBlockSize - 1);
+   switch (fTypes[i >> kBlockBits]) {
+      case kUChar:
+         if (((UChar_t *)block)[j] != 0xFFU) { ++((UChar_t *)block)[j]; return; }
+         break;
+      case kUShort:
+         if (((UShort_t *)block)[j] != 0xFFFFU) { ++((UShort_t *)block)[j]; return; }
+         break;
+      case kUInt:
+         if (((UInt_t *)block)[j] != 0xFFFFFFFFU) { ++((UInt_t *)block)[j]; return; }
+         break;
+      case kDouble:
+         ++((Double_t *)block)[j];
+         return;
+      default:
+         break;
+   }
+   Store(i, At(i) + 1);
+}
+
+#endif
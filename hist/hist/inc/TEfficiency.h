@@ -2,6 +2,7 @@
 #define ROOT_TEfficiency
 
 //standard header
+#include <atomic>
 #include <vector>
 #include <utility>
 
@@ -24,8 +25,16 @@ class TH1;
 class TH2;
 class TList;
 
+namespace ROOT {
+namespace Internal {
+class TEfficiencyCache;
+}
+}
+
 class TEfficiency: public TNamed, public TAttLine, public TAttFill, public TAttMarker
 {
+   friend class ROOT::Internal::TEfficiencyCache;
+
 public:
       //enumaration type for different statistic options for calculating confidence intervals
       //kF* ... frequentist methods; kB* ... bayesian methods
@@ -50,6 +59,7 @@ protected:
       Double_t      (*fBoundary)(Double_t,Double_t,Double_t,Bool_t);               //!pointer to a method calculating the boundaries of confidence intervals
       Double_t      fConfLevel;              //confidence level (default = 0.683, 1 sigma)
       TDirectory*   fDirectory;              //!pointer to directory holding this TEfficiency object
+      mutable std::atomic<ROOT::Internal::TEfficiencyCache*> fErrorCache; //!errors of the bins already computed
       TList*        fFunctions;              //->pointer to list of functions
       TGraphAsymmErrors* fPaintGraph;        //!temporary graph for painting
       TH2*          fPaintHisto;             //!temporary histogram for painting
@@ -67,8 +77,12 @@ protected:
       };
 
       void          Build(const char* name,const char* title);
+      Double_t      ComputeEfficiencyErrorLow(Int_t bin) const;
+      Double_t      ComputeEfficiencyErrorUp(Int_t bin) const;
       void          FillGraph(TGraphAsymmErrors * graph, Option_t * opt) const;
       void          FillHistogram(TH2 * h2) const;
+      void          GetEfficiencyErrors(Int_t bin,Double_t& low,Double_t& up) const;
+      ROOT::Internal::TEfficiencyCache* GetErrorCache() const;
 
 public:
       TEfficiency();
@@ -93,6 +107,7 @@ public:
 
       void          Add(const TEfficiency& rEff) {*this += rEff;}
       void          Browse(TBrowser*){Draw();}
+      void          CacheErrors() const;
       TGraphAsymmErrors*   CreateGraph(Option_t * opt = "") const;
       TH2*          CreateHistogram(Option_t * opt = "") const;
       virtual Int_t DistancetoPrimitive(Int_t px, Int_t py);
@@ -38,6 +38,7 @@ public:
    virtual TF1     *DrawCopy(Option_t *option="") const;
    virtual Double_t Eval(Double_t x, Double_t y=0, Double_t z=0, Double_t t=0) const;
    virtual Double_t EvalPar(const Double_t *x, const Double_t *params=0);
+   virtual void     EvalPar(Int_t n, const Double_t * const *x, Double_t *result, const Double_t *params=0);
    virtual Double_t GetXY() const {return fXY;}
    virtual void     SavePrimitive(std::ostream &out, Option_t *option = "");
    virtual void     SetXY(Double_t xy);  // *MENU*
@@ -19,6 +19,7 @@
 #include "TObjArray.h"
 #include "TMethodCall.h"
 #include "TInterpreter.h"
+#include <atomic>
 #include <vector>
 #include <list>
 #include <map>
@@ -96,10 +97,15 @@ private:
    TString           fClingName;     //! unique name passed to Cling to define the function ( double clingName(double*x, double*p) )
 
    TInterpreter::CallFuncIFacePtr_t::Generic_t fFuncPtr;   //!  function pointer
+   mutable std::atomic<TInterpreter::CallFuncIFacePtr_t::Generic_t> fBatchFuncPtr; //!  function pointer for arrays of points
+   mutable std::atomic<TInterpreter::CallFuncIFacePtr_t::Generic_t> fGradFuncPtr; //!  function pointer for the parameter gradient
+   mutable std::atomic<Bool_t> fGradFailed;    //!  the parameter gradient can not be generated
    void *   fLambdaPtr;                                    //!  pointer to the lambda function
 
    void     InputFormulaIntoCling();
    Bool_t   PrepareEvalMethod();
+   Bool_t   PrepareBatchMethod() const;
+   Bool_t   PrepareGradientMethod() const;
    void     FillDefaults();
    void     HandlePolN(TString &formula);
    void     HandleParametrizedFunctions(TString &formula);
@@ -164,6 +170,9 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   void           EvalPar(Int_t n, const Double_t * const *x, Double_t *result, const Double_t *params=0) const;
+   Bool_t         GradientPar(const Double_t *x, Double_t *grad, const Double_t *params=0) const;
+   Bool_t         HasGradientPar() const;
    TString        GetExpFormula(Option_t *option="") const;
    const TObject *GetLinearPart(Int_t i) const;
    Int_t          GetNdim() const {return fNdim;}
@@ -197,6 +206,9 @@ public:
    void           SetVariable(const TString &name, Double_t value);
    void           SetVariables(const std::pair<TString,Double_t> *vars, const Int_t size);
 
+   static Bool_t  SaveCompiledFormulas(const char *filename);
+   static Bool_t  LoadCompiledFormulas(const char *filename);
+
    ClassDef(TFormula,10)
 };
 #endif
@@ -34,6 +34,7 @@
 #include "TArrayI.h"
 #include "TArrayF.h"
 #include "TArrayD.h"
+#include "TArrayCompact.h"
 #include "Foption.h"
 
 #include "TVectorFfwd.h"
@@ -52,6 +53,11 @@ class TCollection;
 class TVirtualFFT;
 class TVirtualHistPainter;
 
+namespace ROOT {
+namespace Internal {
+class TH1ConcurrentFill;
+}
+}
 
 class TH1 : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
@@ -100,6 +106,7 @@ protected:
     Int_t         fDimension;       ///<!Histogram dimension (1, 2 or 3 dim)
     Double_t     *fIntegral;        ///<!Integral of bins used by GetRandom
     TVirtualHistPainter *fPainter;  ///<!pointer to histogram painter
+    ROOT::Internal::TH1ConcurrentFill *fConcurrentFill; ///<!per-thread fill shadows (see SetConcurrentFill)
     EBinErrorOpt  fBinStatErrOpt;   ///< option for bin statistical errors
     static Int_t  fgBufferSize;     ///<!default buffer size for automatic histograms
     static Bool_t fgAddDirectory;   ///<!flag to add histograms to the directory
@@ -135,6 +142,8 @@ protected:
 
    virtual void     DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride=1);
 
+   TH1             *GetConcurrentFillShadow();
+
    static bool CheckAxisLimits(const TAxis* a1, const TAxis* a2);
    static bool CheckBinLimits(const TAxis* a1, const TAxis* a2);
    static bool CheckBinLabels(const TAxis* a1, const TAxis* a2);
@@ -213,6 +222,7 @@ public:
    virtual TFitResultPtr    Fit(const char *formula ,Option_t *option="" ,Option_t *goption="", Double_t xmin=0, Double_t xmax=0); // *MENU*
    virtual TFitResultPtr    Fit(TF1 *f1 ,Option_t *option="" ,Option_t *goption="", Double_t xmin=0, Double_t xmax=0);
    virtual void     FitPanel(); // *MENU*
+   void             FlushConcurrentFill();
    TH1             *GetAsymmetry(TH1* h2, Double_t c2=1, Double_t dc2=0);
    Int_t            GetBufferLength() const {return fBuffer ? (Int_t)fBuffer[0] : 0;}
    Int_t            GetBufferSize  () const {return fBufferSize;}
@@ -309,6 +319,7 @@ public:
    virtual Double_t Interpolate(Double_t x);
    virtual Double_t Interpolate(Double_t x, Double_t y);
    virtual Double_t Interpolate(Double_t x, Double_t y, Double_t z);
+           Bool_t   IsConcurrentFill() const { return fConcurrentFill != 0; }
            Bool_t   IsBinOverflow(Int_t bin, Int_t axis = 0) const;
            Bool_t   IsBinUnderflow(Int_t bin, Int_t axis = 0) const;
    virtual Double_t AndersonDarlingTest(const TH1 *h2, Option_t *option="") const;
@@ -354,6 +365,7 @@ public:
    virtual void     SetBinErrorOption(EBinErrorOpt type) { fBinStatErrOpt = type; }
    virtual void     SetBuffer(Int_t buffersize, Option_t *option="");
    virtual UInt_t   SetCanExtend(UInt_t extendBitMask);
+   virtual void     SetConcurrentFill(Bool_t concurrent = kTRUE);
    virtual void     SetContent(const Double_t *content);
    virtual void     SetContour(Int_t nlevels, const Double_t *levels=0);
    virtual void     SetContourLevel(Int_t level, Double_t value);
@@ -632,6 +644,32 @@ TH1D operator-(const TH1D &h1, const TH1D &h2);
 TH1D operator*(const TH1D &h1, const TH1D &h2);
 TH1D operator/(const TH1D &h1, const TH1D &h2);
 
+//________________________________________________________________________
+
+class TH1Compact : public TH1, public TArrayCompact {
+
+public:
+   TH1Compact();
+   TH1Compact(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup);
+   TH1Compact(const char *name,const char *title,Int_t nbinsx,const Float_t  *xbins);
+   TH1Compact(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins);
+   TH1Compact(const TH1Compact &h1c);
+   TH1Compact& operator=(const TH1Compact &h1);
+   virtual ~TH1Compact();
+
+   virtual void     AddBinContent(Int_t bin) {Increment(bin);}
+   virtual void     AddBinContent(Int_t bin, Double_t w) {AddAt(w, bin);}
+   virtual void     Copy(TObject &hnew) const;
+   virtual void     Reset(Option_t *option="");
+   virtual void     SetBinsLength(Int_t n=-1);
+
+   ClassDef(TH1Compact,1)  //1-Dim histograms (compact bin storage, promoted to wider types when needed)
+
+protected:
+   virtual Double_t RetrieveBinContent(Int_t bin) const { return At(bin); }
+   virtual void     UpdateBinContent(Int_t bin, Double_t content) { SetAt(content, bin); }
+};
+
    extern TH1 *R__H(Int_t hid);
    extern TH1 *R__H(const char *hname);
 
@@ -325,5 +325,37 @@ protected:
    ClassDef(TH2D,3)  //2-Dim histograms (one double per channel)
 };
 
+//______________________________________________________________________________
+
+class TH2Compact : public TH2, public TArrayCompact {
+
+public:
+   TH2Compact();
+   TH2Compact(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+                                                ,Int_t nbinsy,Double_t ylow,Double_t yup);
+   TH2Compact(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+                                                ,Int_t nbinsy,Double_t ylow,Double_t yup);
+   TH2Compact(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+                                                ,Int_t nbinsy,const Double_t *ybins);
+   TH2Compact(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+                                                ,Int_t nbinsy,const Double_t *ybins);
+   TH2Compact(const char *name,const char *title,Int_t nbinsx,const Float_t  *xbins
+                                                ,Int_t nbinsy,const Float_t  *ybins);
+   TH2Compact(const TH2Compact &h2c);
+   virtual ~TH2Compact();
+   virtual void     AddBinContent(Int_t bin) {Increment(bin);}
+   virtual void     AddBinContent(Int_t bin, Double_t w) {AddAt(w, bin);}
+   virtual void     Copy(TObject &hnew) const;
+   virtual void     Reset(Option_t *option="");
+   virtual void     SetBinsLength(Int_t n=-1);
+           TH2Compact& operator=(const TH2Compact &h1);
+
+protected:
+   virtual Double_t RetrieveBinContent(Int_t bin) const { return At(bin); }
+   virtual void     UpdateBinContent(Int_t bin, Double_t content) { SetAt(content, bin); }
+
+   ClassDef(TH2Compact,1)  //2-Dim histograms (compact bin storage, promoted to wider types when needed)
+};
+
 #endif
 
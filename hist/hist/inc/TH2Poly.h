@@ -62,6 +62,11 @@ class TList;
 class TGraph;
 class TMultiGraph;
 class TPad;
+namespace ROOT {
+namespace Internal {
+class TH2PolyIndex;
+}
+}
 
 class TH2Poly : public TH2 {
 
@@ -91,6 +96,7 @@ public:
    Int_t        Fill(const char *, const char *, Double_t ){return -1;} //MayNotUse
    void         FillN(Int_t, const Double_t*, const Double_t*, Int_t){return;}  //MayNotUse
    Int_t        FindBin(Double_t x, Double_t y, Double_t z = 0);
+   void         FindBin(Int_t n, const Double_t *x, const Double_t *y, Int_t *bins, Int_t stride = 1);
    TList       *GetBins(){return fBins;}                                // Returns the TList of all bins in the histogram
    virtual Double_t     GetBinContent(Int_t bin) const;
    virtual Double_t     GetBinContent(Int_t, Int_t) const {return 0;}           //MayNotUse
@@ -143,8 +149,12 @@ protected:
    Bool_t   fFloat;             //When set to kTRUE, allows the histogram to expand if a bin outside the limits is added.
    Bool_t   fNewBinAdded;       //!For the 3D Painter
    Bool_t   fBinContentChanged; //!For the 3D Painter
+   ROOT::Internal::TH2PolyIndex *fIndex; //!Spatial index of the bins, built by FindBin
 
    void   AddBinToPartition(TH2PolyBin *bin);  // Adds the input bin into the partition matrix
+   Int_t  DoFill(Int_t bin, Double_t x, Double_t y, Double_t w);
+   Int_t  FindOverflow(Double_t x, Double_t y) const;
+   const ROOT::Internal::TH2PolyIndex &GetIndex();
    void   Initialize(Double_t xlow, Double_t xup, Double_t ylow, Double_t yup, Int_t n, Int_t m);
    Bool_t IsIntersecting(TH2PolyBin *bin, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
    Bool_t IsIntersectingPolygon(Int_t bn, Double_t *x, Double_t *y, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
@@ -80,6 +80,9 @@ public:
    virtual Int_t    Fill(Double_t x, const char *namey, const char *namez, Double_t w);
    virtual Int_t    Fill(Double_t x, const char *namey, Double_t z, Double_t w);
    virtual Int_t    Fill(Double_t x, Double_t y, const char *namez, Double_t w);
+   virtual void     FillN(Int_t, const Double_t *, const Double_t *, Int_t) {;} //MayNotUse
+   virtual void     FillN(Int_t, const Double_t *, const Double_t *, const Double_t *, Int_t) {;} //MayNotUse
+   virtual void     FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride=1);
 
    virtual void     FillRandom(const char *fname, Int_t ntimes=5000);
    virtual void     FillRandom(TH1 *h, Int_t ntimes=5000);
@@ -336,5 +339,35 @@ protected:
    ClassDef(TH3D,3)  //3-Dim histograms (one double per channel)
 };
 
+//________________________________________________________________________
+
+class TH3Compact : public TH3, public TArrayCompact {
+public:
+   TH3Compact();
+   TH3Compact(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+                                        ,Int_t nbinsy,Double_t ylow,Double_t yup
+                                        ,Int_t nbinsz,Double_t zlow,Double_t zup);
+   TH3Compact(const char *name,const char *title,Int_t nbinsx,const Float_t *xbins
+                                                ,Int_t nbinsy,const Float_t *ybins
+                                                ,Int_t nbinsz,const Float_t *zbins);
+   TH3Compact(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+                                                ,Int_t nbinsy,const Double_t *ybins
+                                                ,Int_t nbinsz,const Double_t *zbins);
+   TH3Compact(const TH3Compact &h3c);
+   virtual ~TH3Compact();
+   virtual void      AddBinContent(Int_t bin) {Increment(bin);}
+   virtual void      AddBinContent(Int_t bin, Double_t w) {AddAt(w, bin);}
+   virtual void      Copy(TObject &hnew) const;
+   virtual void      Reset(Option_t *option="");
+   virtual void      SetBinsLength(Int_t n=-1);
+           TH3Compact& operator=(const TH3Compact &h1);
+
+protected:
+   virtual Double_t RetrieveBinContent(Int_t bin) const { return At(bin); }
+   virtual void     UpdateBinContent(Int_t bin, Double_t content) { SetAt(content, bin); }
+
+   ClassDef(TH3Compact,1)  //3-Dim histograms (compact bin storage, promoted to wider types when needed)
+};
+
 #endif
 
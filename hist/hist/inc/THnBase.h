@@ -104,8 +104,11 @@ private:
                    const TObjArray* axes, Bool_t keepTargetAxis) const;
    TObject* ProjectionAny(Int_t ndim, const Int_t* dim,
                           Bool_t wantNDim, Option_t* option = "") const;
+   Bool_t ProjectionParallel(TH1* hist, Int_t ndim, const Int_t* dim, Bool_t keepTargetAxis,
+                             Bool_t wantErrors, Bool_t& haveSkippedBin) const;
    Bool_t PrintBin(Long64_t idx, Int_t* coord, Option_t* options) const;
    void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
+   virtual Bool_t AddSameBinning(const THnBase* /*h*/, Double_t /*c*/) { return kFALSE; }
    THnBase* RebinBase(Int_t group) const;
    THnBase* RebinBase(const Int_t* group) const;
    void ResetBase(Option_t *option= "");
@@ -152,6 +155,7 @@ private:
       return bin;
    }
 
+   virtual void FillN(Int_t ntimes, const Double_t* x, const Double_t* w = 0);
    virtual void FillBin(Long64_t bin, Double_t w) = 0;
 
    void SetBinEdges(Int_t idim, const Double_t* bins);
@@ -21,7 +21,6 @@
 
 
 #include "THnBase.h"
-#include "TExMap.h"
 #include "THnSparse_Internal.h"
 
 // needed only for template instantiations of THnSparseT:
@@ -32,14 +31,14 @@
 #include "TArrayC.h"
 
 class THnSparseCompactBinCoord;
+class THnSparseBinMap;
 
 class THnSparse: public THnBase {
  private:
    Int_t      fChunkSize;    // number of entries for each chunk
    Long64_t   fFilledBins;   // number of filled bins
    TObjArray  fBinContent;   // array of THnSparseArrayChunk
-   TExMap     fBins;         //! filled bins
-   TExMap     fBinsContinued;//! filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   THnSparseBinMap *fBinMap; //! filled bins: hash of the compact coordinates to bin index
    THnSparseCompactBinCoord *fCompactCoord; //! compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -57,9 +56,13 @@ class THnSparse: public THnBase {
 
    THnSparseArrayChunk* AddChunk();
    void Reserve(Long64_t nbins);
-   void FillExMap();
+   void FillBinMap();
+   THnSparseBinMap* GetBinMap();
    virtual TArray* GenerateArray() const = 0;
+   Long64_t FindBinIndex(ULong64_t hash, const Char_t* coordbuf) const;
+   Long64_t GetBinIndex(ULong64_t hash, const Char_t* coordbuf, Bool_t allocate);
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
+   Bool_t AddSameBinning(const THnBase* h, Double_t c);
    void FillBin(Long64_t bin, Double_t w) {
       // Increment the bin content of "bin" by "w",
       // return the bin index.
@@ -113,6 +116,8 @@ class THnSparse: public THnBase {
    void AddBinContent(Long64_t bin, Double_t v = 1.);
    void AddBinError2(Long64_t bin, Double_t e2);
 
+   void FillN(Int_t ntimes, const Double_t* x, const Double_t* w = 0);
+
    Double_t GetBinContent(const Int_t *idx) const {
       // Forwards to THnBase::GetBinContent() overload.
       // Non-virtual, CINT-compatible replacement of a using declaration.
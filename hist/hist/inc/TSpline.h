@@ -14,6 +14,8 @@
 
 #include "TGraph.h"
 
+#include <vector>
+
 class TH1;
 class TF1;
 
@@ -196,8 +198,10 @@ protected:
    Double_t       fValEnd;     // End value of first or second derivative
    Int_t          fBegCond;    // 0=no beg cond, 1=first derivative, 2=second derivative
    Int_t          fEndCond;    // 0=no end cond, 1=first derivative, 2=second derivative
+   std::vector<Double_t> fCoeff; //! x, y, b, c and d of the knots, as fNp long contiguous arrays
 
    void   BuildCoeff();
+   void   FillCoeff();
    void   SetCond(const char *opt);
 
 public:
@@ -226,6 +230,7 @@ public:
    TSpline3& operator=(const TSpline3&);
    Int_t    FindX(Double_t x) const;
    Double_t Eval(Double_t x) const;
+   void     Eval(Int_t n, const Double_t *x, Double_t *y) const;
    Double_t Derivative(Double_t x) const;
    virtual ~TSpline3() {if (fPoly) delete [] fPoly;}
    void GetCoeff(Int_t i, Double_t &x, Double_t &y, Double_t &b,
@@ -362,7 +362,7 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
       fitConfig.SetWeightCorrection(weight);
       bool extended = ((fitOption.Like & 4 ) != 4 );
       //if (!extended) Info("HFitImpl","Do a not -extended binned fit");
-      fitok = fitter->LikelihoodFit(*fitdata, extended);
+      fitok = fitter->LikelihoodFit(*fitdata, extended, fitOption.ExecPolicy);
    }
    else{ // standard least square fit
       fitok = fitter->Fit(*fitdata, fitOption.ExecPolicy);
@@ -703,10 +703,10 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
             opt.ReplaceAll("WIDTH","");
       }
 
-      // if (opt.Contains("MULTIPROC")) {
-      //    fitOption.ExecPolicy = ROOT::Fit::kMultiprocess;
-      //    opt.ReplaceAll("MULTIPROC","");
-      // }
+      if (opt.Contains("MULTIPROC")) {
+         fitOption.ExecPolicy = ROOT::Fit::kMultiprocess;
+         opt.ReplaceAll("MULTIPROC","");
+      }
 
       if (opt.Contains("MULTITHREAD")) {
          fitOption.ExecPolicy = ROOT::Fit::kMultithread;
@@ -0,0 +1,288 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TArrayCompact
+\ingroup Hist
+Array of doubles with a compact storage, used for the bin contents of the
+TH1Compact, TH2Compact and TH3Compact histograms.
+
+The elements are stored in blocks of kBlockSize consecutive elements. Each
+block has its own storage type: a block whose elements are all zero has no
+storage, and a block whose elements are non-negative integers is stored as
+8, 16 or 32 bit unsigned integers. A block is promoted to the next wider type
+that holds a new value when it is stored, and to doubles for negative or
+non-integer values. Blocks are never demoted, except by Reset().
+
+Occupancy-style contents (counts of unweighted entries) thus take one byte
+per element as long as they stay below 256, and nothing in empty regions.
+*/
+
+#include "TArrayCompact.h"
+#include "TBuffer.h"
+#include "TError.h"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+ClassImp(TArrayCompact)
+
+namespace {
+
+// Size in bytes of an element of the given block type.
+size_t GetElementSize(UChar_t type)
+{
+   switch (type) {
+      case TArrayCompact::kUChar:  return sizeof(UChar_t);
+      case TArrayCompact::kUShort: return sizeof(UShort_t);
+      case TArrayCompact::kUInt:   return sizeof(UInt_t);
+      case TArrayCompact::kDouble: return sizeof(Double_t);
+      default:                     return 0;
+   }
+}
+
+// Narrowest block type that holds the value v.
+TArrayCompact::EBlockType GetRequiredType(Double_t v)
+{
+   if (v == 0) return TArrayCompact::kEmpty;
+   if (v < 0 || v != std::floor(v)) return TArrayCompact::kDouble;
+   if (v <= 0xFFU) return TArrayCompact::kUChar;
+   if (v <= 0xFFFFU) return TArrayCompact::kUShort;
+   if (v <= 0xFFFFFFFFU) return TArrayCompact::kUInt;
+   return TArrayCompact::kDouble;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default TArrayCompact ctor.
+
+TArrayCompact::TArrayCompact()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create TArrayCompact object and set array size to n elements, all zero.
+
+TArrayCompact::TArrayCompact(Int_t n)
+{
+   if (n > 0) Set(n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor.
+
+TArrayCompact::TArrayCompact(const TArrayCompact &array) : TArray()
+{
+   *this = array;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// TArrayCompact assignment operator, the blocks keep their storage type.
+
+TArrayCompact &TArrayCompact::operator=(const TArrayCompact &rhs)
+{
+   if (this == &rhs) return *this;
+   Reset();
+   fN = rhs.fN;
+   fTypes = rhs.fTypes;
+   fBlocks.assign(rhs.fBlocks.size(), nullptr);
+   for (Int_t b = 0; b < GetNBlocks(); ++b) {
+      if (!rhs.fBlocks[b]) continue;
+      size_t size = GetBlockLength(b) * GetElementSize(fTypes[b]);
+      fBlocks[b] = ::operator new(size);
+      memcpy(fBlocks[b], rhs.fBlocks[b], size);
+   }
+   return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete TArrayCompact object.
+
+TArrayCompact::~TArrayCompact()
+{
+   Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add value c to element i.
+
+void TArrayCompact::AddAt(Double_t c, Int_t i)
+{
+   if (c == 1) {
+      Increment(i);
+      return;
+   }
+   if (!BoundsOk("TArrayCompact::AddAt", i)) return;
+   if (fTypes[i >> kBlockBits] == kDouble) {
+      ((Double_t *)fBlocks[i >> kBlockBits])[i & (kBlockSize - 1)] += c;
+      return;
+   }
+   Store(i, At(i) + c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of elements of the given block.
+
+Int_t TArrayCompact::GetBlockLength(Int_t block) const
+{
+   Int_t first = block << kBlockBits;
+   return (fN - first < kBlockSize) ? fN - first : (Int_t)kBlockSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes used by the elements.
+
+Long64_t TArrayCompact::GetMemorySize() const
+{
+   Long64_t size = 0;
+   for (Int_t b = 0; b < GetNBlocks(); ++b)
+      size += GetBlockLength(b) * GetElementSize(fTypes[b]);
+   return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert the storage of the given block to the wider type.
+
+void TArrayCompact::Promote(Int_t block, EBlockType type)
+{
+   const Int_t n = GetBlockLength(block);
+   void *storage = ::operator new(n * GetElementSize(type));
+   const Int_t first = block << kBlockBits;
+   for (Int_t j = 0; j < n; ++j) {
+      Double_t v = At(first + j);
+      switch (type) {
+         case kUChar:  ((UChar_t *)storage)[j] = (UChar_t)v; break;
+         case kUShort: ((UShort_t *)storage)[j] = (UShort_t)v; break;
+         case kUInt:   ((UInt_t *)storage)[j] = (UInt_t)v; break;
+         default:      ((Double_t *)storage)[j] = v; break;
+      }
+   }
+   ::operator delete(fBlocks[block]);
+   fBlocks[block] = storage;
+   fTypes[block] = type;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the storage of all blocks, setting all elements to zero.
+
+void TArrayCompact::Reset()
+{
+   for (auto block : fBlocks)
+      ::operator delete(block);
+   fBlocks.assign(fBlocks.size(), nullptr);
+   fTypes.assign(fTypes.size(), kEmpty);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set size of this array to n elements.
+/// The values of the first min(n, old size) elements are kept, the new
+/// elements are zero.
+
+void TArrayCompact::Set(Int_t n)
+{
+   if (n < 0) return;
+   if (n == fN) return;
+   TArrayCompact old;
+   std::swap(old.fTypes, fTypes);
+   std::swap(old.fBlocks, fBlocks);
+   old.fN = fN;
+   fN = n;
+   const Int_t nBlocks = (n + kBlockSize - 1) / kBlockSize;
+   fTypes.assign(nBlocks, kEmpty);
+   fBlocks.assign(nBlocks, nullptr);
+   const Int_t ncopy = (n < old.fN) ? n : old.fN;
+   for (Int_t i = 0; i < ncopy; ++i) {
+      if (old.fTypes[i >> kBlockBits] != kEmpty) Store(i, old.At(i));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set element i to v.
+
+void TArrayCompact::SetAt(Double_t v, Int_t i)
+{
+   if (!BoundsOk("TArrayCompact::SetAt", i)) return;
+   Store(i, v);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set element i to v, promoting its block if needed.
+
+void TArrayCompact::Store(Int_t i, Double_t v)
+{
+   const Int_t b = i >> kBlockBits;
+   EBlockType type = GetRequiredType(v);
+   if (type > fTypes[b]) Promote(b, type);
+   const Int_t j = i & (kBlockSize - 1);
+   switch (fTypes[b]) {
+      case kUChar:  ((UChar_t *)fBlocks[b])[j] = (UChar_t)v; break;
+      case kUShort: ((UShort_t *)fBlocks[b])[j] = (UShort_t)v; break;
+      case kUInt:   ((UInt_t *)fBlocks[b])[j] = (UInt_t)v; break;
+      case kDouble: ((Double_t *)fBlocks[b])[j] = v; break;
+      default:      break;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stream a TArrayCompact object: the storage type of each block followed
+/// by its elements.
+
+void TArrayCompact::Streamer(TBuffer &b)
+{
+   if (b.IsReading()) {
+      UInt_t R__s, R__c;
+      b.ReadVersion(&R__s, &R__c);
+      Int_t n;
+      b >> n;
+      Reset();
+      fN = 0;
+      fTypes.clear();
+      fBlocks.clear();
+      Set(n);
+      for (Int_t block = 0; block < GetNBlocks(); ++block) {
+         UChar_t type;
+         b >> type;
+         if (type == kEmpty) continue;
+         if (type > kDouble) {
+            // corrupted data or unknown storage type: skip the object, all elements are zero
+            ::Error("TArrayCompact::Streamer", "unknown type %d of block %d, the array is reset", (Int_t)type, block);
+            Reset();
+            b.SetBufferOffset(R__s + R__c + sizeof(UInt_t));
+            return;
+         }
+         Promote(block, (EBlockType)type);
+         const Int_t len = GetBlockLength(block);
+         switch (type) {
+            case kUChar:  b.ReadFastArray((UChar_t *)fBlocks[block], len); break;
+            case kUShort: b.ReadFastArray((UShort_t *)fBlocks[block], len); break;
+            case kUInt:   b.ReadFastArray((UInt_t *)fBlocks[block], len); break;
+            default:      b.ReadFastArray((Double_t *)fBlocks[block], len); break;
+         }
+      }
+      b.CheckByteCount(R__s, R__c, TArrayCompact::IsA());
+   } else {
+      UInt_t R__c = b.WriteVersion(TArrayCompact::IsA(), kTRUE);
+      b << fN;
+      for (Int_t block = 0; block < GetNBlocks(); ++block) {
+         UChar_t type = fTypes[block];
+         b << type;
+         const Int_t len = GetBlockLength(block);
+         switch (type) {
+            case kUChar:  b.WriteFastArray((UChar_t *)fBlocks[block], len); break;
+            case kUShort: b.WriteFastArray((UShort_t *)fBlocks[block], len); break;
+            case kUInt:   b.WriteFastArray((UInt_t *)fBlocks[block], len); break;
+            case kDouble: b.WriteFastArray((Double_t *)fBlocks[block], len); break;
+            default:      break;
+         }
+      }
+      b.SetByteCount(R__c, kTRUE);
+   }
+}
@@ -7,6 +7,9 @@
 #include <cmath>
 #include <stdlib.h>
 #include <cassert>
+#include <algorithm>
+#include <limits>
+#include <mutex>
 
 //ROOT headers
 #include "Math/DistFuncMathCore.h"
@@ -32,6 +35,10 @@
 // file with extra class for FC method
 #include "TEfficiencyHelper.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 //default values
 const Double_t kDefBetaAlpha = 1;
 const Double_t kDefBetaBeta = 1;
@@ -39,6 +46,101 @@ const Double_t kDefConfLevel = 0.682689492137; // 1 sigma
 const TEfficiency::EStatOption kDefStatOpt = TEfficiency::kFCP;
 const Double_t kDefWeight = 1;
 
+namespace ROOT {
+namespace Internal {
+
+// Errors of the bins of a TEfficiency, with the bin contents and the settings
+// they were computed for (see TEfficiency::GetEfficiencyErrorLow).
+// The errors are computed without holding the lock and stored afterwards,
+// so that concurrent const calls on the same TEfficiency are safe.
+class TEfficiencyCache {
+public:
+   struct Settings_t {
+      Int_t fStatisticOption;
+      Double_t fConfLevel;
+      UInt_t fBits;
+      Bool_t operator==(const Settings_t &rhs) const
+      {
+         return fStatisticOption == rhs.fStatisticOption && fConfLevel == rhs.fConfLevel && fBits == rhs.fBits;
+      }
+   };
+   struct Entry_t {
+      Double_t fTotal;    // content of the total histogram, NaN if the errors were not computed
+      Double_t fPassed;   // content of the passed histogram
+      Double_t fTotalW2;  // sum of weights squared of the total histogram, 0 without weights
+      Double_t fPassedW2; // sum of weights squared of the passed histogram, 0 without weights
+      Double_t fAlpha;    // parameters of the beta prior of the bin
+      Double_t fBeta;
+      Double_t fLow;      // lower error
+      Double_t fUp;       // upper error
+      Bool_t operator==(const Entry_t &rhs) const
+      {
+         return fTotal == rhs.fTotal && fPassed == rhs.fPassed && fTotalW2 == rhs.fTotalW2 &&
+                fPassedW2 == rhs.fPassedW2 && fAlpha == rhs.fAlpha && fBeta == rhs.fBeta;
+      }
+   };
+
+   Settings_t fSettings;
+   std::vector<Entry_t> fEntries; // by global bin
+   std::mutex fMutex;             // protects the settings and the entries
+
+   static Settings_t GetSettings(const TEfficiency &eff);
+   static Entry_t GetKey(const TEfficiency &eff, Int_t bin);
+
+   void Validate(const Settings_t &settings, UInt_t ncells);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the current statistic settings of the efficiency.
+
+TEfficiencyCache::Settings_t TEfficiencyCache::GetSettings(const TEfficiency &eff)
+{
+   Settings_t settings;
+   settings.fStatisticOption = eff.fStatisticOption;
+   settings.fConfLevel = eff.fConfLevel;
+   settings.fBits = eff.TestBits(TEfficiency::kIsBayesian | TEfficiency::kPosteriorMode |
+                                 TEfficiency::kShortestInterval | TEfficiency::kUseBinPrior |
+                                 TEfficiency::kUseWeights);
+   return settings;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the quantities the errors in the given global bin depend on, with
+/// the current statistic settings: the contents of the bin, their sums of
+/// weights squared and the parameters of the beta prior.
+
+TEfficiencyCache::Entry_t TEfficiencyCache::GetKey(const TEfficiency &eff, Int_t bin)
+{
+   Entry_t key = {};
+   key.fTotal = eff.fTotalHistogram->GetBinContent(bin);
+   key.fPassed = eff.fPassedHistogram->GetBinContent(bin);
+   if (eff.TestBit(TEfficiency::kUseWeights)) {
+      key.fTotalW2 = eff.fTotalHistogram->GetSumw2N() ? eff.fTotalHistogram->GetSumw2()->At(bin) : 0;
+      key.fPassedW2 = eff.fPassedHistogram->GetSumw2N() ? eff.fPassedHistogram->GetSumw2()->At(bin) : 0;
+   }
+   const Bool_t binPrior = eff.TestBit(TEfficiency::kUseBinPrior);
+   key.fAlpha = binPrior ? eff.GetBetaAlpha(bin) : eff.GetBetaAlpha();
+   key.fBeta = binPrior ? eff.GetBetaBeta(bin) : eff.GetBetaBeta();
+   return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Empties the cache if the statistic settings or the number of bins changed
+/// since the errors were stored. Must be called with fMutex locked.
+
+void TEfficiencyCache::Validate(const Settings_t &settings, UInt_t ncells)
+{
+   if (fSettings == settings && fEntries.size() == ncells)
+      return;
+   Entry_t empty = {};
+   empty.fTotal = std::numeric_limits<Double_t>::quiet_NaN();
+   fSettings = settings;
+   fEntries.assign(ncells, empty);
+}
+
+} // namespace Internal
+} // namespace ROOT
+
 ClassImp(TEfficiency)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -622,6 +724,7 @@ fBeta_beta(kDefBetaBeta),
 fBoundary(0),
 fConfLevel(kDefConfLevel),
 fDirectory(0),
+fErrorCache(0),
 fFunctions(0),
 fPaintGraph(0),
 fPaintHisto(0),
@@ -660,6 +763,7 @@ fBeta_alpha(kDefBetaAlpha),
 fBeta_beta(kDefBetaBeta),
 fConfLevel(kDefConfLevel),
 fDirectory(0),
+fErrorCache(0),
 fFunctions(0),
 fPaintGraph(0),
 fPaintHisto(0),
@@ -727,6 +831,7 @@ fBeta_alpha(kDefBetaAlpha),
 fBeta_beta(kDefBetaBeta),
 fConfLevel(kDefConfLevel),
 fDirectory(0),
+fErrorCache(0),
 fFunctions(0),
 fPaintGraph(0),
 fPaintHisto(0),
@@ -766,6 +871,7 @@ fBeta_alpha(kDefBetaAlpha),
 fBeta_beta(kDefBetaBeta),
 fConfLevel(kDefConfLevel),
 fDirectory(0),
+fErrorCache(0),
 fFunctions(0),
 fPaintGraph(0),
 fPaintHisto(0),
@@ -809,6 +915,7 @@ fBeta_alpha(kDefBetaAlpha),
 fBeta_beta(kDefBetaBeta),
 fConfLevel(kDefConfLevel),
 fDirectory(0),
+fErrorCache(0),
 fFunctions(0),
 fPaintGraph(0),
 fPaintHisto(0),
@@ -852,6 +959,7 @@ fBeta_alpha(kDefBetaAlpha),
 fBeta_beta(kDefBetaBeta),
 fConfLevel(kDefConfLevel),
 fDirectory(0),
+fErrorCache(0),
 fFunctions(0),
 fPaintGraph(0),
 fPaintHisto(0),
@@ -899,6 +1007,7 @@ fBeta_alpha(kDefBetaAlpha),
 fBeta_beta(kDefBetaBeta),
 fConfLevel(kDefConfLevel),
 fDirectory(0),
+fErrorCache(0),
 fFunctions(0),
 fPaintGraph(0),
 fPaintHisto(0),
@@ -946,6 +1055,7 @@ fBeta_alpha(kDefBetaAlpha),
 fBeta_beta(kDefBetaBeta),
 fConfLevel(kDefConfLevel),
 fDirectory(0),
+fErrorCache(0),
 fFunctions(0),
 fPaintGraph(0),
 fPaintHisto(0),
@@ -987,6 +1097,7 @@ fBeta_beta(rEff.fBeta_beta),
 fBeta_bin_params(rEff.fBeta_bin_params),
 fConfLevel(rEff.fConfLevel),
 fDirectory(0),
+fErrorCache(0),
 fFunctions(0),
 fPaintGraph(0),
 fPaintHisto(0),
@@ -1048,6 +1159,7 @@ TEfficiency::~TEfficiency()
    delete fPassedHistogram;
    delete fPaintGraph;
    delete fPaintHisto;
+   delete fErrorCache.load();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1585,6 +1697,100 @@ Bool_t TEfficiency::CheckWeights(const TH1& pass,const TH1& total)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Computes the errors on the efficiency of all bins and caches them
+///
+/// GetEfficiencyErrorLow(), GetEfficiencyErrorUp(), CreateGraph() and
+/// Paint() then use the cached errors of the bins which did not change.
+/// The errors of bins with the same contents are computed only once, and in
+/// parallel when implicit multi-threading is enabled
+/// (see ROOT::EnableImplicitMT()).
+
+void TEfficiency::CacheErrors() const
+{
+   if(!fTotalHistogram || !fPassedHistogram)
+      return;
+   // the contents must not be read from a buffer by concurrent tasks
+   fTotalHistogram->BufferEmpty();
+   fPassedHistogram->BufferEmpty();
+
+   // frequentist errors with weights change the statistic option on the way
+   if(TestBit(kUseWeights) && !TestBit(kIsBayesian) && fStatisticOption != kFNormal) {
+      Double_t low, up;
+      for(Int_t bin = 0; bin < fTotalHistogram->GetNcells(); ++bin)
+         GetEfficiencyErrors(bin, low, up);
+      return;
+   }
+
+   typedef ROOT::Internal::TEfficiencyCache::Entry_t Entry_t;
+   ROOT::Internal::TEfficiencyCache* cache = GetErrorCache();
+   const ROOT::Internal::TEfficiencyCache::Settings_t settings =
+      ROOT::Internal::TEfficiencyCache::GetSettings(*this);
+   const Int_t ncells = fTotalHistogram->GetNcells();
+
+   // the bins which are not cached yet, sorted by key
+   std::vector<Int_t> bins;
+   std::vector<Entry_t> keys(ncells);
+   {
+      std::lock_guard<std::mutex> lock(cache->fMutex);
+      cache->Validate(settings, ncells);
+      for(Int_t bin = 0; bin < ncells; ++bin) {
+         keys[bin] = ROOT::Internal::TEfficiencyCache::GetKey(*this, bin);
+         if(!(keys[bin] == cache->fEntries[bin]))
+            bins.push_back(bin);
+      }
+   }
+   if(bins.empty())
+      return;
+   auto less = [&keys](Int_t a, Int_t b) {
+      const Entry_t& ka = keys[a];
+      const Entry_t& kb = keys[b];
+      if(ka.fTotal != kb.fTotal) return ka.fTotal < kb.fTotal;
+      if(ka.fPassed != kb.fPassed) return ka.fPassed < kb.fPassed;
+      if(ka.fTotalW2 != kb.fTotalW2) return ka.fTotalW2 < kb.fTotalW2;
+      if(ka.fPassedW2 != kb.fPassedW2) return ka.fPassedW2 < kb.fPassedW2;
+      if(ka.fAlpha != kb.fAlpha) return ka.fAlpha < kb.fAlpha;
+      return ka.fBeta < kb.fBeta;
+   };
+   std::sort(bins.begin(), bins.end(), less);
+
+   // one bin of each group of bins with the same key
+   std::vector<Int_t> first;
+   for(UInt_t i = 0; i < bins.size(); ++i) {
+      if(i == 0 || !(keys[bins[i]] == keys[bins[i - 1]]))
+         first.push_back(i);
+   }
+   const Int_t ngroups = first.size();
+   auto compute = [&](Int_t igroup) {
+      Entry_t& key = keys[bins[first[igroup]]];
+      key.fLow = ComputeEfficiencyErrorLow(bins[first[igroup]]);
+      key.fUp = ComputeEfficiencyErrorUp(bins[first[igroup]]);
+   };
+#ifdef R__USE_IMT
+   if(ROOT::IsImplicitMTEnabled() && ngroups > 1) {
+      ROOT::TThreadExecutor pool;
+      const Int_t ntasks = std::min(ngroups, 4 * (Int_t)ROOT::GetImplicitMTPoolSize());
+      pool.Foreach([&](Int_t itask) {
+         for(Int_t igroup = itask; igroup < ngroups; igroup += ntasks)
+            compute(igroup);
+      }, ROOT::TSeq<Int_t>(0, ntasks));
+   } else
+#endif
+   {
+      for(Int_t igroup = 0; igroup < ngroups; ++igroup)
+         compute(igroup);
+   }
+
+   std::lock_guard<std::mutex> lock(cache->fMutex);
+   cache->Validate(settings, ncells);
+   for(Int_t igroup = 0; igroup < ngroups; ++igroup) {
+      const Entry_t& key = keys[bins[first[igroup]]];
+      const UInt_t end = (igroup + 1 < ngroups) ? first[igroup + 1] : bins.size();
+      for(UInt_t i = first[igroup]; i < end; ++i)
+         cache->fEntries[bins[i]] = key;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create the graph used be painted (for dim=1 TEfficiency)
 /// The return object is managed by the caller
@@ -1612,6 +1818,8 @@ TGraphAsymmErrors * TEfficiency::CreateGraph(Option_t * opt) const
 
 void TEfficiency::FillGraph(TGraphAsymmErrors * graph, Option_t * opt) const
 {
+   CacheErrors();
+
    TString option = opt;
    option.ToLower();
 
@@ -2509,8 +2717,45 @@ Double_t TEfficiency::GetEfficiency(Int_t bin) const
 ///
 /// Note: If the histograms are filled with weights, only bayesian methods and the
 ///       normal approximation are supported.
+///
+/// The lower and upper errors of a bin are computed together and cached: they
+/// are only computed again once the contents of the bin (or its sums of
+/// weights squared) or the statistic settings change, e.g. after Fill(),
+/// SetPassedEvents() or SetTotalEvents() for this bin, or
+/// SetConfidenceLevel(). CacheErrors() computes the errors of all bins at
+/// once.
 
 Double_t TEfficiency::GetEfficiencyErrorLow(Int_t bin) const
+{
+   Double_t low, up;
+   GetEfficiencyErrors(bin, low, up);
+   return low;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the upper error on the efficiency in the given global bin
+///
+/// The result depends on the current confidence level fConfLevel and the
+/// chosen statistic option fStatisticOption. See SetStatisticOption(Int_t) for
+/// more details.
+///
+/// Note: If the histograms are filled with weights, only bayesian methods and the
+///       normal approximation are supported.
+///
+/// The errors are cached, see GetEfficiencyErrorLow().
+
+Double_t TEfficiency::GetEfficiencyErrorUp(Int_t bin) const
+{
+   Double_t low, up;
+   GetEfficiencyErrors(bin, low, up);
+   return up;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Computes the lower error on the efficiency in the given global bin,
+/// see GetEfficiencyErrorLow().
+
+Double_t TEfficiency::ComputeEfficiencyErrorLow(Int_t bin) const
 {
    Int_t total = (Int_t)fTotalHistogram->GetBinContent(bin);
    Int_t passed = (Int_t)fPassedHistogram->GetBinContent(bin);
@@ -2581,16 +2826,10 @@ Double_t TEfficiency::GetEfficiencyErrorLow(Int_t bin) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Returns the upper error on the efficiency in the given global bin
-///
-/// The result depends on the current confidence level fConfLevel and the
-/// chosen statistic option fStatisticOption. See SetStatisticOption(Int_t) for
-/// more details.
-///
-/// Note: If the histograms are filled with weights, only bayesian methods and the
-///       normal approximation are supported.
+/// Computes the upper error on the efficiency in the given global bin,
+/// see GetEfficiencyErrorUp().
 
-Double_t TEfficiency::GetEfficiencyErrorUp(Int_t bin) const
+Double_t TEfficiency::ComputeEfficiencyErrorUp(Int_t bin) const
 {
    Int_t total = (Int_t)fTotalHistogram->GetBinContent(bin);
    Int_t passed = (Int_t)fPassedHistogram->GetBinContent(bin);
@@ -2659,6 +2898,56 @@ Double_t TEfficiency::GetEfficiencyErrorUp(Int_t bin) const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the lower and upper errors on the efficiency in the given global
+/// bin, from the cache if they were already computed for the current contents
+/// of the bin.
+
+void TEfficiency::GetEfficiencyErrors(Int_t bin,Double_t& low,Double_t& up) const
+{
+   const Int_t ncells = fTotalHistogram ? fTotalHistogram->GetNcells() : 0;
+   if(bin < 0 || bin >= ncells) {
+      low = ComputeEfficiencyErrorLow(bin);
+      up = ComputeEfficiencyErrorUp(bin);
+      return;
+   }
+   ROOT::Internal::TEfficiencyCache* cache = GetErrorCache();
+   ROOT::Internal::TEfficiencyCache::Entry_t key = ROOT::Internal::TEfficiencyCache::GetKey(*this, bin);
+   {
+      std::lock_guard<std::mutex> lock(cache->fMutex);
+      cache->Validate(ROOT::Internal::TEfficiencyCache::GetSettings(*this), ncells);
+      if(key == cache->fEntries[bin]) {
+         low = cache->fEntries[bin].fLow;
+         up = cache->fEntries[bin].fUp;
+         return;
+      }
+   }
+   key.fLow = low = ComputeEfficiencyErrorLow(bin);
+   key.fUp = up = ComputeEfficiencyErrorUp(bin);
+   // computing the errors may change the statistic option (weights with a
+   // frequentist method), validate the cache again
+   std::lock_guard<std::mutex> lock(cache->fMutex);
+   cache->Validate(ROOT::Internal::TEfficiencyCache::GetSettings(*this), ncells);
+   cache->fEntries[bin] = key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the cache of the errors, created on first use. Its entries must
+/// only be accessed with its mutex locked.
+
+ROOT::Internal::TEfficiencyCache* TEfficiency::GetErrorCache() const
+{
+   ROOT::Internal::TEfficiencyCache* cache = fErrorCache.load(std::memory_order_acquire);
+   if(cache)
+      return cache;
+   // concurrent first calls: only one cache is published
+   ROOT::Internal::TEfficiencyCache* created = new ROOT::Internal::TEfficiencyCache();
+   if(fErrorCache.compare_exchange_strong(cache, created, std::memory_order_acq_rel))
+      return created;
+   delete created;
+   return cache;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the global bin number which can be used as argument for the
 /// following functions:
@@ -1276,6 +1276,36 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of this function at n points and store them in result.
+/// The coordinates of the points are given by one array of n values for each
+/// dimension: x[0][i], x[1][i], ... for the point i.
+/// If argument params is omitted or equal 0, the internal values
+/// of parameters (array fParams) will be used instead.
+///
+/// The functions defined by a formula (fType=0) are evaluated on all the points
+/// at once by TFormula::EvalPar, the other ones one point at a time.
+
+void TF1::EvalPar(Int_t n, const Double_t * const *x, Double_t *result, const Double_t *params)
+{
+   if (n <= 0) return;
+   if (fType == 0) {
+      assert(fFormula);
+      fFormula->EvalPar(n, x, result, params);
+      if (fNormalized && fNormIntegral != 0) {
+         for (Int_t i = 0; i < n; ++i) result[i] /= fNormIntegral;
+      }
+      return;
+   }
+   Int_t ndim = GetNdim();
+   std::vector<Double_t> xx(std::max(ndim, 1));
+   if (fMethodCall) InitArgs(xx.data(), params);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < ndim; ++j) xx[j] = x[j][i];
+      result[i] = EvalPar(xx.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2266,6 +2296,25 @@ void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the analytic gradient with respect to the parameters
+///
+/// \param x  point, were the gradient is computed
+/// \param grad  used to return the computed gradient, assumed to be of at least fNpar size
+/// \param params  parameter values (the ones of the function if null)
+///
+/// The gradient is available for functions defined by a formula whose
+/// derivatives can be generated (see TFormula::HasGradientPar) and which are
+/// not normalized. Otherwise kFALSE is returned and the numerical gradient
+/// of GradientPar must be used.
+/// Unlike GradientPar, the derivatives with respect to fixed parameters are also computed.
+
+Bool_t TF1::AnalyticalGradientPar(const Double_t *x, Double_t *grad, const Double_t *params)
+{
+   if (fType != 0 || !fFormula || fNormalized) return kFALSE;
+   return fFormula->GradientPar(x, grad, params);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize parameters addresses.
 
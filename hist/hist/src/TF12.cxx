@@ -13,6 +13,9 @@
 #include "TH1.h"
 #include "TVirtualPad.h"
 
+#include <algorithm>
+#include <vector>
+
 ClassImp(TF12)
 
 /** \class TF12
@@ -163,6 +166,23 @@ Double_t TF12::EvalPar(const Double_t *x, const Double_t *params)
    return fF2->EvalPar(xx,params);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate this function at the n points x[0][i] with the evaluation of the mother
+/// TF2 on arrays of points.
+
+void TF12::EvalPar(Int_t n, const Double_t * const *x, Double_t *result, const Double_t *params)
+{
+   if (n <= 0) return;
+   if (!fF2) {
+      std::fill(result, result + n, 0.);
+      return;
+   }
+   std::vector<Double_t> xy(n, fXY);
+   const Double_t *xx[2] = {x[0], xy.data()};
+   if (fCase != 0) std::swap(xx[0], xx[1]);
+   fF2->EvalPar(n, xx, result, params);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitive as a C++ statement(s) on output stream out
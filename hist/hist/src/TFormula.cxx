@@ -22,10 +22,16 @@
 #include <TBenchmark.h>
 #include "TError.h"
 #include "TInterpreter.h"
+#include "TSystem.h"
 #include "TFormula.h"
+#include "TFormulaGradient.h"
 #include <cassert>
+#include <cctype>
+#include <cstring>
 #include <iostream>
 #include <unordered_map>
+#include <map>
+#include <fstream>
 #include <functional>
 
 using namespace std;
@@ -136,6 +142,64 @@ static const TString gNamePrefix = "TFormula__";
 // static map of function pointers and expressions
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
+// static map of the names and code of the functions declared in Cling, used to save them in a library
+static std::map<std::string, std::string> gClingFunctionInputs;
+// true when a library of compiled formula functions has been loaded
+static Bool_t gCompiledFormulasLoaded = false;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare a formula function in Cling. When the function is available in a loaded
+/// library of compiled formulas only its prototype is declared, to avoid compiling it again.
+
+static Bool_t DeclareFormulaFunction(const TString &name, const TString &input)
+{
+   Bool_t ok = kFALSE;
+   Ssiz_t body = input.First('{');
+   if (gCompiledFormulasLoaded && body != kNPOS && gSystem->DynFindSymbol("*", name))
+      ok = gCling->Declare(TString::Format("extern \"C\" %s;", TString(input(0, body)).Data()));
+   if (!ok)
+      ok = gCling->Declare(input);
+   if (ok)
+      gClingFunctionInputs[name.Data()] = input.Data();
+   return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the first function called by the formula function `input`, named `name`,
+/// which is not declared in the headers included by TFormula::SaveCompiledFormulas
+/// (typically a function only known to the interpreter), or an empty string if there is none.
+
+static std::string FindInterpreterOnlyCall(const std::string &name, const std::string &input)
+{
+   static const char *keywords[] = {"for", "if", "while", "return", "sizeof", "void",
+                                    "bool", "int", "double", "Bool_t", "Int_t", "Double_t"};
+   static const char *namespaces[] = {"TMath::", "ROOT::Math::", "std::"};
+   size_t i = 0;
+   while (i < input.size()) {
+      unsigned char c = input[i];
+      if (isdigit(c) || c == '.') {
+         // a number, including its exponent
+         while (i < input.size() && (isalnum((unsigned char)input[i]) || input[i] == '.')) ++i;
+         continue;
+      }
+      if (!isalpha(c) && c != '_') {
+         ++i;
+         continue;
+      }
+      size_t begin = i;
+      while (i < input.size() && (isalnum((unsigned char)input[i]) || input[i] == '_' || input[i] == ':')) ++i;
+      std::string id = input.substr(begin, i - begin);
+      size_t next = input.find_first_not_of(' ', i);
+      if (next == std::string::npos || input[next] != '(' || id == name) continue;
+      Bool_t known = kFALSE;
+      for (const char *keyword : keywords)
+         known |= (id == keyword);
+      for (const char *ns : namespaces)
+         known |= (id.compare(0, strlen(ns), ns) == 0);
+      if (!known) return id;
+   }
+   return "";
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 Bool_t TFormula::IsOperator(const char c)
@@ -277,6 +341,10 @@ TFormula::TFormula()
    fClingName = "";
    fFormula = "";
    fLambdaPtr = nullptr;
+   fFuncPtr = nullptr;
+   fBatchFuncPtr = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradFailed = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -322,6 +390,10 @@ TFormula::TFormula(const char *name, const char *formula, bool addToGlobList)
    fNumber = 0;
    fMethod = 0;
    fLambdaPtr = nullptr;
+   fFuncPtr = nullptr;
+   fBatchFuncPtr = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradFailed = false;
 
    FillDefaults();
 
@@ -364,6 +436,9 @@ TFormula::TFormula(const char *name, const char *formula, int ndim, int npar, bo
    fNumber = 0;
    fLambdaPtr = nullptr;
    fFuncPtr = nullptr;
+   fBatchFuncPtr = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradFailed = false;
 
 
    fNdim = ndim;
@@ -411,6 +486,9 @@ TFormula::TFormula(const TFormula &formula) :
    fFormula = formula.GetExpFormula();   // returns fFormula in case of Lambda's
    fLambdaPtr = nullptr;
    fFuncPtr = nullptr;
+   fBatchFuncPtr = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradFailed = false;
 
    // case of function based on a C++  expression (lambda's) which is ready to be compiled
    if (formula.fLambdaPtr && formula.TestBit(TFormula::kLambda)) {
@@ -611,6 +689,9 @@ void TFormula::Copy(TObject &obj) const
    }
 
    fnew.fFuncPtr = fFuncPtr;
+   fnew.fBatchFuncPtr = fBatchFuncPtr.load();
+   fnew.fGradFuncPtr = fGradFuncPtr.load();
+   fnew.fGradFailed = fGradFailed.load();
 
 }
 
@@ -625,6 +706,9 @@ void TFormula::Clear(Option_t * )
    fNumber = 0;
    fFormula = "";
    fClingName = "";
+   fBatchFuncPtr = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradFailed = false;
 
 
    if(fMethod) fMethod->Delete();
@@ -707,6 +791,131 @@ bool TFormula::PrepareEvalMethod()
    return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the expression of the function passed to Cling, with the variables in x[]
+/// and the parameters in p[], or an empty string if it is not found.
+
+static TString GetClingExpression(const TString &clingInput)
+{
+   std::string clingFunc = clingInput.Data();
+   std::size_t found = clingFunc.find("return");
+   std::size_t found2 = clingFunc.rfind(";");
+   if (found == std::string::npos || found2 == std::string::npos || found2 < found + 7) return "";
+   return clingInput(found+7,found2-found-7);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare to Cling the function evaluating the formula on arrays of points,
+///
+///     void clingName_batchN(Int_t n, Double_t **x, Double_t *p, Double_t *result)
+///
+/// with the coordinates of the points given by one array for each of the N variables,
+/// and set the function pointer used by EvalPar(n, x, result, params).
+/// It is done when the formula is first evaluated on arrays, since most formulas are not.
+/// The functions are shared between the formulas with the same expression.
+
+Bool_t TFormula::PrepareBatchMethod() const
+{
+   // the pointer is only published, with release semantics, once the function is compiled
+   if (fBatchFuncPtr.load(std::memory_order_acquire)) return true;
+   if (!fReadyToExecute || !fClingInitialized || TestBit(TFormula::kLambda) || fClingName.IsNull())
+      return false;
+
+   R__LOCKGUARD2(gROOTMutex);
+   if (fBatchFuncPtr.load(std::memory_order_acquire)) return true;
+
+   TString expression = GetClingExpression(fClingInput);
+   if (expression.IsNull()) return false;
+
+   TString batchName = TString::Format("%s_batch%d", fClingName.Data(), fNdim);
+   TString batchInput = TString::Format("void %s(Int_t n_, Double_t **x_, Double_t *p, Double_t *result_) {"
+                                        " Double_t x[%d]; for (Int_t i_ = 0; i_ < n_; ++i_) {"
+                                        " for (Int_t j_ = 0; j_ < %d; ++j_) x[j_] = x_[j_][i_];"
+                                        " result_[i_] = %s; } (void)p; }",
+                                        batchName.Data(), std::max(fNdim, 1), fNdim, expression.Data());
+
+   std::string batchKey = batchInput.Data();
+   auto funcit = gClingFunctions.find(batchKey);
+   if (funcit != gClingFunctions.end()) {
+      fBatchFuncPtr.store((TInterpreter::CallFuncIFacePtr_t::Generic_t) funcit->second, std::memory_order_release);
+      return true;
+   }
+
+   if (!DeclareFormulaFunction(batchName, batchInput)) return false;
+   TMethodCall method;
+   method.InitWithPrototype(batchName, "Int_t,Double_t**,Double_t*,Double_t*");
+   if (!method.IsValid()) {
+      Error("EvalPar","Can't find %s function for the evaluation on arrays of points",batchName.Data());
+      return false;
+   }
+   auto batchFuncPtr = gCling->CallFunc_IFacePtr(method.GetCallFunc()).fGeneric;
+   gClingFunctions.insert(std::make_pair(batchKey, (void*) batchFuncPtr));
+   fBatchFuncPtr.store(batchFuncPtr, std::memory_order_release);
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare to Cling the function computing the derivatives of the formula with
+/// respect to its parameters,
+///
+///     void clingName_gradN(Double_t *x, Double_t *p, Double_t *grad)
+///
+/// for the N parameters, and set the function pointer used by GradientPar.
+/// The code of the derivatives is generated from the expression of the formula,
+/// which must be made of arithmetic operators and of functions of the parameters
+/// with a known derivative (the mathematical functions of TMath, like TMath::Exp, TMath::Power
+/// or TMath::Gaus). Functions depending only on the variables can be any.
+/// It is done when the gradient is first needed, and the generation is not tried again
+/// when it fails.
+
+Bool_t TFormula::PrepareGradientMethod() const
+{
+   // The pointer is published after the function is compiled and the failure
+   // flag only after the generation failed, so that the threads asking for the
+   // gradient while it is generated wait on the lock below for the result.
+   if (fGradFuncPtr.load(std::memory_order_acquire)) return true;
+   if (fGradFailed.load(std::memory_order_acquire) || !fReadyToExecute || !fClingInitialized ||
+       TestBit(TFormula::kLambda) || fClingName.IsNull() || fNpar == 0)
+      return false;
+
+   R__LOCKGUARD2(gROOTMutex);
+   if (fGradFuncPtr.load(std::memory_order_acquire)) return true;
+   if (fGradFailed.load(std::memory_order_acquire)) return false;
+
+   // failures are remembered until the formula changes
+   auto fail = [this]() {
+      fGradFailed.store(true, std::memory_order_release);
+      return false;
+   };
+   TString expression = GetClingExpression(fClingInput);
+   std::string gradCode;
+   if (expression.IsNull() || !ROOT::TFormulaGradient::GenerateGradientCode(expression.Data(), fNpar, gradCode))
+      return fail();
+
+   TString gradName = TString::Format("%s_grad%d", fClingName.Data(), fNpar);
+   TString gradInput = TString::Format("void %s(Double_t *x, Double_t *p, Double_t *grad_) { %s(void)x; (void)p; }",
+                                       gradName.Data(), gradCode.c_str());
+
+   std::string gradKey = gradInput.Data();
+   auto funcit = gClingFunctions.find(gradKey);
+   if (funcit != gClingFunctions.end()) {
+      fGradFuncPtr.store((TInterpreter::CallFuncIFacePtr_t::Generic_t) funcit->second, std::memory_order_release);
+      return true;
+   }
+
+   if (!DeclareFormulaFunction(gradName, gradInput)) return fail();
+   TMethodCall method;
+   method.InitWithPrototype(gradName, "Double_t*,Double_t*,Double_t*");
+   if (!method.IsValid()) {
+      Error("GradientPar","Can't find %s function for the parameter gradient",gradName.Data());
+      return fail();
+   }
+   auto gradFuncPtr = gCling->CallFunc_IFacePtr(method.GetCallFunc()).fGeneric;
+   gClingFunctions.insert(std::make_pair(gradKey, (void*) gradFuncPtr));
+   fGradFuncPtr.store(gradFuncPtr, std::memory_order_release);
+   return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///    Inputs formula, transfered to C++ code into Cling
 
@@ -715,11 +924,84 @@ void TFormula::InputFormulaIntoCling()
 
    if(!fClingInitialized && fReadyToExecute && fClingInput.Length() > 0)
    {
-      gCling->Declare(fClingInput);
+      DeclareFormulaFunction(fClingName, fClingInput);
       fClingInitialized = PrepareEvalMethod();
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Save the functions of all the formulas compiled so far in the C++ source file
+/// `filename` and compile it in a shared library with ACLiC.
+///
+/// A later process can load the library with TFormula::LoadCompiledFormulas,
+/// and the formulas found in it are then not compiled again by Cling.
+/// The functions are cached by their expression, so that the library can be used for
+/// any formula with the same expression, independently of its name.
+/// The functions of the formulas calling functions which are only known to the interpreter
+/// (i.e. not in the TMath or ROOT::Math namespaces of MathCore or in the standard library)
+/// can not be compiled: they are skipped with a warning.
+/// Return kFALSE if the file can not be written or compiled.
+
+Bool_t TFormula::SaveCompiledFormulas(const char *filename)
+{
+   R__LOCKGUARD2(gROOTMutex);
+   std::string functions;
+   for (const auto &input : gClingFunctionInputs) {
+      std::string call = FindInterpreterOnlyCall(input.first, input.second);
+      if (!call.empty()) {
+         ::Warning("TFormula::SaveCompiledFormulas", "%s calls %s, which is only known to the interpreter: it is not saved",
+                   input.first.c_str(), call.c_str());
+         continue;
+      }
+      functions += input.second + "\n";
+   }
+   if (functions.empty()) {
+      ::Error("TFormula::SaveCompiledFormulas", "There are no compiled formulas to save");
+      return kFALSE;
+   }
+
+   std::ofstream out(filename);
+   if (!out) {
+      ::Error("TFormula::SaveCompiledFormulas", "Can't open file %s", filename);
+      return kFALSE;
+   }
+   // the definitions are hidden to the dictionary, since the functions are declared
+   // to Cling by the formulas using them
+   out << "// Formula functions saved by TFormula::SaveCompiledFormulas\n"
+       << "#ifndef __CLING__\n"
+       << "#include \"TMath.h\"\n"
+       << "#include \"Math/ChebyshevPol.h\"\n"
+       << "#include \"Math/PdfFuncMathCore.h\"\n"
+       << "#include \"Math/ProbFuncMathCore.h\"\n"
+       << "#include \"Math/QuantFuncMathCore.h\"\n"
+       << "#include \"Math/SpecFuncMathCore.h\"\n\n"
+       << "extern \"C\" {\n"
+       << functions
+       << "}\n#endif\n";
+   out.close();
+
+   return gSystem->CompileMacro(filename, "kf") == 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the formula functions saved with TFormula::SaveCompiledFormulas.
+///
+/// `filename` is the name of the source file given to TFormula::SaveCompiledFormulas,
+/// whose library is compiled again only when it is older than the source file.
+/// The formulas created afterwards use the compiled functions of the library
+/// instead of compiling their expression with Cling.
+
+Bool_t TFormula::LoadCompiledFormulas(const char *filename)
+{
+   R__LOCKGUARD2(gROOTMutex);
+   if (gSystem->CompileMacro(filename, "k") != 1) {
+      ::Error("TFormula::LoadCompiledFormulas", "Can't load the compiled formulas of %s", filename);
+      return kFALSE;
+   }
+   gCompiledFormulasLoaded = kTRUE;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///    Fill structures with default variables, constants and function shortcuts
 
@@ -1881,6 +2163,10 @@ void TFormula::ProcessFormula(TString &formula)
 
          // set the name for Cling using the hash_function
          fClingName = gNamePrefix;
+         // the functions for arrays of points and for the gradient are declared again when first used
+         fBatchFuncPtr = nullptr;
+         fGradFuncPtr = nullptr;
+         fGradFailed = false;
 
          // check if formula exist already in the map
          R__LOCKGUARD2(gROOTMutex);
@@ -2609,6 +2895,65 @@ Double_t TFormula::EvalPar(const Double_t *x,const Double_t *params) const
    return DoEval(x, params);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula at n points, whose coordinates are given by one array of n values
+/// for each variable (x[0][i], x[1][i], ... for the point i), and store the values in result.
+/// If params is null the parameter values of the formula are used.
+///
+/// The formula is evaluated by a loop over the points compiled by Cling together with the
+/// expression, without the call of a function for each point as in EvalPar(x, params).
+/// Formulas built with a lambda expression are evaluated one point at a time.
+
+void TFormula::EvalPar(Int_t n, const Double_t * const *x, Double_t *result, const Double_t *params) const
+{
+   if (n <= 0) return;
+   if (PrepareBatchMethod()) {
+      Int_t npoints = n;
+      double ** vars = const_cast<double**>(x);
+      double * pars = (params) ? const_cast<double*>(params) : const_cast<double*>(fClingParameters.data());
+      void* args[4] = {&npoints, &vars, &pars, &result};
+      (*fBatchFuncPtr.load(std::memory_order_acquire))(0, 4, args, nullptr);
+      return;
+   }
+   std::vector<Double_t> xx(std::max(fNdim, 1));
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < fNdim; ++j) xx[j] = x[j][i];
+      result[i] = DoEval(xx.data(), params);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the derivatives of the formula with respect to its parameters at the point x,
+/// in the array grad of size GetNpar(), using the parameter values params (or the
+/// values of the formula if params is null).
+///
+/// The derivatives are computed analytically, with code generated from the expression of the
+/// formula and compiled by Cling the first time they are needed (see HasGradientPar).
+/// Return kFALSE, without modifying grad, if the gradient can not be generated.
+
+Bool_t TFormula::GradientPar(const Double_t *x, Double_t *grad, const Double_t *params) const
+{
+   if (!PrepareGradientMethod()) return kFALSE;
+   double * vars = const_cast<double*>(x);
+   double * pars = (params) ? const_cast<double*>(params) : const_cast<double*>(fClingParameters.data());
+   void* args[3] = {&vars, &pars, &grad};
+   (*fGradFuncPtr.load(std::memory_order_acquire))(0, 3, args, nullptr);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the analytic derivatives with respect to the parameters can be
+/// computed by GradientPar.
+///
+/// This is the case for formulas whose parameters appear only in arithmetic
+/// operations and in the mathematical functions of TMath (as for the predefined
+/// functions gaus, expo and polN), but not in lambda expressions or other functions.
+
+Bool_t TFormula::HasGradientPar() const
+{
+   return PrepareGradientMethod();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets first 4  variables (e.g. x, y, z, t) and evaluate formula.
 
@@ -0,0 +1,444 @@
+// @(#)root/hist:$Id$
+// Author: L. Moneta 2017
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017  ROOT  Team, CERN/PH-SFT                        *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Generation of the code of the derivatives of a TFormula expression with respect to its
+// parameters. The expression is parsed and, in forward mode, each sub-expression depending on the
+// parameters is assigned to a temporary together with its derivatives, so that every function of
+// the expression is evaluated only once.
+
+#include "TFormulaGradient.h"
+
+#include <cctype>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// A sub-expression: its value (a temporary or an expression which can be used as an operand)
+/// and its derivatives with respect to the parameters it depends on.
+struct Term {
+   std::string fValue;
+   std::map<int, std::string> fDeriv;
+
+   bool IsConstant() const { return fDeriv.empty(); }
+};
+
+class GradientGenerator {
+public:
+   GradientGenerator(const std::string &expression, int npar) : fExpr(expression), fNpar(npar) {}
+
+   bool Generate(std::string &code);
+
+private:
+   Term ParseConditional();
+   Term ParseBinary(int level);
+   Term ParseUnary();
+   Term ParsePrimary();
+   Term Call(const std::string &name, const std::vector<Term> &args);
+   Term Chain(const std::string &value, const std::vector<Term> &args, const std::vector<std::string> &partials);
+
+   void SkipSpaces();
+   bool Accept(const char *token);
+   bool Fail() { fError = true; return false; }
+   std::string Temp(const std::string &expression, const char *prefix = "t");
+   static std::string Mul(const std::string &a, const std::string &b);
+
+   const std::string fExpr;
+   const int fNpar;
+   std::size_t fPos = 0;
+   bool fError = false;
+   std::vector<std::pair<std::string, std::string>> fStatements; // temporaries and their expressions
+};
+
+// binary operators, by increasing precedence
+const std::vector<std::vector<std::string>> gOperators = {
+   {"||"}, {"&&"}, {"==", "!="}, {"<=", ">=", "<", ">"}, {"+", "-"}, {"*", "/"}};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void GradientGenerator::SkipSpaces()
+{
+   while (fPos < fExpr.size() && std::isspace(fExpr[fPos])) ++fPos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Consume the given token if it is next in the expression.
+
+bool GradientGenerator::Accept(const char *token)
+{
+   SkipSpaces();
+   std::string t(token);
+   if (fExpr.compare(fPos, t.size(), t) != 0) return false;
+   // do not take the first character of a two character operator
+   if (t.size() == 1 && fPos + 1 < fExpr.size()) {
+      char next = fExpr[fPos + 1];
+      if ((t == "<" || t == ">" || t == "!") && next == '=') return false;
+      if ((t == "&" || t == "|") && next == t[0]) return false;
+   }
+   fPos += t.size();
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Assign an expression to a new temporary and return its name.
+
+std::string GradientGenerator::Temp(const std::string &expression, const char *prefix)
+{
+   std::string name = prefix + std::to_string(fStatements.size()) + "_";
+   fStatements.emplace_back(name, expression);
+   return name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string GradientGenerator::Mul(const std::string &a, const std::string &b)
+{
+   if (a == "1.") return b;
+   if (b == "1.") return a;
+   return a + "*" + b;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// conditional := binary [ '?' conditional ':' conditional ]
+
+Term GradientGenerator::ParseConditional()
+{
+   Term cond = ParseBinary(0);
+   if (fError || !Accept("?")) return cond;
+   Term a = ParseConditional();
+   if (!Accept(":")) Fail();
+   Term b = ParseConditional();
+   if (fError) return Term();
+
+   Term result;
+   std::string value = "(" + cond.fValue + " ? " + a.fValue + " : " + b.fValue + ")";
+   if (a.IsConstant() && b.IsConstant()) {
+      result.fValue = value;
+      return result;
+   }
+   result.fValue = Temp(value);
+   std::set<int> pars;
+   for (auto &d : a.fDeriv) pars.insert(d.first);
+   for (auto &d : b.fDeriv) pars.insert(d.first);
+   for (int j : pars) {
+      std::string da = a.fDeriv.count(j) ? a.fDeriv[j] : "0.";
+      std::string db = b.fDeriv.count(j) ? b.fDeriv[j] : "0.";
+      result.fDeriv[j] = Temp("(" + cond.fValue + " ? " + da + " : " + db + ")", "d");
+   }
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Binary operators of precedence `level` and higher, left associative.
+
+Term GradientGenerator::ParseBinary(int level)
+{
+   if (level == (int)gOperators.size()) return ParseUnary();
+   Term a = ParseBinary(level + 1);
+   while (!fError) {
+      std::string op;
+      for (auto &o : gOperators[level])
+         if (Accept(o.c_str())) { op = o; break; }
+      if (op.empty()) break;
+      Term b = ParseBinary(level + 1);
+      if (fError) break;
+
+      Term result;
+      std::string value = a.fValue + op + b.fValue;
+      // comparisons and logical operators are piecewise constant
+      if ((a.IsConstant() && b.IsConstant()) || level < 4) {
+         result.fValue = "(" + value + ")";
+         a = result;
+         continue;
+      }
+      result.fValue = Temp(value);
+      std::set<int> pars;
+      for (auto &d : a.fDeriv) pars.insert(d.first);
+      for (auto &d : b.fDeriv) pars.insert(d.first);
+      for (int j : pars) {
+         bool hasA = a.fDeriv.count(j), hasB = b.fDeriv.count(j);
+         std::string da = hasA ? a.fDeriv[j] : "";
+         std::string db = hasB ? b.fDeriv[j] : "";
+         if (op == "+" || op == "-") {
+            if (hasA && hasB) result.fDeriv[j] = Temp(da + op + db, "d");
+            else if (hasA) result.fDeriv[j] = da;
+            else result.fDeriv[j] = (op == "+") ? db : Temp("-" + db, "d");
+         } else if (op == "*") {
+            if (hasA && hasB) result.fDeriv[j] = Temp(Mul(da, b.fValue) + "+" + Mul(a.fValue, db), "d");
+            else if (hasA) result.fDeriv[j] = Temp(Mul(da, b.fValue), "d");
+            else result.fDeriv[j] = Temp(Mul(a.fValue, db), "d");
+         } else {
+            // d(a/b) = (da - a/b*db)/b
+            if (hasA && hasB) result.fDeriv[j] = Temp("(" + da + "-" + Mul(result.fValue, db) + ")/" + b.fValue, "d");
+            else if (hasA) result.fDeriv[j] = Temp(da + "/" + b.fValue, "d");
+            else result.fDeriv[j] = Temp("-" + Mul(result.fValue, db) + "/" + b.fValue, "d");
+         }
+      }
+      a = result;
+   }
+   return a;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// unary := ( '-' | '+' | '!' ) unary | primary
+
+Term GradientGenerator::ParseUnary()
+{
+   if (Accept("+")) return ParseUnary();
+   if (Accept("!")) {
+      Term a = ParseUnary();
+      Term result;
+      result.fValue = "(!" + a.fValue + ")";
+      return result;
+   }
+   if (Accept("-")) {
+      Term a = ParseUnary();
+      Term result;
+      if (a.IsConstant()) {
+         result.fValue = "(-" + a.fValue + ")";
+         return result;
+      }
+      result.fValue = Temp("-" + a.fValue);
+      for (auto &d : a.fDeriv)
+         result.fDeriv[d.first] = Temp("-" + d.second, "d");
+      return result;
+   }
+   return ParsePrimary();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// primary := number | x[i] | p[i] | name | name '(' arguments ')' | '(' conditional ')'
+
+Term GradientGenerator::ParsePrimary()
+{
+   Term result;
+   SkipSpaces();
+   if (fPos >= fExpr.size()) {
+      Fail();
+      return result;
+   }
+
+   if (Accept("(")) {
+      result = ParseConditional();
+      if (!Accept(")")) Fail();
+      return result;
+   }
+
+   std::size_t begin = fPos;
+   char c = fExpr[fPos];
+   if (std::isdigit(c) || c == '.') {
+      while (fPos < fExpr.size() && (std::isalnum(fExpr[fPos]) || fExpr[fPos] == '.')) {
+         char e = fExpr[fPos++];
+         // sign of the exponent
+         if ((e == 'e' || e == 'E') && fPos < fExpr.size() && (fExpr[fPos] == '-' || fExpr[fPos] == '+')) ++fPos;
+      }
+      result.fValue = fExpr.substr(begin, fPos - begin);
+      return result;
+   }
+
+   if (!std::isalpha(c) && c != '_' && c != ':') {
+      Fail();
+      return result;
+   }
+   // name, possibly with namespaces
+   while (fPos < fExpr.size()) {
+      if (std::isalnum(fExpr[fPos]) || fExpr[fPos] == '_') ++fPos;
+      else if (fExpr.compare(fPos, 2, "::") == 0) fPos += 2;
+      else break;
+   }
+   std::string name = fExpr.substr(begin, fPos - begin);
+   if (name.empty()) {
+      Fail();
+      return result;
+   }
+
+   if (Accept("(")) {
+      std::vector<Term> args;
+      if (!Accept(")")) {
+         do {
+            args.push_back(ParseConditional());
+         } while (!fError && Accept(","));
+         if (!Accept(")")) Fail();
+      }
+      if (fError) return result;
+      return Call(name, args);
+   }
+
+   if (Accept("[")) {
+      SkipSpaces();
+      std::size_t ibegin = fPos;
+      while (fPos < fExpr.size() && std::isdigit(fExpr[fPos])) ++fPos;
+      std::string index = fExpr.substr(ibegin, fPos - ibegin);
+      if (index.empty() || !Accept("]") || (name != "x" && name != "p")) {
+         Fail();
+         return result;
+      }
+      result.fValue = name + "[" + index + "]";
+      int ipar = std::stoi(index);
+      if (name == "p" && ipar < fNpar) result.fDeriv[ipar] = "1.";
+      return result;
+   }
+
+   // a constant
+   result.fValue = name;
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Derivatives of a function from its partial derivatives with respect to its arguments.
+
+Term GradientGenerator::Chain(const std::string &value, const std::vector<Term> &args,
+                              const std::vector<std::string> &partials)
+{
+   Term result;
+   result.fValue = value;
+   std::map<int, std::string> sums;
+   for (std::size_t k = 0; k < args.size(); ++k) {
+      if (args[k].IsConstant()) continue;
+      std::string partial = (partials[k] == value) ? value : Temp(partials[k]);
+      for (auto &d : args[k].fDeriv) {
+         std::string &sum = sums[d.first];
+         if (!sum.empty()) sum += "+";
+         sum += Mul(partial, d.second);
+      }
+   }
+   for (auto &s : sums)
+      result.fDeriv[s.first] = Temp(s.second, "d");
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// A function call. The derivatives are known for the mathematical functions of TMath and of
+/// the standard library, and any function can be used with arguments not depending on the parameters.
+
+Term GradientGenerator::Call(const std::string &name, const std::vector<Term> &args)
+{
+   Term result;
+   std::string value = name + "(";
+   bool constant = true;
+   for (std::size_t k = 0; k < args.size(); ++k) {
+      value += (k > 0 ? "," : "") + args[k].fValue;
+      constant &= args[k].IsConstant();
+   }
+   value += ")";
+   if (constant) {
+      result.fValue = value;
+      return result;
+   }
+
+   std::string f = name;
+   for (const char *prefix : {"::", "TMath::", "std::"})
+      if (f.compare(0, std::string(prefix).size(), prefix) == 0) f = f.substr(std::string(prefix).size());
+   for (auto &ch : f) ch = std::tolower(ch);
+
+   const std::size_t nargs = args.size();
+   const std::string a = args[0].fValue;
+   const std::string b = (nargs > 1) ? args[1].fValue : "";
+   std::string v = Temp(value);
+   std::vector<std::string> partials;
+
+   if (nargs == 1) {
+      if (f == "exp") partials = {v};
+      else if (f == "log") partials = {"1./" + a};
+      else if (f == "log10") partials = {"1./(" + a + "*TMath::Ln10())"};
+      else if (f == "sin") partials = {"TMath::Cos(" + a + ")"};
+      else if (f == "cos") partials = {"-TMath::Sin(" + a + ")"};
+      else if (f == "tan") partials = {"1.+" + v + "*" + v};
+      else if (f == "sinh") partials = {"TMath::CosH(" + a + ")"};
+      else if (f == "cosh") partials = {"TMath::SinH(" + a + ")"};
+      else if (f == "tanh") partials = {"1.-" + v + "*" + v};
+      else if (f == "asin") partials = {"1./TMath::Sqrt(1.-" + a + "*" + a + ")"};
+      else if (f == "acos") partials = {"-1./TMath::Sqrt(1.-" + a + "*" + a + ")"};
+      else if (f == "atan") partials = {"1./(1.+" + a + "*" + a + ")"};
+      else if (f == "sqrt") partials = {"0.5/" + v};
+      else if (f == "sq") partials = {"2.*" + a};
+      else if (f == "abs" || f == "fabs") partials = {"TMath::Sign(1.," + a + ")"};
+      else if (f == "erf") partials = {"2./TMath::Sqrt(TMath::Pi())*TMath::Exp(-" + a + "*" + a + ")"};
+      else if (f == "erfc") partials = {"-2./TMath::Sqrt(TMath::Pi())*TMath::Exp(-" + a + "*" + a + ")"};
+   } else if (nargs == 2) {
+      if (f == "power" || f == "pow") {
+         std::string da = (b == "2") ? "2.*" + a : b + "*TMath::Power(" + a + "," + b + "-1.)";
+         partials = {da, v + "*TMath::Log(" + a + ")"};
+      } else if (f == "atan2") {
+         std::string r2 = "(" + a + "*" + a + "+" + b + "*" + b + ")";
+         partials = {b + "/" + r2, "-" + a + "/" + r2};
+      } else if (f == "min") {
+         partials = {"(" + a + "<=" + b + " ? 1. : 0.)", "(" + a + "<=" + b + " ? 0. : 1.)"};
+      } else if (f == "max") {
+         partials = {"(" + a + ">=" + b + " ? 1. : 0.)", "(" + a + ">=" + b + " ? 0. : 1.)"};
+      }
+   }
+   if (f == "gaus" && nargs <= 4 && (nargs < 4 || args[3].IsConstant())) {
+      // TMath::Gaus(x, mean = 0, sigma = 1, norm = false)
+      std::string mean = (nargs > 1) ? b : "0.";
+      std::string sigma = (nargs > 2) ? args[2].fValue : "1.";
+      std::string norm = (nargs > 3) ? "(" + args[3].fValue + " ? 1. : 0.)" : "0.";
+      std::string u = Temp("(" + a + "-" + mean + ")/" + sigma);
+      partials = {"-" + v + "*" + u + "/" + sigma, v + "*" + u + "/" + sigma,
+                  v + "*(" + u + "*" + u + "-" + norm + ")/" + sigma, "0."};
+      partials.resize(nargs);
+   }
+
+   if (partials.size() != nargs) {
+      Fail();
+      return result;
+   }
+   return Chain(v, args, partials);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool GradientGenerator::Generate(std::string &code)
+{
+   Term result = ParseConditional();
+   SkipSpaces();
+   if (fError || fPos != fExpr.size()) return false;
+
+   std::vector<std::string> assignments;
+   for (int j = 0; j < fNpar; ++j) {
+      auto d = result.fDeriv.find(j);
+      assignments.push_back("grad_[" + std::to_string(j) + "] = " + (d != result.fDeriv.end() ? d->second : "0.") + ";");
+   }
+
+   // keep only the temporaries needed by the derivatives, looking at the statements backward
+   std::set<std::string> needed;
+   auto addNames = [&needed](const std::string &s) {
+      for (std::size_t i = 0; i < s.size(); ++i) {
+         if ((s[i] != 't' && s[i] != 'd') || (i > 0 && (std::isalnum(s[i - 1]) || s[i - 1] == '_'))) continue;
+         std::size_t j = i + 1;
+         while (j < s.size() && std::isdigit(s[j])) ++j;
+         if (j > i + 1 && j < s.size() && s[j] == '_') needed.insert(s.substr(i, j + 1 - i));
+      }
+   };
+   for (auto &s : assignments) addNames(s);
+   std::vector<std::string> statements;
+   for (auto it = fStatements.rbegin(); it != fStatements.rend(); ++it) {
+      if (!needed.count(it->first)) continue;
+      addNames(it->second);
+      statements.push_back("const Double_t " + it->first + " = " + it->second + ";");
+   }
+
+   code.clear();
+   for (auto it = statements.rbegin(); it != statements.rend(); ++it) code += *it + " ";
+   for (auto &s : assignments) code += s + " ";
+   return true;
+}
+
+} // end anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ROOT::TFormulaGradient::GenerateGradientCode(const std::string &expression, int npar, std::string &code)
+{
+   GradientGenerator generator(expression, npar);
+   return generator.Generate(code);
+}
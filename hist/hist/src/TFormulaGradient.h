@@ -0,0 +1,33 @@
+// @(#)root/hist:$Id$
+// Author: L. Moneta 2017
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017  ROOT  Team, CERN/PH-SFT                        *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// helper functions used internally by TFormula
+
+#ifndef ROOT_TFormulaGradient
+#define ROOT_TFormulaGradient
+
+#include <string>
+
+namespace ROOT {
+
+   namespace TFormulaGradient {
+
+      /// Generate the statements computing the derivatives of the C++ expression of a formula
+      /// (written with the variables x[] and the parameters p[]) with respect to the parameters
+      /// p[0],...,p[npar-1], stored in the array grad_.
+      /// Return false if the expression can not be parsed or contains a function of the
+      /// parameters whose derivative is not known.
+      bool GenerateGradientCode(const std::string &expression, int npar, std::string &code);
+
+   } // end namespace TFormulaGradient
+
+} // end namespace ROOT
+
+#endif
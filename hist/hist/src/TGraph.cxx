@@ -35,6 +35,9 @@
 #include <stdlib.h>
 #include <string>
 #include <cassert>
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -952,6 +955,101 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    return yn;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Interpolate the graph at the n points x, storing the values in y: y[i] is
+/// equal to Eval(x[i], spline, option).
+///
+/// The points x can be in any order. Consecutive points that lie in the same
+/// or in the next interval between the graph points, as for increasing x, are
+/// interpolated without searching again. If the graph is not sorted
+/// (kIsSortedX not set), a sorted copy of its points is made once for the
+/// whole batch instead of looping over all points for each x. With option
+/// "s" and no spline given, the spline is built once for the whole batch.
+/// A TSpline3 is evaluated with TSpline3::Eval(n, x, y).
+
+void TGraph::Eval(Int_t n, const Double_t *x, Double_t *y, TSpline *spline, Option_t *option) const
+{
+   if (!spline && fNpoints > 1 && option && *option) {
+      TString opt = option;
+      opt.ToLower();
+      if (opt.Contains("s")) {
+         // points must be sorted before using a TSpline, as in Eval(x)
+         std::vector<Double_t> xsort(fNpoints);
+         std::vector<Double_t> ysort(fNpoints);
+         std::vector<Int_t> indxsort(fNpoints);
+         TMath::Sort(fNpoints, fX, &indxsort[0], false);
+         for (Int_t i = 0; i < fNpoints; ++i) {
+            xsort[i] = fX[ indxsort[i] ];
+            ysort[i] = fY[ indxsort[i] ];
+         }
+         TSpline3 s("", &xsort[0], &ysort[0], fNpoints);
+         s.Eval(n, x, y);
+         return;
+      }
+   }
+   if (spline) {
+      if (TSpline3 *s3 = dynamic_cast<TSpline3 *>(spline))
+         s3->Eval(n, x, y);
+      else
+         for (Int_t i = 0; i < n; ++i) y[i] = spline->Eval(x[i]);
+      return;
+   }
+
+   // Linear interpolation between the points gx, gy, sorted in x. For an
+   // unsorted graph, they are a sorted copy of the points keeping, among the
+   // points with the same abscissa, the first one: the one Eval(x) picks.
+   const Bool_t sorted = TestBit(TGraph::kIsSortedX);
+   const Double_t *gx = fX;
+   const Double_t *gy = fY;
+   Int_t np = fNpoints;
+   std::vector<Double_t> xsort, ysort;
+   if (!sorted && fNpoints > 1) {
+      std::vector<Int_t> indxsort(fNpoints);
+      std::iota(indxsort.begin(), indxsort.end(), 0);
+      std::stable_sort(indxsort.begin(), indxsort.end(), [this](Int_t a, Int_t b) { return fX[a] < fX[b]; });
+      for (Int_t i : indxsort) {
+         if (xsort.empty() || fX[i] != xsort.back()) {
+            xsort.push_back(fX[i]);
+            ysort.push_back(fY[i]);
+         }
+      }
+      gx = xsort.data();
+      gy = ysort.data();
+      np = xsort.size();
+   }
+   if (np < 2) {
+      for (Int_t i = 0; i < n; ++i) y[i] = Eval(x[i]);
+      return;
+   }
+
+   // low is the point below x[i], as in Eval(x), and it is kept for the next x
+   Int_t low = 0;
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t xi = x[i];
+      if (!(gx[low] < xi && xi < gx[low+1])) {
+         if (low + 2 < np && gx[low+1] < xi && xi < gx[low+2]) {
+            ++low;
+         } else if (sorted) {
+            Int_t k = TMath::BinarySearch(np, gx, xi);
+            if (k == -1) k = 0; // use first two points for doing an extrapolation
+            low = (k == np-1) ? k-1 : k; // for extrapolating
+            if (gx[k] == xi) { y[i] = gy[k]; continue; }
+            if (gx[low] == gx[low+1]) { y[i] = gy[low]; continue; }
+         } else if (!(gx[0] < xi && xi < gx[np-1])) {
+            // extrapolation from the unsorted points
+            low = 0;
+            y[i] = Eval(xi);
+            continue;
+         } else {
+            low = TMath::BinarySearch(np, gx, xi);
+            if (gx[low] == xi) { y[i] = gy[low]; continue; }
+         }
+      }
+      const Int_t up = low + 1;
+      y[i] = gy[up] + (xi - gx[up]) * (gy[low] - gy[up]) / (gx[low] - gx[up]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -49,6 +49,7 @@
 #include "Math/QuantFuncMathCore.h"
 
 #include "TH1Merger.h"
+#include "TH1ConcurrentFill.h"
 
 /** \addtogroup Hist
 @{
@@ -311,6 +312,10 @@ When using the options 2 or 3 above, the labels are automatically
  capacity (127 or 32767). Histograms of all types may have positive
  or/and negative bin contents.
 
+ A histogram can be filled from several threads at the same time after
+ calling TH1::SetConcurrentFill: each thread then fills its own copy of
+ the histogram, which is merged back when the histogram is read or written.
+
 #### Rebinning
  At any time, an histogram can be rebinned via TH1::Rebin. This function
  returns a new histogram with the rebinned contents.
@@ -552,6 +557,7 @@ TH1::TH1(): TNamed(), TAttLine(), TAttFill(), TAttMarker()
    fNcells        = 0;
    fIntegral      = 0;
    fPainter       = 0;
+   fConcurrentFill= 0;
    fEntries       = 0;
    fNormFactor    = 0;
    fTsumw         = fTsumw2=fTsumwx=fTsumwx2=0;
@@ -608,6 +614,8 @@ TH1::~TH1()
    }
    delete fPainter;
    fPainter = 0;
+   delete fConcurrentFill;
+   fConcurrentFill = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -691,6 +699,7 @@ TH1::TH1(const char *name,const char *title,Int_t nbins,const Double_t *xbins)
 
 TH1::TH1(const TH1 &h) : TNamed(), TAttLine(), TAttFill(), TAttMarker()
 {
+   fConcurrentFill = 0;
    ((TH1&)h).Copy(*this);
 }
 
@@ -718,6 +727,7 @@ void TH1::Build()
 {
    fDirectory     = 0;
    fPainter       = 0;
+   fConcurrentFill= 0;
    fIntegral      = 0;
    fEntries       = 0;
    fNormFactor    = 0;
@@ -787,6 +797,7 @@ Bool_t TH1::Add(TF1 *f1, Double_t c1, Option_t *option)
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
 
    //   - Add statistics
    Double_t s1[10];
@@ -861,6 +872,8 @@ Bool_t TH1::Add(const TH1 *h1, Double_t c1)
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
+   if (h1->fConcurrentFill) const_cast<TH1*>(h1)->FlushConcurrentFill();
 
    bool useMerge = (c1 == 1. &&  !this->TestBit(kIsAverage) && !h1->TestBit(kIsAverage) );
    try {
@@ -1023,6 +1036,9 @@ Bool_t TH1::Add(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2)
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
+   if (h1->fConcurrentFill) const_cast<TH1*>(h1)->FlushConcurrentFill();
+   if (h2->fConcurrentFill) const_cast<TH1*>(h2)->FlushConcurrentFill();
 
    Bool_t normWidth = kFALSE;
    if (h1 == h2 && c2 < 0) {c2 = 0; normWidth = kTRUE;}
@@ -1901,6 +1917,7 @@ Double_t TH1::Chi2TestX(const TH1* h2,  Double_t &chi2, Int_t &ndf, Int_t &igood
    opt.ToUpper();
 
    if (fBuffer) const_cast<TH1*>(this)->BufferEmpty();
+   if (fConcurrentFill) const_cast<TH1*>(this)->FlushConcurrentFill();
 
    const TAxis *xaxis1 = GetXaxis();
    const TAxis *xaxis2 = h2->GetXaxis();
@@ -2353,6 +2370,7 @@ void TH1::ClearUnderflowAndOverflow()
 Double_t TH1::ComputeIntegral(Bool_t onlyPositive)
 {
    if (fBuffer) BufferEmpty();
+   if (fConcurrentFill) FlushConcurrentFill();
 
    // delete previously computed integral (if any)
    if (fIntegral) delete [] fIntegral;
@@ -2462,9 +2480,13 @@ TH1 *TH1::GetCumulative(Bool_t forward, const char* suffix) const
 /// Note also that the histogram it will be created in gDirectory (if AddDirectoryStatus()=true)
 /// or will not be added to any directory if  AddDirectoryStatus()=false
 /// independently of the current directory stored in the original histogram
+///
+/// A histogram in concurrent fill mode is flushed first (see FlushConcurrentFill),
+/// so that the copy includes the entries filled by all threads.
 
 void TH1::Copy(TObject &obj) const
 {
+   if (fConcurrentFill) const_cast<TH1*>(this)->FlushConcurrentFill();
    if (((TH1&)obj).fDirectory) {
       // We are likely to change the hash value of this object
       // with TNamed::Copy, to keep things correct, we need to
@@ -2610,6 +2632,7 @@ Bool_t TH1::Divide(TF1 *f1, Double_t c1)
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
 
    Int_t nx = GetNbinsX() + 2; // normal bins + uf / of
    Int_t ny = GetNbinsY() + 2;
@@ -2678,6 +2701,7 @@ Bool_t TH1::Divide(const TH1 *h1)
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
 
    try {
       CheckConsistency(this,h1);
@@ -2750,6 +2774,7 @@ Bool_t TH1::Divide(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2, Optio
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
 
    try {
       CheckConsistency(h1,h2);
@@ -2986,6 +3011,7 @@ void TH1::Eval(TF1 *f1, Option_t *option)
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
 
    Int_t nbinsx  = fXaxis.GetNbins();
    Int_t nbinsy  = fYaxis.GetNbins();
@@ -3123,6 +3149,7 @@ TH1* TH1::FFT(TH1* h_output, Option_t *option)
 
 Int_t TH1::Fill(Double_t x)
 {
+   if (fConcurrentFill) return GetConcurrentFillShadow()->Fill(x);
    if (fBuffer)  return BufferFill(x,1);
 
    Int_t bin;
@@ -3155,6 +3182,7 @@ Int_t TH1::Fill(Double_t x)
 
 Int_t TH1::Fill(Double_t x, Double_t w)
 {
+   if (fConcurrentFill) return GetConcurrentFillShadow()->Fill(x,w);
 
    if (fBuffer) return BufferFill(x,w);
 
@@ -3191,6 +3219,7 @@ Int_t TH1::Fill(Double_t x, Double_t w)
 
 Int_t TH1::Fill(const char *namex, Double_t w)
 {
+   if (fConcurrentFill) return GetConcurrentFillShadow()->Fill(namex,w);
    Int_t bin;
    fEntries++;
    bin =fXaxis.FindBin(namex);
@@ -3226,6 +3255,10 @@ Int_t TH1::Fill(const char *namex, Double_t w)
 
 void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
+   if (fConcurrentFill) {
+      GetConcurrentFillShadow()->FillN(ntimes, x, w, stride);
+      return;
+   }
    //If a buffer is activated, fill buffer
    if (fBuffer) {
       ntimes *= stride;
@@ -3250,27 +3283,35 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
+   const Int_t kBlockSize = 256;
+   Int_t bins[kBlockSize];
    Int_t bin,i;
 
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
-   ntimes *= stride;
-   for (i=0;i<ntimes;i+=stride) {
-      bin =fXaxis.FindBin(x[i]);
-      if (bin <0) continue;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin, ww);
-      if (bin == 0 || bin > nbins) {
-         if (!fgStatOverflows) continue;
+   // Find the bins of a block of values at once, unless the axis can be
+   // extended: an extension would invalidate the bins found for the block.
+   for (Int_t first = 0, nblock = 0; first < ntimes; first += nblock) {
+      nblock = fXaxis.CanExtend() ? 1 : TMath::Min(kBlockSize, ntimes - first);
+      fXaxis.FindBin(nblock, &x[first*stride], bins, stride);
+      for (Int_t k = 0; k < nblock; ++k) {
+         i = (first + k)*stride;
+         bin = bins[k];
+         if (bin <0) continue;
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+         if (bin == 0 || bin > nbins) {
+            if (!fgStatOverflows) continue;
+         }
+         Double_t z= ww;
+         fTsumw   += z;
+         fTsumw2  += z*z;
+         fTsumwx  += z*x[i];
+         fTsumwx2 += z*x[i]*x[i];
       }
-      Double_t z= ww;
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
    }
 }
 
@@ -3498,6 +3539,7 @@ Int_t TH1::FindFixBin(Double_t x, Double_t y, Double_t z) const
 Int_t TH1::FindFirstBinAbove(Double_t threshold, Int_t axis) const
 {
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    if (axis != 1) {
       Warning("FindFirstBinAbove","Invalid axis number : %d, axis x assumed\n",axis);
@@ -3517,6 +3559,7 @@ Int_t TH1::FindFirstBinAbove(Double_t threshold, Int_t axis) const
 Int_t TH1::FindLastBinAbove(Double_t threshold, Int_t axis) const
 {
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    if (axis != 1) {
       Warning("FindLastBinAbove","Invalid axis number : %d, axis x assumed\n",axis);
@@ -3901,6 +3944,7 @@ TFitResultPtr TH1::Fit(TF1 *f1 ,Option_t *option ,Option_t *goption, Double_t xx
    // need to empty the buffer before
    // (t.b.d. do a ML unbinned fit with buffer data)
    if (fBuffer) BufferEmpty();
+   if (fConcurrentFill) FlushConcurrentFill();
 
    return ROOT::Fit::FitObject(this, f1 , fitOption , minOption, goption, range);
 }
@@ -3931,6 +3975,28 @@ void TH1::FitPanel()
          Error("FitPanel", "Unable to find the FitPanel plug-in");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the per-thread shadows of a histogram in concurrent fill mode into
+/// the histogram (see TH1::SetConcurrentFill) and reset them.
+///
+/// This is done automatically by the functions reading the content or the
+/// statistics of the histogram and when writing it, but like them it must
+/// not be called while other threads are still filling the histogram.
+
+void TH1::FlushConcurrentFill()
+{
+   if (fConcurrentFill) fConcurrentFill->Fold();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the histogram the calling thread fills when this histogram is in
+/// concurrent fill mode.
+
+TH1 *TH1::GetConcurrentFillShadow()
+{
+   return fConcurrentFill->GetShadow();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return an histogram containing the asymmetry of this histogram with h2,
 /// where the asymmetry is defined as:
@@ -4051,6 +4117,7 @@ Bool_t TH1::GetDefaultSumw2()
 
 Double_t TH1::GetEntries() const
 {
+   if (fConcurrentFill) const_cast<TH1*>(this)->FlushConcurrentFill();
    if (fBuffer) {
       Int_t nentries = (Int_t) fBuffer[0];
       if (nentries > 0) return nentries;
@@ -4637,6 +4704,7 @@ Double_t TH1::GetRandom() const
 Double_t TH1::GetBinContent(Int_t bin) const
 {
    if (fBuffer) const_cast<TH1*>(this)->BufferEmpty();
+   if (fConcurrentFill) const_cast<TH1*>(this)->FlushConcurrentFill();
    if (bin < 0) bin = 0;
    if (bin >= fNcells) bin = fNcells-1;
 
@@ -4668,6 +4736,7 @@ Double_t TH1::GetBinWithContent(Double_t c, Int_t &binx, Int_t firstx, Int_t las
    }
 
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    if (firstx <= 0) firstx = 1;
    if (lastx < firstx) lastx = fXaxis.GetNbins();
@@ -4691,6 +4760,7 @@ Double_t TH1::GetBinWithContent(Double_t c, Int_t &binx, Int_t firstx, Int_t las
 Double_t TH1::Interpolate(Double_t x)
 {
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    Int_t xbin = FindBin(x);
    Double_t x0,x1,y0,y1;
@@ -5340,6 +5410,13 @@ Long64_t TH1::Merge(TCollection *li)
     if (!li) return 0;
     if (li->IsEmpty()) return (Long64_t) GetEntries();
 
+    // fold the concurrent fills of the inputs
+    TIter next(li);
+    while (TObject *obj = next()) {
+       TH1 *h = dynamic_cast<TH1*>(obj);
+       if (h && h->fConcurrentFill) h->FlushConcurrentFill();
+    }
+
     // use TH1Merger class
     TH1Merger merger(*this,*li);
     Bool_t ret =  merger();
@@ -5368,6 +5445,7 @@ Bool_t TH1::Multiply(TF1 *f1, Double_t c1)
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
 
    Int_t nx = GetNbinsX() + 2; // normal bins + uf / of (cells)
    Int_t ny = GetNbinsY() + 2;
@@ -5430,6 +5508,7 @@ Bool_t TH1::Multiply(const TH1 *h1)
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
 
    try {
       CheckConsistency(this,h1);
@@ -5492,6 +5571,7 @@ Bool_t TH1::Multiply(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2, Opt
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
 
    try {
       CheckConsistency(h1,h2);
@@ -5941,6 +6021,7 @@ void TH1::Scale(Double_t c1, Option_t *option)
    if (opt.Contains("width")) Add(this, this, c1, -1);
    else {
       if (fBuffer) BufferEmpty(1);
+      if (fConcurrentFill) FlushConcurrentFill();
       for(Int_t i = 0; i < fNcells; ++i) UpdateBinContent(i, c1 * RetrieveBinContent(i));
       if (fSumw2.fN) for(Int_t i = 0; i < fNcells; ++i) fSumw2.fArray[i] *= (c1 * c1); // update errors
       SetMinimum(); SetMaximum(); // minimum and maximum value will be recalculated the next time
@@ -5992,6 +6073,53 @@ UInt_t TH1::SetCanExtend(UInt_t extendBitMask)
    return oldExtendBitMask;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the concurrent fill mode, in which the histogram can be
+/// filled from several threads at the same time without locking.
+///
+/// In this mode the Fill and FillN functions do not modify the histogram:
+/// each thread fills its own shadow copy of it (contents, sum of squares of
+/// weights and statistics), created on the first fill from that thread.
+/// The shadows are merged into the histogram (see TH1::FlushConcurrentFill)
+/// by the functions accessing the content or the statistics of the histogram
+/// (GetBinContent, GetBinError, GetEntries, GetStats, Integral, ...), by the
+/// functions modifying it (Add, Scale, ...) and when the histogram is written.
+/// Consequently these functions must only be called once the filling threads
+/// are done, as with ROOT::TThreadedObject:
+/// ~~~ {.cpp}
+///    TH1D h("h", "h", 100, -5, 5);
+///    h.SetConcurrentFill();
+///    std::vector<std::thread> threads;
+///    for (int i = 0; i < 4; ++i)
+///       threads.emplace_back([&h]() { for (int j = 0; j < 1000000; ++j) h.Fill(gRandom->Gaus()); });
+///    for (auto &t : threads) t.join();
+///    h.Draw(); // contains the 4000000 entries
+/// ~~~
+/// The return value of Fill is the bin number in the shadow, which differs
+/// from the one of the histogram if the axes were extended.
+/// Disabling the mode merges the shadows and deletes them.
+///
+/// As for any use of ROOT from several threads, ROOT::EnableThreadSafety()
+/// must have been called before. The mode is not supported by TH1K and
+/// TH2Poly, whose fills are not forwarded to the shadows.
+
+void TH1::SetConcurrentFill(Bool_t concurrent)
+{
+   if (concurrent == IsConcurrentFill()) return;
+   if (concurrent) {
+      if (InheritsFrom("TH1K") || InheritsFrom("TH2Poly")) {
+         Error("SetConcurrentFill", "Concurrent fill mode is not supported by %s", ClassName());
+         return;
+      }
+      if (fBuffer) BufferEmpty(1);
+      fConcurrentFill = new ROOT::Internal::TH1ConcurrentFill(*this);
+   } else {
+      FlushConcurrentFill();
+      delete fConcurrentFill;
+      fConcurrentFill = 0;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static function to set the default buffer size for automatic histograms.
 /// When an histogram is created with one of its axis lower limit greater
@@ -6204,6 +6332,7 @@ void  TH1::Smooth(Int_t ntimes, Option_t *option)
 
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
+   if (fConcurrentFill) FlushConcurrentFill();
 
    Int_t firstbin = 1, lastbin = nbins;
    TString opt = option;
@@ -6307,6 +6436,7 @@ void TH1::Streamer(TBuffer &b)
       b.CheckByteCount(R__s, R__c, TH1::IsA());
 
    } else {
+      if (fConcurrentFill) FlushConcurrentFill();
       b.WriteClassBuffer(TH1::Class(),this);
    }
 }
@@ -6323,6 +6453,7 @@ void TH1::Streamer(TBuffer &b)
 void TH1::Print(Option_t *option) const
 {
    if (fBuffer) const_cast<TH1*>(this)->BufferEmpty();
+   if (fConcurrentFill) const_cast<TH1*>(this)->FlushConcurrentFill();
    printf( "TH1.Print Name  = %s, Entries= %d, Total sum= %g\n",GetName(),Int_t(fEntries),GetSumOfWeights());
    TString opt = option;
    opt.ToLower();
@@ -6423,6 +6554,9 @@ void TH1::Reset(Option_t *option)
    opt.ToUpper();
    fSumw2.Reset();
    if (fIntegral) {delete [] fIntegral; fIntegral = 0;}
+   // the content of the shadows is discarded too, except when only
+   // reallocating the bins (when extending the axes)
+   if (fConcurrentFill && !opt.Contains("ICE")) fConcurrentFill->Reset();
 
    if (opt.Contains("M")) {
       SetMinimum();
@@ -6471,6 +6605,7 @@ void TH1::SavePrimitive(std::ostream &out, Option_t *option /*= ""*/)
 {
    // empty the buffer before if it exists
    if (fBuffer) BufferEmpty();
+   if (fConcurrentFill) FlushConcurrentFill();
 
    Bool_t nonEqiX = kFALSE;
    Bool_t nonEqiY = kFALSE;
@@ -7019,6 +7154,7 @@ Double_t TH1::GetKurtosis(Int_t axis) const
 void TH1::GetStats(Double_t *stats) const
 {
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    // Loop on bins (possibly including underflows/overflows)
    Int_t bin, binx;
@@ -7101,6 +7237,7 @@ void TH1::ResetStats()
 Double_t TH1::GetSumOfWeights() const
 {
    if (fBuffer) const_cast<TH1*>(this)->BufferEmpty();
+   if (fConcurrentFill) const_cast<TH1*>(this)->FlushConcurrentFill();
 
    Int_t bin,binx,biny,binz;
    Double_t sum =0;
@@ -7162,6 +7299,7 @@ Double_t TH1::DoIntegral(Int_t binx1, Int_t binx2, Int_t biny1, Int_t biny2, Int
                           Option_t *option, Bool_t doError) const
 {
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    Int_t nx = GetNbinsX() + 2;
    if (binx1 < 0) binx1 = 0;
@@ -7269,6 +7407,7 @@ Double_t TH1::AndersonDarlingTest(const TH1 *h2, Double_t & advalue) const
 
    // empty the buffer. Probably we could add as an unbinned test
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    // use the BinData class
    ROOT::Fit::BinData data1;
@@ -7384,6 +7523,7 @@ Double_t TH1::KolmogorovTest(const TH1 *h2, Option_t *option) const
 
    // empty the buffer. Probably we could add as an unbinned test
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    // Check consistency in bin edges
    for(Int_t i = 1; i <= axis1->GetNbins() + 1; ++i) {
@@ -7667,6 +7807,7 @@ Double_t TH1::GetMaximum(Double_t maxval) const
 
    // empty the buffer
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    Int_t bin, binx, biny, binz;
    Int_t xfirst  = fXaxis.GetFirst();
@@ -7704,6 +7845,7 @@ Int_t TH1::GetMaximumBin(Int_t &locmax, Int_t &locmay, Int_t &locmaz) const
 {
       // empty the buffer
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    Int_t bin, binx, biny, binz;
    Int_t locm;
@@ -7752,6 +7894,7 @@ Double_t TH1::GetMinimum(Double_t minval) const
 
    // empty the buffer
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    Int_t bin, binx, biny, binz;
    Int_t xfirst  = fXaxis.GetFirst();
@@ -7789,6 +7932,7 @@ Int_t TH1::GetMinimumBin(Int_t &locmix, Int_t &locmiy, Int_t &locmiz) const
 {
       // empty the buffer
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    Int_t bin, binx, biny, binz;
    Int_t locm;
@@ -7846,6 +7990,7 @@ void TH1::GetMinimumAndMaximum(Double_t& min, Double_t& max) const
 {
    // empty the buffer
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    Int_t bin, binx, biny, binz;
    Int_t xfirst  = fXaxis.GetFirst();
@@ -8145,6 +8290,7 @@ void TH1::Sumw2(Bool_t flag)
 
    // empty the buffer
    if (fBuffer) BufferEmpty();
+   if (fConcurrentFill) FlushConcurrentFill();
 
    if (fEntries > 0)
       for (Int_t i = 0; i < fNcells; ++i)
@@ -8175,6 +8321,7 @@ Double_t TH1::GetBinError(Int_t bin) const
    if (bin < 0) bin = 0;
    if (bin >= fNcells) bin = fNcells-1;
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
    if (fSumw2.fN) return TMath::Sqrt(fSumw2.fArray[bin]);
 
    return TMath::Sqrt(TMath::Abs(RetrieveBinContent(bin)));
@@ -8195,6 +8342,7 @@ Double_t TH1::GetBinErrorLow(Int_t bin) const
    if (bin < 0) bin = 0;
    if (bin >= fNcells) bin = fNcells-1;
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    Double_t alpha = 1.- 0.682689492;
    if (fBinStatErrOpt == kPoisson2) alpha = 0.05;
@@ -8225,6 +8373,7 @@ Double_t TH1::GetBinErrorUp(Int_t bin) const
    if (bin < 0) bin = 0;
    if (bin >= fNcells) bin = fNcells-1;
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH1*)this)->FlushConcurrentFill();
 
    Double_t alpha = 1.- 0.682689492;
    if (fBinStatErrOpt == kPoisson2) alpha = 0.05;
@@ -9464,6 +9613,121 @@ TH1D operator/(const TH1D &h1, const TH1D &h2)
    return hnew;
 }
 
+//______________________________________________________________________________
+//                     TH1Compact methods
+// TH1Compact : histograms storing the bin contents in blocks of 8, 16 or 32
+//              bit integers, promoted to wider types (up to doubles) when needed
+//______________________________________________________________________________
+
+ClassImp(TH1Compact)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor.
+
+TH1Compact::TH1Compact(): TH1(), TArrayCompact()
+{
+   fDimension = 1;
+   SetBinsLength(3);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a 1-Dim histogram with fix bins and compact storage
+/// (see TH1::TH1 for explanation of parameters)
+///
+/// The bin contents are stored in blocks of TArrayCompact::kBlockSize bins,
+/// each with the narrowest type that holds its contents: no storage for empty
+/// blocks, 8, 16 or 32 bit unsigned integers for unweighted entries and
+/// doubles for weighted or negative contents. Well suited for occupancy
+/// histograms with many bins, see TArrayCompact.
+
+TH1Compact::TH1Compact(const char *name,const char *title,Int_t nbins,Double_t xlow,Double_t xup)
+: TH1(name,title,nbins,xlow,xup)
+{
+   fDimension = 1;
+   TArrayCompact::Set(fNcells);
+
+   if (xlow >= xup) SetBuffer(fgBufferSize);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a 1-Dim histogram with variable bins and compact storage
+/// (see TH1::TH1 for explanation of parameters)
+
+TH1Compact::TH1Compact(const char *name,const char *title,Int_t nbins,const Float_t *xbins)
+: TH1(name,title,nbins,xbins)
+{
+   fDimension = 1;
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a 1-Dim histogram with variable bins and compact storage
+/// (see TH1::TH1 for explanation of parameters)
+
+TH1Compact::TH1Compact(const char *name,const char *title,Int_t nbins,const Double_t *xbins)
+: TH1(name,title,nbins,xbins)
+{
+   fDimension = 1;
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TH1Compact::~TH1Compact()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor.
+
+TH1Compact::TH1Compact(const TH1Compact &h) : TH1(), TArrayCompact()
+{
+   ((TH1Compact&)h).Copy(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy this histogram structure to newth.
+
+void TH1Compact::Copy(TObject &newth) const
+{
+   TH1::Copy(newth);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset this histogram: contents, errors, etc.
+/// The storage of the bin contents is released.
+
+void TH1Compact::Reset(Option_t *option)
+{
+   TH1::Reset(option);
+   TArrayCompact::Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set total number of bins including under/overflow
+/// Reallocate bin contents array
+
+void TH1Compact::SetBinsLength(Int_t n)
+{
+   if (n < 0) n = fXaxis.GetNbins() + 2;
+   fNcells = n;
+   TArrayCompact::Set(n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Operator =
+
+TH1Compact& TH1Compact::operator=(const TH1Compact &h1)
+{
+   if (this != &h1)  ((TH1Compact&)h1).Copy(*this);
+   return *this;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///return pointer to histogram with name
 ///hid if id >=0
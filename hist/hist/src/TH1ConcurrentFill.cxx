@@ -0,0 +1,139 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TH1ConcurrentFill.h"
+
+#include "TClass.h"
+#include "TDirectory.h"
+#include "TH1.h"
+#include "TList.h"
+#include "ThreadLocalStorage.h"
+
+#include <atomic>
+
+namespace {
+
+const Int_t kCacheSize = 8; // number of histograms whose shadow a thread remembers
+
+std::atomic<ULong64_t> gNextId(1);
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor, hist is the histogram in concurrent fill mode.
+
+TH1ConcurrentFill::TH1ConcurrentFill(TH1 &hist) : fHist(hist), fId(gNextId++)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor, the shadows that have not been folded are lost.
+
+TH1ConcurrentFill::~TH1ConcurrentFill()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the shadow of the calling thread, creating it if needed.
+/// The last shadows used by a thread are cached in thread-local storage, so
+/// that the lock is only taken the first time a thread fills the histogram.
+
+TH1 *TH1ConcurrentFill::GetShadow()
+{
+   TTHREAD_TLS_ARRAY(ULong64_t, kCacheSize, ids);
+   TTHREAD_TLS_ARRAY(TH1 *, kCacheSize, shadows);
+   Int_t slot = fId % kCacheSize;
+   if (ids[slot] != fId) {
+      shadows[slot] = FindOrCreateShadow();
+      ids[slot] = fId;
+   }
+   return shadows[slot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the shadow of the calling thread, creating it from an empty copy
+/// of the histogram if the thread has none yet.
+
+TH1 *TH1ConcurrentFill::FindOrCreateShadow()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto id = std::this_thread::get_id();
+   for (auto &shadow : fShadows) {
+      if (shadow.first == id)
+         return shadow.second.get();
+   }
+
+   TH1 *shadow = NewShadow();
+   fShadows.emplace_back(id, std::unique_ptr<TH1>(shadow));
+   return shadow;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an empty copy of the histogram. Must be called with fMutex held:
+/// TH1::Copy folds the shadows first, which is skipped here since it would
+/// lock fMutex again and an empty copy does not need the folded content.
+
+TH1 *TH1ConcurrentFill::NewShadow()
+{
+   // The shadow must not be registered to any directory.
+   TDirectory::TContext ctxt(nullptr);
+   TH1 *shadow = (TH1 *)fHist.IsA()->New();
+   fCopying = kTRUE;
+   fHist.Copy(*shadow);
+   fCopying = kFALSE;
+   shadow->BufferEmpty(1);
+   shadow->Reset();
+   return shadow;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the content and statistics of the shadows into the histogram and
+/// reset them. Must not be called while other threads are filling.
+
+void TH1ConcurrentFill::Fold()
+{
+   // Merge() reads back the statistics of the histogram, which would fold again,
+   // and NewShadow() copies the histogram while holding the lock.
+   if (fFolding || fCopying)
+      return;
+   std::lock_guard<std::mutex> lock(fMutex);
+   TList list;
+   for (auto &shadow : fShadows) {
+      if (shadow.second->GetEntries() != 0)
+         list.Add(shadow.second.get());
+   }
+   if (list.IsEmpty())
+      return;
+
+   fFolding = kTRUE;
+   fHist.Merge(&list);
+   fFolding = kFALSE;
+   TIter next(&list);
+   while (TH1 *shadow = (TH1 *)next())
+      shadow->Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Discard the content of the shadows.
+
+void TH1ConcurrentFill::Reset()
+{
+   if (fFolding)
+      return;
+   std::lock_guard<std::mutex> lock(fMutex);
+   for (auto &shadow : fShadows)
+      shadow.second->Reset();
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,58 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Helper class implementing the concurrent fill mode of TH1 (see TH1::SetConcurrentFill)
+
+#ifndef ROOT_TH1ConcurrentFill
+#define ROOT_TH1ConcurrentFill
+
+#include "RtypesCore.h"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class TH1;
+
+namespace ROOT {
+namespace Internal {
+
+class TH1ConcurrentFill {
+private:
+   using Shadow_t = std::pair<std::thread::id, std::unique_ptr<TH1>>;
+
+   TH1 &fHist;                    // histogram receiving the folded shadows
+   ULong64_t fId;                 // unique identifier, used as key of the thread-local shadow caches
+   Bool_t fFolding = kFALSE;      // true while the shadows are being merged into fHist
+   Bool_t fCopying = kFALSE;      // true while fHist is being copied into a new shadow
+   std::mutex fMutex;             // protects fShadows
+   std::vector<Shadow_t> fShadows; // one empty-on-fold copy of fHist per filling thread
+
+   TH1 *FindOrCreateShadow();
+   TH1 *NewShadow();
+
+public:
+   TH1ConcurrentFill(TH1 &hist);
+   ~TH1ConcurrentFill();
+
+   TH1ConcurrentFill(const TH1ConcurrentFill &) = delete;
+   TH1ConcurrentFill &operator=(const TH1ConcurrentFill &) = delete;
+
+   TH1 *GetShadow();
+   void Fold();
+   void Reset();
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
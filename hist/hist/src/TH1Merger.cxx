@@ -8,8 +8,37 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include "TArrayCompact.h"
+#include <algorithm>
 #include <iostream>
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+namespace {
+
+// Number of cells summed by a task when the cells are split among the tasks.
+// A multiple of the block size of TArrayCompact, so that no two tasks write
+// to the same block.
+const Int_t kChunkSize = 4 * TArrayCompact::kBlockSize;
+// Minimal number of cell additions for which the merge is run in parallel.
+const Long64_t kMinParallelWork = 1 << 20;
+// Maximal number of partial sums kept when the inputs are split among the tasks.
+const Long64_t kMaxPartialSums = 1 << 24;
+
+// Add the elements [first,last) of src to sums.
+template <class T>
+void AddRange(const T *src, Int_t first, Int_t last, Double_t *sums)
+{
+   const T *in = src + first;
+   for (Int_t i = 0, n = last - first; i < n; ++i)
+      sums[i] += in[i];
+}
+
+} // anonymous namespace
+
 
 Bool_t TH1Merger::AxesHaveLimits(const TH1 * h) {
    Bool_t hasLimits = h->GetXaxis()->GetXmin() < h->GetXaxis()->GetXmax();
@@ -18,6 +47,106 @@ Bool_t TH1Merger::AxesHaveLimits(const TH1 * h) {
    return hasLimits; 
 }
 
+/// Sum the cells of several inputs in parallel, using the implicit
+/// multi-threading pool. For each cell of [0,ncells), add() accumulates the
+/// contributions of an input to nsums sums, stored as nsums consecutive arrays
+/// of last - first elements; store() adds these sums to the result.
+/// If there are enough cells, each task sums all inputs over its own range of
+/// cells. Otherwise each task sums a group of inputs over all cells and the
+/// partial sums of the groups are added pairwise, in a tree. The order of the
+/// additions only depends on the number of inputs and on the pool size, so
+/// that the result does not depend on the scheduling.
+/// store() is called concurrently for disjoint ranges of cells aligned to the
+/// blocks of TArrayCompact.
+/// Return kFALSE, without calling add() or store(), if implicit
+/// multi-threading is disabled or the merge is too small to be worth it: the
+/// caller then merges sequentially.
+
+Bool_t TH1Merger::ReduceCells(Int_t ncells, Int_t ninputs, Int_t nsums, const AddCells_t &add, const StoreCells_t &store)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || ninputs < 2 || ncells <= 0 || (Long64_t)ncells * ninputs < kMinParallelWork)
+      return kFALSE;
+
+   ROOT::TThreadExecutor pool;
+   const Int_t poolSize = ROOT::GetImplicitMTPoolSize();
+   const Int_t ngroups = std::min<Long64_t>({4LL * poolSize, (Long64_t)ninputs, kMaxPartialSums / ((Long64_t)ncells * nsums)});
+
+   if (ncells >= poolSize * kChunkSize || ngroups < 2) {
+      const Int_t nchunks = (ncells + kChunkSize - 1) / kChunkSize;
+      pool.Foreach([&](Int_t ichunk) {
+         const Int_t first = ichunk * kChunkSize;
+         const Int_t last = std::min(first + kChunkSize, ncells);
+         std::vector<Double_t> sums((Long64_t)nsums * (last - first));
+         for (Int_t input = 0; input < ninputs; ++input)
+            add(input, first, last, sums.data());
+         store(first, last, sums.data());
+      }, ROOT::TSeq<Int_t>(0, nchunks));
+      return kTRUE;
+   }
+
+   std::vector<std::vector<Double_t>> partial(ngroups);
+   pool.Foreach([&](Int_t igroup) {
+      partial[igroup].assign((Long64_t)nsums * ncells, 0.);
+      const Int_t begin = (Long64_t)igroup * ninputs / ngroups;
+      const Int_t end = (Long64_t)(igroup + 1) * ninputs / ngroups;
+      for (Int_t input = begin; input < end; ++input)
+         add(input, 0, ncells, partial[igroup].data());
+   }, ROOT::TSeq<Int_t>(0, ngroups));
+
+   for (Int_t step = 1; step < ngroups; step *= 2) {
+      pool.Foreach([&](Int_t ipair) {
+         const Int_t a = 2 * step * ipair;
+         const Int_t b = a + step;
+         if (b >= ngroups)
+            return;
+         AddRange(partial[b].data(), 0, partial[b].size(), partial[a].data());
+         std::vector<Double_t>().swap(partial[b]);
+      }, ROOT::TSeq<Int_t>(0, (ngroups + 2 * step - 1) / (2 * step)));
+   }
+   store(0, ncells, partial[0].data());
+   return kTRUE;
+#else
+   (void)ncells;
+   (void)ninputs;
+   (void)nsums;
+   (void)add;
+   (void)store;
+   return kFALSE;
+#endif
+}
+
+/// Add the contents of the cells [first,last) of h to sums. The arrays of
+/// the TH1 storage classes are read directly, so that the loop vectorizes.
+void TH1Merger::AddBinContents(const TH1 *h, Int_t first, Int_t last, Double_t *sums)
+{
+   const TArray *array = dynamic_cast<const TArray *>(h);
+   if (array && array->GetSize() == h->fNcells) {
+      if (auto a = dynamic_cast<const TArrayD *>(array))
+         return AddRange(a->GetArray(), first, last, sums);
+      if (auto a = dynamic_cast<const TArrayF *>(array))
+         return AddRange(a->GetArray(), first, last, sums);
+      if (auto a = dynamic_cast<const TArrayI *>(array))
+         return AddRange(a->GetArray(), first, last, sums);
+      if (auto a = dynamic_cast<const TArrayS *>(array))
+         return AddRange(a->GetArray(), first, last, sums);
+      if (auto a = dynamic_cast<const TArrayC *>(array))
+         return AddRange(a->GetArray(), first, last, sums);
+   }
+   for (Int_t ibin = first; ibin < last; ++ibin)
+      sums[ibin - first] += h->RetrieveBinContent(ibin);
+}
+
+/// Add the squared errors of the cells [first,last) of h to sums,
+/// as given by TH1::GetBinErrorSqUnchecked.
+void TH1Merger::AddBinErrorsSq(const TH1 *h, Int_t first, Int_t last, Double_t *sums)
+{
+   if (h->fSumw2.fN)
+      AddRange(h->fSumw2.fArray, first, last, sums);
+   else
+      AddBinContents(h, first, last, sums);
+}
+
 /// Function performing the actual merge
 Bool_t TH1Merger::operator() () {
 
@@ -419,6 +548,7 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
    
+   std::vector<TH1*> hists;
    TIter next(&fInputList); 
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -435,18 +565,36 @@ Bool_t TH1Merger::SameAxesMerge() {
       for (Int_t i=0; i<TH1::kNstat; i++)
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
+      hists.push_back(hist);
+   }
+
+   // the axes are compatible (see ExamineHistograms): the cells of all
+   // histograms can be summed in parallel, without looking at the axes
+   const Bool_t haveSumw2 = fH0->fSumw2.fN != 0;
+   auto addCells = [&](Int_t input, Int_t first, Int_t last, Double_t *sums) {
+      AddBinContents(hists[input], first, last, sums);
+      if (haveSumw2) AddBinErrorsSq(hists[input], first, last, sums + (last - first));
+   };
+   auto storeCells = [&](Int_t first, Int_t last, const Double_t *sums) {
+      for (Int_t ibin = first; ibin < last; ibin++) {
+         fH0->AddBinContent(ibin, sums[ibin - first]);
+         if (haveSumw2) fH0->fSumw2.fArray[ibin] += sums[last - first + ibin - first];
+      }
+   };
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
+   if (!ReduceCells(fH0->fNcells, hists.size(), haveSumw2 ? 2 : 1, addCells, storeCells)) {
+      for (TH1 *hist : hists) {
          // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
+         for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
 
-         Double_t cu = hist->RetrieveBinContent(ibin);
-         Double_t e1sq = TMath::Abs(cu);
-         if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
+            Double_t cu = hist->RetrieveBinContent(ibin);
+            Double_t e1sq = TMath::Abs(cu);
+            if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
 
-         fH0->AddBinContent(ibin,cu);
-         if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
+            fH0->AddBinContent(ibin,cu);
+            if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
 
+         }
       }
    }
    //copy merged stats
@@ -11,9 +11,15 @@
 
 // Helper clas implementing some of the TH1 functionality
 
+#ifndef ROOT_TH1Merger
+#define ROOT_TH1Merger
+
 #include "TH1.h"
 #include "TList.h"
 
+#include <functional>
+#include <vector>
+
 class TH1Merger {
 
 public: 
@@ -26,8 +32,15 @@ public:
       kAllLabel = 3  // histogram have labels all axis
    };
 
+   // add the contributions of an input to the sums of the cells [first,last)
+   using AddCells_t = std::function<void(Int_t input, Int_t first, Int_t last, Double_t *sums)>;
+   // add the sums of the cells [first,last) to the result
+   using StoreCells_t = std::function<void(Int_t first, Int_t last, const Double_t *sums)>;
+
    static Bool_t AxesHaveLimits(const TH1 * h);
 
+   static Bool_t ReduceCells(Int_t ncells, Int_t ninputs, Int_t nsums, const AddCells_t &add, const StoreCells_t &store);
+
    static Int_t FindFixBinNumber(Int_t ibin, const TAxis & inAxis, const TAxis & outAxis) {
       // should I ceck in case of underflow/overflow if underflow/overflow values of input axis
       // outside  output axis ?  
@@ -67,6 +80,10 @@ public:
 
 private: 
 
+   static void AddBinContents(const TH1 *h, Int_t first, Int_t last, Double_t *sums);
+
+   static void AddBinErrorsSq(const TH1 *h, Int_t first, Int_t last, Double_t *sums);
+
    EMergerType ExamineHistograms();
 
    void DefineNewAxes(); 
@@ -88,3 +105,5 @@ private:
    TAxis fNewZAxis; 
    UInt_t fNewAxisFlag; 
 };
+
+#endif
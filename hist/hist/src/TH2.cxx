@@ -313,6 +313,7 @@ Int_t TH2::Fill(Double_t )
 
 Int_t TH2::Fill(Double_t x,Double_t y)
 {
+   if (fConcurrentFill) return ((TH2*)GetConcurrentFillShadow())->Fill(x,y);
    if (fBuffer) return BufferFill(x,y,1);
 
    Int_t binx, biny, bin;
@@ -357,6 +358,7 @@ Int_t TH2::Fill(Double_t x,Double_t y)
 
 Int_t TH2::Fill(Double_t x, Double_t y, Double_t w)
 {
+   if (fConcurrentFill) return ((TH2*)GetConcurrentFillShadow())->Fill(x,y,w);
    if (fBuffer) return BufferFill(x,y,w);
 
    Int_t binx, biny, bin;
@@ -403,6 +405,7 @@ Int_t TH2::Fill(Double_t x, Double_t y, Double_t w)
 
 Int_t TH2::Fill(const char *namex, const char *namey, Double_t w)
 {
+   if (fConcurrentFill) return ((TH2*)GetConcurrentFillShadow())->Fill(namex,namey,w);
    Int_t binx, biny, bin;
    fEntries++;
    binx = fXaxis.FindBin(namex);
@@ -445,6 +448,7 @@ Int_t TH2::Fill(const char *namex, const char *namey, Double_t w)
 
 Int_t TH2::Fill(const char *namex, Double_t y, Double_t w)
 {
+   if (fConcurrentFill) return ((TH2*)GetConcurrentFillShadow())->Fill(namex,y,w);
    Int_t binx, biny, bin;
    fEntries++;
    binx = fXaxis.FindBin(namex);
@@ -488,6 +492,7 @@ Int_t TH2::Fill(const char *namex, Double_t y, Double_t w)
 
 Int_t TH2::Fill(Double_t x, const char *namey, Double_t w)
 {
+   if (fConcurrentFill) return ((TH2*)GetConcurrentFillShadow())->Fill(x,namey,w);
    Int_t binx, biny, bin;
    fEntries++;
    binx = fXaxis.FindBin(x);
@@ -532,6 +537,10 @@ Int_t TH2::Fill(Double_t x, const char *namey, Double_t w)
 
 void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *w, Int_t stride)
 {
+   if (fConcurrentFill) {
+      ((TH2*)GetConcurrentFillShadow())->FillN(ntimes, x, y, w, stride);
+      return;
+   }
    Int_t binx, biny, bin, i;
    ntimes *= stride;
    Int_t ifirst = 0;
@@ -551,31 +560,42 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
          return;
    }
 
+   const Int_t kBlockSize = 256;
+   Int_t binsx[kBlockSize], binsy[kBlockSize];
    Double_t ww = 1;
-   for (i=ifirst;i<ntimes;i+=stride) {
-      fEntries++;
-      binx = fXaxis.FindBin(x[i]);
-      biny = fYaxis.FindBin(y[i]);
-      if (binx <0 || biny <0) continue;
-      bin  = biny*(fXaxis.GetNbins()+2) + binx;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin,ww);
-      if (binx == 0 || binx > fXaxis.GetNbins()) {
-         if (!fgStatOverflows) continue;
-      }
-      if (biny == 0 || biny > fYaxis.GetNbins()) {
-         if (!fgStatOverflows) continue;
+   // Find the bins of a block of values at once, unless an axis can be
+   // extended: an extension would invalidate the bins found for the block.
+   Bool_t canExtend = fXaxis.CanExtend() || fYaxis.CanExtend();
+   for (Int_t first = ifirst, nblock = 0; first < ntimes; first += nblock*stride) {
+      nblock = canExtend ? 1 : TMath::Min(kBlockSize, (ntimes - first + stride - 1)/stride);
+      fXaxis.FindBin(nblock, &x[first], binsx, stride);
+      fYaxis.FindBin(nblock, &y[first], binsy, stride);
+      for (Int_t k = 0; k < nblock; ++k) {
+         i = first + k*stride;
+         fEntries++;
+         binx = binsx[k];
+         biny = binsy[k];
+         if (binx <0 || biny <0) continue;
+         bin  = biny*(fXaxis.GetNbins()+2) + binx;
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > fXaxis.GetNbins()) {
+            if (!fgStatOverflows) continue;
+         }
+         if (biny == 0 || biny > fYaxis.GetNbins()) {
+            if (!fgStatOverflows) continue;
+         }
+         Double_t z= ww; //(ww > 0 ? ww : -ww);
+         fTsumw   += z;
+         fTsumw2  += z*z;
+         fTsumwx  += z*x[i];
+         fTsumwx2 += z*x[i]*x[i];
+         fTsumwy  += z*y[i];
+         fTsumwy2 += z*y[i]*y[i];
+         fTsumwxy += z*x[i]*y[i];
       }
-      Double_t z= ww; //(ww > 0 ? ww : -ww);
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
-      fTsumwy  += z*y[i];
-      fTsumwy2 += z*y[i]*y[i];
-      fTsumwxy += z*x[i]*y[i];
    }
 }
 
@@ -1128,6 +1148,7 @@ void TH2::GetRandom2(Double_t &x, Double_t &y)
 void TH2::GetStats(Double_t *stats) const
 {
    if (fBuffer) ((TH2*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH2*)this)->FlushConcurrentFill();
 
    if ((fTsumw == 0 && fEntries > 0) || fXaxis.TestBit(TAxis::kAxisRange) || fYaxis.TestBit(TAxis::kAxisRange)) {
       std::fill(stats, stats + 7, 0);
@@ -3927,3 +3948,139 @@ TH2D operator/(TH2D &h1, TH2D &h2)
    hnew.SetDirectory(0);
    return hnew;
 }
+
+
+
+//______________________________________________________________________________
+//                     TH2Compact methods
+//  TH2Compact a 2-D histogram with compact, type promoting storage (see TArrayCompact)
+//______________________________________________________________________________
+
+ClassImp(TH2Compact)
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor.
+
+TH2Compact::TH2Compact(): TH2(), TArrayCompact()
+{
+   SetBinsLength(9);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor for fix bin size 2-D histograms with compact storage.
+///
+/// The bin contents are stored in blocks of TArrayCompact::kBlockSize bins,
+/// each with the narrowest type that holds its contents: no storage for empty
+/// blocks, 8, 16 or 32 bit unsigned integers for unweighted entries and
+/// doubles for weighted or negative contents. A TH2Compact thus takes one
+/// byte per bin instead of eight for a TH2D as long as the bins of a block
+/// have less than 256 entries, without the risk of overflows of a TH2C.
+
+TH2Compact::TH2Compact(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+           ,Int_t nbinsy,Double_t ylow,Double_t yup)
+           :TH2(name,title,nbinsx,xlow,xup,nbinsy,ylow,yup)
+{
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+
+   if (xlow >= xup || ylow >= yup) SetBuffer(fgBufferSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor.
+
+TH2Compact::TH2Compact(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+           ,Int_t nbinsy,Double_t ylow,Double_t yup)
+           :TH2(name,title,nbinsx,xbins,nbinsy,ylow,yup)
+{
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor.
+
+TH2Compact::TH2Compact(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+           ,Int_t nbinsy,const Double_t *ybins)
+           :TH2(name,title,nbinsx,xlow,xup,nbinsy,ybins)
+{
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor.
+
+TH2Compact::TH2Compact(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+           ,Int_t nbinsy,const Double_t *ybins)
+           :TH2(name,title,nbinsx,xbins,nbinsy,ybins)
+{
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor.
+
+TH2Compact::TH2Compact(const char *name,const char *title,Int_t nbinsx,const Float_t *xbins
+           ,Int_t nbinsy,const Float_t *ybins)
+           :TH2(name,title,nbinsx,xbins,nbinsy,ybins)
+{
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TH2Compact::~TH2Compact()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor.
+
+TH2Compact::TH2Compact(const TH2Compact &h) : TH2(), TArrayCompact()
+{
+   ((TH2Compact&)h).Copy(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy this histogram structure to newth.
+
+void TH2Compact::Copy(TObject &newth) const
+{
+   TH2::Copy(newth);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset this histogram: contents, errors, etc.
+/// The storage of the bin contents is released.
+
+void TH2Compact::Reset(Option_t *option)
+{
+   TH2::Reset(option);
+   TArrayCompact::Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set total number of bins including under/overflow
+/// Reallocate bin contents array
+
+void TH2Compact::SetBinsLength(Int_t n)
+{
+   if (n < 0) n = (fXaxis.GetNbins()+2)*(fYaxis.GetNbins()+2);
+   fNcells = n;
+   TArrayCompact::Set(n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Operator =
+
+TH2Compact& TH2Compact::operator=(const TH2Compact &h1)
+{
+   if (this != &h1)  ((TH2Compact&)h1).Copy(*this);
+   return *this;
+}
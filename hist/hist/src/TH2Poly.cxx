@@ -11,12 +11,21 @@
  *************************************************************************/
 
 #include "TH2Poly.h"
+#include "TH2PolyIndex.h"
 #include "TMultiGraph.h"
 #include "TGraph.h"
 #include "TClass.h"
 #include "TList.h"
 #include "TMath.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
+#include <vector>
+
 ClassImp(TH2Poly)
 
 /** \class TH2Poly
@@ -56,19 +65,12 @@ histogram limits is added. This is done when the default constructor (with no
 arguments) is used. It generates a histogram with no limits along the X and Y
 axis. Adding bins to it will extend it up to a proper size.
 
-`TH2Poly` implements a partitioning algorithm to speed up bins' filling.
-The partitioning algorithm divides the histogram into regions called cells.
-The bins that each cell intersects are recorded in an array of `TList`s.
-When a coordinate in the histogram is to be filled; the method (quickly) finds
-which cell the coordinate belongs.  It then only loops over the bins
-intersecting that cell to find the bin the input coordinate corresponds to.
-The partitioning of the histogram is updated continuously as each bin is added.
-The default number of cells on each axis is 25. This number could be set to
-another value in the constructor or adjusted later by calling the
-`ChangePartition(Int_t, Int_t)` method. The partitioning algorithm is
-considerably faster than the brute force algorithm (i.e. checking if each bin
-contains the input coordinates), especially if the histogram is to be filled
-many times.
+`TH2Poly` finds the bin containing a coordinate with a spatial index (an
+R-tree over the bounding boxes of the bins), see [Spatial Index](#spatialindex).
+Many coordinates can be looked up at once with
+`FindBin(Int_t n, const Double_t *x, const Double_t *y, Int_t *bins, Int_t stride)`
+and filled with `FillN()`; with implicit multi-threading enabled
+(`ROOT::EnableImplicitMT()`) the bins of large batches are searched in parallel.
 
 The following very simple macro shows how to build and fill a `TH2Poly`:
 ~~~ {.cpp}
@@ -95,9 +97,24 @@ The following very simple macro shows how to build and fill a `TH2Poly`:
 
 More examples can bin found in `$ROOTSYS/tutorials/hist/th2poly*.C`
 
+## Spatial Index {#spatialindex}
+The bins are stored as the leaves of an R-tree: groups of up to 16 bins with
+nearby bounding boxes form the nodes of the lowest level, groups of 16 nodes
+the nodes of the next level, up to a single root. Each node records the
+bounding box of its children. To find the bin containing a coordinate, only
+the nodes whose box contains it are descended, and the polygon containment is
+tested only for the bins whose bounding box contains it. The nodes, the bins
+and the polygon vertices of `TGraph` bins are stored in contiguous arrays.
+
+The tree is built in one pass ("sort-tile-recursive" packing) by the first
+`FindBin()` or `Fill()` after bins were added, so that adding many bins stays
+cheap. The search time grows with the logarithm of the number of bins, which
+makes histograms with hundreds of thousands of bins practical.
+
 ## Partitioning Algorithm
-The partitioning algorithm forms an essential part of the `TH2Poly`
-class. It is implemented to speed up the filling of bins.
+The partition of the histogram into cells described here was used to find bins
+before the spatial index; it is kept for backward compatibility of the
+`ChangePartition()` interface and of the I/O format.
 
 With the brute force approach, the filling is done in the following way:  An
 iterator loops over all bins in the `TH2Poly` and invokes the
@@ -177,6 +194,7 @@ TH2Poly::TH2Poly(const char *name,const char *title,
 
 TH2Poly::~TH2Poly()
 {
+   delete fIndex;
    delete[] fCells;
    delete[] fIsEmpty;
    delete[] fCompletelyInside;
@@ -244,6 +262,7 @@ Int_t TH2Poly::AddBin(TObject *poly)
 
    fBins->Add((TObject*) bin);
    SetNewBinAdded(kTRUE);
+   if (fIndex) fIndex->Invalidate();
 
    // Adds the bin to the partition matrix
    AddBinToPartition(bin);
@@ -486,6 +505,9 @@ void TH2Poly::ChangePartition(Int_t n, Int_t m)
    while((obj = next())){   // Loop over bins and add them to the partition
       AddBinToPartition((TH2PolyBin*) obj);
    }
+
+   // The bins may have been changed in place: rebuild the index on next use
+   if (fIndex) fIndex->Invalidate();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -539,10 +561,37 @@ void TH2Poly::Reset(Option_t *opt)
       bin = (TH2PolyBin*) obj;
       bin->ClearContent();
    }
+   if (fIndex) fIndex->Invalidate();
 
    TH2::Reset(opt);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the overflow bin number (-1 to -9) of the given coordinate, see
+/// FindBin(). -5 means that the coordinate is within the histogram limits.
+
+Int_t TH2Poly::FindOverflow(Double_t x, Double_t y) const
+{
+   Int_t overflow = 0;
+   if      (y > fYaxis.GetXmax()) overflow += -1;
+   else if (y > fYaxis.GetXmin()) overflow += -4;
+   else                           overflow += -7;
+   if      (x > fXaxis.GetXmax()) overflow += -2;
+   else if (x > fXaxis.GetXmin()) overflow += -1;
+   return overflow;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the spatial index of the bins, building it if bins have been
+/// added since it was last built.
+
+const ROOT::Internal::TH2PolyIndex &TH2Poly::GetIndex()
+{
+   if (!fIndex) fIndex = new ROOT::Internal::TH2PolyIndex();
+   if (!fIndex->IsValid(fBins, GetNumberOfBins())) fIndex->Build(fBins, GetNumberOfBins());
+   return *fIndex;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the bin number of the bin at the given coordinate. -1 to -9 are
 /// the overflow and underflow bins.  overflow bin -5 is the unbinned areas in
@@ -560,46 +609,54 @@ void TH2Poly::Reset(Option_t *opt)
 
 Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
 {
-
    // Checks for overflow/underflow
-   Int_t overflow = 0;
-   if      (y > fYaxis.GetXmax()) overflow += -1;
-   else if (y > fYaxis.GetXmin()) overflow += -4;
-   else                           overflow += -7;
-   if      (x > fXaxis.GetXmax()) overflow += -2;
-   else if (x > fXaxis.GetXmin()) overflow += -1;
+   Int_t overflow = FindOverflow(x, y);
    if (overflow != -5) return overflow;
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) return -5;
-
-   TH2PolyBin *bin;
+   // If the search does not return a bin, the point must be on "the sea"
+   TH2PolyBin *bin = GetIndex().FindBin(x, y);
+   return bin ? bin->GetBinNumber() : -5;
+}
 
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
+////////////////////////////////////////////////////////////////////////////////
+/// Sets bins[i] to the bin number at (x[i*stride], y[i*stride]) for i < n,
+/// as returned by FindBin(Double_t, Double_t, Double_t).
+/// With implicit multi-threading enabled, large batches are searched in
+/// parallel.
 
-   // Search for the bin in the cell
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
+void TH2Poly::FindBin(Int_t n, const Double_t *x, const Double_t *y, Int_t *bins, Int_t stride)
+{
+   // The index must be built before it is shared by the tasks.
+   const ROOT::Internal::TH2PolyIndex &index = GetIndex();
+   auto findRange = [&](Int_t first, Int_t last) {
+      for (Int_t i = first; i < last; ++i) {
+         Double_t xi = x[(Long64_t)i * stride];
+         Double_t yi = y[(Long64_t)i * stride];
+         Int_t overflow = FindOverflow(xi, yi);
+         if (overflow != -5) {
+            bins[i] = overflow;
+         } else {
+            TH2PolyBin *bin = index.FindBin(xi, yi);
+            bins[i] = bin ? bin->GetBinNumber() : -5;
+         }
+      }
+   };
+#ifdef R__USE_IMT
+   const Int_t kMinPerTask = 1024;
+   if (ROOT::IsImplicitMTEnabled() && n >= 2 * kMinPerTask) {
+      const Int_t ntasks = std::min<Int_t>(n / kMinPerTask, 4 * ROOT::GetImplicitMTPoolSize());
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t itask) { findRange((Long64_t)n * itask / ntasks, (Long64_t)n * (itask + 1) / ntasks); },
+                   ROOT::TSeq<Int_t>(0, ntasks));
+      return;
    }
-
-   // If the search has not returned a bin, the point must be on "the sea"
-   return -5;
+#endif
+   findRange(0, n);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by 1.
-/// Uses the partitioning algorithm.
+/// Uses the spatial index.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y)
 {
@@ -608,70 +665,41 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by w.
-/// Uses the partitioning algorithm.
+/// Uses the spatial index.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
 {
    if (fNcells <= kNOverflow) return 0;
-   Int_t overflow = 0;
-   if      (y > fYaxis.GetXmax()) overflow += -1;
-   else if (y > fYaxis.GetXmin()) overflow += -4;
-   else                           overflow += -7;
-   if      (x > fXaxis.GetXmax()) overflow += -2;
-   else if(x > fXaxis.GetXmin())  overflow += -1;
-   if (overflow != -5) {
-      fOverflow[-overflow - 1]+= w;
-      if (fSumw2.fN) fSumw2.fArray[-overflow - 1] += w*w;
-      return overflow;
-   }
+   return DoFill(FindBin(x, y), x, y, w);
+}
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
+////////////////////////////////////////////////////////////////////////////////
+/// Increment bin number bin, as returned by FindBin() for (x,y), by w.
+/// The spatial index must be up to date.
 
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) {
-      fOverflow[4]+= w;
-      if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-      return -5;
+Int_t TH2Poly::DoFill(Int_t bin, Double_t x, Double_t y, Double_t w)
+{
+   if (bin < 0) {
+      fOverflow[-bin - 1]+= w;
+      if (fSumw2.fN) fSumw2.fArray[-bin - 1] += w*w;
+      return bin;
    }
 
-   TH2PolyBin *bin;
-   Int_t bi;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
+   fIndex->GetBin(bin)->Fill(w);
 
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      // needs to account offset in array for overflow bins
-      bi = bin->GetBinNumber()-1+kNOverflow;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
-
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) fSumw2.fArray[bi] += w*w;
-         fEntries++;
-
-         SetBinContentChanged(kTRUE);
+   // Statistics
+   fTsumw   = fTsumw + w;
+   fTsumwx  = fTsumwx + w*x;
+   fTsumwx2 = fTsumwx2 + w*x*x;
+   fTsumwy  = fTsumwy + w*y;
+   fTsumwy2 = fTsumwy2 + w*y*y;
+   // needs to account offset in array for overflow bins
+   if (fSumw2.fN) fSumw2.fArray[bin - 1 + kNOverflow] += w*w;
+   fEntries++;
 
-         return bin->GetBinNumber();
-      }
-   }
+   SetBinContentChanged(kTRUE);
 
-   fOverflow[4]+= w;
-   if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-   return -5;
+   return bin;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -705,14 +733,28 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights, or 0 for unit weights
 /// \param [in] stride:  step size through arrays x, y and w
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
-   for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+   if (fNcells <= kNOverflow || ntimes <= 0) return;
+   Int_t n = (ntimes + stride - 1) / stride;
+   // Derived classes (e.g. TProfile2Poly) may fill differently: use their Fill.
+   if (IsA() != TH2Poly::Class()) {
+      for (Int_t i = 0; i < n; ++i) {
+         Long64_t j = (Long64_t)i * stride;
+         Fill(x[j], y[j], w ? w[j] : 1.);
+      }
+      return;
+   }
+   // The bins are searched for all entries at once, possibly in parallel.
+   std::vector<Int_t> bins(n);
+   FindBin(n, x, y, bins.data(), stride);
+   for (Int_t i = 0; i < n; ++i) {
+      Long64_t j = (Long64_t)i * stride;
+      DoFill(bins[i], x[j], y[j], w ? w[j] : 1.);
    }
 }
 
@@ -959,6 +1001,7 @@ void TH2Poly::Initialize(Double_t xlow, Double_t xup,
 
    fBins   = 0;
    fNcells = kNOverflow;
+   fIndex  = 0;
 
    // Sets the boundaries of the histogram
    fXaxis.Set(100, xlow, xup);
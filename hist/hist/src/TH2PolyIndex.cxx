@@ -0,0 +1,181 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TH2PolyIndex.h"
+
+#include "TGraph.h"
+#include "TH2Poly.h"
+#include "TList.h"
+#include "TMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+const UInt_t kNodeSize = 16; // maximal number of children of a node
+const UInt_t kMaxDepth = 8;  // kNodeSize**kMaxDepth leaves are enough for any TH2Poly
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the order in which the boxes are packed into nodes, following the
+/// sort-tile-recursive algorithm: the boxes are sorted by x into vertical
+/// slices, each slice is sorted by y, and each run of kNodeSize consecutive
+/// boxes becomes a node. This keeps the nodes compact and overlapping little.
+
+template <class BOX>
+static std::vector<UInt_t> TileOrder(const std::vector<BOX> &boxes)
+{
+   const UInt_t n = boxes.size();
+   std::vector<UInt_t> order(n);
+   std::iota(order.begin(), order.end(), 0);
+   std::sort(order.begin(), order.end(), [&boxes](UInt_t a, UInt_t b) {
+      return boxes[a].fXmin + boxes[a].fXmax < boxes[b].fXmin + boxes[b].fXmax;
+   });
+   const UInt_t nNodes = (n + kNodeSize - 1) / kNodeSize;
+   const UInt_t nSlices = (UInt_t)std::ceil(std::sqrt((Double_t)nNodes));
+   const UInt_t sliceSize = (nNodes + nSlices - 1) / nSlices * kNodeSize;
+   for (UInt_t first = 0; first < n; first += sliceSize) {
+      std::sort(order.begin() + first, order.begin() + std::min(first + sliceSize, n), [&boxes](UInt_t a, UInt_t b) {
+         return boxes[a].fYmin + boxes[a].fYmax < boxes[b].fYmin + boxes[b].fYmax;
+      });
+   }
+   return order;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the index of the nbins bins in the list. The bins are the leaves of
+/// an R-tree over their bounding boxes, packed bottom-up; the nodes, the bins
+/// and the vertices of the TGraph polygons are stored contiguously.
+
+void TH2PolyIndex::Build(const TList *bins, Int_t nbins)
+{
+   fBinList = bins;
+   fNBins = nbins;
+   fEntries.clear();
+   fNodes.clear();
+   fNLeaves = 0;
+   fX.clear();
+   fY.clear();
+   fBins.assign(nbins > 0 ? nbins : 0, nullptr);
+   if (!bins || nbins <= 0)
+      return;
+
+   std::vector<Entry_t> entries;
+   std::vector<Box_t> boxes;
+   entries.reserve(nbins);
+   boxes.reserve(nbins);
+   TIter next(bins);
+   while (TH2PolyBin *bin = (TH2PolyBin *)next()) {
+      Entry_t entry;
+      entry.fBox = {bin->GetXMin(), bin->GetYMin(), bin->GetXMax(), bin->GetYMax()};
+      entry.fBin = bin;
+      entry.fNumber = bin->GetBinNumber();
+      entry.fFirst = fX.size();
+      entry.fNVertices = -1;
+      if (bin->GetPolygon()->IsA() == TGraph::Class()) {
+         TGraph *g = (TGraph *)bin->GetPolygon();
+         fX.insert(fX.end(), g->GetX(), g->GetX() + g->GetN());
+         fY.insert(fY.end(), g->GetY(), g->GetY() + g->GetN());
+         entry.fNVertices = g->GetN();
+      }
+      if (entry.fNumber >= 1 && entry.fNumber <= nbins)
+         fBins[entry.fNumber - 1] = bin;
+      entries.push_back(entry);
+      boxes.push_back(entry.fBox);
+   }
+
+   // The leaves.
+   for (UInt_t i : TileOrder(boxes))
+      fEntries.push_back(entries[i]);
+   for (UInt_t first = 0; first < fEntries.size(); first += kNodeSize) {
+      Node_t node{fEntries[first].fBox, first, std::min<UInt_t>(kNodeSize, fEntries.size() - first)};
+      for (UInt_t i = first + 1; i < first + node.fCount; ++i) {
+         const Box_t &box = fEntries[i].fBox;
+         node.fBox = {std::min(node.fBox.fXmin, box.fXmin), std::min(node.fBox.fYmin, box.fYmin),
+                      std::max(node.fBox.fXmax, box.fXmax), std::max(node.fBox.fYmax, box.fYmax)};
+      }
+      fNodes.push_back(node);
+   }
+   fNLeaves = fNodes.size();
+
+   // The upper levels, until a single root is left.
+   UInt_t levelBegin = 0;
+   UInt_t levelEnd = fNodes.size();
+   while (levelEnd - levelBegin > 1) {
+      boxes.clear();
+      for (UInt_t i = levelBegin; i < levelEnd; ++i)
+         boxes.push_back(fNodes[i].fBox);
+      std::vector<Node_t> level;
+      for (UInt_t i : TileOrder(boxes))
+         level.push_back(fNodes[levelBegin + i]);
+      std::copy(level.begin(), level.end(), fNodes.begin() + levelBegin);
+      for (UInt_t first = levelBegin; first < levelEnd; first += kNodeSize) {
+         Node_t node{fNodes[first].fBox, first, std::min(kNodeSize, levelEnd - first)};
+         for (UInt_t i = first + 1; i < first + node.fCount; ++i) {
+            const Box_t &box = fNodes[i].fBox;
+            node.fBox = {std::min(node.fBox.fXmin, box.fXmin), std::min(node.fBox.fYmin, box.fYmin),
+                         std::max(node.fBox.fXmax, box.fXmax), std::max(node.fBox.fYmax, box.fYmax)};
+         }
+         fNodes.push_back(node);
+      }
+      levelBegin = levelEnd;
+      levelEnd = fNodes.size();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the bin containing (x,y), 0 if there is none. If several bins
+/// contain it, the one with the lowest bin number is returned, as TH2Poly
+/// fills the first matching bin it was given.
+/// Can be called concurrently.
+
+TH2PolyBin *TH2PolyIndex::FindBin(Double_t x, Double_t y) const
+{
+   if (fNodes.empty())
+      return nullptr;
+   const Entry_t *found = nullptr;
+   UInt_t stack[kNodeSize * kMaxDepth];
+   Int_t top = 0;
+   stack[top++] = fNodes.size() - 1;
+   while (top) {
+      UInt_t inode = stack[--top];
+      const Node_t &node = fNodes[inode];
+      if (!node.fBox.Contains(x, y))
+         continue;
+      if (inode >= fNLeaves) {
+         for (UInt_t i = 0; i < node.fCount; ++i)
+            stack[top++] = node.fFirst + i;
+         continue;
+      }
+      for (UInt_t i = node.fFirst; i < node.fFirst + node.fCount; ++i) {
+         const Entry_t &entry = fEntries[i];
+         if ((found && entry.fNumber > found->fNumber) || !entry.fBox.Contains(x, y))
+            continue;
+         Bool_t inside;
+         if (entry.fNVertices >= 0)
+            inside = TMath::IsInside(x, y, entry.fNVertices, const_cast<Double_t *>(fX.data() + entry.fFirst),
+                                     const_cast<Double_t *>(fY.data() + entry.fFirst));
+         else
+            inside = entry.fBin->IsInside(x, y);
+         if (inside)
+            found = &entry;
+      }
+   }
+   return found ? found->fBin : nullptr;
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,67 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Spatial index of the bins of a TH2Poly (see TH2Poly::FindBin)
+
+#ifndef ROOT_TH2PolyIndex
+#define ROOT_TH2PolyIndex
+
+#include "RtypesCore.h"
+
+#include <vector>
+
+class TH2PolyBin;
+class TList;
+
+namespace ROOT {
+namespace Internal {
+
+class TH2PolyIndex {
+private:
+   struct Box_t {
+      Double_t fXmin, fYmin, fXmax, fYmax;
+      Bool_t Contains(Double_t x, Double_t y) const { return x >= fXmin && x <= fXmax && y >= fYmin && y <= fYmax; }
+   };
+   struct Node_t {
+      Box_t fBox;    // bounding box of the children
+      UInt_t fFirst; // index of the first child, in fNodes or (for leaves) in fEntries
+      UInt_t fCount; // number of children
+   };
+   struct Entry_t {
+      Box_t fBox;        // bounding box of the bin
+      TH2PolyBin *fBin;  // the bin
+      Int_t fNumber;     // its bin number
+      UInt_t fFirst;     // index of its first vertex in fX, fY
+      Int_t fNVertices;  // number of vertices, -1 if the bin is not a TGraph
+   };
+
+   const TList *fBinList = nullptr;   // list of bins the index was built from
+   Int_t fNBins = 0;                  // number of bins when the index was built
+   std::vector<Entry_t> fEntries;     // bins, ordered such that the bins of a leaf are contiguous
+   std::vector<Node_t> fNodes;        // leaves first, then the upper levels, the root last
+   UInt_t fNLeaves = 0;               // number of leaves at the beginning of fNodes
+   std::vector<Double_t> fX;          // x coordinates of the polygons of all TGraph bins
+   std::vector<Double_t> fY;          // y coordinates of the polygons of all TGraph bins
+   std::vector<TH2PolyBin *> fBins;   // bins by bin number - 1
+
+public:
+   /// Only the bin list and the number of bins are checked: the owner must call
+   /// Invalidate() when the bins are changed in another way.
+   Bool_t IsValid(const TList *bins, Int_t nbins) const { return bins == fBinList && nbins == fNBins; }
+   void Invalidate() { fBinList = nullptr; fNBins = 0; }
+   void Build(const TList *bins, Int_t nbins);
+   TH2PolyBin *FindBin(Double_t x, Double_t y) const;
+   TH2PolyBin *GetBin(Int_t bin) const { return fBins[bin - 1]; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -292,6 +292,7 @@ Int_t TH3::Fill(Double_t )
 
 Int_t TH3::Fill(Double_t x, Double_t y, Double_t z)
 {
+   if (fConcurrentFill) return ((TH3*)GetConcurrentFillShadow())->Fill(x,y,z);
    if (fBuffer) return BufferFill(x,y,z,1);
 
    Int_t binx, biny, binz, bin;
@@ -340,6 +341,7 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z)
 
 Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 {
+   if (fConcurrentFill) return ((TH3*)GetConcurrentFillShadow())->Fill(x,y,z,w);
    if (fBuffer) return BufferFill(x,y,z,w);
 
    Int_t binx, biny, binz, bin;
@@ -376,6 +378,91 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+/// \param[in] ntimes number of entries in arrays x, y, z and w (if w is non zero)
+/// \param[in] x array of x values to be histogrammed
+/// \param[in] y array of y values to be histogrammed
+/// \param[in] z array of z values to be histogrammed
+/// \param[in] w array of weights
+/// \param[in] stride step size through arrays x, y, z and w
+///
+/// The bins of blocks of values are found at once with TAxis::FindBin(Int_t,
+/// const Double_t*, Int_t*, Int_t), which is faster than filling the values
+/// one by one with Fill().
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   if (fConcurrentFill) {
+      ((TH3*)GetConcurrentFillShadow())->FillN(ntimes, x, y, z, w, stride);
+      return;
+   }
+   Int_t binx, biny, binz, bin, i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         if (w) BufferFill(x[i],y[i],z[i],w[i]);
+         else BufferFill(x[i], y[i], z[i], 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   const Int_t kBlockSize = 256;
+   Int_t binsx[kBlockSize], binsy[kBlockSize], binsz[kBlockSize];
+   Double_t ww = 1;
+   // Find the bins of a block of values at once, unless an axis can be
+   // extended: an extension would invalidate the bins found for the block.
+   Bool_t canExtend = fXaxis.CanExtend() || fYaxis.CanExtend() || fZaxis.CanExtend();
+   for (Int_t first = ifirst, nblock = 0; first < ntimes; first += nblock*stride) {
+      nblock = canExtend ? 1 : TMath::Min(kBlockSize, (ntimes - first + stride - 1)/stride);
+      fXaxis.FindBin(nblock, &x[first], binsx, stride);
+      fYaxis.FindBin(nblock, &y[first], binsy, stride);
+      fZaxis.FindBin(nblock, &z[first], binsz, stride);
+      for (Int_t k = 0; k < nblock; ++k) {
+         i = first + k*stride;
+         fEntries++;
+         binx = binsx[k];
+         biny = binsy[k];
+         binz = binsz[k];
+         if (binx <0 || biny <0 || binz<0) continue;
+         bin  =  binx + (fXaxis.GetNbins()+2)*(biny + (fYaxis.GetNbins()+2)*binz);
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();   // must be called before AddBinContent
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > fXaxis.GetNbins()) {
+            if (!fgStatOverflows) continue;
+         }
+         if (biny == 0 || biny > fYaxis.GetNbins()) {
+            if (!fgStatOverflows) continue;
+         }
+         if (binz == 0 || binz > fZaxis.GetNbins()) {
+            if (!fgStatOverflows) continue;
+         }
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*x[i];
+         fTsumwx2 += ww*x[i]*x[i];
+         fTsumwy  += ww*y[i];
+         fTsumwy2 += ww*y[i]*y[i];
+         fTsumwxy += ww*x[i]*y[i];
+         fTsumwz  += ww*z[i];
+         fTsumwz2 += ww*z[i]*z[i];
+         fTsumwxz += ww*x[i]*z[i];
+         fTsumwyz += ww*y[i]*z[i];
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
@@ -387,6 +474,7 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 
 Int_t TH3::Fill(const char *namex, const char *namey, const char *namez, Double_t w)
 {
+   if (fConcurrentFill) return ((TH3*)GetConcurrentFillShadow())->Fill(namex,namey,namez,w);
    Int_t binx, biny, binz, bin;
    fEntries++;
    binx = fXaxis.FindBin(namex);
@@ -430,6 +518,7 @@ Int_t TH3::Fill(const char *namex, const char *namey, const char *namez, Double_
 
 Int_t TH3::Fill(const char *namex, Double_t y, const char *namez, Double_t w)
 {
+   if (fConcurrentFill) return ((TH3*)GetConcurrentFillShadow())->Fill(namex,y,namez,w);
    Int_t binx, biny, binz, bin;
    fEntries++;
    binx = fXaxis.FindBin(namex);
@@ -474,6 +563,7 @@ Int_t TH3::Fill(const char *namex, Double_t y, const char *namez, Double_t w)
 
 Int_t TH3::Fill(const char *namex, const char *namey, Double_t z, Double_t w)
 {
+   if (fConcurrentFill) return ((TH3*)GetConcurrentFillShadow())->Fill(namex,namey,z,w);
    Int_t binx, biny, binz, bin;
    fEntries++;
    binx = fXaxis.FindBin(namex);
@@ -518,6 +608,7 @@ Int_t TH3::Fill(const char *namex, const char *namey, Double_t z, Double_t w)
 
 Int_t TH3::Fill(Double_t x, const char *namey, const char *namez, Double_t w)
 {
+   if (fConcurrentFill) return ((TH3*)GetConcurrentFillShadow())->Fill(x,namey,namez,w);
    Int_t binx, biny, binz, bin;
    fEntries++;
    binx = fXaxis.FindBin(x);
@@ -562,6 +653,7 @@ Int_t TH3::Fill(Double_t x, const char *namey, const char *namez, Double_t w)
 
 Int_t TH3::Fill(Double_t x, const char *namey, Double_t z, Double_t w)
 {
+   if (fConcurrentFill) return ((TH3*)GetConcurrentFillShadow())->Fill(x,namey,z,w);
    Int_t binx, biny, binz, bin;
    fEntries++;
    binx = fXaxis.FindBin(x);
@@ -607,6 +699,7 @@ Int_t TH3::Fill(Double_t x, const char *namey, Double_t z, Double_t w)
 
 Int_t TH3::Fill(Double_t x, Double_t y, const char *namez, Double_t w)
 {
+   if (fConcurrentFill) return ((TH3*)GetConcurrentFillShadow())->Fill(x,y,namez,w);
    Int_t binx, biny, binz, bin;
    fEntries++;
    binx = fXaxis.FindBin(x);
@@ -1136,6 +1229,7 @@ void TH3::GetRandom3(Double_t &x, Double_t &y, Double_t &z)
 void TH3::GetStats(Double_t *stats) const
 {
    if (fBuffer) ((TH3*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TH3*)this)->FlushConcurrentFill();
 
    Int_t bin, binx, biny, binz;
    Double_t w,err;
@@ -4369,3 +4463,118 @@ TH3D operator/(TH3D &h1, TH3D &h2)
    hnew.SetDirectory(0);
    return hnew;
 }
+
+
+
+//______________________________________________________________________________
+//                     TH3Compact methods
+//  TH3Compact a 3-D histogram with compact, type promoting storage (see TArrayCompact)
+//______________________________________________________________________________
+
+ClassImp(TH3Compact)
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor.
+
+TH3Compact::TH3Compact(): TH3(), TArrayCompact()
+{
+   SetBinsLength(27);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for fix bin size 3-D histograms with compact storage.
+///
+/// The bin contents are stored in blocks of TArrayCompact::kBlockSize bins,
+/// each with the narrowest type that holds its contents: no storage for empty
+/// blocks, 8, 16 or 32 bit unsigned integers for unweighted entries and
+/// doubles for weighted or negative contents, see TArrayCompact.
+
+TH3Compact::TH3Compact(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+           ,Int_t nbinsy,Double_t ylow,Double_t yup
+           ,Int_t nbinsz,Double_t zlow,Double_t zup)
+           :TH3(name,title,nbinsx,xlow,xup,nbinsy,ylow,yup,nbinsz,zlow,zup)
+{
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+
+   if (xlow >= xup || ylow >= yup || zlow >= zup) SetBuffer(fgBufferSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for variable bin size 3-D histograms with compact storage.
+
+TH3Compact::TH3Compact(const char *name,const char *title,Int_t nbinsx,const Float_t *xbins
+           ,Int_t nbinsy,const Float_t *ybins
+           ,Int_t nbinsz,const Float_t *zbins)
+           :TH3(name,title,nbinsx,xbins,nbinsy,ybins,nbinsz,zbins)
+{
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for variable bin size 3-D histograms with compact storage.
+
+TH3Compact::TH3Compact(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+           ,Int_t nbinsy,const Double_t *ybins
+           ,Int_t nbinsz,const Double_t *zbins)
+           :TH3(name,title,nbinsx,xbins,nbinsy,ybins,nbinsz,zbins)
+{
+   TArrayCompact::Set(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TH3Compact::~TH3Compact()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor.
+
+TH3Compact::TH3Compact(const TH3Compact &h) : TH3(), TArrayCompact()
+{
+   ((TH3Compact&)h).Copy(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy this histogram structure to newth.
+
+void TH3Compact::Copy(TObject &newth) const
+{
+   TH3::Copy(newth);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset this histogram: contents, errors, etc.
+/// The storage of the bin contents is released.
+
+void TH3Compact::Reset(Option_t *option)
+{
+   TH3::Reset(option);
+   TArrayCompact::Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set total number of bins including under/overflow
+/// Reallocate bin contents array
+
+void TH3Compact::SetBinsLength(Int_t n)
+{
+   if (n < 0) n = (fXaxis.GetNbins()+2)*(fYaxis.GetNbins()+2)*(fZaxis.GetNbins()+2);
+   fNcells = n;
+   TArrayCompact::Set(n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Operator =
+
+TH3Compact& TH3Compact::operator=(const TH3Compact &h1)
+{
+   if (this != &h1)  ((TH3Compact&)h1).Copy(*this);
+   return *this;
+}
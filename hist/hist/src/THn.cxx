@@ -13,6 +13,13 @@
 
 #include "TClass.h"
 
+#include <algorithm>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 namespace {
    //______________________________________________________________________________
    //
@@ -222,6 +229,52 @@ void THn::Sumw2() {
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add c * h to this histogram if h is a THn with the same binning, see
+/// THnBase::Add(). Return kFALSE if h is not a THn.
+/// The bins are added in their linear order, without iterating over their
+/// coordinates, in parallel (one task per range of bins) if implicit
+/// multi-threading is enabled.
+
+Bool_t THn::AddSameBinning(const THnBase* h, Double_t c)
+{
+   const THn* hn = dynamic_cast<const THn*>(h);
+   const Long64_t nbins = GetNbins();
+   if (!hn || hn->GetNbins() != nbins)
+      return kFALSE;
+
+   if (!GetCalculateErrors() && hn->GetCalculateErrors())
+      Sumw2();
+   const Bool_t haveErrors = GetCalculateErrors();
+   const TNDArray& from = hn->GetArray();
+   TNDArray& to = GetArray();
+   // Allocate the storage before it is used concurrently.
+   to.AddAt(0, 0.);
+   if (haveErrors)
+      fSumw2.AddAt(0, 0.);
+
+   auto addRange = [&](Long64_t first, Long64_t last) {
+      for (Long64_t i = first; i < last; ++i) {
+         if (haveErrors)
+            fSumw2.At(i) += c * c * hn->GetBinError2(i);
+         // only _after_ error calculation, or sqrt(v) is taken into account!
+         to.AddAt(i, c * from.AtAsDouble(i));
+      }
+   };
+
+   const Long64_t chunkSize = 1 << 16;
+   const Long64_t nchunks = (nbins + chunkSize - 1) / chunkSize;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t ichunk) { addRange(ichunk * chunkSize, std::min(nbins, (ichunk + 1) * chunkSize)); },
+                   ROOT::TSeq<Int_t>(0, nchunks));
+   } else
+#endif
+   addRange(0, nbins);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create the coordinate buffer. Outlined to hide allocation
 /// from inlined functions.
@@ -32,6 +32,13 @@
 #include "Math/MinimizerOptions.h"
 #include "Math/WrappedMultiTF1.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <vector>
+
 
 /** \class THnBase
     \ingroup Hist
@@ -520,61 +527,65 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    Bool_t haveErrors = GetCalculateErrors();
    Bool_t wantErrors = haveErrors || (option && (strchr(option, 'E') || strchr(option, 'e')));
 
-   Int_t* bins  = new Int_t[ndim];
-   Long64_t myLinBin = 0;
+   Bool_t haveSkippedBin = kFALSE;
+   if (wantNDim || !ProjectionParallel(hist, ndim, dim, keepTargetAxis, wantErrors, haveSkippedBin)) {
+      Int_t* bins  = new Int_t[ndim];
+      Long64_t myLinBin = 0;
 
-   THnIter iter(this, kTRUE /*use axis range*/);
+      THnIter iter(this, kTRUE /*use axis range*/);
 
-   while ((myLinBin = iter.Next()) >= 0) {
-      Double_t v = GetBinContent(myLinBin);
+      while ((myLinBin = iter.Next()) >= 0) {
+         Double_t v = GetBinContent(myLinBin);
 
-      for (Int_t d = 0; d < ndim; ++d) {
-         bins[d] = iter.GetCoord(dim[d]);
-         if (!keepTargetAxis && GetAxis(dim[d])->TestBit(TAxis::kAxisRange)) {
-            Int_t binOffset = GetAxis(dim[d])->GetFirst();
-            // Don't subtract even more if underflow is alreday included:
-            if (binOffset > 0) --binOffset;
-            bins[d] -= binOffset;
+         for (Int_t d = 0; d < ndim; ++d) {
+            bins[d] = iter.GetCoord(dim[d]);
+            if (!keepTargetAxis && GetAxis(dim[d])->TestBit(TAxis::kAxisRange)) {
+               Int_t binOffset = GetAxis(dim[d])->GetFirst();
+               // Don't subtract even more if underflow is alreday included:
+               if (binOffset > 0) --binOffset;
+               bins[d] -= binOffset;
+            }
          }
-      }
 
-      Long64_t targetLinBin = -1;
-      if (!wantNDim) {
-         if (ndim == 1) targetLinBin = bins[0];
-         else if (ndim == 2) targetLinBin = hist->GetBin(bins[0], bins[1]);
-         else if (ndim == 3) targetLinBin = hist->GetBin(bins[0], bins[1], bins[2]);
-      } else {
-         targetLinBin = hn->GetBin(bins, kTRUE /*allocate*/);
-      }
-
-      if (wantErrors) {
-         Double_t err2 = 0.;
-         if (haveErrors) {
-            err2 = GetBinError2(myLinBin);
+         Long64_t targetLinBin = -1;
+         if (!wantNDim) {
+            if (ndim == 1) targetLinBin = bins[0];
+            else if (ndim == 2) targetLinBin = hist->GetBin(bins[0], bins[1]);
+            else if (ndim == 3) targetLinBin = hist->GetBin(bins[0], bins[1], bins[2]);
          } else {
-            err2 = v;
+            targetLinBin = hn->GetBin(bins, kTRUE /*allocate*/);
          }
-         if (wantNDim) {
-            hn->AddBinError2(targetLinBin, err2);
-         } else {
-            Double_t preverr = hist->GetBinError(targetLinBin);
-            hist->SetBinError(targetLinBin, TMath::Sqrt(preverr * preverr + err2));
+
+         if (wantErrors) {
+            Double_t err2 = 0.;
+            if (haveErrors) {
+               err2 = GetBinError2(myLinBin);
+            } else {
+               err2 = v;
+            }
+            if (wantNDim) {
+               hn->AddBinError2(targetLinBin, err2);
+            } else {
+               Double_t preverr = hist->GetBinError(targetLinBin);
+               hist->SetBinError(targetLinBin, TMath::Sqrt(preverr * preverr + err2));
+            }
          }
+
+         // only _after_ error calculation, or sqrt(v) is taken into account!
+         if (wantNDim)
+            hn->AddBinContent(targetLinBin, v);
+         else
+            hist->AddBinContent(targetLinBin, v);
       }
 
-      // only _after_ error calculation, or sqrt(v) is taken into account!
-      if (wantNDim)
-         hn->AddBinContent(targetLinBin, v);
-      else
-         hist->AddBinContent(targetLinBin, v);
+      haveSkippedBin = iter.HaveSkippedBin();
+      delete [] bins;
    }
 
-   delete [] bins;
-
    if (wantNDim) {
       hn->SetEntries(fEntries);
    } else {
-      if (!iter.HaveSkippedBin()) {
+      if (!haveSkippedBin) {
          hist->SetEntries(fEntries);
       } else {
          // re-compute the entries
@@ -602,6 +613,101 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Parallel implementation of ProjectionAny() into the TH1/2/3 "hist", used
+/// for large THnSparse if implicit multi-threading is enabled (see
+/// ROOT::EnableImplicitMT()). Each task projects a range of the filled bins
+/// into its own array of target bins; these arrays are summed up into hist.
+/// Return kFALSE (without touching hist) if the projection should be done
+/// sequentially, i.e. for small histograms or for targets with so many
+/// bins that summing up the per-task arrays would cost more than it saves.
+
+Bool_t THnBase::ProjectionParallel(TH1* hist, Int_t ndim, const Int_t* dim, Bool_t keepTargetAxis,
+                                   Bool_t wantErrors, Bool_t& haveSkippedBin) const
+{
+#ifdef R__USE_IMT
+   const Long64_t kMinBinsParallel = 100000;
+   const Long64_t nbins = GetNbins();
+   if (!ROOT::IsImplicitMTEnabled() || nbins < kMinBinsParallel || !InheritsFrom(THnSparse::Class()))
+      return kFALSE;
+   const Int_t ncells = hist->GetNcells();
+   const Int_t ntasks = 4 * ROOT::GetImplicitMTPoolSize();
+   if ((Long64_t)ncells * ntasks > nbins)
+      return kFALSE;
+
+   Int_t offset[3] = {0, 0, 0};
+   for (Int_t d = 0; d < ndim; ++d) {
+      if (!keepTargetAxis && GetAxis(dim[d])->TestBit(TAxis::kAxisRange)) {
+         offset[d] = GetAxis(dim[d])->GetFirst();
+         // Don't subtract even more if underflow is alreday included:
+         if (offset[d] > 0) --offset[d];
+      }
+   }
+   const Bool_t haveErrors = GetCalculateErrors();
+
+   // Decoding the bin coordinates needs the lazily created compact
+   // coordinate object; create it before the tasks start.
+   std::vector<Int_t> coord(fNdimensions);
+   GetBinContent(0, coord.data());
+
+   std::vector<std::vector<Double_t>> content(ntasks);
+   std::vector<std::vector<Double_t>> error2(ntasks);
+   std::vector<char> skipped(ntasks, 0);
+   const Long64_t binsPerTask = (nbins + ntasks - 1) / ntasks;
+   auto project = [&](Int_t task) {
+      content[task].assign(ncells, 0.);
+      if (wantErrors)
+         error2[task].assign(ncells, 0.);
+      std::vector<Int_t> taskCoord(fNdimensions);
+      Int_t bins[3] = {0, 0, 0};
+      const Long64_t last = TMath::Min(nbins, (task + 1) * binsPerTask);
+      for (Long64_t i = task * binsPerTask; i < last; ++i) {
+         Double_t v = GetBinContent(i, taskCoord.data());
+         if (!IsInRange(taskCoord.data())) {
+            skipped[task] = 1;
+            continue;
+         }
+         for (Int_t d = 0; d < ndim; ++d)
+            bins[d] = taskCoord[dim[d]] - offset[d];
+         Int_t targetLinBin = bins[0];
+         if (ndim == 2) targetLinBin = hist->GetBin(bins[0], bins[1]);
+         else if (ndim == 3) targetLinBin = hist->GetBin(bins[0], bins[1], bins[2]);
+
+         content[task][targetLinBin] += v;
+         if (wantErrors)
+            error2[task][targetLinBin] += haveErrors ? GetBinError2(i) : v;
+      }
+   };
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(project, ROOT::TSeq<Int_t>(0, ntasks));
+
+   for (Int_t task = 1; task < ntasks; ++task) {
+      for (Int_t bin = 0; bin < ncells; ++bin) {
+         content[0][bin] += content[task][bin];
+         if (wantErrors)
+            error2[0][bin] += error2[task][bin];
+      }
+      if (skipped[task])
+         skipped[0] = 1;
+   }
+   haveSkippedBin = skipped[0];
+
+   if (wantErrors) {
+      for (Int_t bin = 0; bin < ncells; ++bin)
+         if (error2[0][bin])
+            hist->SetBinError(bin, TMath::Sqrt(error2[0][bin]));
+   }
+   // only _after_ error calculation, or sqrt(v) is taken into account!
+   for (Int_t bin = 0; bin < ncells; ++bin)
+      if (content[0][bin])
+         hist->AddBinContent(bin, content[0][bin]);
+   return kTRUE;
+#else
+   (void) hist; (void) ndim; (void) dim; (void) keepTargetAxis; (void) wantErrors; (void) haveSkippedBin;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Scale contents and errors of this histogram by c:
 /// this = this * c
@@ -638,6 +744,12 @@ void THnBase::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
       return;
    }
 
+   // Histograms with the same binning might have a faster way
+   if (!rebinned && AddSameBinning(h, c)) {
+      SetEntries(GetEntries() + c * h->GetEntries());
+      return;
+   }
+
    // Trigger error calculation if h has it
    if (!GetCalculateErrors() && h->GetCalculateErrors())
       Sumw2();
@@ -649,7 +761,7 @@ void THnBase::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
    }
    Int_t* coord = new Int_t[fNdimensions];
 
-   // Expand the exmap if needed, to reduce collisions
+   // Reserve the bins' storage if needed, to reduce rehashing
    Long64_t numTargetBins = GetNbins() + h->GetNbins();
    Reserve(numTargetBins);
 
@@ -747,6 +859,17 @@ Long64_t THnBase::Merge(TCollection* list)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram with "ntimes" entries: x contains the "ntimes" points,
+/// each given by GetNdimensions() consecutive values, and w their weights
+/// (or NULL for weights of 1).
+
+void THnBase::FillN(Int_t ntimes, const Double_t* x, const Double_t* w /*= 0*/)
+{
+   for (Int_t i = 0; i < ntimes; ++i)
+      Fill(x + (Long64_t)i * fNdimensions, w ? w[i] : 1.);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Multiply this histogram by histogram h
 /// this = this * h
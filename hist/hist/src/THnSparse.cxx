@@ -16,6 +16,14 @@
 #include "TClass.h"
 #include "TDataMember.h"
 #include "TDataType.h"
+#include "TMath.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <vector>
 
 namespace {
 //______________________________________________________________________________
@@ -319,9 +327,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the THnSparseBinMap.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the THnSparseBinMap's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -342,6 +350,115 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 
 
 
+/** \class THnSparseBinMap
+THnSparseBinMap is used by THnSparse internally to find the linear bin index
+of a compact bin coordinate. It is an open addressing hash table with linear
+probing: a power-of-two array of (hash, index) slots, where the home slot of
+a hash is given by a multiplicative (Fibonacci) hash of it. Compared to a
+TExMap with a chain of collisions, a lookup touches one or two adjacent
+slots instead of several scattered allocations.
+
+If the compact coordinates fit into 8 bytes, the hash is the compact
+coordinate itself, i.e. a slot identifies its bin without looking at the
+chunks. Otherwise entries with equal hash are told apart by comparing the
+coordinates stored in the chunks; they simply continue the probe sequence.
+*/
+
+class THnSparseBinMap {
+public:
+   struct Slot_t {
+      ULong64_t fHash;  // hash of the bin's compact coordinates
+      Long64_t  fIndex; // linear bin index + 1; 0 means the slot is empty
+   };
+
+   THnSparseBinMap(): fShift(64), fSize(0) {}
+
+   Long64_t GetSize() const { return fSize; }
+   Long64_t GetCapacity() const { return fSlots.size(); }
+
+   /// Return the position of the slot of the bin with hash "hash" for which
+   /// "matches(index)" is true, or of the empty slot where it would be
+   /// inserted. The table must not be empty.
+   template <class MATCHES>
+   ULong64_t Find(ULong64_t hash, MATCHES matches) const {
+      const ULong64_t mask = fSlots.size() - 1;
+      for (ULong64_t pos = GetHome(hash); ; pos = (pos + 1) & mask) {
+         const Slot_t& slot = fSlots[pos];
+         if (!slot.fIndex || (slot.fHash == hash && matches(slot.fIndex - 1)))
+            return pos;
+      }
+   }
+
+   /// Return the bin index stored at position "pos" of Find(), -1 if none.
+   Long64_t GetIndex(ULong64_t pos) const { return fSlots[pos].fIndex - 1; }
+
+   /// Store bin "index" with "hash" at the empty slot "pos" returned by Find().
+   void Insert(ULong64_t pos, ULong64_t hash, Long64_t index) {
+      fSlots[pos].fHash = hash;
+      fSlots[pos].fIndex = index + 1;
+      ++fSize;
+      if (4 * fSize > 3 * GetCapacity())
+         Rehash(2 * GetCapacity());
+   }
+
+   /// Store bin "index" with "hash", which must not be in the table yet.
+   void Insert(ULong64_t hash, Long64_t index) {
+      Reserve(fSize + 1);
+      Insert(Find(hash, [](Long64_t) { return kFALSE; }), hash, index);
+   }
+
+   /// Make room for "nbins" bins without rehashing.
+   void Reserve(Long64_t nbins) {
+      Long64_t capacity = 16;
+      while (4 * nbins > 3 * capacity)
+         capacity *= 2;
+      if (capacity > GetCapacity())
+         Rehash(capacity);
+   }
+
+   /// Hint the CPU to load the home slot of "hash" into the cache.
+   void Prefetch(ULong64_t hash) const {
+#if defined(__GNUC__) || defined(__clang__)
+      if (!fSlots.empty())
+         __builtin_prefetch(&fSlots[GetHome(hash)]);
+#else
+      (void) hash;
+#endif
+   }
+
+   /// Remove all bins and release the memory.
+   void Clear() {
+      std::vector<Slot_t>().swap(fSlots);
+      fShift = 64;
+      fSize = 0;
+   }
+
+private:
+   ULong64_t GetHome(ULong64_t hash) const {
+      return (hash * 0x9E3779B97F4A7C15ULL) >> fShift;
+   }
+
+   void Rehash(Long64_t capacity) {
+      std::vector<Slot_t> old(capacity);
+      old.swap(fSlots);
+      fShift = 64;
+      for (Long64_t c = capacity; c > 1; c /= 2)
+         --fShift;
+      const ULong64_t mask = capacity - 1;
+      for (const Slot_t& slot: old) {
+         if (!slot.fIndex) continue;
+         ULong64_t pos = GetHome(slot.fHash);
+         while (fSlots[pos].fIndex)
+            pos = (pos + 1) & mask;
+         fSlots[pos] = slot;
+      }
+   }
+
+   std::vector<Slot_t> fSlots; // the hash table, size is a power of two
+   Int_t fShift;               // 64 - log2(fSlots.size()), to select the home slot
+   Long64_t fSize;             // number of used slots
+};
+
 
 /** \class THnSparseCompactBinCoord
 THnSparseCompactBinCoord is a class used by THnSparse internally. It
@@ -571,14 +688,21 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the open addressing hash
+table fBinMap (see THnSparseBinMap), which stores pairs of hash and linear
+index in one contiguous array. If the compact coordinates are larger than
+8 bytes, the coordinates of the bin an entry points to are compared to the
+coordinates passed to GetBin(). If they do not match, these two coordinates
+have the same hash - which is extremely unlikely but possible. In this case
+the lookup continues with the next slots of the table until the matching bin
+or an empty slot is found.
+
+Many entries can be filled at once with FillN(); it computes the compact
+coordinates of a block of entries and prefetches their slots of the hash
+table before updating the bins. Adding or merging a THnSparse with the same
+binning uses the compact coordinates of the other histogram directly and,
+with implicit multi-threading enabled (see ROOT::EnableImplicitMT()),
+updates the bins that exist in both histograms in parallel.
 */
 
 
@@ -588,7 +712,7 @@ ClassImp(THnSparse);
 /// Construct an empty THnSparse.
 
 THnSparse::THnSparse():
-   fChunkSize(1024), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(1024), fFilledBins(0), fBinMap(0), fCompactCoord(0)
 {
    fBinContent.SetOwner();
 }
@@ -605,7 +729,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
                      const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
                      Int_t chunksize):
    THnBase(name, title, dim, nbins, xmin, xmax),
-   fChunkSize(chunksize), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(chunksize), fFilledBins(0), fBinMap(0), fCompactCoord(0)
 {
    fCompactCoord = new THnSparseCompactBinCoord(dim, nbins);
    fBinContent.SetOwner();
@@ -615,6 +739,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
 /// Destruct a THnSparse
 
 THnSparse::~THnSparse() {
+   delete fBinMap;
    delete fCompactCoord;
 }
 
@@ -651,49 +776,44 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///We have been streamed; set up fBins
+///We have been streamed; set up fBinMap
 
-void THnSparse::FillExMap()
+void THnSparse::FillBinMap()
 {
+   if (!fBinMap)
+      fBinMap = new THnSparseBinMap();
+   fBinMap->Reserve(GetNbins());
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         fBinMap->Insert(compactCoord.GetHashFromBuffer(buf), idx);
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the map of filled bins, setting it up if needed.
+
+THnSparseBinMap* THnSparse::GetBinMap()
+{
+   if (!fBinMap)
+      fBinMap = new THnSparseBinMap();
+   if (GetNChunks() && !fBinMap->GetSize())
+      FillBinMap();
+   return fBinMap;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
-      FillExMap();
-   }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
-   }
+   GetBinMap()->Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -784,28 +904,37 @@ Double_t THnSparse::GetBinError2(Long64_t linidx) const {
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return the index for fCurrentBinIndex.
-/// If it doesn't exist then return -1, or allocate a new bin if allocate is set
+/// Return the index of the bin with compact coordinates "coordbuf" and their
+/// hash "hash", or -1 if the bin is not filled.
+/// Unlike GetBin() this does not modify the histogram; it can be called
+/// concurrently as long as no bins are added, once the map of filled bins
+/// has been set up by GetBinMap().
 
-Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
+Long64_t THnSparse::FindBinIndex(ULong64_t hash, const Char_t* coordbuf) const
 {
-   THnSparseCompactBinCoord* cc = GetCompactCoord();
-   ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
+   if (!fBinMap || !fBinMap->GetSize())
+      return -1;
+   ULong64_t pos = 0;
+   if (GetCompactCoord()->GetBufferSize() <= 8) {
+      // The hash is the compact coordinate: no need to look at the chunks.
+      pos = fBinMap->Find(hash, [](Long64_t) { return kTRUE; });
+   } else {
+      pos = fBinMap->Find(hash, [&](Long64_t idx) {
+            return GetChunk(idx / fChunkSize)->Matches(idx % fChunkSize, coordbuf); });
+   }
+   return fBinMap->GetIndex(pos);
+}
 
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the bin with compact coordinates "coordbuf" and their
+/// hash "hash". If it doesn't exist then return -1, or allocate a new bin if
+/// allocate is set.
 
-      linidx = nextlinidx;
-   }
-   if (!allocate) return -1;
+Long64_t THnSparse::GetBinIndex(ULong64_t hash, const Char_t* coordbuf, Bool_t allocate)
+{
+   THnSparseBinMap* binMap = GetBinMap();
+   Long64_t linidx = FindBinIndex(hash, coordbuf);
+   if (linidx >= 0 || !allocate) return linidx;
 
    ++fFilledBins;
 
@@ -816,23 +945,126 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
       chunk = AddChunk();
       newidx = 0;
    }
-   chunk->AddBin(newidx, cc->GetBuffer());
+   chunk->AddBin(newidx, coordbuf);
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   binMap->Insert(hash, newidx);
    return newidx;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index for fCurrentBinIndex.
+/// If it doesn't exist then return -1, or allocate a new bin if allocate is set
+
+Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
+{
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   return GetBinIndex(cc->GetHash(), cc->GetBuffer(), allocate);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram with "ntimes" entries: x contains the "ntimes" points,
+/// each given by GetNdimensions() consecutive values, and w their weights
+/// (or NULL for weights of 1).
+/// Equivalent to calling Fill() for each entry, but faster for large
+/// histograms: the bins of a block of entries are looked up together, so
+/// that the memory accesses to the hash table overlap.
+
+void THnSparse::FillN(Int_t ntimes, const Double_t* x, const Double_t* w /*= 0*/)
+{
+   const Int_t kBlockSize = 16;
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   const Int_t bufSize = TMath::Max(cc->GetBufferSize(), (Int_t)sizeof(Long64_t));
+   std::vector<Char_t> buffers(kBlockSize * bufSize);
+   std::vector<Int_t> coord(fNdimensions);
+   ULong64_t hashes[kBlockSize];
+   THnSparseBinMap* binMap = GetBinMap();
+
+   for (Int_t first = 0; first < ntimes; first += kBlockSize) {
+      const Int_t n = TMath::Min(kBlockSize, ntimes - first);
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t* xi = x + (Long64_t)(first + i) * fNdimensions;
+         for (Int_t d = 0; d < fNdimensions; ++d)
+            coord[d] = GetAxis(d)->FindBin(xi[d]);
+         hashes[i] = cc->SetBufferFromCoord(coord.data(), &buffers[i * bufSize]);
+         binMap->Prefetch(hashes[i]);
+      }
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t wi = w ? w[first + i] : 1.;
+         UpdateXStat(x + (Long64_t)(first + i) * fNdimensions, wi);
+         FillBin(GetBinIndex(hashes[i], &buffers[i * bufSize], kTRUE), wi);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add c * h to this histogram if h is a THnSparse with the same binning,
+/// see THnBase::Add(). Return kFALSE if h is not a THnSparse.
+/// The compact bin coordinates of h are used without decoding them. The bins
+/// of h that are already filled in this histogram are updated in parallel
+/// (one task per chunk of h) if implicit multi-threading is enabled; the
+/// others are then allocated sequentially.
+
+Bool_t THnSparse::AddSameBinning(const THnBase* h, Double_t c)
+{
+   const THnSparse* hs = dynamic_cast<const THnSparse*>(h);
+   if (!hs)
+      return kFALSE;
+
+   if (!GetCalculateErrors() && hs->GetCalculateErrors())
+      Sumw2();
+   const Bool_t haveErrors = GetCalculateErrors();
+   const THnSparseCompactBinCoord* hcc = hs->GetCompactCoord();
+   // Set up the map before it is used concurrently.
+   GetBinMap()->Reserve(GetNbins() + hs->GetNbins());
+
+   auto addBin = [&](Long64_t bin, const THnSparseArrayChunk* from, Int_t i) {
+      THnSparseArrayChunk* to = GetChunk(bin / fChunkSize);
+      const Int_t j = bin % fChunkSize;
+      const Double_t v = from->fContent->GetAt(i);
+      if (haveErrors) {
+         const Double_t err2 = from->fSumw2 ? from->fSumw2->GetAt(i) : v;
+         (*to->fSumw2)[j] += c * c * err2;
+      }
+      to->fContent->SetAt(to->fContent->GetAt(j) + c * v, j);
+   };
+
+   const Int_t nchunks = hs->GetNChunks();
+   std::vector<std::vector<Int_t>> missing(nchunks);
+   auto addChunk = [&](Int_t ichunk) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(ichunk);
+      const Int_t size = chunk->fSingleCoordinateSize;
+      for (Int_t i = 0, n = chunk->GetEntries(); i < n; ++i) {
+         const Char_t* buf = chunk->fCoordinates + i * size;
+         Long64_t bin = FindBinIndex(hcc->GetHashFromBuffer(buf), buf);
+         if (bin < 0)
+            missing[ichunk].push_back(i);
+         else
+            addBin(bin, chunk, i);
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1 && hs != this) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(addChunk, ROOT::TSeq<Int_t>(0, nchunks));
+   } else
+#endif
+   for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk)
+      addChunk(ichunk);
+
+   for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(ichunk);
+      const Int_t size = chunk->fSingleCoordinateSize;
+      for (Int_t i: missing[ichunk]) {
+         const Char_t* buf = chunk->fCoordinates + i * size;
+         addBin(GetBinIndex(hcc->GetHashFromBuffer(buf), buf, kTRUE), chunk, i);
+      }
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return THnSparseCompactBinCoord object.
 
@@ -881,7 +1113,8 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   if (fBinMap)
+      size += sizeof(THnSparseBinMap::Slot_t) * fBinMap->GetCapacity();
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -963,8 +1196,8 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   if (fBinMap)
+      fBinMap->Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -42,17 +42,69 @@
 #include "TH1.h"
 #include "TCanvas.h"
 #include "TKDE.h"
+#include "TPluginManager.h"
+#include "TROOT.h"
+#include "TVirtualFFT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 
 ClassImp(TKDE)
 
+namespace {
+   // Calls func(i) for i in [0, n), in parallel if implicit multi-threading is enabled
+   template <class F>
+   void ForEachIndex(UInt_t n, F func) {
+#ifdef R__USE_IMT
+      const UInt_t kMinPerTask = 256;
+      if (ROOT::IsImplicitMTEnabled() && n >= 2 * kMinPerTask) {
+         const UInt_t nTasks = std::min(n / kMinPerTask, 8 * ROOT::GetImplicitMTPoolSize());
+         auto task = [&](UInt_t iTask) {
+            for (UInt_t i = iTask * n / nTasks, last = (iTask + 1) * n / nTasks; i < last; ++i)
+               func(i);
+         };
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(task, ROOT::TSeq<UInt_t>(0, nTasks));
+         return;
+      }
+#endif
+      for (UInt_t i = 0; i < n; ++i)
+         func(i);
+   }
+}
+
 class TKDE::TKernel {
+   struct TPoint {
+      Double_t fX;      // data point
+      Double_t fWeight; // its bandwidth
+      Double_t fCoeff;  // its count divided by its bandwidth
+   };
+   enum { kBlockSize = 32 }; // number of points per leaf of the block tree
+
    TKDE* fKDE;
    UInt_t fNWeights; // Number of kernel weights (bandwidth as vectorized for binning)
    std::vector<Double_t> fWeights; // Kernel weights (bandwidth)
+   std::vector<TPoint> fPoints;    // Data points sorted by position, for the built-in kernels
+   UInt_t fNLeaves;                // Number of leaves of the block tree, a power of 2
+   std::vector<Double_t> fNodeMin; // Block tree: lower end of the support of the kernels of the points below each node
+   std::vector<Double_t> fNodeMax; // Block tree: upper end of the support of the kernels of the points below each node
+   std::vector<Double_t> fGrid;    // Sum of the kernels tabulated on a grid for the fast evaluation
+   Double_t fGridMin;              // Position of the first grid point
+   Double_t fGridStep;             // Distance between grid points
+
+   Double_t GetKernelSupport() const;
+   Bool_t ConvolveGrid();
+   template <class KERNEL>
+   Double_t SumNeighbours(Double_t x, KERNEL kernel) const;
+   Double_t Sum(Double_t x) const;
+   Double_t GetSum(Double_t x) const;
 public:
    TKernel(Double_t weight, TKDE* kde);
    void ComputeAdaptiveWeights();
+   void SetNeighbours();
+   void SetGrid(UInt_t nGridPoints);
    Double_t operator()(Double_t x) const;
    Double_t GetWeight(Double_t x) const;
    Double_t GetFixedWeight() const;
@@ -130,6 +182,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fNBins = events < 10000 ? 100 : events / 10;
    fNEvents = events;
    fUseBinsNEvents = 10000;
+   fNGridPoints = 0;
    fMean = 0.0;
    fSigma = 0.0;
    fXMin = xMin;
@@ -413,6 +466,25 @@ void TKDE::SetRange(Double_t xMin, Double_t xMax) {
    SetKernel();
 }
 
+void TKDE::SetFastEvaluation(UInt_t nGridPoints) {
+   // Evaluates the density by linear interpolation between its values on a
+   // grid of nGridPoints points, spanning the data and the kernels' support.
+   // The grid is computed once, with an FFT based convolution for the fixed
+   // bandwidth if the FFTW plugin is available. This is much faster than the
+   // exact evaluation for many evaluations of a KDE of many events, e.g. for
+   // drawing or integrating it; the relative deviation from the exact value
+   // is of the order of (grid step / bandwidth)**2.
+   // 0 switches back to the exact evaluation. Not available for user defined
+   // kernels.
+   if (nGridPoints && fKernelType == kUserDefined) {
+      this->Warning("SetFastEvaluation", "Fast evaluation is not available for user defined kernels.");
+      return;
+   }
+   if (nGridPoints == 1) nGridPoints = 2;
+   fNGridPoints = nGridPoints;
+   if (fKernel) fKernel->SetGrid(fNGridPoints);
+}
+
 // private methods
 
 void TKDE::SetUseBins() {
@@ -548,6 +620,8 @@ void TKDE::SetKernel() {
    weight *= fRho * fCanonicalBandwidths[fKernelType] / fCanonicalBandwidths[kGaussian];
    if (fKernel) delete fKernel;
    fKernel = new TKernel(weight, this);
+   fKernel->SetNeighbours();
+   fKernel->SetGrid(fNGridPoints);
    if (fIteration == kAdaptive) {
       fKernel->ComputeAdaptiveWeights();
    }
@@ -672,6 +746,20 @@ Double_t TKDE::operator()(Double_t x) const {
    return (*fKernel)(x);
 }
 
+void TKDE::GetValues(UInt_t n, const Double_t* x, Double_t* values) const {
+   // Sets values[i] to the kernel density estimate at x[i], for i < n.
+   // With implicit multi-threading enabled (see ROOT::EnableImplicitMT()) the
+   // points are evaluated in parallel, unless the kernel is user defined.
+   if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
+   const TKernel& kernel = *fKernel;
+   if (fKernelType == kUserDefined) {
+      for (UInt_t i = 0; i < n; ++i)
+         values[i] = kernel(x[i]);
+      return;
+   }
+   ForEachIndex(n, [&](UInt_t i) { values[i] = kernel(x[i]); });
+}
+
 Double_t TKDE::GetMean() const {
    // return the mean of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
@@ -694,7 +782,10 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(fNWeights, weight)
+fWeights(fNWeights, weight),
+fNLeaves(0),
+fGridMin(0.),
+fGridStep(0.)
 {}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
@@ -704,11 +795,22 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    unsigned int n = fKDE->fData.size();
    assert( n == weights.size() );
    bool useDataWeights = (fKDE->fBinCount.size() == n); 
+   // The pilot density at the data points
+   std::vector<Double_t> pilot(n, 0.0);
+   auto evalPilot = [&](UInt_t i) {
+      if (!useDataWeights || fKDE->fBinCount[i] > 0)
+         pilot[i] = (*this)(fKDE->fData[i]);
+   };
+   if (fKDE->fKernelType == kUserDefined) {
+      for (UInt_t i = 0; i < n; ++i) evalPilot(i);
+   } else {
+      ForEachIndex(n, evalPilot);
+   }
    Double_t f = 0.0;
    for (unsigned int i = 0; i < n; ++i) { 
 //   for (; weight != weights.end(); ++weight, ++data, ++dataW) {
       if (useDataWeights && fKDE->fBinCount[i] <= 0) continue;  // skip negative or null weights
-      f = (*fKDE->fKernel)(fKDE->fData[i]);
+      f = pilot[i];
       if (f <= 0)
          fKDE->Warning("ComputeAdativeWeights","function value is zero or negative for x = %f w = %f",
                        fKDE->fData[i],(useDataWeights) ? fKDE->fBinCount[i] : 1.);
@@ -720,6 +822,190 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    fKDE->fAdaptiveBandwidthFactor = fKDE->fUseMirroring ? kAPPROX_GEO_MEAN / fKDE->fSigmaRob : std::sqrt(std::exp(fKDE->fAdaptiveBandwidthFactor / fKDE->fData.size()));
    transform(weights.begin(), weights.end(), fWeights.begin(), std::bind2nd(std::multiplies<Double_t>(), fKDE->fAdaptiveBandwidthFactor));
    //printf("adaptive bandwidth factor % f weight 0 %f , %f \n",fKDE->fAdaptiveBandwidthFactor, weights[0],fWeights[0] );
+   SetNeighbours();
+   SetGrid(fKDE->fNGridPoints);
+}
+
+Double_t TKDE::TKernel::GetKernelSupport() const {
+   // Returns the half width of the (truncated) support of the built-in kernels
+   return fKDE->fKernelType == kGaussian ? 9. : 1.;
+}
+
+void TKDE::TKernel::SetNeighbours() {
+   // Sorts the data points and builds a binary tree over blocks of kBlockSize
+   // consecutive points, each node holding the range where the kernels of the
+   // points below it are non-zero. The density at x is then summed only over
+   // the blocks whose range contains x, which is exact for the built-in
+   // kernels and a small fraction of the data for large samples, also for
+   // adaptive bandwidths. Not used for user defined kernels, whose support is
+   // not known.
+   fPoints.clear();
+   fNodeMin.clear();
+   fNodeMax.clear();
+   fNLeaves = 0;
+   if (fKDE->fKernelType == kUserDefined) return;
+   UInt_t n = fKDE->fData.size();
+   Bool_t useBins = (fKDE->fBinCount.size() == n);
+   fPoints.resize(n);
+   for (UInt_t i = 0; i < n; ++i) {
+      fPoints[i].fX = fKDE->fData[i];
+      fPoints[i].fWeight = fWeights[i];
+      fPoints[i].fCoeff = (useBins ? fKDE->fBinCount[i] : 1.0) / fWeights[i];
+   }
+   std::sort(fPoints.begin(), fPoints.end(), [](const TPoint& a, const TPoint& b) { return a.fX < b.fX; });
+
+   UInt_t nBlocks = (n + kBlockSize - 1) / kBlockSize;
+   fNLeaves = 1;
+   while (fNLeaves < nBlocks) fNLeaves *= 2;
+   fNodeMin.assign(2 * fNLeaves, std::numeric_limits<Double_t>::infinity());
+   fNodeMax.assign(2 * fNLeaves, -std::numeric_limits<Double_t>::infinity());
+   Double_t support = GetKernelSupport();
+   for (UInt_t i = 0; i < n; ++i) {
+      UInt_t leaf = fNLeaves + i / kBlockSize;
+      fNodeMin[leaf] = std::min(fNodeMin[leaf], fPoints[i].fX - support * fPoints[i].fWeight);
+      fNodeMax[leaf] = std::max(fNodeMax[leaf], fPoints[i].fX + support * fPoints[i].fWeight);
+   }
+   for (UInt_t node = fNLeaves - 1; node > 0; --node) {
+      fNodeMin[node] = std::min(fNodeMin[2 * node], fNodeMin[2 * node + 1]);
+      fNodeMax[node] = std::max(fNodeMax[2 * node], fNodeMax[2 * node + 1]);
+   }
+}
+
+template <class KERNEL>
+Double_t TKDE::TKernel::SumNeighbours(Double_t x, KERNEL kernel) const {
+   // Returns the sum of the kernels at x, visiting only the blocks of points
+   // whose kernels' support contains x
+   Double_t result = 0.0;
+   UInt_t stack[2 * 8 * sizeof(UInt_t)];
+   Int_t top = 0;
+   stack[top++] = 1;
+   while (top) {
+      UInt_t node = stack[--top];
+      if (!(fNodeMin[node] < x && x < fNodeMax[node])) continue;
+      if (node < fNLeaves) {
+         stack[top++] = 2 * node + 1;
+         stack[top++] = 2 * node;
+         continue;
+      }
+      UInt_t first = (node - fNLeaves) * kBlockSize;
+      UInt_t last = std::min<UInt_t>(first + kBlockSize, fPoints.size());
+      for (UInt_t i = first; i < last; ++i) {
+         const TPoint& p = fPoints[i];
+         result += p.fCoeff * kernel((x - p.fX) / p.fWeight);
+      }
+   }
+   return result;
+}
+
+Double_t TKDE::TKernel::Sum(Double_t x) const {
+   // Returns the sum of the kernels at x using the block tree
+   const TKDE& kde = *fKDE;
+   switch (kde.fKernelType) {
+      case kGaussian:
+         return SumNeighbours(x, [&kde](Double_t u) { return kde.GaussianKernel(u); });
+      case kEpanechnikov:
+         return SumNeighbours(x, [&kde](Double_t u) { return kde.EpanechnikovKernel(u); });
+      case kBiweight:
+         return SumNeighbours(x, [&kde](Double_t u) { return kde.BiweightKernel(u); });
+      case kCosineArch:
+         return SumNeighbours(x, [&kde](Double_t u) { return kde.CosineArchKernel(u); });
+      default:
+         return SumNeighbours(x, [&kde](Double_t u) { return (*kde.fKernelFunction)(u); });
+   }
+}
+
+Double_t TKDE::TKernel::GetSum(Double_t x) const {
+   // Returns the sum of the kernels at x, interpolated from the grid if the
+   // fast evaluation is enabled
+   if (fGrid.empty()) return Sum(x);
+   Double_t t = (x - fGridMin) / fGridStep;
+   // Outside of the grid all kernels are zero.
+   if (!(t >= 0. && t < fGrid.size() - 1.)) return 0.0;
+   UInt_t i = (UInt_t)t;
+   t -= i;
+   return (1. - t) * fGrid[i] + t * fGrid[i + 1];
+}
+
+void TKDE::TKernel::SetGrid(UInt_t nGridPoints) {
+   // Tabulates the sum of the kernels on nGridPoints points spanning the
+   // data and the kernels' support, or removes the grid for nGridPoints = 0
+   fGrid.clear();
+   if (nGridPoints < 2 || fPoints.empty()) return;
+   Double_t support = GetKernelSupport();
+   Double_t maxWeight = 0.0;
+   Double_t minWeight = std::numeric_limits<Double_t>::max();
+   for (UInt_t i = 0; i < fPoints.size(); ++i) {
+      maxWeight = std::max(maxWeight, fPoints[i].fWeight);
+      minWeight = std::min(minWeight, fPoints[i].fWeight);
+   }
+   fGridMin = fPoints.front().fX - support * maxWeight;
+   fGridStep = (fPoints.back().fX + support * maxWeight - fGridMin) / (nGridPoints - 1);
+   std::vector<Double_t> grid(nGridPoints, 0.0);
+   fGrid.swap(grid);
+   // Equal bandwidths: the sum of kernels is a convolution.
+   if (minWeight == maxWeight && ConvolveGrid()) return;
+   std::vector<Double_t> sums(nGridPoints);
+   ForEachIndex(nGridPoints, [&](UInt_t i) { sums[i] = Sum(fGridMin + i * fGridStep); });
+   fGrid.swap(sums);
+}
+
+Bool_t TKDE::TKernel::ConvolveGrid() {
+   // Computes the grid for equal bandwidths by convolving the data, linearly
+   // binned on the grid, with the kernel sampled on the grid, using an FFT.
+   // Returns false if no FFT implementation is available.
+   TPluginHandler* h = gROOT->GetPluginManager()->FindHandler("TVirtualFFT", "fftwr2c");
+   if (!h || h->CheckPlugin() == -1) return kFALSE;
+
+   const UInt_t nGrid = fGrid.size();
+   const Double_t weight = fPoints.front().fWeight;
+   const Int_t nKernel = std::min<Int_t>(nGrid - 1, (Int_t)std::ceil(GetKernelSupport() * weight / fGridStep));
+   Int_t n = 1;
+   while (n < (Int_t)nGrid + nKernel) n *= 2;
+
+   std::vector<Double_t> binned(n, 0.0);
+   for (UInt_t i = 0; i < fPoints.size(); ++i) {
+      Double_t t = (fPoints[i].fX - fGridMin) / fGridStep;
+      UInt_t bin = std::min((UInt_t)t, nGrid - 2);
+      t -= bin;
+      binned[bin] += (1. - t) * fPoints[i].fCoeff;
+      binned[bin + 1] += t * fPoints[i].fCoeff;
+   }
+   // The kernel is symmetric; negative offsets wrap around.
+   std::vector<Double_t> kernel(n, 0.0);
+   for (Int_t j = 0; j <= nKernel; ++j) {
+      Double_t k = (*fKDE->fKernelFunction)(j * fGridStep / weight);
+      kernel[j] = k;
+      if (j) kernel[n - j] = k;
+   }
+
+   TVirtualFFT* fft = TVirtualFFT::FFT(1, &n, "R2C ES K");
+   TVirtualFFT* inverse = TVirtualFFT::FFT(1, &n, "C2R ES K");
+   if (!fft || !inverse) {
+      delete fft;
+      delete inverse;
+      return kFALSE;
+   }
+   const Int_t nFreq = n / 2 + 1;
+   std::vector<Double_t> dataRe(nFreq), dataIm(nFreq), kernRe(nFreq), kernIm(nFreq);
+   fft->SetPoints(&binned[0]);
+   fft->Transform();
+   fft->GetPointsComplex(&dataRe[0], &dataIm[0]);
+   fft->SetPoints(&kernel[0]);
+   fft->Transform();
+   fft->GetPointsComplex(&kernRe[0], &kernIm[0]);
+   for (Int_t i = 0; i < nFreq; ++i) {
+      Double_t re = dataRe[i] * kernRe[i] - dataIm[i] * kernIm[i];
+      Double_t im = dataRe[i] * kernIm[i] + dataIm[i] * kernRe[i];
+      dataRe[i] = re;
+      dataIm[i] = im;
+   }
+   inverse->SetPointsComplex(&dataRe[0], &dataIm[0]);
+   inverse->Transform();
+   for (UInt_t i = 0; i < nGrid; ++i)
+      fGrid[i] = inverse->GetPointReal(i) / n;
+   delete fft;
+   delete inverse;
+   return kTRUE;
 }
 
 Double_t TKDE::TKernel::GetWeight(Double_t x) const {
@@ -909,6 +1195,16 @@ Double_t TKDE::TKernel::operator()(Double_t x) const {
    // case of bins or weighted data 
    Bool_t useBins = (fKDE->fBinCount.size() == n);
    Double_t nSum = (useBins) ? fKDE->fSumOfCounts : fKDE->fNEvents;
+   if (!fPoints.empty()) {
+      // built-in (symmetric) kernels: the asymmetric mirror terms are the sums at the mirrored x
+      result = GetSum(x);
+      if (fKDE->fAsymLeft) result -= GetSum(2. * fKDE->fXMin - x);
+      if (fKDE->fAsymRight) result -= GetSum(2. * fKDE->fXMax - x);
+      if ( TMath::IsNaN(result) ) {
+         fKDE->Warning("operator()","Result is NaN for  x %f \n",x);
+      }
+      return result / nSum;
+   }
    // double dmin = 1.E10;
    // double xmin,bmin,wmin; 
    for (UInt_t i = 0; i < n; ++i) {
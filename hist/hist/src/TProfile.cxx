@@ -629,6 +629,7 @@ Bool_t TProfile::Divide(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2,
 
 Int_t TProfile::Fill(Double_t x, Double_t y)
 {
+   if (fConcurrentFill) return ((TProfile*)GetConcurrentFillShadow())->Fill(x,y);
    if (fBuffer) return BufferFill(x,y,1);
 
    Int_t bin;
@@ -659,6 +660,7 @@ Int_t TProfile::Fill(Double_t x, Double_t y)
 
 Int_t TProfile::Fill(const char *namex, Double_t y)
 {
+   if (fConcurrentFill) return ((TProfile*)GetConcurrentFillShadow())->Fill(namex,y);
    Int_t bin;
    if (fYmin != fYmax) {
       if (y <fYmin || y> fYmax || TMath::IsNaN(y) ) return -1;
@@ -688,6 +690,7 @@ Int_t TProfile::Fill(const char *namex, Double_t y)
 
 Int_t TProfile::Fill(Double_t x, Double_t y, Double_t w)
 {
+   if (fConcurrentFill) return ((TProfile*)GetConcurrentFillShadow())->Fill(x,y,w);
    if (fBuffer) return BufferFill(x,y,w);
 
    Int_t bin;
@@ -720,6 +723,7 @@ Int_t TProfile::Fill(Double_t x, Double_t y, Double_t w)
 
 Int_t TProfile::Fill(const char *namex, Double_t y, Double_t w)
 {
+   if (fConcurrentFill) return ((TProfile*)GetConcurrentFillShadow())->Fill(namex,y,w);
    Int_t bin;
 
    if (fYmin != fYmax) {
@@ -752,6 +756,10 @@ Int_t TProfile::Fill(const char *namex, Double_t y, Double_t w)
 
 void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *w, Int_t stride)
 {
+   if (fConcurrentFill) {
+      ((TProfile*)GetConcurrentFillShadow())->FillN(ntimes, x, y, w, stride);
+      return;
+   }
    Int_t bin,i;
    ntimes *= stride;
    Int_t ifirst = 0;
@@ -770,28 +778,39 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
          return;
    }
 
-   for (i=ifirst;i<ntimes;i+=stride) {
-      if (fYmin != fYmax) {
-         if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
-      }
+   const Int_t kBlockSize = 256;
+   Int_t bins[kBlockSize];
+   // Find the bins of a block of values at once, unless the axis can be
+   // extended: an extension would invalidate the bins found for the block.
+   for (Int_t first = ifirst, nblock = 0; first < ntimes; first += nblock*stride) {
+      nblock = fXaxis.CanExtend() ? 1 : TMath::Min(kBlockSize, (ntimes - first + stride - 1)/stride);
+      // (values rejected by the y range must not extend the axis)
+      if (nblock > 1 || fYmin == fYmax || !(y[first] <fYmin || y[first]> fYmax || TMath::IsNaN(y[first])))
+         fXaxis.FindBin(nblock, &x[first], bins, stride);
+      for (Int_t k = 0; k < nblock; ++k) {
+         i = first + k*stride;
+         if (fYmin != fYmax) {
+            if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
+         }
 
-      Double_t u = (w) ? w[i] : 1; // (w[i] > 0 ? w[i] : -w[i]);
-      fEntries++;
-      bin =fXaxis.FindBin(x[i]);
-      AddBinContent(bin, u*y[i]);
-      fSumw2.fArray[bin] += u*y[i]*y[i];
-      if (!fBinSumw2.fN && u != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();  // must be called before accumulating the entries
-      if (fBinSumw2.fN)  fBinSumw2.fArray[bin] += u*u;
-      fBinEntries.fArray[bin] += u;
-      if (bin == 0 || bin > fXaxis.GetNbins()) {
-         if (!fgStatOverflows) continue;
+         Double_t u = (w) ? w[i] : 1; // (w[i] > 0 ? w[i] : -w[i]);
+         fEntries++;
+         bin = bins[k];
+         AddBinContent(bin, u*y[i]);
+         fSumw2.fArray[bin] += u*y[i]*y[i];
+         if (!fBinSumw2.fN && u != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();  // must be called before accumulating the entries
+         if (fBinSumw2.fN)  fBinSumw2.fArray[bin] += u*u;
+         fBinEntries.fArray[bin] += u;
+         if (bin == 0 || bin > fXaxis.GetNbins()) {
+            if (!fgStatOverflows) continue;
+         }
+         fTsumw   += u;
+         fTsumw2  += u*u;
+         fTsumwx  += u*x[i];
+         fTsumwx2 += u*x[i]*x[i];
+         fTsumwy  += u*y[i];
+         fTsumwy2 += u*y[i]*y[i];
       }
-      fTsumw   += u;
-      fTsumw2  += u*u;
-      fTsumwx  += u*x[i];
-      fTsumwx2 += u*x[i]*x[i];
-      fTsumwy  += u*y[i];
-      fTsumwy2 += u*y[i]*y[i];
    }
 }
 
@@ -801,6 +820,7 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
 Double_t TProfile::GetBinContent(Int_t bin) const
 {
    if (fBuffer) ((TProfile*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TProfile*)this)->FlushConcurrentFill();
 
    if (bin < 0 || bin >= fNcells) return 0;
    if (fBinEntries.fArray[bin] == 0) return 0;
@@ -814,6 +834,7 @@ Double_t TProfile::GetBinContent(Int_t bin) const
 Double_t TProfile::GetBinEntries(Int_t bin) const
 {
    if (fBuffer) ((TProfile*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TProfile*)this)->FlushConcurrentFill();
 
    if (bin < 0 || bin >= fNcells) return 0;
    return fBinEntries.fArray[bin];
@@ -898,6 +919,7 @@ Option_t *TProfile::GetErrorOption() const
 void TProfile::GetStats(Double_t *stats) const
 {
    if (fBuffer) ((TProfile*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TProfile*)this)->FlushConcurrentFill();
 
    // Loop on bins
    Int_t bin, binx;
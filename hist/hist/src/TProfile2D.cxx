@@ -585,6 +585,7 @@ Bool_t TProfile2D::Divide(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2
 
 Int_t TProfile2D::Fill(Double_t x, Double_t y, Double_t z)
 {
+   if (fConcurrentFill) return ((TProfile2D*)GetConcurrentFillShadow())->Fill(x,y,z);
    if (fBuffer) return BufferFill(x,y,z,1);
 
    Int_t bin,binx,biny;
@@ -625,6 +626,7 @@ Int_t TProfile2D::Fill(Double_t x, Double_t y, Double_t z)
 
 Int_t TProfile2D::Fill(Double_t x, const char *namey, Double_t z)
 {
+   if (fConcurrentFill) return ((TProfile2D*)GetConcurrentFillShadow())->Fill(x,namey,z);
    Int_t bin,binx,biny;
 
    if (fZmin != fZmax) {
@@ -662,6 +664,7 @@ Int_t TProfile2D::Fill(Double_t x, const char *namey, Double_t z)
 
 Int_t TProfile2D::Fill(const char *namex, const char *namey, Double_t z)
 {
+   if (fConcurrentFill) return ((TProfile2D*)GetConcurrentFillShadow())->Fill(namex,namey,z);
    Int_t bin,binx,biny;
 
    if (fZmin != fZmax) {
@@ -698,6 +701,7 @@ Int_t TProfile2D::Fill(const char *namex, const char *namey, Double_t z)
 
 Int_t TProfile2D::Fill(const char *namex, Double_t y, Double_t z)
 {
+   if (fConcurrentFill) return ((TProfile2D*)GetConcurrentFillShadow())->Fill(namex,y,z);
    Int_t bin,binx,biny;
 
    if (fZmin != fZmax) {
@@ -735,6 +739,7 @@ Int_t TProfile2D::Fill(const char *namex, Double_t y, Double_t z)
 
 Int_t TProfile2D::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 {
+   if (fConcurrentFill) return ((TProfile2D*)GetConcurrentFillShadow())->Fill(x,y,z,w);
    if (fBuffer) return BufferFill(x,y,z,w);
 
    Int_t bin,binx,biny;
@@ -778,6 +783,7 @@ Int_t TProfile2D::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 Double_t TProfile2D::GetBinContent(Int_t bin) const
 {
    if (fBuffer) ((TProfile2D*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TProfile2D*)this)->FlushConcurrentFill();
 
    if (bin < 0 || bin >= fNcells) return 0;
    if (fBinEntries.fArray[bin] == 0) return 0;
@@ -791,6 +797,7 @@ Double_t TProfile2D::GetBinContent(Int_t bin) const
 Double_t TProfile2D::GetBinEntries(Int_t bin) const
 {
    if (fBuffer) ((TProfile2D*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TProfile2D*)this)->FlushConcurrentFill();
 
    if (bin < 0 || bin >= fNcells) return 0;
    return fBinEntries.fArray[bin];
@@ -865,6 +872,7 @@ Option_t *TProfile2D::GetErrorOption() const
 void TProfile2D::GetStats(Double_t *stats) const
 {
    if (fBuffer) ((TProfile2D*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TProfile2D*)this)->FlushConcurrentFill();
 
    // Loop on bins
    if (fTsumw == 0 || fXaxis.TestBit(TAxis::kAxisRange) || fYaxis.TestBit(TAxis::kAxisRange)) {
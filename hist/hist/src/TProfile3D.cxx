@@ -585,6 +585,7 @@ Bool_t TProfile3D::Divide(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2
 
 Int_t TProfile3D::Fill(Double_t x, Double_t y, Double_t z, Double_t t)
 {
+   if (fConcurrentFill) return ((TProfile3D*)GetConcurrentFillShadow())->Fill(x,y,z,t);
    if (fBuffer) return BufferFill(x,y,z,t,1);
 
    Int_t bin,binx,biny,binz;
@@ -634,6 +635,7 @@ Int_t TProfile3D::Fill(Double_t x, Double_t y, Double_t z, Double_t t)
 
 Int_t TProfile3D::Fill(Double_t x, Double_t y, Double_t z, Double_t t, Double_t w)
 {
+   if (fConcurrentFill) return ((TProfile3D*)GetConcurrentFillShadow())->Fill(x,y,z,t,w);
    if (fBuffer) return BufferFill(x,y,z,t,w);
 
    Int_t bin,binx,biny,binz;
@@ -685,6 +687,7 @@ Int_t TProfile3D::Fill(Double_t x, Double_t y, Double_t z, Double_t t, Double_t
 Double_t TProfile3D::GetBinContent(Int_t bin) const
 {
    if (fBuffer) ((TProfile3D*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TProfile3D*)this)->FlushConcurrentFill();
 
    if (bin < 0 || bin >= fNcells) return 0;
    if (fBinEntries.fArray[bin] == 0) return 0;
@@ -698,6 +701,7 @@ Double_t TProfile3D::GetBinContent(Int_t bin) const
 Double_t TProfile3D::GetBinEntries(Int_t bin) const
 {
    if (fBuffer) ((TProfile3D*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TProfile3D*)this)->FlushConcurrentFill();
 
    if (bin < 0 || bin >= fNcells) return 0;
    return fBinEntries.fArray[bin];
@@ -779,6 +783,7 @@ Option_t *TProfile3D::GetErrorOption() const
 void TProfile3D::GetStats(Double_t *stats) const
 {
    if (fBuffer) ((TProfile3D*)this)->BufferEmpty();
+   if (fConcurrentFill) ((TProfile3D*)this)->FlushConcurrentFill();
 
    // Loop on bins
    if (fTsumw == 0 || fXaxis.TestBit(TAxis::kAxisRange) || fYaxis.TestBit(TAxis::kAxisRange)) {
@@ -22,11 +22,14 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TH1.h"
+#include "TH1Merger.h"
 #include "TError.h"
 #include "TCollection.h"
 #include "THashList.h"
 #include "TMath.h"
 
+#include <vector>
+
 class TProfileHelper {
 
 public:
@@ -77,6 +80,9 @@ Bool_t TProfileHelper::Add(T* p, const TH1 *h1,  const TH1 *h2, Double_t c1, Dou
 
    // delete buffer if it is there since it will become invalid
    if (p->fBuffer) p->BufferEmpty(1);
+   if (p->fConcurrentFill) p->FlushConcurrentFill();
+   if (h1->IsConcurrentFill()) const_cast<TH1*>(h1)->FlushConcurrentFill();
+   if (h2->IsConcurrentFill()) const_cast<TH1*>(h2)->FlushConcurrentFill();
 
 // Check profile compatibility
    Int_t nx = p->GetNbinsX();
@@ -151,6 +157,7 @@ Double_t TProfileHelper::GetBinEffectiveEntries(T* p, Int_t bin)
 //
 
    if (p->fBuffer) p->BufferEmpty();
+   if (p->fConcurrentFill) p->FlushConcurrentFill();
 
    if (bin < 0 || bin >= p->fNcells) return 0;
    double sumOfWeights = p->fBinEntries.fArray[bin];
@@ -184,6 +191,13 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
    TList inlist;
    inlist.AddAll(li);
 
+   // fold the concurrent fills of the inputs
+   TIter nextin(&inlist);
+   while (TObject *obj = nextin()) {
+      TH1 *h = dynamic_cast<TH1*>(obj);
+      if (h && h->IsConcurrentFill()) h->FlushConcurrentFill();
+   }
+
    TAxis newXAxis;
    TAxis newYAxis;
    TAxis newZAxis;
@@ -362,6 +376,7 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
    Bool_t canExtend = p->CanExtendAllAxes();
    p->SetCanExtend(TH1::kNoAxis); // reset, otherwise setting the under/overflow will extend the axis
 
+   std::vector<T*> hists;
    while ( (h=static_cast<T*>(next())) ) {
       // process only if the histogram has limits; otherwise it was processed before
 
@@ -371,7 +386,43 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
          for (Int_t i = 0; i < TH1::kNstat; i++)
             totstats[i] += stats[i];
          nentries += h->GetEntries();
+         hists.push_back(h);
+      }
+   }
+
+   // with the same limits the cells of all profiles are summed in parallel:
+   // the sums of weights, of weights squared, the bin entries and their sum of weights squared
+   const Bool_t haveBinSumw2 = p->fBinSumw2.fN != 0;
+   auto addCells = [&](Int_t input, Int_t first, Int_t last, Double_t *sums) {
+      T* hi = hists[input];
+      const Int_t n = last - first;
+      const Double_t *w = hi->GetW() + first;
+      const Double_t *w2 = hi->GetW2() + first;
+      const Double_t *b = hi->GetB() + first;
+      const Double_t *b2 = hi->GetB2() ? hi->GetB2() + first : b;
+      for (Int_t i = 0; i < n; ++i) {
+         sums[i] += w[i];
+         sums[n + i] += w2[i];
+         sums[2 * n + i] += b[i];
+      }
+      if (haveBinSumw2) {
+         for (Int_t i = 0; i < n; ++i)
+            sums[3 * n + i] += b2[i];
+      }
+   };
+   auto storeCells = [&](Int_t first, Int_t last, const Double_t *sums) {
+      const Int_t n = last - first;
+      for (Int_t i = 0; i < n; ++i) {
+         p->fArray[first + i]             += sums[i];
+         p->fSumw2.fArray[first + i]      += sums[n + i];
+         p->fBinEntries.fArray[first + i] += sums[2 * n + i];
+         if (haveBinSumw2) p->fBinSumw2.fArray[first + i] += sums[3 * n + i];
+      }
+   };
 
+   if (!allSameLimits || !TH1Merger::ReduceCells(p->fN, hists.size(), haveBinSumw2 ? 4 : 3, addCells, storeCells)) {
+      for (T* hi : hists) {
+         h = hi;
          for ( Int_t hbin = 0; hbin < h->fN; ++hbin ) {
             Int_t pbin = hbin;
             if (!allSameLimits) {
@@ -664,6 +715,7 @@ Double_t TProfileHelper::GetBinError(T* p, Int_t bin)
    // compute bin error of profile histograms
 
    if (p->fBuffer) p->BufferEmpty();
+   if (p->fConcurrentFill) p->FlushConcurrentFill();
 
    if (bin < 0 || bin >= p->fNcells) return 0;
    Double_t cont = p->fArray[bin];                  // sum of bin w *y
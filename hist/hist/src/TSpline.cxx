@@ -24,6 +24,8 @@
 #include "TClass.h"
 #include "TMath.h"
 
+#include <algorithm>
+
 ClassImp(TSplinePoly)
 ClassImp(TSplinePoly3)
 ClassImp(TSplinePoly5)
@@ -537,7 +539,8 @@ TSpline3::TSpline3(const TSpline3& sp3) :
   fValBeg(sp3.fValBeg),
   fValEnd(sp3.fValEnd),
   fBegCond(sp3.fBegCond),
-  fEndCond(sp3.fEndCond)
+  fEndCond(sp3.fEndCond),
+  fCoeff(sp3.fCoeff)
 {
    if (fNp > 0) fPoly = new TSplinePoly3[fNp];
    for (Int_t i=0; i<fNp; ++i)
@@ -560,6 +563,7 @@ TSpline3& TSpline3::operator=(const TSpline3& sp3)
       fValEnd=sp3.fValEnd;
       fBegCond=sp3.fBegCond;
       fEndCond=sp3.fEndCond;
+      fCoeff=sp3.fCoeff;
    }
    return *this;
 }
@@ -786,6 +790,55 @@ Double_t TSpline3::Eval(Double_t x) const
    return fPoly[klow].Eval(x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Eval this spline at the n points x, storing the values in y: y[i] is
+/// equal to Eval(x[i]).
+/// The points can be in any order, but consecutive points that lie in the
+/// same or in the next interval between knots, as for increasing x, are
+/// found without searching. The polynomials are then evaluated from
+/// contiguous arrays of coefficients, in a loop the compiler can vectorize.
+
+void TSpline3::Eval(Int_t n, const Double_t *x, Double_t *y) const
+{
+   if (fNp < 2 || (Int_t)fCoeff.size() != 5 * fNp) {
+      for (Int_t i = 0; i < n; ++i)
+         y[i] = Eval(x[i]);
+      return;
+   }
+
+   const Double_t *kx = fCoeff.data();
+   const Double_t *ky = kx + fNp;
+   const Double_t *kb = ky + fNp;
+   const Double_t *kc = kb + fNp;
+   const Double_t *kd = kc + fNp;
+   const Int_t kChunk = 256;
+   Int_t knot[kChunk];
+   Int_t k = 0;
+   for (Int_t first = 0; first < n; first += kChunk) {
+      const Int_t m = std::min(kChunk, n - first);
+      const Double_t *xc = x + first;
+      // Strictly inside an interval, FindX() returns that interval.
+      for (Int_t i = 0; i < m; ++i) {
+         const Double_t xi = xc[i];
+         if (!(kx[k] < xi && xi < kx[k + 1])) {
+            if (k + 2 < fNp && kx[k + 1] < xi && xi < kx[k + 2]) {
+               ++k;
+            } else {
+               k = FindX(xi);
+               if (k >= fNp - 1) k = fNp - 2;
+            }
+         }
+         knot[i] = k;
+      }
+      Double_t *yc = y + first;
+      for (Int_t i = 0; i < m; ++i) {
+         const Int_t j = knot[i];
+         const Double_t dx = xc[i] - kx[j];
+         yc[i] = ky[j] + dx * (kb[j] + dx * (kc[j] + dx * kd[j]));
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Derivative.
 
@@ -993,6 +1046,10 @@ void TSpline3::SetPoint(Int_t i, Double_t x, Double_t y)
    if (i < 0 || i >= fNp) return;
    fPoly[i].X()= x;
    fPoly[i].Y()= y;
+   if ((Int_t)fCoeff.size() == 5 * fNp) {
+      fCoeff[i] = x;
+      fCoeff[fNp + i] = y;
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1004,6 +1061,27 @@ void TSpline3::SetPointCoeff(Int_t i, Double_t b, Double_t c, Double_t d)
    fPoly[i].B()= b;
    fPoly[i].C()= c;
    fPoly[i].D()= d;
+   if ((Int_t)fCoeff.size() == 5 * fNp) {
+      fCoeff[2 * fNp + i] = b;
+      fCoeff[3 * fNp + i] = c;
+      fCoeff[4 * fNp + i] = d;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the knots and coefficients of the polynomials into fCoeff, used by
+/// Eval(n, x, y).
+
+void TSpline3::FillCoeff()
+{
+   fCoeff.resize(5 * fNp);
+   for (Int_t i = 0; i < fNp; ++i) {
+      fCoeff[i] = fPoly[i].X();
+      fCoeff[fNp + i] = fPoly[i].Y();
+      fCoeff[2 * fNp + i] = fPoly[i].B();
+      fCoeff[3 * fNp + i] = fPoly[i].C();
+      fCoeff[4 * fNp + i] = fPoly[i].D();
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1161,6 +1239,7 @@ L30: j = l-1;
       fPoly[i-1].C() = (divdf1 - fPoly[i-1].B() - divdf3)/dtau;
       fPoly[i-1].D() = (divdf3/dtau)/dtau;
    }
+   FillCoeff();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1173,6 +1252,7 @@ void TSpline3::Streamer(TBuffer &R__b)
       Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
       if (R__v > 1) {
          R__b.ReadClassBuffer(TSpline3::Class(), this, R__v, R__s, R__c);
+         FillCoeff();
          return;
       }
       //====process old versions before automatic schema evolution
@@ -1188,6 +1268,7 @@ void TSpline3::Streamer(TBuffer &R__b)
       R__b >> fValEnd;
       R__b >> fBegCond;
       R__b >> fEndCond;
+      FillCoeff();
    } else {
       R__b.WriteClassBuffer(TSpline3::Class(),this);
    }
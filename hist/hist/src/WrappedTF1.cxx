@@ -15,6 +15,7 @@
 #include "TClass.h"   // needed to copy the TF1 pointer
 
 #include <cmath>
+#include <vector>
 
 
 namespace ROOT {
@@ -96,6 +97,8 @@ namespace ROOT {
       {
          // evaluate the derivative of the function with respect to the parameters
          if (!fLinear) {
+            // use the analytic gradient of a formula when it is available
+            if (fFunc->AnalyticalGradientPar(&x, grad, par)) return;
             // need to set parameter values
             fFunc->SetParameters(par);
             // no need to call InitArgs (it is called in TF1::GradientPar)
@@ -124,6 +127,8 @@ namespace ROOT {
          //  so in case of fLinear (or fPolynomial) a non-zero value will be returned for fixed parameters
 
          if (! fLinear) {
+            std::vector<double> grad(NPar());
+            if (fFunc->AnalyticalGradientPar(&x, grad.data(), p)) return grad[ipar];
             fFunc->SetParameters(p);
             return fFunc->GradientPar(ipar, &x, GetDerivPrecision());
          } else if (fPolynomial) {
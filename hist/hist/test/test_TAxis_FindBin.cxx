@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+
+#include "TAxis.h"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TH3D.h"
+#include "TMath.h"
+#include "TProfile.h"
+#include "TRandom3.h"
+
+#include <algorithm>
+#include <vector>
+
+static std::vector<Double_t> MakeValues(Int_t n, UInt_t seed = 5)
+{
+   TRandom3 rnd(seed);
+   std::vector<Double_t> x(n);
+   for (auto &xi : x)
+      xi = rnd.Uniform(-1., 11.);
+   // Edges, under/overflows and NaN.
+   x[0] = 0.;
+   x[1] = 10.;
+   x[2] = 2.5;
+   x[3] = TMath::QuietNaN();
+   x[4] = -TMath::Infinity();
+   x[5] = TMath::Infinity();
+   return x;
+}
+
+static void CheckBatch(const TAxis &axis)
+{
+   auto x = MakeValues(1001);
+   std::vector<Int_t> bins(x.size());
+   axis.FindFixBin(x.size(), x.data(), bins.data());
+   for (size_t i = 0; i < x.size(); ++i)
+      EXPECT_EQ(axis.FindFixBin(x[i]), bins[i]) << "x = " << x[i];
+
+   // Every third value.
+   axis.FindFixBin(x.size() / 3, x.data(), bins.data(), 3);
+   for (size_t i = 0; i < x.size() / 3; ++i)
+      EXPECT_EQ(axis.FindFixBin(x[3 * i]), bins[i]) << "x = " << x[3 * i];
+}
+
+TEST(TAxis, FindFixBinBatchFixed)
+{
+   CheckBatch(TAxis(40, 0., 10.));
+   CheckBatch(TAxis(1, 0., 10.));
+}
+
+TEST(TAxis, FindFixBinBatchVariable)
+{
+   std::vector<Double_t> edges = {0., 0.1, 0.5, 2.5, 2.6, 4., 7., 10.};
+   CheckBatch(TAxis(edges.size() - 1, edges.data()));
+   std::vector<Double_t> two = {0., 10.};
+   CheckBatch(TAxis(1, two.data()));
+}
+
+TEST(TH1, FillNBatchedFindBin)
+{
+   auto x = MakeValues(1000);
+   auto y = MakeValues(1000, 6);
+   auto z = MakeValues(1000, 7);
+   std::rotate(y.begin(), y.begin() + 10, y.end());
+   // Profiles of NaN would not compare equal.
+   std::vector<Double_t> v(x.size());
+   for (size_t i = 0; i < x.size(); ++i)
+      v[i] = TMath::Finite(y[i]) ? y[i] : 0.;
+   std::vector<Double_t> w(x.size(), 0.5);
+
+   TH1D h1n("h1n", "", 40, 0., 10.), h1("h1", "", 40, 0., 10.);
+   TH2D h2n("h2n", "", 40, 0., 10., 20, 0., 10.), h2("h2", "", 40, 0., 10., 20, 0., 10.);
+   TH3D h3n("h3n", "", 10, 0., 10., 20, 0., 10., 5, 0., 10.), h3("h3", "", 10, 0., 10., 20, 0., 10., 5, 0., 10.);
+   TProfile pn("pn", "", 40, 0., 10.), p("p", "", 40, 0., 10.);
+   h1n.FillN(x.size(), x.data(), w.data());
+   h2n.FillN(x.size(), x.data(), y.data(), w.data());
+   h3n.FillN(x.size(), x.data(), y.data(), z.data(), w.data());
+   pn.FillN(x.size(), x.data(), v.data(), w.data());
+   for (size_t i = 0; i < x.size(); ++i) {
+      h1.Fill(x[i], w[i]);
+      h2.Fill(x[i], y[i], w[i]);
+      h3.Fill(x[i], y[i], z[i], w[i]);
+      p.Fill(x[i], v[i], w[i]);
+   }
+
+   for (Int_t bin = 0; bin < h1.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(bin), h1n.GetBinContent(bin));
+   for (Int_t bin = 0; bin < h2.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(h2.GetBinContent(bin), h2n.GetBinContent(bin));
+   for (Int_t bin = 0; bin < h3.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(h3.GetBinContent(bin), h3n.GetBinContent(bin));
+   for (Int_t bin = 0; bin < p.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(p.GetBinContent(bin), pn.GetBinContent(bin));
+   EXPECT_DOUBLE_EQ(h3.GetMean(3), h3n.GetMean(3));
+   EXPECT_DOUBLE_EQ(p.GetMean(2), pn.GetMean(2));
+}
@@ -0,0 +1,142 @@
+#include "TEfficiency.h"
+#include "TH1.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+// The errors of a copy are computed from scratch, as the cache is not copied.
+void CheckErrors(const TEfficiency &eff)
+{
+   TEfficiency reference(eff);
+   for (Int_t bin = 0; bin < eff.GetTotalHistogram()->GetNcells(); ++bin) {
+      EXPECT_EQ(reference.GetEfficiencyErrorLow(bin), eff.GetEfficiencyErrorLow(bin));
+      EXPECT_EQ(reference.GetEfficiencyErrorUp(bin), eff.GetEfficiencyErrorUp(bin));
+   }
+}
+
+void FillEfficiency(TEfficiency &eff, Int_t n, Bool_t weighted = kFALSE)
+{
+   TRandom3 rnd(1);
+   for (Int_t i = 0; i < n; ++i) {
+      Double_t x = rnd.Uniform(-1, 11);
+      Bool_t passed = rnd.Rndm() < 0.1 * x;
+      if (weighted)
+         eff.FillWeighted(passed, 0.5 * (1 + i % 3), x);
+      else
+         eff.Fill(passed, x);
+   }
+}
+
+TEST(TEfficiencyCache, StatisticOptions)
+{
+   TH1::AddDirectory(kFALSE);
+   TEfficiency eff("eff", "eff", 100, 0, 10);
+   FillEfficiency(eff, 20000);
+   for (Int_t option : {TEfficiency::kFCP, TEfficiency::kFNormal, TEfficiency::kFWilson, TEfficiency::kFAC,
+                        TEfficiency::kFFC, TEfficiency::kBJeffrey, TEfficiency::kBUniform, TEfficiency::kBBayesian,
+                        TEfficiency::kMidP}) {
+      eff.SetStatisticOption((TEfficiency::EStatOption)option);
+      eff.CacheErrors();
+      CheckErrors(eff);
+      eff.SetConfidenceLevel(0.95);
+      CheckErrors(eff);
+      eff.SetConfidenceLevel(0.683);
+   }
+   eff.SetStatisticOption(TEfficiency::kBBayesian);
+   eff.SetPosteriorMode();
+   CheckErrors(eff);
+   eff.SetBetaBinParameters(10, 2., 3.);
+   CheckErrors(eff);
+}
+
+TEST(TEfficiencyCache, ChangedBins)
+{
+   TH1::AddDirectory(kFALSE);
+   TEfficiency eff("eff", "eff", 100, 0, 10);
+   FillEfficiency(eff, 20000);
+   eff.CacheErrors();
+
+   eff.Fill(kTRUE, 5.);
+   CheckErrors(eff);
+   eff.SetPassedEvents(20, 0);
+   eff.SetTotalEvents(30, 1000);
+   CheckErrors(eff);
+   eff.CacheErrors();
+   CheckErrors(eff);
+}
+
+TEST(TEfficiencyCache, Weights)
+{
+   TH1::AddDirectory(kFALSE);
+   TEfficiency eff("eff", "eff", 100, 0, 10);
+   eff.SetUseWeightedEvents();
+   FillEfficiency(eff, 20000, kTRUE);
+   eff.SetStatisticOption(TEfficiency::kBJeffrey);
+   eff.CacheErrors();
+   CheckErrors(eff);
+   eff.FillWeighted(kFALSE, 2., 5.);
+   CheckErrors(eff);
+
+   // Frequentist errors with weights switch to the normal approximation.
+   eff.SetStatisticOption(TEfficiency::kFCP);
+   eff.CacheErrors();
+   EXPECT_EQ(TEfficiency::kFNormal, eff.GetStatisticOption());
+   CheckErrors(eff);
+}
+
+// Concurrent const calls fill the cache of the same object.
+TEST(TEfficiencyCache, ConcurrentGetErrors)
+{
+   TH1::AddDirectory(kFALSE);
+   TEfficiency eff("eff", "eff", 1000, 0, 10);
+   FillEfficiency(eff, 200000);
+   eff.SetStatisticOption(TEfficiency::kBJeffrey);
+   const TEfficiency reference(eff);
+   const Int_t ncells = eff.GetTotalHistogram()->GetNcells();
+
+   const Int_t nthreads = 8;
+   std::vector<std::vector<Double_t>> low(nthreads, std::vector<Double_t>(ncells));
+   std::vector<std::vector<Double_t>> up(nthreads, std::vector<Double_t>(ncells));
+   std::vector<std::thread> threads;
+   for (Int_t i = 0; i < nthreads; ++i) {
+      threads.emplace_back([&, i]() {
+         const TEfficiency &ceff = eff;
+         for (Int_t bin = 0; bin < ncells; ++bin) {
+            // each thread starts with other bins
+            Int_t ibin = (bin + i * ncells / nthreads) % ncells;
+            low[i][ibin] = ceff.GetEfficiencyErrorLow(ibin);
+            up[i][ibin] = ceff.GetEfficiencyErrorUp(ibin);
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+
+   for (Int_t i = 0; i < nthreads; ++i) {
+      for (Int_t bin = 0; bin < ncells; ++bin) {
+         EXPECT_EQ(reference.GetEfficiencyErrorLow(bin), low[i][bin]);
+         EXPECT_EQ(reference.GetEfficiencyErrorUp(bin), up[i][bin]);
+      }
+   }
+   CheckErrors(eff);
+}
+
+#ifdef R__USE_IMT
+TEST(TEfficiencyCache, Parallel)
+{
+   TH1::AddDirectory(kFALSE);
+   TEfficiency eff("eff", "eff", 1000, 0, 10);
+   FillEfficiency(eff, 200000);
+   for (Int_t option : {TEfficiency::kFCP, TEfficiency::kFFC, TEfficiency::kBUniform}) {
+      eff.SetStatisticOption((TEfficiency::EStatOption)option);
+      ROOT::EnableImplicitMT(2);
+      eff.CacheErrors();
+      ROOT::DisableImplicitMT();
+      CheckErrors(eff);
+   }
+}
+#endif
@@ -0,0 +1,45 @@
+#include "TFormula.h"
+#include "TInterpreter.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+TEST(TFormula, CompiledCache)
+{
+   TFormula f1("f1", "[0]*exp(-0.5*x*x)+[1]*y");
+   f1.SetParameters(2., 3.);
+   TFormula f2("f2", "sin(x)+TMath::Abs(y)");
+   Double_t x[2] = {0.5, -1.5};
+
+   // also the functions used for arrays of points are saved
+   const Double_t *xx[2] = {&x[0], &x[1]};
+   Double_t result;
+   f1.EvalPar(1, xx, &result);
+   EXPECT_DOUBLE_EQ(f1.EvalPar(x), result);
+
+   // a formula calling a function only known to the interpreter is not saved
+   ASSERT_TRUE(gInterpreter->Declare("double testTFormulaInterpreted(double x) { return 2 * x; }"));
+   TFormula f3("f3", "testTFormulaInterpreted(x)+[0]");
+   f3.SetParameter(0, 1.);
+   EXPECT_DOUBLE_EQ(2., f3.EvalPar(x));
+
+   const char *filename = "testTFormulaCompiledCache.C";
+   ASSERT_TRUE(TFormula::SaveCompiledFormulas(filename));
+   std::ifstream in(filename);
+   std::stringstream source;
+   source << in.rdbuf();
+   EXPECT_NE(std::string::npos, source.str().find("TMath::Exp"));
+   EXPECT_EQ(std::string::npos, source.str().find("testTFormulaInterpreted"));
+
+   // the formulas of this process use the functions compiled by Cling, the library
+   // is used by new processes
+   EXPECT_EQ(0, gSystem->Exec(TString::Format("./testTFormulaCompiledCacheLoad %s", filename)));
+
+   // loading the library again does not compile it
+   EXPECT_TRUE(TFormula::LoadCompiledFormulas(filename));
+   gSystem->Unlink(filename);
+}
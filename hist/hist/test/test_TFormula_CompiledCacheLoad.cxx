@@ -0,0 +1,65 @@
+// Load the library of formula functions saved by testTFormulaCompiledCache in a new
+// process, where Cling has compiled no formula yet, and check that the formulas with
+// the same expressions use the compiled functions.
+//
+// Usage: testTFormulaCompiledCacheLoad file.C
+
+#include "TFormula.h"
+#include "TInterpreter.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int check(const char *what, Double_t value, Double_t expected)
+{
+   if (std::abs(value - expected) <= 1.E-12 * (1 + std::abs(expected))) return 0;
+   std::cerr << what << ": " << value << " instead of " << expected << std::endl;
+   return 1;
+}
+
+int main(int argc, char **argv)
+{
+   if (argc != 2) {
+      std::cerr << "Usage: " << argv[0] << " file.C" << std::endl;
+      return 2;
+   }
+   if (!TFormula::LoadCompiledFormulas(argv[1])) return 1;
+
+   int iret = 0;
+   Double_t x[2] = {0.5, -1.5};
+   TFormula f1("f1", "[0]*exp(-0.5*x*x)+[1]*y");
+   f1.SetParameters(2., 3.);
+   iret |= check("f1", f1.EvalPar(x), 2 * std::exp(-0.125) - 4.5);
+   const Double_t *xx[2] = {&x[0], &x[1]};
+   Double_t result;
+   f1.EvalPar(1, xx, &result);
+   iret |= check("f1 on arrays", result, 2 * std::exp(-0.125) - 4.5);
+   TFormula f2("f2", "sin(x)+TMath::Abs(y)");
+   iret |= check("f2", f2.EvalPar(x), std::sin(0.5) + 1.5);
+
+   // a formula which is not in the library is still compiled by Cling
+   TFormula f4("f4", "x*y+[0]");
+   f4.SetParameter(0, 1.);
+   iret |= check("f4", f4.EvalPar(x), 0.25);
+
+   // Cling got only the declarations of the saved functions, so that their
+   // definitions can still be given to it
+   std::ifstream in(argv[1]);
+   std::string line;
+   int ndefinitions = 0;
+   while (std::getline(in, line)) {
+      if (line.compare(0, 9, "Double_t ") != 0 && line.compare(0, 5, "void ") != 0) continue;
+      ++ndefinitions;
+      if (!gInterpreter->Declare(("extern \"C\" { " + line + " }").c_str())) {
+         std::cerr << "Cling compiled the saved function " << line << std::endl;
+         iret = 1;
+      }
+   }
+   if (ndefinitions < 3) {
+      std::cerr << "Only " << ndefinitions << " functions were saved in " << argv[1] << std::endl;
+      iret = 1;
+   }
+   return iret;
+}
@@ -0,0 +1,120 @@
+#include "TF1.h"
+#include "TF12.h"
+#include "TF2.h"
+#include "TFormula.h"
+#include "TRandom3.h"
+#include "Math/WrappedMultiTF1.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+// Coordinates of n random points, one array per dimension.
+std::vector<std::vector<Double_t>> GetPoints(Int_t ndim, Int_t n)
+{
+   TRandom3 rnd(1);
+   std::vector<std::vector<Double_t>> x(ndim, std::vector<Double_t>(n));
+   for (Int_t i = 0; i < n; ++i)
+      for (Int_t j = 0; j < ndim; ++j)
+         x[j][i] = rnd.Uniform(-5, 5);
+   return x;
+}
+
+std::vector<const Double_t *> GetPointers(const std::vector<std::vector<Double_t>> &x)
+{
+   std::vector<const Double_t *> ptrs;
+   for (const auto &xj : x)
+      ptrs.push_back(xj.data());
+   return ptrs;
+}
+
+// Compare the evaluation at 1000 random points in one call, evalBatch(n, x, result), with the
+// evaluation at each point, evalPoint(x).
+template <class EVALBATCH, class EVALPOINT>
+void CheckEvalBatch(Int_t ndim, EVALBATCH evalBatch, EVALPOINT evalPoint)
+{
+   const Int_t n = 1000;
+   auto x = GetPoints(ndim, n);
+   std::vector<Double_t> result(n);
+   evalBatch(n, GetPointers(x).data(), result.data());
+   std::vector<Double_t> xx(ndim);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < ndim; ++j)
+         xx[j] = x[j][i];
+      EXPECT_DOUBLE_EQ(evalPoint(xx.data()), result[i]);
+   }
+}
+
+// Check EvalPar on arrays of points of a TFormula or a TF1.
+template <class FUNC>
+void CheckEvalPar(FUNC &f, Int_t ndim, const Double_t *params = nullptr)
+{
+   CheckEvalBatch(ndim, [&](Int_t n, const Double_t *const *x, Double_t *result) { f.EvalPar(n, x, result, params); },
+                  [&](const Double_t *x) { return f.EvalPar(x, params); });
+}
+
+TEST(TFormula, EvalBatch)
+{
+   TFormula f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2)+[3]*x");
+   f1.SetParameters(2, 0.5, 1.5, 0.1);
+   CheckEvalPar(f1, 1);
+   Double_t p[4] = {1, -1, 2, 0.5};
+   CheckEvalPar(f1, 1, p);
+
+   TFormula f2("f2", "sin(x)*cos(y)+[0]*z");
+   f2.SetParameter(0, 3.);
+   CheckEvalPar(f2, 3);
+
+   // without parameters
+   TFormula f3("f3", "x*x+TMath::Abs(y)");
+   CheckEvalPar(f3, 2);
+
+   // a copy evaluates the same way
+   TFormula f4(f1);
+   CheckEvalPar(f4, 1);
+
+   // the function is declared again when the formula changes
+   f3.Compile("x*y");
+   CheckEvalPar(f3, 2);
+}
+
+TEST(TFormula, EvalBatchLambda)
+{
+   TFormula f("f", "[](double *x, double *p){ return p[0]*x[0]*x[1]; }", 2, 1);
+   f.SetParameter(0, 2.);
+   CheckEvalPar(f, 2);
+}
+
+TEST(TF1, EvalBatch)
+{
+   TF1 f1("f1", "gaus", -5, 5);
+   f1.SetParameters(3, 0.2, 1.1);
+   CheckEvalPar(f1, 1);
+
+   // normalized function
+   TF1 f2("f2", "gausn", -5, 5);
+   f2.SetParameters(3, 0.2, 1.1);
+   f2.SetNormalized(true);
+   CheckEvalPar(f2, 1);
+
+   // function which is not a formula
+   TF1 f3("f3", [](double *x, double *p) { return p[0] * x[0] * x[0]; }, -5, 5, 1);
+   f3.SetParameter(0, 2);
+   CheckEvalPar(f3, 1);
+
+   // projection of a TF2
+   TF2 f4("f4", "x*x+[0]*y", -5, 5, -5, 5);
+   f4.SetParameter(0, 2);
+   TF12 f5("f5", &f4, 0.5, "y");
+   CheckEvalPar(f5, 1);
+}
+
+TEST(WrappedMultiTF1, EvalBatch)
+{
+   TF2 f("f", "[0]*x*y+[1]*y", -5, 5, -5, 5);
+   ROOT::Math::WrappedMultiTF1 wf(f, 2);
+   Double_t p[2] = {1.5, -2};
+
+   CheckEvalBatch(2, [&](Int_t n, const Double_t *const *x, Double_t *result) { wf(n, x, p, result); },
+                  [&](const Double_t *x) { return wf(x, p); });
+}
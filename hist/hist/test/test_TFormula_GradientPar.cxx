@@ -0,0 +1,142 @@
+#include "TF1.h"
+#include "TF2.h"
+#include "TFitResult.h"
+#include "TFormula.h"
+#include "TH1.h"
+#include "TRandom.h"
+#include "TROOT.h"
+#include "Math/WrappedMultiTF1.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+// Compare the analytic gradient with the numerical one of TF1::GradientPar.
+void CheckGradient(TF1 &f, const std::vector<Double_t> &points)
+{
+   const Int_t npar = f.GetNpar();
+   std::vector<Double_t> grad(npar), ref(npar);
+   for (Double_t xx : points) {
+      Double_t x[2] = {xx, 0.5 * xx};
+      ASSERT_TRUE(f.AnalyticalGradientPar(x, grad.data()));
+      f.GradientPar(x, ref.data(), 1.E-4);
+      for (Int_t i = 0; i < npar; ++i)
+         EXPECT_NEAR(ref[i], grad[i], 1.E-6 * (1 + std::abs(ref[i]))) << f.GetExpFormula() << " p" << i << " x=" << xx;
+   }
+}
+
+TEST(TFormula, GradientPar)
+{
+   std::vector<Double_t> points = {-2.5, -0.3, 0.7, 1.9};
+
+   TF1 f1("f1", "gaus", -5, 5);
+   f1.SetParameters(3, 0.2, 1.1);
+   CheckGradient(f1, points);
+
+   TF1 f2("f2", "expo", -5, 5);
+   f2.SetParameters(0.5, -0.3);
+   CheckGradient(f2, points);
+
+   TF1 f3("f3", "pol3", -5, 5);
+   f3.SetParameters(1, 2, 3, 4);
+   CheckGradient(f3, points);
+
+   TF1 f4("f4", "[0]*sin([1]*x)/sqrt([2]+x*x)+TMath::Power(abs(x-[3]),[4])+x^[1]", 0.1, 5);
+   f4.SetParameters(1.5, 0.7, 2, -3, 1.3);
+   CheckGradient(f4, {0.3, 1.2, 2.9});
+
+   TF1 f5("f5", "[0]*TMath::Gaus(x,[1],[2],true)+(x>[1] ? [3]*log(x-[1]+1) : [3]*x)", -5, 5);
+   f5.SetParameters(2, 0.1, 1.3, 0.7);
+   CheckGradient(f5, points);
+
+   TF2 f6("f6", "xygaus", -5, 5, -5, 5);
+   f6.SetParameters(2, 0.1, 1.3, -0.2, 0.8);
+   CheckGradient(f6, points);
+
+   // the parameters are passed to the gradient
+   TFormula f7("f7", "[0]*exp([1]*x)");
+   Double_t p[2] = {2, 0.5};
+   Double_t x = 1.5;
+   Double_t grad[2];
+   ASSERT_TRUE(f7.GradientPar(&x, grad, p));
+   EXPECT_DOUBLE_EQ(std::exp(0.75), grad[0]);
+   EXPECT_DOUBLE_EQ(2 * x * std::exp(0.75), grad[1]);
+}
+
+TEST(TFormula, NoGradientPar)
+{
+   // functions of the parameters without known derivatives
+   TFormula f1("f1", "landau");
+   EXPECT_FALSE(f1.HasGradientPar());
+   TFormula f2("f2", "[](double *x, double *p){ return p[0]*x[0]; }", 1, 1);
+   EXPECT_FALSE(f2.HasGradientPar());
+   // without parameters
+   TFormula f3("f3", "x*x");
+   EXPECT_FALSE(f3.HasGradientPar());
+
+   // a normalized function has only the numerical gradient
+   TF1 f4("f4", "gausn", -5, 5);
+   f4.SetParameters(3, 0.2, 1.1);
+   f4.SetNormalized(true);
+   Double_t grad[3];
+   Double_t x = 0.5;
+   EXPECT_FALSE(f4.AnalyticalGradientPar(&x, grad));
+
+   // any function of the variables can be used
+   TFormula f5("f5", "[0]*TMath::Landau(x,1,2)+[1]");
+   EXPECT_TRUE(f5.HasGradientPar());
+}
+
+TEST(TFormula, GradientParConcurrentFirstUse)
+{
+   // All the threads asking for the gradient while it is generated must get it.
+   ROOT::EnableThreadSafety();
+   TFormula f("f", "[0]*exp(-[1]*x)+[2]*sin([3]*x)");
+   const Int_t nThreads = 8;
+   std::vector<Int_t> ok(nThreads, 0);
+   std::vector<std::thread> threads;
+   for (Int_t i = 0; i < nThreads; ++i)
+      threads.emplace_back([&f, &ok, i]() {
+         Double_t x = 0.1 * i;
+         Double_t p[4] = {1, 0.5, 2, 3};
+         Double_t grad[4];
+         ok[i] = f.GradientPar(&x, grad, p);
+      });
+   for (auto &t : threads)
+      t.join();
+   for (Int_t i = 0; i < nThreads; ++i)
+      EXPECT_TRUE(ok[i]) << "thread " << i;
+}
+
+TEST(WrappedMultiTF1, GradientPar)
+{
+   TF1 f("f", "[0]*exp(-0.5*((x-[1])/[2])^2)+[3]*exp(-[4]*x)", 0, 10);
+   ROOT::Math::WrappedMultiTF1 wf(f, 1);
+   Double_t p[5] = {10, 5, 1.5, 3, 0.3};
+   Double_t x = 4.2;
+   std::vector<Double_t> grad(5);
+   wf.ParameterGradient(&x, p, grad.data());
+   for (unsigned int i = 0; i < 5; ++i)
+      EXPECT_DOUBLE_EQ(grad[i], wf.ParameterDerivative(&x, p, i));
+}
+
+TEST(TFormula, GradientFit)
+{
+   TH1::AddDirectory(kFALSE);
+   TF1 f("f", "[0]*exp(-0.5*((x-[1])/[2])^2)+[3]*exp(-[4]*x)", 0, 10);
+   f.SetParameters(10, 5, 1.5, 3, 0.3);
+   TH1D h("h", "h", 100, 0, 10);
+   gRandom->SetSeed(1);
+   for (Int_t i = 0; i < 10000; ++i)
+      h.Fill(f.GetRandom());
+
+   f.SetParameters(8, 4.5, 1, 2, 0.2);
+   TFitResultPtr r1 = h.Fit(&f, "SQ0");
+   f.SetParameters(8, 4.5, 1, 2, 0.2);
+   TFitResultPtr r2 = h.Fit(&f, "SQ0G");
+   ASSERT_EQ(0, r1->Status());
+   ASSERT_EQ(0, r2->Status());
+   for (Int_t i = 0; i < 5; ++i)
+      EXPECT_NEAR(r1->Parameter(i), r2->Parameter(i), 1.E-2 * r1->ParError(i));
+}
@@ -0,0 +1,112 @@
+#include "TGraph.h"
+#include "TMemFile.h"
+#include "TRandom3.h"
+#include "TSpline.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Points inside and outside [xmin, xmax], including the knots, in increasing order and shuffled.
+std::vector<Double_t> GetPoints(const TGraph &g, Bool_t sorted)
+{
+   TRandom3 rnd(1);
+   Double_t xmin = *std::min_element(g.GetX(), g.GetX() + g.GetN());
+   Double_t xmax = *std::max_element(g.GetX(), g.GetX() + g.GetN());
+   std::vector<Double_t> x(g.GetX(), g.GetX() + g.GetN());
+   for (Int_t i = 0; i < 5000; ++i)
+      x.push_back(rnd.Uniform(xmin - 1, xmax + 1));
+   if (sorted)
+      std::sort(x.begin(), x.end());
+   else
+      std::shuffle(x.begin(), x.end(), std::mt19937(2));
+   return x;
+}
+
+void CheckSpline(const TSpline3 &s, const TGraph &g)
+{
+   for (Bool_t sorted : {kTRUE, kFALSE}) {
+      std::vector<Double_t> x = GetPoints(g, sorted);
+      std::vector<Double_t> y(x.size());
+      s.Eval(x.size(), x.data(), y.data());
+      for (size_t i = 0; i < x.size(); ++i)
+         EXPECT_DOUBLE_EQ(s.Eval(x[i]), y[i]);
+   }
+}
+
+void CheckGraph(const TGraph &g, TSpline *s = nullptr, Option_t *option = "")
+{
+   for (Bool_t sorted : {kTRUE, kFALSE}) {
+      std::vector<Double_t> x = GetPoints(g, sorted);
+      std::vector<Double_t> y(x.size());
+      g.Eval(x.size(), x.data(), y.data(), s, option);
+      for (size_t i = 0; i < x.size(); ++i)
+         EXPECT_DOUBLE_EQ(g.Eval(x[i], s, option), y[i]);
+   }
+}
+
+TEST(TSpline3, EvalBatch)
+{
+   TRandom3 rnd(2);
+   std::vector<Double_t> x(50), y(50);
+   for (Int_t i = 0; i < 50; ++i) {
+      x[i] = i * 0.3 + (i % 7) * 0.01;
+      y[i] = std::sin(x[i]) + rnd.Gaus(0, 0.05);
+   }
+   TGraph g(50, x.data(), y.data());
+   TSpline3 s("s", x.data(), y.data(), 50);
+   CheckSpline(s, g);
+
+   // Equidistant knots.
+   TSpline3 se("se", 0., 10., y.data(), 50);
+   for (Int_t i = 0; i < 50; ++i)
+      x[i] = i * 10. / 49;
+   CheckSpline(se, TGraph(50, x.data(), y.data()));
+
+   // The contiguous coefficients follow the changes of the polynomials.
+   s.SetPointCoeff(10, 1., 2., 3.);
+   CheckSpline(s, g);
+}
+
+TEST(TSpline3, EvalBatchAfterIO)
+{
+   std::vector<Double_t> x = {0, 1, 2.5, 3, 4.5, 6};
+   std::vector<Double_t> y = {1, 3, 2, 2, 5, 4};
+   TSpline3 s("s", x.data(), y.data(), x.size());
+   TMemFile file("test_TGraph_Eval.root", "RECREATE");
+   file.WriteObject(&s, "s");
+   TSpline3 *ptr = nullptr;
+   file.GetObject("s", ptr);
+   std::unique_ptr<TSpline3> read(ptr);
+   ASSERT_TRUE(read != nullptr);
+   CheckSpline(*read, TGraph(x.size(), x.data(), y.data()));
+}
+
+TEST(TGraph, EvalBatch)
+{
+   TRandom3 rnd(3);
+   TGraph g;
+   for (Int_t i = 0; i < 200; ++i)
+      g.SetPoint(i, (Int_t)rnd.Uniform(0, 100), rnd.Gaus());
+
+   // Unsorted, with several points at the same abscissa.
+   CheckGraph(g);
+
+   g.Sort();
+   g.SetBit(TGraph::kIsSortedX);
+   CheckGraph(g);
+}
+
+TEST(TGraph, EvalBatchSpline)
+{
+   std::vector<Double_t> x = {0, 1, 2.5, 3, 4.5, 6, 6.5, 8};
+   std::vector<Double_t> y = {1, 3, 2, 2, 5, 4, 4, 1};
+   TGraph g(x.size(), x.data(), y.data());
+   TSpline3 s("s", &g);
+   CheckGraph(g, &s);
+   CheckGraph(g, nullptr, "S");
+}
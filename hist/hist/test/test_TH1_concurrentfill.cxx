@@ -0,0 +1,125 @@
+#include "TH1.h"
+#include "TH2.h"
+#include "TProfile.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+static const int kNThreads = 4;
+static const int kNFills = 100000;
+
+// Call fill kNFills times from each of kNThreads threads, thread i using the seed i + 1.
+template <class FILL>
+static void FillConcurrently(FILL fill)
+{
+   std::vector<std::thread> threads;
+   for (int i = 0; i < kNThreads; ++i)
+      threads.emplace_back([i, &fill]() {
+         TRandom3 rndm(i + 1);
+         for (int j = 0; j < kNFills; ++j)
+            fill(rndm);
+      });
+   for (auto &t : threads)
+      t.join();
+}
+
+// Call fill with the same random numbers as FillConcurrently, from one thread.
+template <class FILL>
+static void FillSequentially(FILL fill)
+{
+   for (int i = 0; i < kNThreads; ++i) {
+      TRandom3 rndm(i + 1);
+      for (int j = 0; j < kNFills; ++j)
+         fill(rndm);
+   }
+}
+
+static void ExpectEqual(const TH1 &ref, const TH1 &h)
+{
+   EXPECT_EQ(ref.GetEntries(), h.GetEntries());
+   EXPECT_NEAR(ref.GetMean(), h.GetMean(), 1E-10);
+   EXPECT_NEAR(ref.GetStdDev(), h.GetStdDev(), 1E-10);
+   for (int bin = 0; bin < ref.GetNcells(); ++bin) {
+      EXPECT_NEAR(ref.GetBinContent(bin), h.GetBinContent(bin), 1E-6);
+      EXPECT_NEAR(ref.GetBinError(bin), h.GetBinError(bin), 1E-6);
+   }
+}
+
+TEST(TH1ConcurrentFill, TH1D)
+{
+   ROOT::EnableThreadSafety();
+   TH1::AddDirectory(kFALSE);
+   TH1D ref("ref", "ref", 100, -5, 5);
+   TH1D h("h", "h", 100, -5, 5);
+   h.SetConcurrentFill();
+   EXPECT_TRUE(h.IsConcurrentFill());
+
+   FillSequentially([&ref](TRandom &rndm) { ref.Fill(rndm.Gaus(), rndm.Uniform(0.5, 1.5)); });
+   FillConcurrently([&h](TRandom &rndm) { h.Fill(rndm.Gaus(), rndm.Uniform(0.5, 1.5)); });
+   ExpectEqual(ref, h);
+
+   // The shadows are reset after being folded.
+   h.FlushConcurrentFill();
+   EXPECT_EQ(kNThreads * kNFills, h.GetEntries());
+
+   h.Reset();
+   EXPECT_EQ(0, h.GetEntries());
+   h.SetConcurrentFill(kFALSE);
+   EXPECT_FALSE(h.IsConcurrentFill());
+}
+
+TEST(TH1ConcurrentFill, TH2F)
+{
+   ROOT::EnableThreadSafety();
+   TH1::AddDirectory(kFALSE);
+   TH2F ref("ref", "ref", 20, -3, 3, 20, -3, 3);
+   TH2F h("h", "h", 20, -3, 3, 20, -3, 3);
+   h.SetConcurrentFill();
+
+   FillSequentially([&ref](TRandom &rndm) { ref.Fill(rndm.Gaus(), rndm.Gaus()); });
+   FillConcurrently([&h](TRandom &rndm) { h.Fill(rndm.Gaus(), rndm.Gaus()); });
+   ExpectEqual(ref, h);
+}
+
+TEST(TH1ConcurrentFill, TProfile)
+{
+   ROOT::EnableThreadSafety();
+   TH1::AddDirectory(kFALSE);
+   TProfile ref("ref", "ref", 50, 0, 1);
+   TProfile h("h", "h", 50, 0, 1);
+   h.SetConcurrentFill();
+
+   FillSequentially([&ref](TRandom &rndm) { ref.Fill(rndm.Rndm(), rndm.Gaus()); });
+   FillConcurrently([&h](TRandom &rndm) { h.Fill(rndm.Rndm(), rndm.Gaus()); });
+   ExpectEqual(ref, h);
+}
+
+TEST(TH1ConcurrentFill, Copy)
+{
+   ROOT::EnableThreadSafety();
+   TH1::AddDirectory(kFALSE);
+   TProfile ref("ref", "ref", 50, 0, 1);
+   TProfile h("h", "h", 50, 0, 1);
+   h.SetConcurrentFill();
+
+   FillSequentially([&ref](TRandom &rndm) { ref.Fill(rndm.Rndm(), rndm.Gaus()); });
+   FillConcurrently([&h](TRandom &rndm) { h.Fill(rndm.Rndm(), rndm.Gaus()); });
+
+   // Nothing has read h since the fill: the copies must fold the shadows themselves.
+   TProfile copy(h);
+   EXPECT_FALSE(copy.IsConcurrentFill());
+   ExpectEqual(ref, copy);
+
+   TH1D ref1("ref1", "ref1", 100, -5, 5);
+   TH1D h1("h1", "h1", 100, -5, 5);
+   h1.SetConcurrentFill();
+   FillSequentially([&ref1](TRandom &rndm) { ref1.Fill(rndm.Gaus()); });
+   FillConcurrently([&h1](TRandom &rndm) { h1.Fill(rndm.Gaus()); });
+   TH1D assigned;
+   assigned = h1;
+   ExpectEqual(ref1, assigned);
+}
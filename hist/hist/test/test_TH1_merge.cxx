@@ -0,0 +1,165 @@
+#include "TH1.h"
+#include "TH2.h"
+#include "THn.h"
+#include "TList.h"
+#include "TProfile.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+// The weights are multiples of 0.5: all sums are exact, whatever their order.
+
+void CheckMergeMany()
+{
+   TH1::AddDirectory(kFALSE);
+   TRandom3 rnd(1);
+   TH1D target("target", "target", 1000, -5, 5);
+   target.Sumw2();
+   target.Fill(0.1, 2.);
+   std::vector<Double_t> contents(target.GetNcells()), errors(target.GetNcells());
+   for (Int_t bin = 0; bin < target.GetNcells(); ++bin) {
+      contents[bin] = target.GetBinContent(bin);
+      errors[bin] = target.GetBinError(bin) * target.GetBinError(bin);
+   }
+   Double_t entries = target.GetEntries();
+
+   std::vector<std::unique_ptr<TH1D>> hists;
+   TList list;
+   for (Int_t i = 0; i < 2000; ++i) {
+      hists.emplace_back(new TH1D(TString::Format("h%d", i), "h", 1000, -5, 5));
+      hists.back()->Sumw2();
+      for (Int_t j = 0; j < 20; ++j)
+         hists.back()->Fill(rnd.Gaus(0, 2), 0.5 * (1 + j % 3));
+      for (Int_t bin = 0; bin < target.GetNcells(); ++bin) {
+         contents[bin] += hists.back()->GetBinContent(bin);
+         errors[bin] += hists.back()->GetBinError(bin) * hists.back()->GetBinError(bin);
+      }
+      entries += hists.back()->GetEntries();
+      list.Add(hists.back().get());
+   }
+
+   EXPECT_EQ(entries, target.Merge(&list));
+   for (Int_t bin = 0; bin < target.GetNcells(); ++bin) {
+      EXPECT_EQ(contents[bin], target.GetBinContent(bin));
+      EXPECT_EQ(errors[bin], target.GetBinError(bin) * target.GetBinError(bin));
+   }
+}
+
+void CheckMergeLarge()
+{
+   TH1::AddDirectory(kFALSE);
+   TRandom3 rnd(2);
+   TH2F target("target", "target", 1000, -5, 5, 1000, -5, 5);
+   std::vector<std::unique_ptr<TH2F>> hists;
+   TList list;
+   for (Int_t i = 0; i < 4; ++i) {
+      hists.emplace_back(new TH2F(TString::Format("h%d", i), "h", 1000, -5, 5, 1000, -5, 5));
+      for (Int_t j = 0; j < 100000; ++j)
+         hists.back()->Fill(rnd.Gaus(0, 2), rnd.Gaus(0, 2));
+      list.Add(hists.back().get());
+   }
+   TH2F reference(*hists[0]);
+   for (Int_t i = 1; i < 4; ++i)
+      reference.Add(hists[i].get());
+
+   target.Merge(&list);
+   EXPECT_EQ(reference.GetEntries(), target.GetEntries());
+   EXPECT_DOUBLE_EQ(reference.GetMean(1), target.GetMean(1));
+   for (Int_t bin = 0; bin < target.GetNcells(); ++bin)
+      EXPECT_EQ(reference.GetBinContent(bin), target.GetBinContent(bin));
+}
+
+void CheckMergeProfiles()
+{
+   TH1::AddDirectory(kFALSE);
+   TRandom3 rnd(3);
+   TProfile target("target", "target", 500, -5, 5);
+   TProfile reference("reference", "reference", 500, -5, 5);
+   std::vector<std::unique_ptr<TProfile>> profiles;
+   TList list;
+   for (Int_t i = 0; i < 2500; ++i) {
+      profiles.emplace_back(new TProfile(TString::Format("p%d", i), "p", 500, -5, 5));
+      for (Int_t j = 0; j < 20; ++j) {
+         Double_t x = rnd.Gaus(0, 2);
+         Double_t y = (Int_t)rnd.Uniform(0, 10);
+         profiles.back()->Fill(x, y);
+         reference.Fill(x, y);
+      }
+      list.Add(profiles.back().get());
+   }
+
+   target.Merge(&list);
+   EXPECT_EQ(reference.GetEntries(), target.GetEntries());
+   for (Int_t bin = 0; bin < target.GetNcells(); ++bin) {
+      EXPECT_EQ(reference.GetBinEntries(bin), target.GetBinEntries(bin));
+      EXPECT_DOUBLE_EQ(reference.GetBinContent(bin), target.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(reference.GetBinError(bin), target.GetBinError(bin));
+   }
+}
+
+void CheckMergeTHn()
+{
+   TRandom3 rnd(4);
+   Int_t bins[3] = {100, 100, 20};
+   Double_t xmin[3] = {-5, -5, 0};
+   Double_t xmax[3] = {5, 5, 1};
+   THnD target("target", "target", 3, bins, xmin, xmax);
+   THnD reference("reference", "reference", 3, bins, xmin, xmax);
+   target.Sumw2();
+   reference.Sumw2();
+   std::vector<std::unique_ptr<THnD>> hists;
+   TList list;
+   for (Int_t i = 0; i < 4; ++i) {
+      hists.emplace_back(new THnD(TString::Format("h%d", i), "h", 3, bins, xmin, xmax));
+      hists.back()->Sumw2();
+      for (Int_t j = 0; j < 10000; ++j) {
+         Double_t x[3] = {rnd.Gaus(0, 2), rnd.Gaus(0, 2), rnd.Rndm()};
+         hists.back()->Fill(x, 0.5);
+         reference.Fill(x, 0.5);
+      }
+      list.Add(hists.back().get());
+   }
+
+   target.Merge(&list);
+   EXPECT_EQ(reference.GetEntries(), target.GetEntries());
+   for (Long64_t bin = 0; bin < target.GetNbins(); ++bin) {
+      EXPECT_EQ(reference.GetBinContent(bin), target.GetBinContent(bin));
+      EXPECT_EQ(reference.GetBinError2(bin), target.GetBinError2(bin));
+   }
+}
+
+TEST(TH1Merge, ManyHistograms)
+{
+   CheckMergeMany();
+}
+
+TEST(TH1Merge, LargeHistograms)
+{
+   CheckMergeLarge();
+}
+
+TEST(TH1Merge, Profiles)
+{
+   CheckMergeProfiles();
+}
+
+TEST(TH1Merge, THn)
+{
+   CheckMergeTHn();
+}
+
+#ifdef R__USE_IMT
+TEST(TH1Merge, Parallel)
+{
+   ROOT::EnableImplicitMT(2);
+   CheckMergeMany();
+   CheckMergeLarge();
+   CheckMergeProfiles();
+   CheckMergeTHn();
+   ROOT::DisableImplicitMT();
+}
+#endif
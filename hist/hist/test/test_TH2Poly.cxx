@@ -0,0 +1,153 @@
+#include "TGraph.h"
+#include "TH2Poly.h"
+#include "TList.h"
+#include "TProfile2Poly.h"
+#include "TRandom3.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// Honeycomb with overlapping rectangles on top, whose bins must lose against the earlier hexagons.
+static void AddBins(TH2Poly &h)
+{
+   h.Honeycomb(0, 0, 0.5, 60, 40);
+   TRandom3 rnd(17);
+   for (int i = 0; i < 200; ++i) {
+      Double_t x = rnd.Uniform(-5, 50);
+      Double_t y = rnd.Uniform(-5, 35);
+      h.AddBin(x, y, x + rnd.Uniform(0.1, 3), y + rnd.Uniform(0.1, 3));
+   }
+}
+
+// The first bin containing (x,y), by brute force.
+static Int_t FindBinBruteForce(TH2Poly &h, Double_t x, Double_t y)
+{
+   TIter next(h.GetBins());
+   while (TH2PolyBin *bin = (TH2PolyBin *)next()) {
+      if (bin->IsInside(x, y))
+         return bin->GetBinNumber();
+   }
+   return -5;
+}
+
+TEST(TH2Poly, FindBin)
+{
+   TH2Poly h("h", "h", -10, 60, -10, 40);
+   AddBins(h);
+   TRandom3 rnd(4);
+   for (int i = 0; i < 20000; ++i) {
+      Double_t x = rnd.Uniform(-8, 58);
+      Double_t y = rnd.Uniform(-8, 38);
+      EXPECT_EQ(FindBinBruteForce(h, x, y), h.FindBin(x, y)) << x << ", " << y;
+   }
+   EXPECT_EQ(-1, h.FindBin(-20, 50));
+   EXPECT_EQ(-9, h.FindBin(70, -20));
+
+   // Bins added after the index was built are found.
+   Int_t bin = h.AddBin(-9.5, -9.5, -9, -9);
+   EXPECT_EQ(bin, h.FindBin(-9.2, -9.2));
+}
+
+static void CheckFillN()
+{
+   TH2Poly h1("h1", "h1", -10, 60, -10, 40);
+   TH2Poly h2("h2", "h2", -10, 60, -10, 40);
+   AddBins(h1);
+   AddBins(h2);
+   h1.Sumw2();
+   h2.Sumw2();
+
+   const Int_t n = 50000;
+   TRandom3 rnd(5);
+   std::vector<Double_t> x(2 * n), y(2 * n), w(2 * n);
+   for (Int_t i = 0; i < 2 * n; ++i) {
+      x[i] = rnd.Uniform(-15, 65);
+      y[i] = rnd.Uniform(-15, 45);
+      w[i] = rnd.Uniform(0, 2);
+   }
+   for (Int_t i = 0; i < 2 * n; i += 2)
+      h1.Fill(x[i], y[i], w[i]);
+   h2.FillN(2 * n, x.data(), y.data(), w.data(), 2);
+
+   std::vector<Int_t> bins(n);
+   h2.FindBin(n, x.data(), y.data(), bins.data(), 2);
+   for (Int_t i = 0; i < n; i += 97)
+      EXPECT_EQ(h1.FindBin(x[2 * i], y[2 * i]), bins[i]);
+
+   EXPECT_EQ(h1.GetEntries(), h2.GetEntries());
+   for (Int_t bin = -9; bin <= h1.GetNumberOfBins(); ++bin) {
+      if (bin == 0)
+         continue;
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(bin), h2.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(h1.GetBinError(bin), h2.GetBinError(bin));
+   }
+   EXPECT_DOUBLE_EQ(h1.GetMean(1), h2.GetMean(1));
+   EXPECT_DOUBLE_EQ(h1.GetMean(2), h2.GetMean(2));
+}
+
+TEST(TH2Poly, FillN)
+{
+   CheckFillN();
+}
+
+// TProfile2Poly overrides Fill: FillN must go through it.
+TEST(TH2Poly, TProfile2PolyFillN)
+{
+   TProfile2Poly p1("p1", "p1", -10, 60, -10, 40);
+   TProfile2Poly p2("p2", "p2", -10, 60, -10, 40);
+   p1.Honeycomb(0, 0, 0.5, 60, 40);
+   p2.Honeycomb(0, 0, 0.5, 60, 40);
+
+   const Int_t n = 20000;
+   TRandom3 rnd(6);
+   std::vector<Double_t> x(n), y(n), v(n);
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = rnd.Uniform(-15, 65);
+      y[i] = rnd.Uniform(-15, 45);
+      v[i] = rnd.Gaus(3, 1);
+   }
+   for (Int_t i = 0; i < n; ++i)
+      p1.Fill(x[i], y[i], v[i]);
+   p2.FillN(n, x.data(), y.data(), v.data(), 1);
+
+   EXPECT_EQ(p1.GetEntries(), p2.GetEntries());
+   for (Int_t bin = 1; bin <= p1.GetNumberOfBins(); ++bin) {
+      EXPECT_DOUBLE_EQ(p1.GetBinContent(bin), p2.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(p1.GetBinEntries(bin), p2.GetBinEntries(bin));
+      EXPECT_DOUBLE_EQ(p1.GetBinError(bin), p2.GetBinError(bin));
+   }
+   for (Int_t idx = 0; idx < 9; ++idx)
+      EXPECT_DOUBLE_EQ(p1.GetOverflowContent(idx), p2.GetOverflowContent(idx));
+   EXPECT_DOUBLE_EQ(p1.GetMean(1), p2.GetMean(1));
+   EXPECT_DOUBLE_EQ(p1.GetMean(2), p2.GetMean(2));
+}
+
+// A polygon changed in place (within its bounding box) is taken into account
+// after ChangePartition.
+TEST(TH2Poly, BinChangedInPlace)
+{
+   TH2Poly h("h", "h", -10, 10, -10, 10);
+   Int_t bin = h.AddBin(0, 0, 1, 1);
+   EXPECT_EQ(bin, h.FindBin(0.9, 0.9));
+
+   // Move the corner (1,1) of the rectangle to its center.
+   TGraph *g = (TGraph *)((TH2PolyBin *)h.GetBins()->At(0))->GetPolygon();
+   g->SetPoint(2, 0.5, 0.5);
+   h.ChangePartition(25, 25);
+   EXPECT_EQ(-5, h.FindBin(0.9, 0.9));
+   EXPECT_EQ(bin, h.FindBin(0.2, 0.2));
+}
+
+#ifdef R__USE_IMT
+TEST(TH2Poly, FillNParallel)
+{
+   ROOT::EnableImplicitMT(4);
+   CheckFillN();
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -0,0 +1,129 @@
+#include "TArrayCompact.h"
+#include "TBufferFile.h"
+#include "TError.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TMemFile.h"
+#include "TRandom3.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+TEST(TArrayCompact, Promotion)
+{
+   TArrayCompact a(3 * TArrayCompact::kBlockSize);
+   EXPECT_EQ(0, a.GetMemorySize());
+   a.Increment(1);
+   EXPECT_EQ(TArrayCompact::kUChar, a.GetBlockType(0));
+   EXPECT_EQ(TArrayCompact::kEmpty, a.GetBlockType(1));
+   for (int i = 0; i < 300; ++i)
+      a.Increment(2);
+   EXPECT_EQ(TArrayCompact::kUShort, a.GetBlockType(0));
+   EXPECT_EQ(1, a.At(1));
+   EXPECT_EQ(300, a.At(2));
+   a.SetAt(1e6, TArrayCompact::kBlockSize);
+   EXPECT_EQ(TArrayCompact::kUInt, a.GetBlockType(1));
+   a.AddAt(0.25, 2 * TArrayCompact::kBlockSize);
+   EXPECT_EQ(TArrayCompact::kDouble, a.GetBlockType(2));
+   EXPECT_EQ((2 + 4 + 8) * TArrayCompact::kBlockSize, a.GetMemorySize());
+   a.Reset();
+   EXPECT_EQ(0, a.GetMemorySize());
+   EXPECT_EQ(0, a.At(2));
+}
+
+// An unknown block type in the buffer must not be read as doubles into an unallocated block.
+TEST(TArrayCompact, BadBlockType)
+{
+   TArrayCompact a(2 * TArrayCompact::kBlockSize);
+   a.SetAt(3, 1);
+   a.SetAt(7, TArrayCompact::kBlockSize + 1);
+   TBufferFile buf(TBuffer::kWrite);
+   a.Streamer(buf);
+   const Int_t end = buf.Length();
+   buf << 12345;
+
+   // byte count and version, number of elements, then the type of the first block
+   const Int_t typePos = sizeof(UInt_t) + sizeof(Version_t) + sizeof(Int_t);
+   ASSERT_EQ(TArrayCompact::kUChar, (UChar_t)buf.Buffer()[typePos]);
+   buf.Buffer()[typePos] = TArrayCompact::kDouble + 1;
+
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   TArrayCompact b;
+   Int_t level = gErrorIgnoreLevel;
+   gErrorIgnoreLevel = kFatal;
+   b.Streamer(buf);
+   gErrorIgnoreLevel = level;
+   EXPECT_EQ(2 * TArrayCompact::kBlockSize, b.GetSize());
+   EXPECT_EQ(0, b.GetMemorySize());
+   EXPECT_EQ(0, b.At(1));
+   EXPECT_EQ(0, b.At(TArrayCompact::kBlockSize + 1));
+
+   // the rest of the buffer is still readable
+   EXPECT_EQ(end, buf.Length());
+   Int_t marker = 0;
+   buf >> marker;
+   EXPECT_EQ(12345, marker);
+}
+
+TEST(TH2Compact, FillAsTH2D)
+{
+   TH2D hd("hd", "hd", 200, -4, 4, 200, -4, 4);
+   TH2Compact hc("hc", "hc", 200, -4, 4, 200, -4, 4);
+   TRandom3 rnd(1);
+   for (int i = 0; i < 200000; ++i) {
+      Double_t x = rnd.Gaus(0, 0.3);
+      Double_t y = rnd.Gaus(0, 1.5);
+      hd.Fill(x, y);
+      hc.Fill(x, y);
+   }
+   // Occupancy contents take at most two bytes per bin.
+   EXPECT_LE(hc.GetMemorySize(), 2 * hc.GetNcells());
+   for (Int_t bin = 0; bin < hd.GetNcells(); ++bin)
+      EXPECT_EQ(hd.GetBinContent(bin), hc.GetBinContent(bin));
+   EXPECT_DOUBLE_EQ(hd.GetMean(1), hc.GetMean(1));
+   EXPECT_DOUBLE_EQ(hd.GetStdDev(2), hc.GetStdDev(2));
+
+   // Weighted fills switch the block to doubles.
+   Int_t bin = hc.Fill(0., 0., 0.5);
+   hd.Fill(0., 0., 0.5);
+   EXPECT_EQ(TArrayCompact::kDouble, hc.GetBlockType(bin >> TArrayCompact::kBlockBits));
+   EXPECT_DOUBLE_EQ(hd.GetBinContent(bin), hc.GetBinContent(bin));
+   EXPECT_DOUBLE_EQ(hd.GetBinError(bin), hc.GetBinError(bin));
+
+   hc.Scale(-1);
+   EXPECT_DOUBLE_EQ(-hd.GetBinContent(bin), hc.GetBinContent(bin));
+}
+
+TEST(TH3Compact, CopyAndIO)
+{
+   TH3Compact h("h3c", "h3c", 20, 0, 1, 20, 0, 1, 20, 0, 1);
+   TRandom3 rnd(2);
+   for (int i = 0; i < 100000; ++i)
+      h.Fill(rnd.Uniform(0, 0.1), rnd.Uniform(), rnd.Uniform());
+   h.SetBinContent(h.GetBin(15, 15, 15), 1e5);
+
+   TH3Compact copy(h);
+   TMemFile file("compact.root", "RECREATE");
+   file.WriteObject(&h, "h3c");
+   std::unique_ptr<TH3Compact> read(dynamic_cast<TH3Compact *>(file.Get("h3c")));
+   ASSERT_TRUE(read != nullptr);
+   EXPECT_EQ(h.GetMemorySize(), read->GetMemorySize());
+   for (Int_t bin = 0; bin < h.GetNcells(); ++bin) {
+      EXPECT_EQ(h.GetBinContent(bin), copy.GetBinContent(bin));
+      EXPECT_EQ(h.GetBinContent(bin), read->GetBinContent(bin));
+   }
+   EXPECT_EQ(h.GetEntries(), read->GetEntries());
+}
+
+TEST(TH1Compact, Rebin)
+{
+   TH1Compact h("h1c", "h1c", 100, 0, 10);
+   for (int i = 0; i < 1000; ++i)
+      h.Fill(i % 100 / 10. + 0.05);
+   std::unique_ptr<TH1> rebinned(h.Rebin(10, "rebinned"));
+   EXPECT_TRUE(dynamic_cast<TH1Compact *>(rebinned.get()) != nullptr);
+   EXPECT_EQ(100, rebinned->GetBinContent(3));
+}
@@ -0,0 +1,78 @@
+#include "ROOT/THist.hxx"
+#include "ROOT/THistConcurrentFill.hxx"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+using namespace ROOT::Experimental;
+
+// A statistics class with runtime polymorphism, which supports neither
+// FillAtomic() nor Add().
+template <int DIMENSIONS, class PRECISION, template <class P_> class STORAGE>
+class TFillCounter: public THistStatRuntime<DIMENSIONS, PRECISION, STORAGE> {
+public:
+  using typename THistStatRuntime<DIMENSIONS, PRECISION, STORAGE>::CoordArray_t;
+  using typename THistStatRuntime<DIMENSIONS, PRECISION, STORAGE>::Weight_t;
+
+  int fNCalls = 0;
+
+  TFillCounter() = default;
+  TFillCounter(size_t) {}
+
+  void DoFill(const CoordArray_t &, int, Weight_t) override { ++fNCalls; }
+};
+
+using HistD_t = THist<1, double, THistStatContent, THistStatUncertainty>;
+using HistRuntime_t = THist<1, double, THistStatContent, TFillCounter>;
+
+static_assert(HistD_t::ImplBase_t::Stat_t::HasConcurrentFill(), "THistStatContent supports concurrent fills");
+static_assert(!HistRuntime_t::ImplBase_t::Stat_t::HasConcurrentFill(),
+              "THistStatRuntime does not support concurrent fills");
+
+static const int kNThreads = 4;
+static const int kNFills = 10000;
+
+// Fill kNFills entries from each of kNThreads threads through a manager using `strategy`.
+template <class HIST>
+static void FillConcurrently(HIST &hist, EConcurrentFillStrategy strategy)
+{
+  THistConcurrentFillManager<HIST> fillMgr(hist, strategy);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNThreads; ++i)
+    threads.emplace_back([&fillMgr]() {
+      auto filler = fillMgr.MakeFiller();
+      for (int j = 0; j < kNFills; ++j)
+        filler.Fill({(j % 10) / 10. + 0.05}, 0.5);
+    });
+  for (auto &t : threads)
+    t.join();
+}
+
+TEST(THistConcurrentFill, Strategies)
+{
+  for (auto strategy : {EConcurrentFillStrategy::kMutex, EConcurrentFillStrategy::kSharded,
+                        EConcurrentFillStrategy::kAtomic}) {
+    HistD_t hist{{10, 0., 1.}};
+    FillConcurrently(hist, strategy);
+    EXPECT_EQ(kNThreads * kNFills, hist.GetEntries());
+    for (int bin = 1; bin <= 10; ++bin)
+      EXPECT_DOUBLE_EQ(kNThreads * kNFills / 10 * 0.5, hist.GetBinContent({bin / 10. - 0.05}));
+  }
+}
+
+TEST(THistConcurrentFill, RuntimeStat)
+{
+  for (auto strategy : {EConcurrentFillStrategy::kMutex, EConcurrentFillStrategy::kSharded,
+                        EConcurrentFillStrategy::kAtomic}) {
+    HistRuntime_t hist{{10, 0., 1.}};
+    {
+      THistConcurrentFillManager<HistRuntime_t> fillMgr(hist, strategy);
+      EXPECT_EQ(EConcurrentFillStrategy::kMutex, fillMgr.GetStrategy());
+    }
+    FillConcurrently(hist, strategy);
+    EXPECT_EQ(kNThreads * kNFills, hist.GetEntries());
+    EXPECT_EQ(kNThreads * kNFills, hist.GetImpl()->GetStat().fNCalls);
+  }
+}
@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+
+#include "TH2D.h"
+#include "THnSparse.h"
+#include "TList.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include <memory>
+#include <vector>
+
+// Fill with FillN and with Fill, for small (8 bytes) and large compact coordinates.
+static void CheckFillN(Int_t ndim, Int_t nbinsPerAxis)
+{
+   std::vector<Int_t> bins(ndim, nbinsPerAxis);
+   std::vector<Double_t> xmin(ndim, 0.);
+   std::vector<Double_t> xmax(ndim, 1.);
+   THnSparseD filln("filln", "", ndim, bins.data(), xmin.data(), xmax.data());
+   THnSparseD fill("fill", "", ndim, bins.data(), xmin.data(), xmax.data());
+   filln.Sumw2();
+   fill.Sumw2();
+
+   const Int_t n = 10000;
+   TRandom3 rnd(42);
+   std::vector<Double_t> x(n * ndim);
+   std::vector<Double_t> w(n);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t d = 0; d < ndim; ++d)
+         x[i * ndim + d] = rnd.Gaus(0.5, 0.1);
+      w[i] = rnd.Uniform(0.5, 1.5);
+   }
+   filln.FillN(n, x.data(), w.data());
+   for (Int_t i = 0; i < n; ++i)
+      fill.Fill(&x[i * ndim], w[i]);
+
+   ASSERT_EQ(fill.GetNbins(), filln.GetNbins());
+   EXPECT_DOUBLE_EQ(fill.GetEntries(), filln.GetEntries());
+   std::vector<Int_t> coord(ndim);
+   for (Long64_t bin = 0; bin < fill.GetNbins(); ++bin) {
+      Double_t v = fill.GetBinContent(bin, coord.data());
+      Long64_t other = filln.GetBin(coord.data());
+      ASSERT_LE(0, other);
+      EXPECT_DOUBLE_EQ(v, filln.GetBinContent(other));
+      EXPECT_DOUBLE_EQ(fill.GetBinError2(bin), filln.GetBinError2(other));
+   }
+}
+
+TEST(THnSparse, FillN)
+{
+   CheckFillN(3, 100);
+   CheckFillN(10, 1000);
+}
+
+static void CheckMerge()
+{
+   Int_t bins[3] = {50, 50, 50};
+   Double_t xmin[3] = {0., 0., 0.};
+   Double_t xmax[3] = {1., 1., 1.};
+   // Small chunks, so that the inputs have several chunks to process.
+   THnSparseF merged("merged", "", 3, bins, xmin, xmax, 64);
+   THnSparseF expected("expected", "", 3, bins, xmin, xmax, 64);
+   TList inputs;
+   inputs.SetOwner();
+
+   TRandom3 rnd(1);
+   Double_t x[3];
+   for (Int_t i = 0; i < 5; ++i) {
+      THnSparseF *h = i ? new THnSparseF(TString::Format("h%d", i), "", 3, bins, xmin, xmax, 64) : &merged;
+      if (i == 2)
+         h->Sumw2();
+      for (Int_t j = 0; j < 5000; ++j) {
+         for (Int_t d = 0; d < 3; ++d)
+            x[d] = rnd.Gaus(0.5, 0.15);
+         h->Fill(x);
+         expected.Fill(x);
+      }
+      if (i)
+         inputs.Add(h);
+   }
+   merged.Merge(&inputs);
+
+   EXPECT_TRUE(merged.GetCalculateErrors());
+   EXPECT_DOUBLE_EQ(expected.GetEntries(), merged.GetEntries());
+   ASSERT_EQ(expected.GetNbins(), merged.GetNbins());
+   Int_t coord[3];
+   for (Long64_t bin = 0; bin < expected.GetNbins(); ++bin) {
+      Double_t v = expected.GetBinContent(bin, coord);
+      Long64_t other = merged.GetBin(coord);
+      EXPECT_FLOAT_EQ(v, merged.GetBinContent(other));
+      EXPECT_FLOAT_EQ(v, merged.GetBinError2(other));
+   }
+}
+
+static void CheckProjection()
+{
+   Int_t bins[4] = {20, 30, 40, 50};
+   Double_t xmin[4] = {0., 0., 0., 0.};
+   Double_t xmax[4] = {1., 1., 1., 1.};
+   THnSparseD h("h", "", 4, bins, xmin, xmax);
+   TRandom3 rnd(7);
+   Double_t x[4];
+   for (Int_t i = 0; i < 200000; ++i) {
+      for (Int_t d = 0; d < 4; ++d)
+         x[d] = rnd.Uniform();
+      h.Fill(x);
+   }
+   h.GetAxis(2)->SetRange(5, 30);
+   std::unique_ptr<TH2D> proj(h.Projection(1, 0, "E"));
+   h.GetAxis(2)->SetRange();
+
+   TH2D ref("ref", "", 20, 0., 1., 30, 0., 1.);
+   Int_t coord[4];
+   for (Long64_t bin = 0; bin < h.GetNbins(); ++bin) {
+      Double_t v = h.GetBinContent(bin, coord);
+      if (coord[2] < 5 || coord[2] > 30)
+         continue;
+      ref.AddBinContent(ref.GetBin(coord[0], coord[1]), v);
+   }
+   for (Int_t bin = 0; bin < ref.GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(ref.GetBinContent(bin), proj->GetBinContent(bin));
+      EXPECT_NEAR(ref.GetBinContent(bin), proj->GetBinError(bin) * proj->GetBinError(bin), 1e-9);
+   }
+}
+
+TEST(THnSparse, Merge)
+{
+   CheckMerge();
+}
+
+TEST(THnSparse, Projection)
+{
+   CheckProjection();
+}
+
+#ifdef R__USE_IMT
+TEST(THnSparse, ParallelMergeAndProjection)
+{
+   ROOT::EnableImplicitMT(2);
+   CheckMerge();
+   CheckProjection();
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -0,0 +1,62 @@
+#include "TKDE.h"
+#include "TMath.h"
+#include "TRandom3.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static std::vector<Double_t> MakeData(UInt_t n)
+{
+   TRandom3 rnd(4357);
+   std::vector<Double_t> data(n);
+   for (auto &x : data)
+      x = rnd.Gaus(0., 1.);
+   return data;
+}
+
+TEST(TKDE, FixedGaussian)
+{
+   auto data = MakeData(2000);
+   TKDE kde(data.size(), data.data(), -5., 5., "KernelType:Gaussian;Iteration:Fixed;Mirror:noMirror;Binning:Unbinned");
+   Double_t w = kde.GetFixedWeight();
+   for (Double_t x = -4.; x <= 4.; x += 0.25) {
+      Double_t expected = 0.;
+      for (auto d : data)
+         expected += TMath::Gaus(x, d, w, kTRUE);
+      expected /= data.size();
+      EXPECT_NEAR(expected, kde(x), 1e-12 * expected + 1e-15);
+   }
+}
+
+TEST(TKDE, FastEvaluation)
+{
+   auto data = MakeData(2000);
+   for (auto option : {"KernelType:Gaussian;Iteration:Fixed;Mirror:noMirror;Binning:Unbinned",
+                       "KernelType:Gaussian;Iteration:Adaptive;Mirror:noMirror;Binning:Unbinned",
+                       "KernelType:Epanechnikov;Iteration:Adaptive;Mirror:MirrorAsymLeft;Binning:Unbinned"}) {
+      TKDE exact(data.size(), data.data(), -5., 5., option);
+      TKDE fast(data.size(), data.data(), -5., 5., option);
+      fast.SetFastEvaluation(1 << 14);
+      for (Double_t x = -3.; x <= 3.; x += 0.1) {
+         Double_t expected = exact(x);
+         EXPECT_NEAR(expected, fast(x), 1e-3 * std::abs(expected) + 1e-6) << option << " at " << x;
+      }
+      // Back to the exact evaluation.
+      fast.SetFastEvaluation(0);
+      EXPECT_DOUBLE_EQ(exact(0.5), fast(0.5));
+   }
+}
+
+TEST(TKDE, GetValues)
+{
+   auto data = MakeData(5000);
+   TKDE kde(data.size(), data.data(), -5., 5., "KernelType:Biweight;Iteration:Adaptive;Mirror:noMirror;Binning:Unbinned");
+   std::vector<Double_t> x(1000), values(x.size());
+   for (UInt_t i = 0; i < x.size(); ++i)
+      x[i] = -5. + 10. * i / x.size();
+   kde.GetValues(x.size(), x.data(), values.data());
+   for (UInt_t i = 0; i < x.size(); ++i)
+      EXPECT_EQ(kde(x[i]), values[i]);
+}
@@ -46,6 +46,10 @@ public:
     return std::array_view<Weight_t>(fWBuf.begin(), fWBuf.begin() + fCursor);
   }
 
+  /// Discard the buffered coordinates and weights, e.g. after they have been
+  /// flushed.
+  void ClearBuffer() noexcept { fCursor = 0; }
+
   void Fill(const CoordArray_t& x, Weight_t weight = 1.) {
     fXBuf[fCursor] = x;
     fWBuf[fCursor++] = weight;
@@ -18,7 +18,11 @@
 #include "ROOT/RArrayView.hxx"
 #include "ROOT/THistBufferedFill.hxx"
 
+#include <algorithm>
+#include <memory>
 #include <mutex>
+#include <type_traits>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -26,6 +30,25 @@ namespace Experimental {
 
 template <class HIST, int SIZE> class THistConcurrentFillManager;
 
+/**
+ \enum EConcurrentFillStrategy
+ How THistConcurrentFillManager synchronizes the fillers' updates of the
+ histogram.
+ **/
+enum class EConcurrentFillStrategy {
+  /// Each filler's buffer is flushed into the histogram under a lock.
+  kMutex,
+  /// Each filler fills its own copy ("shard") of the bin statistics; the shards
+  /// are merged into the histogram when it is read through the manager.
+  /// Fillers never wait for each other, at the cost of one copy of the bin
+  /// statistics per filler.
+  kSharded,
+  /// Fillers update the bin statistics of the histogram directly with atomic
+  /// operations. No extra memory, but fills of the same bins (and the entry
+  /// counter) by different threads contend for the same cache lines.
+  kAtomic
+};
+
 
 /**
  \class THistConcurrentFiller
@@ -36,14 +59,22 @@ template <class HIST, int SIZE> class THistConcurrentFillManager;
 template <class HIST, int SIZE>
 class THistConcurrentFiller:
    public Internal::THistBufferedFillBase<THistConcurrentFiller<HIST, SIZE>, HIST, SIZE> {
+  using Shard_t = typename THistConcurrentFillManager<HIST, SIZE>::TShard;
+
   THistConcurrentFillManager<HIST, SIZE>& fManager;
+  std::shared_ptr<Shard_t> fShard; ///< This filler's shard, for EConcurrentFillStrategy::kSharded
 
 public:
   using CoordArray_t = typename HIST::CoordArray_t;
   using Weight_t = typename HIST::Weight_t;
 
-  THistConcurrentFiller(THistConcurrentFillManager<HIST, SIZE>& manager):
-  fManager(manager) {}
+  THistConcurrentFiller(THistConcurrentFillManager<HIST, SIZE>& manager,
+                        std::shared_ptr<Shard_t> shard = nullptr):
+  fManager(manager), fShard(std::move(shard)) {}
+
+  /// Flush while the shard is still alive; the base class flush then finds
+  /// an empty buffer.
+  ~THistConcurrentFiller() { Flush(); }
 
   /// Thread-specific HIST::Fill().
   using Internal::THistBufferedFillBase<THistConcurrentFiller<HIST, SIZE>, HIST, SIZE>::Fill;
@@ -51,20 +82,23 @@ public:
   /// Thread-specific HIST::FillN().
   void FillN(const std::array_view<CoordArray_t> xN,
              const std::array_view<Weight_t> weightN) {
-    fManager.FillN(xN, weightN);
+    fManager.FillNShard(xN, weightN, fShard.get());
   }
 
   /// Thread-specific HIST::FillN().
   void FillN(const std::array_view<CoordArray_t> xN) {
-    fManager.FillN(xN);
+    fManager.FillNShard(xN, fShard.get());
   }
 
   /// The buffer is full, flush it out.
   void Flush() {
-    fManager.FillN(this->GetCoords(), this->GetWeights());
+    if (this->GetCoords().empty())
+      return;
+    fManager.FillNShard(this->GetCoords(), this->GetWeights(), fShard.get());
+    this->ClearBuffer();
   }
 
-  HIST& GetHist() { return fManager->GetHist(); }
+  HIST& GetHist() { return fManager.GetHist(); }
   operator HIST&() { return GetHist(); }
 
   static constexpr int GetNDim() { return HIST::GetNDim(); }
@@ -76,9 +110,17 @@ public:
 
  The HIST template can be a THist instance. This class hands out
  THistConcurrentFiller objects that can concurrently fill the histogram. They
- buffer calls to Fill() until the buffer is full, and then swap the buffer
- with that of the THistConcurrentFillManager. The manager than fills the
- histogram.
+ buffer calls to Fill() until the buffer is full, and then pass the buffer
+ to the THistConcurrentFillManager, which fills the histogram according to
+ its EConcurrentFillStrategy.
+
+ The kSharded and kAtomic strategies need statistics that provide FillAtomic()
+ and Add() (see THistData::HasConcurrentFill()); with other statistics, for
+ instance THistStatRuntime, the manager uses the kMutex strategy.
+
+ With the kSharded and kAtomic strategies the bin index is determined without
+ growing the axes. With the kSharded strategy the histogram is only up to date
+ after GetHist() (or the destruction of the manager), which merges the shards.
  **/
 
 template <class HIST, int SIZE = 1024>
@@ -88,32 +130,146 @@ public:
   using Hist_t = HIST;
   using CoordArray_t = typename HIST::CoordArray_t;
   using Weight_t = typename HIST::Weight_t;
+  /// The bin statistics of the histogram.
+  using Stat_t = typename HIST::ImplBase_t::Stat_t;
+
+  /// Bin statistics filled by one filler, for the kSharded strategy.
+  struct TShard {
+    std::mutex fMutex;  ///< Serializes the filler's flushes and the merge into the histogram
+    Stat_t fStat;       ///< Statistics filled since the last merge
+    bool fEmpty = true; ///< Whether nothing was filled since the last merge
+
+    TShard(size_t nbins): fStat(nbins) {}
+  };
 
 private:
+  /// Whether the statistics support the kSharded and kAtomic strategies.
+  using HasConcurrentFill_t = std::integral_constant<bool, Stat_t::HasConcurrentFill()>;
+
   HIST &fHist;
-  std::mutex fFillMutex; // should become a spin lock
+  EConcurrentFillStrategy fStrategy;
+  std::mutex fFillMutex; ///< Protects the histogram (kMutex) and the list of shards (kSharded)
+  std::vector<std::shared_ptr<TShard>> fShards; ///< Shards handed out to the fillers
+
+  /// Fill the points into `stat`, using `fill(stat, x, bin, weight)`.
+  template <class STAT, class FILL, class WEIGHTS>
+  void FillStat(STAT &stat, const std::array_view<CoordArray_t> xN, const WEIGHTS &weightN, FILL fill) {
+    const auto *impl = fHist.GetImpl();
+    for (size_t i = 0; i < xN.size(); ++i) {
+      int bin = impl->GetBinIndex(xN[i]);
+      if (bin >= 0)
+        fill(stat, xN[i], bin, weightN(i));
+    }
+  }
+
+  /// Statistics without FillAtomic() and Add() only use the kMutex strategy.
+  template <class WEIGHTS>
+  bool FillNUnlocked(const std::array_view<CoordArray_t>, const WEIGHTS &, TShard *, std::false_type) {
+    return false;
+  }
+
+  /// Fill the points without taking the manager's lock, if the strategy
+  /// allows it. Returns false if the points have not been filled.
+  template <class WEIGHTS>
+  bool FillNUnlocked(const std::array_view<CoordArray_t> xN, const WEIGHTS &weightN, TShard *shard,
+                     std::true_type) {
+    if (fStrategy == EConcurrentFillStrategy::kAtomic) {
+      FillStat(fHist.GetImpl()->GetStat(), xN, weightN,
+               [](Stat_t &stat, const CoordArray_t &x, int bin, Weight_t w) { stat.FillAtomic(x, bin, w); });
+      return true;
+    }
+    if (fStrategy == EConcurrentFillStrategy::kSharded && shard) {
+      std::lock_guard<std::mutex> lockGuard(shard->fMutex);
+      FillStat(shard->fStat, xN, weightN,
+               [](Stat_t &stat, const CoordArray_t &x, int bin, Weight_t w) { stat.Fill(x, bin, w); });
+      shard->fEmpty = false;
+      return true;
+    }
+    return false;
+  }
+
+  /// Thread-specific HIST::FillN(), filling `shard` for the kSharded strategy.
+  void FillNShard(const std::array_view<CoordArray_t> xN,
+                  const std::array_view<Weight_t> weightN, TShard *shard) {
+    if (FillNUnlocked(xN, [&weightN](size_t i) { return weightN[i]; }, shard, HasConcurrentFill_t()))
+      return;
+    std::lock_guard<std::mutex> lockGuard(fFillMutex);
+    fHist.FillN(xN, weightN);
+  }
+
+  /// Thread-specific HIST::FillN(), filling `shard` for the kSharded strategy.
+  void FillNShard(const std::array_view<CoordArray_t> xN, TShard *shard) {
+    if (FillNUnlocked(xN, [](size_t) { return (Weight_t)1; }, shard, HasConcurrentFill_t()))
+      return;
+    std::lock_guard<std::mutex> lockGuard(fFillMutex);
+    fHist.FillN(xN);
+  }
 
 public:
-  THistConcurrentFillManager(HIST &hist): fHist(hist)
+  THistConcurrentFillManager(HIST &hist, EConcurrentFillStrategy strategy = EConcurrentFillStrategy::kMutex):
+  fHist(hist), fStrategy(HasConcurrentFill_t::value ? strategy : EConcurrentFillStrategy::kMutex)
   { }
 
+  /// Merges the remaining shards into the histogram. All fillers must have
+  /// been destroyed.
+  ~THistConcurrentFillManager() { MergeShards(); }
+
+  /// The strategy used to synchronize the fillers.
+  EConcurrentFillStrategy GetStrategy() const { return fStrategy; }
+
   THistConcurrentFiller<HIST, SIZE> MakeFiller() {
-    return THistConcurrentFiller<HIST, SIZE>{*this};
+    std::shared_ptr<TShard> shard;
+    if (fStrategy == EConcurrentFillStrategy::kSharded) {
+      shard = std::make_shared<TShard>(fHist.GetImpl()->GetNBins());
+      std::lock_guard<std::mutex> lockGuard(fFillMutex);
+      fShards.push_back(shard);
+    }
+    return THistConcurrentFiller<HIST, SIZE>{*this, shard};
   }
 
   /// Thread-specific HIST::FillN().
   void FillN(const std::array_view<CoordArray_t> xN,
              const std::array_view<Weight_t> weightN) {
-    std::lock_guard<std::mutex> lockGuard(fFillMutex);
-    fHist.FillN(xN, weightN);
+    FillNShard(xN, weightN, nullptr);
   }
 
   /// Thread-specific HIST::FillN().
   void FillN(const std::array_view<CoordArray_t> xN) {
-    std::lock_guard<std::mutex> lockGuard(fFillMutex);
-    fHist.FillN(xN);
+    FillNShard(xN, nullptr);
+  }
+
+  /// Add the content of the fillers' shards to the histogram and reset them.
+  /// Only needed for the kSharded strategy. Content still buffered by the
+  /// fillers is not included.
+  void MergeShards() { MergeShards(HasConcurrentFill_t()); }
+
+  /// Get the histogram, merging the shards first.
+  HIST &GetHist() {
+    MergeShards();
+    return fHist;
   }
 
+private:
+  /// Without Add() there are no shards to merge.
+  void MergeShards(std::false_type) {}
+
+  /// See MergeShards().
+  void MergeShards(std::true_type) {
+    std::lock_guard<std::mutex> lockGuard(fFillMutex);
+    auto &stat = fHist.GetImpl()->GetStat();
+    for (auto &shard: fShards) {
+      std::lock_guard<std::mutex> shardLockGuard(shard->fMutex);
+      if (shard->fEmpty)
+        continue;
+      stat.Add(shard->fStat);
+      shard->fStat = Stat_t(fHist.GetImpl()->GetNBins());
+      shard->fEmpty = true;
+    }
+    // Drop the shards whose filler is gone.
+    fShards.erase(std::remove_if(fShards.begin(), fShards.end(),
+                                 [](const std::shared_ptr<TShard> &shard) { return shard.use_count() == 1; }),
+                  fShards.end());
+  }
 };
 
 } // namespace Experimental
@@ -91,6 +91,19 @@ public:
     ++fEntries;
   }
 
+  /// Add weight to the bin content at binidx; can be called concurrently.
+  void FillAtomic(const CoordArray_t& /*x*/, int binidx, Weight_t weight = 1.) {
+    Hist::Internal::AtomicAdd(fBinContent[binidx], weight);
+    Hist::Internal::AtomicAdd(fEntries, (int64_t)1);
+  }
+
+  /// Add the content of `other`, which has the same number of bins.
+  void Add(const THistStatContent& other) {
+    fEntries += other.fEntries;
+    for (size_t i = 0, n = fBinContent.size(); i < n; ++i)
+      fBinContent[i] += other.fBinContent[i];
+  }
+
   /// Get the number of entries filled into the histogram - i.e. the number of
   /// calls to Fill().
   int64_t GetEntries() const { return fEntries; }
@@ -151,6 +164,16 @@ public:
     fSumWeights += weight;
   }
 
+  /// Add weight to the sum of weights; can be called concurrently.
+  void FillAtomic(const CoordArray_t& /*x*/, int, Weight_t weight = 1.) {
+    Hist::Internal::AtomicAdd(fSumWeights, weight);
+  }
+
+  /// Add the sum of weights of `other`.
+  void Add(const THistStatTotalSumOfWeights& other) {
+    fSumWeights += other.fSumWeights;
+  }
+
   /// Get the sum of weights.
   Weight_t GetSumOfWeights() const { return fSumWeights; }
 
@@ -194,6 +217,16 @@ public:
     fSumWeights2 += weight * weight;
   }
 
+  /// Add weight to the sum of squared weights; can be called concurrently.
+  void FillAtomic(const CoordArray_t& /*x*/, int /*binidx*/, Weight_t weight = 1.) {
+    Hist::Internal::AtomicAdd(fSumWeights2, (Weight_t)(weight * weight));
+  }
+
+  /// Add the sum of squared weights of `other`.
+  void Add(const THistStatTotalSumOfSquaredWeights& other) {
+    fSumWeights2 += other.fSumWeights2;
+  }
+
   /// Get the sum of weights.
   Weight_t GetSumOfSquaredWeights() const { return fSumWeights2; }
 
@@ -263,6 +296,18 @@ public:
     fSumWeightsSquared[binidx] += weight * weight;
   }
 
+  /// Add weight to the bin at binidx; can be called concurrently.
+  void FillAtomic(const CoordArray_t& /*x*/, int binidx, Weight_t weight = 1.) {
+    Hist::Internal::AtomicAdd(fSumWeightsSquared[binidx], (Weight_t)(weight * weight));
+  }
+
+  /// Add the sums of squared weights of `other`, which has the same number of
+  /// bins.
+  void Add(const THistStatUncertainty& other) {
+    for (size_t i = 0, n = fSumWeightsSquared.size(); i < n; ++i)
+      fSumWeightsSquared[i] += other.fSumWeightsSquared[i];
+  }
+
   /// Calculate a bin's (Poisson) uncertainty of the bin content as the
   /// square-root of the bin's sum of squared weights.
   double GetBinUncertaintyImpl(int binidx) const {
@@ -326,6 +371,23 @@ public:
       fMomentX2W[idim] += x[idim] * xw;
     }
   }
+
+  /// Add weight to the bin at binidx; can be called concurrently.
+  void FillAtomic(const CoordArray_t &x, int /*binidx*/, Weight_t weight = 1.) {
+    for (int idim = 0; idim < DIMENSIONS; ++idim) {
+      const PRECISION xw = x[idim] * weight;
+      Hist::Internal::AtomicAdd(fMomentXW[idim], xw);
+      Hist::Internal::AtomicAdd(fMomentX2W[idim], (PRECISION)(x[idim] * xw));
+    }
+  }
+
+  /// Add the moments of `other`.
+  void Add(const THistDataMomentUncert& other) {
+    for (int idim = 0; idim < DIMENSIONS; ++idim) {
+      fMomentXW[idim] += other.fMomentXW[idim];
+      fMomentX2W[idim] += other.fMomentX2W[idim];
+    }
+  }
 };
 
 
@@ -431,6 +493,14 @@ private:
   template <class T>
   static char HaveUncertainty(...);
 
+  /// Check whether `T::FillAtomic()` and `T::Add()` can be called.
+  template <class T>
+  static auto HaveConcurrentFill(T* This)
+    -> decltype(This->FillAtomic(Hist::CoordArray_t<DIMENSIONS>(), 0), This->Add(*This), std::true_type());
+  /// Fall-back case for check whether `T::FillAtomic()` and `T::Add()` can be called.
+  template <class T>
+  static std::false_type HaveConcurrentFill(...);
+
 public:
   /// Matching THist
   using Hist_t = THist<DIMENSIONS, PRECISION, STAT...>;
@@ -479,6 +549,26 @@ public:
     (void)trigger_base_fill{ (STAT<DIMENSIONS, PRECISION, STORAGE>::Fill(x, binidx, weight), 0)... };
   }
 
+  /// Fill weight at x to the bin content at binidx using atomic operations,
+  /// such that several threads can fill concurrently. See Fill().
+  void FillAtomic(const CoordArray_t& x, int binidx, Weight_t weight = 1.) {
+    using trigger_base_fill = int[];
+    (void)trigger_base_fill{ (STAT<DIMENSIONS, PRECISION, STORAGE>::FillAtomic(x, binidx, weight), 0)... };
+  }
+
+  /// Whether all statistics provide FillAtomic() and Add(), which are needed
+  /// by FillAtomic() and Add() of this class. THistStatRuntime does not.
+  static constexpr bool HasConcurrentFill() {
+    return Hist::Internal::AllOf(
+      decltype(HaveConcurrentFill<STAT<DIMENSIONS, PRECISION, STORAGE>>(nullptr))::value...);
+  }
+
+  /// Add the statistics of `other`, which has the same binning, to this one.
+  void Add(const THistData& other) {
+    using trigger_base_add = int[];
+    (void)trigger_base_add{ (STAT<DIMENSIONS, PRECISION, STORAGE>::Add(other), 0)... };
+  }
+
   /// Whether this provides storage for uncertainties, or whether uncertainties
   /// are determined as poisson uncertainty of the content.
   static constexpr bool HasBinUncertainty() {
@@ -16,6 +16,8 @@
 #define ROOT7_THistUtils_h
 
 #include <array>
+#include <atomic>
+#include <type_traits>
 
 namespace ROOT {
 namespace Experimental {
@@ -24,6 +26,60 @@ namespace Hist {
 template <int DIMENSIONS>
 using CoordArray_t = std::array<double, DIMENSIONS>;
 
+namespace Internal {
+
+#if defined(__GNUC__) || defined(__clang__)
+/// AtomicAdd() for integral types.
+template <class T>
+void AtomicAddImpl(T &target, T value, std::true_type /*isIntegral*/) noexcept
+{
+  __atomic_fetch_add(&target, value, __ATOMIC_RELAXED);
+}
+
+/// AtomicAdd() for floating point types: compare-and-swap loop.
+template <class T>
+void AtomicAddImpl(T &target, T value, std::false_type /*isIntegral*/) noexcept
+{
+  T expected;
+  __atomic_load(&target, &expected, __ATOMIC_RELAXED);
+  T desired;
+  do {
+    desired = expected + value;
+  } while (!__atomic_compare_exchange(&target, &expected, &desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+#endif
+
+/// Whether all arguments are true; AllOf() is true.
+constexpr bool AllOf() noexcept
+{
+  return true;
+}
+
+template <class... BOOLS>
+constexpr bool AllOf(bool first, BOOLS... rest) noexcept
+{
+  return first && AllOf(rest...);
+}
+
+/// Atomically add `value` to `target`. All concurrent modifications of
+/// `target` must go through AtomicAdd().
+template <class T>
+void AtomicAdd(T &target, T value) noexcept
+{
+  static_assert(std::is_arithmetic<T>::value, "AtomicAdd() requires an arithmetic type");
+#if defined(__GNUC__) || defined(__clang__)
+  AtomicAddImpl(target, value, std::is_integral<T>());
+#else
+  static_assert(sizeof(std::atomic<T>) == sizeof(T), "std::atomic<T> must have the layout of T");
+  auto &atomicTarget = reinterpret_cast<std::atomic<T> &>(target);
+  T expected = atomicTarget.load(std::memory_order_relaxed);
+  while (!atomicTarget.compare_exchange_weak(expected, (T)(expected + value), std::memory_order_relaxed)) {
+  }
+#endif
+}
+
+} // namespace Internal
+
 
 } // namespace Hist
 } // namespace Experimental
@@ -0,0 +1,91 @@
+// Benchmark of the THistConcurrentFillManager strategies.
+//
+// Build and run with e.g.
+//    g++ -o concurrentfillspeed concurrentfillspeed.cxx `root-config --cflags --libs` -O3
+//    ./concurrentfillspeed 1e8 64
+// where the arguments are the total number of fills and the maximal number of
+// threads. For each strategy (mutex, sharded, atomic) and thread count the
+// fill rate is printed in the same comma-separated format as speedtest.
+
+#include "ROOT/THist.hxx"
+#include "ROOT/THistConcurrentFill.hxx"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace ROOT::Experimental;
+
+struct Timer {
+   using TimePoint_t = decltype( std::chrono::high_resolution_clock::now() );
+
+   std::string fTitle;
+   size_t fCount;
+   TimePoint_t fStart;
+
+   Timer(const std::string &title, size_t count) : fTitle(title), fCount(count),
+   fStart(std::chrono::high_resolution_clock::now()) {}
+
+   ~Timer() {
+      using namespace std::chrono;
+      auto end = high_resolution_clock::now();
+      duration<double> time_span = duration_cast<duration<double>>(end - fStart);
+      std::cout << fCount << " * " << fTitle << "," << time_span.count() << ",seconds ,";
+      std::cout << fCount / (1e6) / time_span.count() << ",millions per seconds \n";
+   }
+};
+
+const char *GetName(EConcurrentFillStrategy strategy)
+{
+   switch (strategy) {
+   case EConcurrentFillStrategy::kMutex: return "mutex";
+   case EConcurrentFillStrategy::kSharded: return "sharded";
+   case EConcurrentFillStrategy::kAtomic: return "atomic";
+   }
+   return "unknown";
+}
+
+template <class HIST>
+void FillConcurrently(const char *histname, EConcurrentFillStrategy strategy, size_t count, unsigned nThreads)
+{
+   HIST hist{{100, 0., 1.}, {100, 0., 1.}};
+   std::string title = std::string(histname) + " " + GetName(strategy) + " " + std::to_string(nThreads) + " threads";
+   {
+      Timer t(title, count);
+      THistConcurrentFillManager<HIST> fillMgr(hist, strategy);
+      std::vector<std::thread> threads;
+      for (unsigned iThread = 0; iThread < nThreads; ++iThread) {
+         threads.emplace_back([&fillMgr, count, nThreads, iThread]() {
+            auto filler = fillMgr.MakeFiller();
+            std::mt19937 gen(iThread);
+            std::uniform_real_distribution<double> dist(0., 1.);
+            for (size_t i = 0, n = count / nThreads; i < n; ++i)
+               filler.Fill({dist(gen), dist(gen)});
+         });
+      }
+      for (auto &thr : threads)
+         thr.join();
+      // Make the result available (merges the shards).
+      fillMgr.GetHist();
+   }
+   if (hist.GetEntries() != (int64_t)(count / nThreads * nThreads))
+      std::cerr << title << ": wrong number of entries " << hist.GetEntries() << '\n';
+}
+
+int main(int argc, char **argv)
+{
+   size_t count = 1e8;
+   unsigned maxThreads = std::thread::hardware_concurrency();
+   if (argc > 1) count = atof(argv[1]);
+   if (argc > 2) maxThreads = atoi(argv[2]);
+
+   for (auto strategy : {EConcurrentFillStrategy::kMutex, EConcurrentFillStrategy::kSharded,
+                         EConcurrentFillStrategy::kAtomic}) {
+      for (unsigned nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+         FillConcurrently<TH2D>("2D", strategy, count, nThreads);
+         FillConcurrently<TH2I>("2I", strategy, count, nThreads);
+      }
+   }
+}
@@ -17,6 +17,8 @@
 #include "TObjArray.h"
 
 #include <map>
+#include <functional>
+#include <iosfwd>
 
 class TVirtualStreamerInfo;
 class TStreamerInfo;
@@ -31,15 +33,26 @@ class TBufferJSON : public TBuffer {
 
 public:
 
+   /// Receives consecutive chunks of the JSON code when streaming, see StreamToJSON()
+   typedef std::function<void(const char *, Int_t)> OutputSink_t;
+
+   enum { kDefaultSinkChunk = 65536 };
+
    TBufferJSON();
    virtual ~TBufferJSON();
 
    void SetCompact(int level);
+   void SetOutputSink(const OutputSink_t &sink, Int_t chunksize = kDefaultSinkChunk);
 
    static TString   ConvertToJSON(const TObject *obj, Int_t compact = 0, const char *member_name = 0);
    static TString   ConvertToJSON(const void *obj, const TClass *cl, Int_t compact = 0, const char *member_name = 0);
    static TString   ConvertToJSON(const void *obj, TDataMember *member, Int_t compact = 0, Int_t arraylen = -1);
 
+   static Long64_t  StreamToJSON(const TObject *obj, const OutputSink_t &sink, Int_t compact = 0, Int_t chunksize = kDefaultSinkChunk);
+   static Long64_t  StreamToJSON(const void *obj, const TClass *cl, const OutputSink_t &sink, Int_t compact = 0, Int_t chunksize = kDefaultSinkChunk);
+   static Long64_t  StreamToJSON(const TObject *obj, std::ostream &out, Int_t compact = 0);
+   static Long64_t  StreamToJSON(const void *obj, const TClass *cl, std::ostream &out, Int_t compact = 0);
+
    static Int_t     ExportToFile(const char* filename, const TObject *obj, const char* option = 0);
    static Int_t     ExportToFile(const char* filename, const void *obj, const TClass *cl, const char* option = 0);
 
@@ -451,6 +464,7 @@ protected:
    void              JsonStreamCollection(TCollection *obj, const TClass *objClass);
 
    void              AppendOutput(const char *line0, const char *line1 = 0);
+   void              FlushOutput();
 
    TString                   fOutBuffer;    //!  main output buffer for json code
    TString                  *fOutput;       //!  current output buffer for json code
@@ -462,6 +476,9 @@ protected:
    TString                   fSemicolon;     //!  depending from compression level, " : " or ":"
    TString                   fArraySepar;    //!  depending from compression level, ", " or ","
    TString                   fNumericLocale; //!  stored value of setlocale(LC_NUMERIC), which should be recovered at the end
+   OutputSink_t              fOutputSink;    //!  when set, main output buffer is passed to the sink when it exceeds fSinkChunk
+   Int_t                     fSinkChunk;     //!  size of the chunks passed to the output sink
+   Long64_t                  fSinkWritten;   //!  number of bytes already passed to the output sink
 
    static const char *fgFloatFmt;          //!  printf argument for floats, either "%f" or "%e" or "%10f" and so on
    static const char *fgDoubleFmt;         //!  printf argument for doubles, either "%f" or "%e" or "%10f" and so on
@@ -14,8 +14,14 @@
 
 #include "TFile.h"
 
+#include <utility>
+
 class TMemFile : public TFile {
 
+public:
+   /// A read-only memory range, not owned by the TMemFile.
+   using ZeroCopyView_t = std::pair<const char *, size_t>;
+
 private:
    struct TMemBlock {
    private:
@@ -38,6 +44,8 @@ private:
    Long64_t     fSysOffset;   ///< Seek offset in file
    TMemBlock   *fBlockSeek;   ///< Pointer to the block we seeked to.
    Long64_t     fBlockOffset; ///< Seek offset within the block
+   Bool_t       fIsView = kFALSE;  ///< True if fBlockList refers to external (read-only) memory
+   Long64_t     fMappedSize = 0;   ///< Size of the shared memory segment mapped by this file, 0 if none
 
    static Long64_t fgDefaultBlockSize;
 
@@ -61,9 +69,18 @@ private:
 public:
    TMemFile(const char *name, Option_t *option="", const char *ftitle="", Int_t compress=1);
    TMemFile(const char *name, char *buffer, Long64_t size, Option_t *option="", const char *ftitle="", Int_t compress=1);
+   TMemFile(const char *name, const ZeroCopyView_t &datarange, const char *ftitle="", Int_t compress=1);
    TMemFile(const TMemFile &orig);
    virtual ~TMemFile();
 
+   static TMemFile *OpenSharedMemory(const char *shmname, const char *name = 0);
+   static Long64_t  CopyFileToSharedMemory(const char *shmname, const char *filename);
+   static Bool_t    RemoveSharedMemory(const char *shmname);
+   Long64_t         CopyToSharedMemory(const char *shmname) const;
+
+   /// Return true if the file is a read-only view of memory it does not own.
+   Bool_t           IsView() const { return fIsView; }
+
    virtual Long64_t CopyTo(void *to, Long64_t maxsize) const;
    virtual void     CopyTo(TBuffer &tobuf) const;
    virtual Long64_t GetSize() const;
@@ -28,6 +28,16 @@
 //    h1->FillRandom("gaus",10000);
 //    TString json = TBufferJSON::ConvertToJSON(h1);
 //
+// For large objects the JSON code does not need to be kept in memory:
+// TBufferJSON::StreamToJSON passes it in chunks to an output sink
+// (a std::ostream or any callable, e.g. writing to a socket) while the
+// object is traversed:
+//
+//    std::ofstream out("h1.json");
+//    TBufferJSON::StreamToJSON(h1, out);
+//
+//    TBufferJSON::StreamToJSON(h1, [sock](const char *buf, Int_t len) { sock->SendRaw(buf, len); });
+//
 //________________________________________________________________________
 
 
@@ -65,6 +75,7 @@
 #include "TClonesArray.h"
 #include "TVirtualMutex.h"
 #include "TInterpreter.h"
+#include "TBase64.h"
 
 #ifdef R__VISUAL_CPLUSPLUS
 #define FLong64    "%I64d"
@@ -308,7 +319,10 @@ TBufferJSON::TBufferJSON() :
    fCompact(0),
    fSemicolon(" : "),
    fArraySepar(", "),
-   fNumericLocale()
+   fNumericLocale(),
+   fOutputSink(),
+   fSinkChunk(kDefaultSinkChunk),
+   fSinkWritten(0)
 {
    fBufSize = 1000000000;
 
@@ -352,6 +366,8 @@ TBufferJSON::~TBufferJSON()
 ///   0 - no compression, standard JSON array
 ///   1 - exclude leading, trailing zeros, required JSROOT v5
 ///   2 - check values repetition and empty gaps, required JSROOT v5
+///   3 - exclude leading, trailing zeros and encode the remaining values
+///       as base64 of their binary representation (typed array), required JSROOT v5
 /// Maximal compression achieved when compact parameter equal to 23
 /// When member_name specified, converts only this data member
 
@@ -381,6 +397,8 @@ TString TBufferJSON::ConvertToJSON(const TObject *obj, Int_t compact, const char
 //   0 - no compression, standard JSON array
 //   1 - exclude leading, trailing zeros, required JSROOT v5
 //   2 - check values repetition and empty gaps, required JSROOT v5
+//   3 - exclude leading, trailing zeros and encode the remaining values
+//       as base64 of their binary representation (typed array), required JSROOT v5
 
 void TBufferJSON::SetCompact(int level)
 {
@@ -389,6 +407,99 @@ void TBufferJSON::SetCompact(int level)
    fArraySepar = (fCompact % 10 > 2) ? "," : ", ";
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Pass produced JSON code to the sink instead of keeping it in memory.
+/// The main output buffer is handed over to the sink each time it
+/// exceeds chunksize bytes, and once more at the end of the conversion.
+
+void TBufferJSON::SetOutputSink(const OutputSink_t &sink, Int_t chunksize)
+{
+   fOutputSink = sink;
+   fSinkChunk = (chunksize > 0) ? chunksize : kDefaultSinkChunk;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Pass content of main output buffer to the output sink and clear it
+
+void TBufferJSON::FlushOutput()
+{
+   if (!fOutputSink || (fOutBuffer.Length() == 0)) return;
+
+   fOutputSink(fOutBuffer.Data(), fOutBuffer.Length());
+   fSinkWritten += fOutBuffer.Length();
+   fOutBuffer.Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Converts object, inherited from TObject class, to JSON and passes it
+/// in chunks of chunksize bytes to the sink while the object is traversed.
+/// Contrary to ConvertToJSON(), the complete JSON code is never kept in memory.
+/// See ConvertToJSON() for the meaning of compact parameter.
+/// Returns total number of bytes passed to the sink
+
+Long64_t TBufferJSON::StreamToJSON(const TObject *obj, const OutputSink_t &sink, Int_t compact, Int_t chunksize)
+{
+   TClass *clActual = 0;
+   void *ptr = (void *) obj;
+
+   if (obj!=0) {
+      clActual = TObject::Class()->GetActualClass(obj);
+      if (!clActual) clActual = TObject::Class(); else
+      if (clActual != TObject::Class())
+         ptr = (void *) ((Long_t) obj - clActual->GetBaseClassOffset(TObject::Class()));
+   }
+
+   return StreamToJSON(ptr, clActual, sink, compact, chunksize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Converts any type of object to JSON and passes it in chunks of
+/// chunksize bytes to the sink while the object is traversed.
+/// One should provide pointer on object and its class.
+/// Returns total number of bytes passed to the sink
+
+Long64_t TBufferJSON::StreamToJSON(const void *obj, const TClass *cl, const OutputSink_t &sink, Int_t compact, Int_t chunksize)
+{
+   if (!sink) return 0;
+
+   TBufferJSON buf;
+
+   buf.SetCompact(compact);
+   buf.SetOutputSink(sink, chunksize);
+
+   buf.JsonWriteObject(obj, cl);
+
+   if ((buf.fSinkWritten > 0) || (buf.fOutBuffer.Length() > 0)) {
+      buf.FlushOutput();
+   } else if (buf.fValue.Length() > 0) {
+      // objects like TArray or STL containers are produced as single value
+      sink(buf.fValue.Data(), buf.fValue.Length());
+      buf.fSinkWritten = buf.fValue.Length();
+   }
+
+   return buf.fSinkWritten;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Converts object, inherited from TObject class, to JSON and writes it
+/// to the output stream while the object is traversed.
+/// Returns number of written bytes
+
+Long64_t TBufferJSON::StreamToJSON(const TObject *obj, std::ostream &out, Int_t compact)
+{
+   return StreamToJSON(obj, [&out](const char *buf, Int_t len) { out.write(buf, len); }, compact);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Converts any type of object to JSON and writes it to the output stream
+/// while the object is traversed.
+/// Returns number of written bytes
+
+Long64_t TBufferJSON::StreamToJSON(const void *obj, const TClass *cl, std::ostream &out, Int_t compact)
+{
+   return StreamToJSON(obj, cl, [&out](const char *buf, Int_t len) { out.write(buf, len); }, compact);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Converts any type of object to JSON string
@@ -402,6 +513,8 @@ void TBufferJSON::SetCompact(int level)
 ///   0 - no compression, standard JSON array
 ///   1 - exclude leading, trailing zeros, required JSROOT v5
 ///   2 - check values repetition and empty gaps, required JSROOT v5
+///   3 - exclude leading, trailing zeros and encode the remaining values
+///       as base64 of their binary representation (typed array), required JSROOT v5
 /// Maximal compression achieved when compact parameter equal to 23
 /// When member_name specified, converts only this data member
 
@@ -484,11 +597,11 @@ Int_t TBufferJSON::ExportToFile(const char* filename, const TObject *obj, const
    Int_t compact = strstr(filename,".json.gz") ? 3 : 0;
    if (option && (*option >= '0') && (*option <='3')) compact = TString(option).Atoi();
 
-   TString json = TBufferJSON::ConvertToJSON(obj, compact);
-
    std::ofstream ofs(filename);
 
    if (strstr(filename,".json.gz")) {
+      TString json = TBufferJSON::ConvertToJSON(obj, compact);
+
       const char *objbuf = json.Data();
       Long_t objlen = json.Length();
 
@@ -540,13 +653,15 @@ Int_t TBufferJSON::ExportToFile(const char* filename, const TObject *obj, const
       ofs.write(buffer, bufcur - buffer);
 
       free(buffer);
-   } else {
-      ofs << json.Data();
+
+      return json.Length();
    }
 
+   Long64_t len = TBufferJSON::StreamToJSON(obj, ofs, compact);
+
    ofs.close();
 
-   return json.Length();
+   return (Int_t) len;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -560,11 +675,11 @@ Int_t TBufferJSON::ExportToFile(const char* filename, const void *obj, const TCl
    Int_t compact = strstr(filename,".json.gz") ? 3 : 0;
    if (option && (*option >= '0') && (*option <='3')) compact = TString(option).Atoi();
 
-   TString json = TBufferJSON::ConvertToJSON(obj, cl, compact);
-
    std::ofstream ofs (filename);
 
    if (strstr(filename,".json.gz")) {
+      TString json = TBufferJSON::ConvertToJSON(obj, cl, compact);
+
       const char *objbuf = json.Data();
       Long_t objlen = json.Length();
 
@@ -616,13 +731,15 @@ Int_t TBufferJSON::ExportToFile(const char* filename, const void *obj, const TCl
       ofs.write(buffer, bufcur - buffer);
 
       free(buffer);
-   } else {
-      ofs << json.Data();
+
+      return json.Length();
    }
 
+   Long64_t len = TBufferJSON::StreamToJSON(obj, cl, ofs, compact);
+
    ofs.close();
 
-   return json.Length();
+   return (Int_t) len;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -867,6 +984,9 @@ void TBufferJSON::AppendOutput(const char *line0, const char *line1)
          fOutput->Append(line1);
       }
    }
+
+   if (fOutputSink && (fOutput == &fOutBuffer) && (fOutBuffer.Length() >= fSinkChunk))
+      FlushOutput();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2296,6 +2416,27 @@ void TBufferJSON::ReadFastArray(void ** /*startp*/, const TClass * /*cl*/,
 {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if array values of type typname, occupying unitsize bytes,
+/// can be stored as base64 of their binary representation.
+/// JSROOT decodes them as little-endian typed arrays.
+
+static Bool_t JsonCanUseBase64(const char *typname, size_t unitsize)
+{
+#ifdef R__BYTESWAP
+   size_t len = strlen(typname);
+   if (strcmp(typname, "Bool") == 0) return unitsize == 1;
+   if ((len > 1) && (typname[len-1] == '8')) return unitsize == 1;
+   if ((len > 2) && (strcmp(typname+len-2, "16") == 0)) return unitsize == 2;
+   if ((len > 2) && (strcmp(typname+len-2, "32") == 0)) return unitsize == 4;
+   if ((len > 2) && (strcmp(typname+len-2, "64") == 0)) return unitsize == 8;
+#else
+   (void) typname;
+   (void) unitsize;
+#endif
+   return kFALSE;
+}
+
 #define TJSONWriteArrayCompress(vname, arrsize, typname)             \
    {                                                                 \
       if ((fCompact < 10) || (arrsize < 6)) {                        \
@@ -2311,6 +2452,12 @@ void TBufferJSON::ReadFastArray(void ** /*startp*/, const TClass * /*cl*/,
          Int_t aindx(0), bindx(arrsize);                             \
          while ((aindx<arrsize) && (vname[aindx]==0)) aindx++;       \
          while ((aindx<bindx) && (vname[bindx-1]==0)) bindx--;       \
+         if ((aindx<bindx) && (fCompact >= 30) && JsonCanUseBase64(typname, sizeof(vname[0]))) { \
+            if (aindx>0) fValue.Append(TString::Format("%s\"p\":%d", fArraySepar.Data(), aindx)); \
+            fValue.Append(TString::Format("%s\"b\":\"", fArraySepar.Data())); \
+            fValue.Append(TBase64::Encode((const char *) (vname + aindx), (bindx - aindx) * sizeof(vname[0]))); \
+            fValue.Append("\"");                                     \
+         } else                                                      \
          if (aindx<bindx) {                                          \
             TString suffix("");                                      \
             Int_t p(aindx), suffixcnt(-1), lastp(0);                 \
@@ -15,6 +15,22 @@
 
 A TMemFile is like a normal TFile except that it reads and writes
 only from memory.
+
+A TMemFile can also be a read-only view of a file image it does not own,
+either any memory range (see the ZeroCopyView_t constructor) or a POSIX
+shared memory segment. The latter allows several processes on the same node,
+for instance the workers of a TProcessExecutor or independent jobs, to read
+the same file image without each of them holding a private copy:
+~~~{.cpp}
+// once per node
+TMemFile::CopyFileToSharedMemory("/calib", "calibration.root");
+// in every process
+std::unique_ptr<TMemFile> f(TMemFile::OpenSharedMemory("/calib"));
+TH2F *calib = nullptr;
+f->GetObject("calib", calib);
+// when no process needs it anymore
+TMemFile::RemoveSharedMemory("/calib");
+~~~
 */
 
 #include "TMemFile.h"
@@ -25,9 +41,16 @@ only from memory.
 #include "TKey.h"
 #include "TClass.h"
 #include "TVirtualMutex.h"
+#include "TMath.h"
 #include <errno.h>
+#include <memory>
 #include <stdio.h>
 #include <sys/stat.h>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 // The following snippet is used for developer-level debugging
 #define TMemFile_TRACE
@@ -180,6 +203,32 @@ zombie:
    gDirectory = gROOT;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor of a read-only file, reading directly from the memory range
+/// datarange. The memory is not copied and must stay valid and unchanged
+/// during the lifetime of the TMemFile.
+
+TMemFile::TMemFile(const char *path, const ZeroCopyView_t &datarange, const char *ftitle, Int_t compress) :
+   TFile(path, "WEB", ftitle, compress),
+   fSize(datarange.second), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0), fIsView(kTRUE)
+{
+   fOption = "READ";
+
+   fBlockList.fBuffer = (UChar_t *)const_cast<char *>(datarange.first);
+   fBlockList.fSize = datarange.second;
+
+   fD = SysOpen(path, O_RDONLY, 0644);
+   if (fD == -1 || !datarange.first) {
+      SysError("TMemFile", "file %s can not be opened for reading", path);
+      MakeZombie();
+      gDirectory = gROOT;
+      return;
+   }
+   fWritable = kFALSE;
+
+   Init(kFALSE);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copying the content of the TMemFile into another TMemFile.
 
@@ -217,9 +266,174 @@ TMemFile::~TMemFile()
    // Need to call close, now as it will need both our virtual table
    // and the content of the list of blocks
    Close();
+   if (fIsView) {
+      // The memory is not ours, make sure the block does not delete it.
+#ifndef WIN32
+      if (fMappedSize > 0)
+         munmap(fBlockList.fBuffer, fMappedSize);
+#endif
+      fBlockList.fBuffer = 0;
+   }
    TRACE("destroy")
 }
 
+#ifndef WIN32
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the POSIX shared memory object, which must start with '/'.
+
+TString SharedMemoryName(const char *shmname)
+{
+   TString name = shmname;
+   if (!name.BeginsWith("/"))
+      name.Prepend("/");
+   return name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a new shared memory segment of the given size and map it for
+/// writing. Returns 0 (and removes the segment) on failure.
+
+UChar_t *CreateSharedMemory(const TString &name, Long64_t size)
+{
+   int fd = shm_open(name.Data(), O_RDWR | O_CREAT | O_EXCL, 0644);
+   if (fd == -1) {
+      ::SysError("TMemFile::CopyToSharedMemory", "can not create shared memory %s", name.Data());
+      return 0;
+   }
+   void *mem = MAP_FAILED;
+   if (ftruncate(fd, size) == 0)
+      mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (mem == MAP_FAILED) {
+      ::SysError("TMemFile::CopyToSharedMemory", "can not map %lld bytes of shared memory %s", size, name.Data());
+      shm_unlink(name.Data());
+      return 0;
+   }
+   return (UChar_t *)mem;
+}
+
+} // anonymous namespace
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open a read-only view of the file image stored in the POSIX shared memory
+/// segment shmname (see CopyToSharedMemory() and CopyFileToSharedMemory()).
+/// The segment is mapped, not copied: all the processes opening it share the
+/// same physical memory. Returns 0 in case of failure; the returned file must
+/// be deleted by the caller.
+
+TMemFile *TMemFile::OpenSharedMemory(const char *shmname, const char *name)
+{
+#ifndef WIN32
+   TString shm = SharedMemoryName(shmname);
+   int fd = shm_open(shm.Data(), O_RDONLY, 0);
+   if (fd == -1) {
+      ::SysError("TMemFile::OpenSharedMemory", "can not open shared memory %s", shm.Data());
+      return 0;
+   }
+   struct stat st;
+   void *mem = MAP_FAILED;
+   if (fstat(fd, &st) == 0 && st.st_size > 0)
+      mem = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (mem == MAP_FAILED) {
+      ::SysError("TMemFile::OpenSharedMemory", "can not map shared memory %s", shm.Data());
+      return 0;
+   }
+
+   TMemFile *file = new TMemFile(name ? name : shm.Data(), ZeroCopyView_t((const char *)mem, st.st_size));
+   file->fMappedSize = st.st_size;
+   if (file->IsZombie()) {
+      delete file;
+      return 0;
+   }
+   return file;
+#else
+   ::Error("TMemFile::OpenSharedMemory", "shared memory files are not supported on this platform (%s, %s)", shmname,
+           name);
+   return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the ROOT file filename (any file TFile::Open() can read) into a new
+/// POSIX shared memory segment shmname. Returns the number of bytes copied or
+/// -1 in case of failure, for instance if the segment already exists.
+
+Long64_t TMemFile::CopyFileToSharedMemory(const char *shmname, const char *filename)
+{
+#ifndef WIN32
+   std::unique_ptr<TFile> file(TFile::Open(filename, "READ"));
+   if (!file || file->IsZombie())
+      return -1;
+
+   TString shm = SharedMemoryName(shmname);
+   Long64_t size = file->GetSize();
+   UChar_t *mem = size > 0 ? CreateSharedMemory(shm, size) : 0;
+   if (!mem)
+      return -1;
+
+   const Long64_t kChunk = 64 * 1024 * 1024;
+   Bool_t failed = kFALSE;
+   for (Long64_t pos = 0; pos < size && !failed; pos += kChunk) {
+      Int_t len = (Int_t)TMath::Min(kChunk, size - pos);
+      failed = file->ReadBuffer((char *)mem + pos, pos, len);
+   }
+   munmap(mem, size);
+
+   if (failed) {
+      ::Error("TMemFile::CopyFileToSharedMemory", "can not read %s", filename);
+      shm_unlink(shm.Data());
+      return -1;
+   }
+   return size;
+#else
+   ::Error("TMemFile::CopyFileToSharedMemory", "shared memory files are not supported on this platform (%s, %s)",
+           shmname, filename);
+   return -1;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the POSIX shared memory segment shmname. Processes that still have
+/// it open keep their view until they delete their TMemFile.
+
+Bool_t TMemFile::RemoveSharedMemory(const char *shmname)
+{
+#ifndef WIN32
+   return shm_unlink(SharedMemoryName(shmname).Data()) == 0;
+#else
+   (void)shmname;
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the binary representation of the TMemFile into a new POSIX shared
+/// memory segment shmname, to be opened with OpenSharedMemory().
+/// For a file being written, call Write() first so that the keys and
+/// streamer infos are part of the image.
+/// Returns the number of bytes copied or -1 in case of failure.
+
+Long64_t TMemFile::CopyToSharedMemory(const char *shmname) const
+{
+#ifndef WIN32
+   TString shm = SharedMemoryName(shmname);
+   Long64_t size = fWritable ? GetEND() : GetSize();
+   UChar_t *mem = size > 0 ? CreateSharedMemory(shm, size) : 0;
+   if (!mem)
+      return -1;
+   Long64_t copied = CopyTo(mem, size);
+   munmap(mem, size);
+   return copied;
+#else
+   Error("CopyToSharedMemory", "shared memory files are not supported on this platform (%s)", shmname);
+   return -1;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy the binary representation of the TMemFile into
 /// the memory area starting at 'to' and of length at most 'maxsize'
@@ -572,7 +786,11 @@ Int_t TMemFile::SysWriteImpl(Int_t /* fd */, const void *buf, Long64_t len)
 {
    TRACE("WRITE")
 
-   if (fBlockList.fBuffer == 0) {
+   if (fIsView) {
+      errno = EBADF;
+      gSystem->SetErrorStr("The memory file is a read-only view.");
+      return 0;
+   } else if (fBlockList.fBuffer == 0) {
       errno = EBADF;
       gSystem->SetErrorStr("The memory file is not open.");
       return 0;
@@ -0,0 +1,59 @@
+#include "TBufferJSON.h"
+
+#include "TH1.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+static TH1F *MakeHistogram()
+{
+   TH1F *h1 = new TH1F("h1", "title", 100, 0, 10);
+   h1->SetDirectory(nullptr);
+   for (int i = 0; i < 1000; ++i)
+      h1->Fill(0.01 * i, 0.5 + i % 7);
+   return h1;
+}
+
+TEST(TBufferJSON, StreamToJSON)
+{
+   std::unique_ptr<TH1F> h1(MakeHistogram());
+
+   for (Int_t compact : {0, 3, 23, 33}) {
+      TString json = TBufferJSON::ConvertToJSON(h1.get(), compact);
+
+      std::string streamed;
+      Int_t nchunks = 0;
+      Long64_t len = TBufferJSON::StreamToJSON(h1.get(),
+                                               [&](const char *buf, Int_t n) {
+                                                  streamed.append(buf, n);
+                                                  ++nchunks;
+                                               },
+                                               compact, 256);
+
+      EXPECT_EQ(json.Length(), len);
+      EXPECT_STREQ(json.Data(), streamed.c_str());
+      EXPECT_LT(1, nchunks);
+
+      std::ostringstream out;
+      EXPECT_EQ(len, TBufferJSON::StreamToJSON(h1.get(), out, compact));
+      EXPECT_STREQ(json.Data(), out.str().c_str());
+   }
+}
+
+TEST(TBufferJSON, Base64Arrays)
+{
+   std::unique_ptr<TH1F> h1(MakeHistogram());
+
+   TString json23 = TBufferJSON::ConvertToJSON(h1.get(), 23);
+   TString json33 = TBufferJSON::ConvertToJSON(h1.get(), 33);
+
+#ifdef R__BYTESWAP
+   EXPECT_NE(kNPOS, json33.Index("\"b\":\""));
+#else
+   EXPECT_STREQ(json23.Data(), json33.Data());
+#endif
+   EXPECT_EQ(kNPOS, json23.Index("\"b\":\""));
+}
@@ -0,0 +1,41 @@
+#include "ROOT/TBufferPool.hxx"
+#include "TMapFile.h"
+#include "TObjString.h"
+#include "TSystem.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+using ROOT::Internal::TBufferPool;
+
+// The buffers of the objects in a map file must be allocated in its shared
+// memory, not drawn from the buffer pool.
+TEST(TMapFile, UpdateWithBufferPool)
+{
+   TBufferPool::Enable();
+   TBufferPool::Clear();
+   TBufferPool::ResetStats();
+
+   TMapFile *mfile = TMapFile::Create("testTMapFile.map", "RECREATE", 1000000, "buffer pool");
+   ASSERT_NE(nullptr, mfile);
+   TObjString str("short");
+   mfile->Add(&str, "str");
+   mfile->Update();
+   // the buffer of the object grows and is reallocated in the shared memory
+   str.SetString(TString('x', 100000));
+   mfile->Update();
+   str.SetString("done");
+   mfile->Update();
+
+   EXPECT_EQ(0u, TBufferPool::GetStats().fRequests);
+
+   std::unique_ptr<TObjString> read(dynamic_cast<TObjString *>(mfile->Get("str")));
+   ASSERT_NE(nullptr, read);
+   EXPECT_EQ(TString("done"), read->GetString());
+
+   mfile->Close();
+   TBufferPool::Enable(kFALSE);
+   TBufferPool::Clear();
+   gSystem->Unlink("testTMapFile.map");
+}
@@ -0,0 +1,58 @@
+#include "TMemFile.h"
+#include "TObjString.h"
+#include "TSystem.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static std::unique_ptr<TMemFile> MakeFile()
+{
+   std::unique_ptr<TMemFile> file(new TMemFile("memfile.root", "RECREATE"));
+   TObjString str("calibration constants");
+   file->WriteObject(&str, "calib");
+   file->Write();
+   return file;
+}
+
+TEST(TMemFile, ZeroCopyView)
+{
+   auto file = MakeFile();
+   std::vector<char> image(file->GetEND());
+   ASSERT_EQ((Long64_t)image.size(), file->CopyTo(image.data(), image.size()));
+
+   TMemFile view("view.root", TMemFile::ZeroCopyView_t(image.data(), image.size()));
+   ASSERT_FALSE(view.IsZombie());
+   EXPECT_TRUE(view.IsView());
+   EXPECT_FALSE(view.IsWritable());
+
+   std::unique_ptr<TObjString> str(dynamic_cast<TObjString *>(view.Get("calib")));
+   ASSERT_TRUE(str != nullptr);
+   EXPECT_STREQ("calibration constants", str->GetName());
+}
+
+#ifndef WIN32
+TEST(TMemFile, SharedMemory)
+{
+   TString shmname = TString::Format("/roottest_tmemfile_%d", gSystem->GetPid());
+   auto file = MakeFile();
+   ASSERT_LT(0, file->CopyToSharedMemory(shmname));
+   // The segment must not be overwritten.
+   EXPECT_EQ(-1, file->CopyToSharedMemory(shmname));
+
+   std::unique_ptr<TMemFile> first(TMemFile::OpenSharedMemory(shmname));
+   std::unique_ptr<TMemFile> second(TMemFile::OpenSharedMemory(shmname));
+   ASSERT_TRUE(first && second);
+   EXPECT_TRUE(first->IsView());
+
+   std::unique_ptr<TObjString> str1(dynamic_cast<TObjString *>(first->Get("calib")));
+   std::unique_ptr<TObjString> str2(dynamic_cast<TObjString *>(second->Get("calib")));
+   ASSERT_TRUE(str1 && str2);
+   EXPECT_STREQ("calibration constants", str1->GetName());
+   EXPECT_STREQ("calibration constants", str2->GetName());
+
+   EXPECT_TRUE(TMemFile::RemoveSharedMemory(shmname));
+   EXPECT_EQ(nullptr, TMemFile::OpenSharedMemory(shmname));
+}
+#endif
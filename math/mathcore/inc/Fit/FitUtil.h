@@ -20,8 +20,6 @@
 #include "ROOT/TThreadExecutor.hxx"
 #endif
 
-// #include "ROOT/TProcessExecutor.hxx"
-
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
 #include "Fit/FitExecutionPolicy.h"
@@ -32,6 +30,10 @@
 #include "TError.h"
 #include "TSystem.h"
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #ifdef R__HAS_VECCORE
 namespace vecCore{
    //Auxiliar function. To be included in VecCore's new release
@@ -260,8 +262,13 @@ namespace FitUtil {
    /**
        evaluate the Chi2 gradient given a model function and the data at the point x.
        return also nPoints as the effective number of used points in the Chi2 evaluation
+       With the kMultithread execution policy the model function and its parameter gradient
+       are evaluated concurrently and must be thread safe
    */
-   void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints);
+   void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints, const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks=0);
+#ifdef R__HAS_VECCORE
+   void EvaluateChi2Gradient(const IModelFunctionTempl<ROOT::Double_v> & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints, const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks=0);
+#endif
 
    /**
        evaluate the LogL given a model function and the data at the point x.
@@ -276,9 +283,9 @@ namespace FitUtil {
        evaluate the LogL gradient given a model function and the data at the point x.
        return also nPoints as the effective number of used points in the LogL evaluation
    */
-   void EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints);
+   void EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints, const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks=0);
 #ifdef R__HAS_VECCORE
-   void EvaluateLogLGradient(const IModelFunctionTempl<ROOT::Double_v> &, const UnBinData &, const double *, double *, unsigned int & ) ;
+   void EvaluateLogLGradient(const IModelFunctionTempl<ROOT::Double_v> & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints, const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks=0);
 #endif
 
    /**
@@ -286,13 +293,18 @@ namespace FitUtil {
        return also nPoints as the effective number of used points in the LogL evaluation
        By default is extended, pass extedend to false if want to be not extended (MultiNomial)
    */
-   double EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints);
+   double EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints, const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks=0);
+#ifdef R__HAS_VECCORE
+   double EvaluatePoissonLogL(const IModelFunctionTempl<ROOT::Double_v> & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints, const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks=0);
+#endif
 
    /**
-       evaluate the Poisson LogL given a model function and the data at the point x.
-       return also nPoints as the effective number of used points in the LogL evaluation
+       evaluate the Poisson LogL gradient given a model function and the data at the point x.
    */
-   void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad);
+   void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks=0);
+#ifdef R__HAS_VECCORE
+   void EvaluatePoissonLogLGradient(const IModelFunctionTempl<ROOT::Double_v> & func, const BinData & data, const double * x, double * grad, const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks=0);
+#endif
 
    // methods required by dedicate minimizer like Fumili
 
@@ -321,9 +333,77 @@ namespace FitUtil {
        is used
    */
    double EvaluatePoissonBinPdf(const IModelFunction & func, const BinData & data, const double * x, unsigned int ipoint, double * g = 0);
+#ifdef R__HAS_VECCORE
+   double EvaluatePoissonBinPdf(const IModelFunctionTempl<ROOT::Double_v> & func, const BinData & data, const double * x, unsigned int ipoint, double * g = 0);
+#endif
 
    unsigned setAutomaticChunking(unsigned nEvents);
 
+   /**
+       evaluate with the kMultiprocess execution policy the sums over n data points returned by
+       chunkSums(begin, end) for the points in [begin, end). The points are split in nChunks chunks
+       (by default one per worker), evaluated in forked worker processes sharing the data: only the
+       partial sums are sent back. The model function does not need to be thread safe.
+       Inside a MultiProcessWorkers::Scope the persistent workers of the scope are used, otherwise
+       the workers are forked for this evaluation only.
+   */
+   std::vector<double> EvaluateChunksMultiProcess(const std::function<std::vector<double>(unsigned int, unsigned int)> & chunkSums,
+                                                  unsigned int n, unsigned nChunks = 0);
+
+   /**
+       worker processes of the kMultiprocess execution policy kept for the life of the objective
+       function (FCN) owning them. They are forked at the first evaluation, each with a copy of the
+       FCN and of the data, and then for each evaluation they receive only the parameters, repeat
+       the evaluation in their copy of the FCN for their chunk of the data and send back the
+       partial sums. Copies of the owner do not share the workers.
+   */
+   class MultiProcessWorkers {
+
+   public:
+
+      /// what the workers evaluate
+      enum ERequest { kValue, kGradient };
+
+      /// evaluation of the FCN repeated by the workers for the parameters x
+      typedef std::function<void(ERequest, const double *)> Replay_t;
+
+      MultiProcessWorkers();
+      MultiProcessWorkers(const MultiProcessWorkers &);
+      MultiProcessWorkers & operator=(const MultiProcessWorkers &) { return *this; }
+      ~MultiProcessWorkers();
+
+      /**
+          scope of an evaluation of the FCN for the npar parameters x: the kMultiprocess evaluations
+          of the FitUtil functions called in it use the workers, which evaluate their chunks by
+          calling replay(request, x). It has no effect for the other execution policies.
+      */
+      class Scope {
+      public:
+         Scope(MultiProcessWorkers & workers, unsigned executionPolicy, ERequest request, const double * x, unsigned int npar,
+               const Replay_t & replay);
+         ~Scope();
+         Scope(const Scope &) = delete;
+         Scope & operator=(const Scope &) = delete;
+
+      private:
+         friend std::vector<double> EvaluateChunksMultiProcess(const std::function<std::vector<double>(unsigned int, unsigned int)> &,
+                                                               unsigned int, unsigned);
+         MultiProcessWorkers & fWorkers;
+         ERequest fRequest;
+         const double * fX;
+         unsigned int fNPar;
+         Replay_t fReplay;
+         Scope * fPrevious;
+      };
+
+   private:
+
+      class Impl;
+      friend std::vector<double> EvaluateChunksMultiProcess(const std::function<std::vector<double>(unsigned int, unsigned int)> &,
+                                                            unsigned int, unsigned);
+      std::unique_ptr<Impl> fImpl; //! the client of the forked workers, created at the first evaluation
+   };
+
 #ifdef R__HAS_VECCORE
    template<class T>
    struct Evaluate{
@@ -413,11 +493,16 @@ namespace FitUtil {
             ROOT::TThreadExecutor pool;
             res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, data.Size() / vecSize), redFunction, chunks);
 #endif
-            // } else if(executionPolicy == ROOT::Fit::kMultitProcess){
-            //   ROOT::TProcessExecutor pool;
-            //   res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, data.Size()/vecSize), redFunction);
+         } else if (executionPolicy == ROOT::Fit::kMultiprocess) {
+            auto chunkChi2 = [&](unsigned int begin, unsigned int end) {
+               T chi2{};
+               for (unsigned int i = begin; i < end; i++)
+                  chi2 += mapFunction(i);
+               return std::vector<double>(1, vecCore::Reduce(chi2));
+            };
+            vecCore::Set(res, 0, EvaluateChunksMultiProcess(chunkChi2, data.Size() / vecSize, nChunks)[0]);
          } else {
-            Error("FitUtil::EvaluateChi2", "Execution policy unknown. Avalaible choices:\n 0: Serial (default)\n 1: MultiThread (requires IMT)\n");
+            Error("FitUtil::EvaluateChi2", "Execution policy unknown. Avalaible choices:\n 0: Serial (default)\n 1: MultiThread (requires IMT)\n 2: MultiProcess\n");
          }
          nPoints = n;
 
@@ -549,12 +634,20 @@ namespace FitUtil {
             logl_v = resArray.logvalue;
             sumW_v = resArray.weight;
             sumW2_v = resArray.weight2;
-        //  } else if (executionPolicy == ROOT::Fit::kMultitProcess) {
-            // ROOT::TProcessExecutor pool;
-            // res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction);
 #endif
+         } else if (executionPolicy == ROOT::Fit::kMultiprocess) {
+            auto chunkLogL = [&](unsigned int begin, unsigned int end) {
+               LikelihoodAux<T> sum{};
+               for (unsigned int i = begin; i < end; ++i)
+                  sum = sum + mapFunction(i);
+               return std::vector<double>{vecCore::Reduce(sum.logvalue), vecCore::Reduce(sum.weight), vecCore::Reduce(sum.weight2)};
+            };
+            auto resArray = EvaluateChunksMultiProcess(chunkLogL, n / vecSize, nChunks);
+            vecCore::Set(logl_v, 0, resArray[0]);
+            vecCore::Set(sumW_v, 0, resArray[1]);
+            vecCore::Set(sumW2_v, 0, resArray[2]);
          } else {
-            Error("FitUtil::EvaluateLogL", "Execution policy unknown. Avalaible choices:\n 0: Serial (default)\n 1: MultiThread (requires IMT)\n");
+            Error("FitUtil::EvaluateLogL", "Execution policy unknown. Avalaible choices:\n 0: Serial (default)\n 1: MultiThread (requires IMT)\n 2: MultiProcess\n");
          }
 
          //reduce vector type to double.
@@ -633,9 +726,33 @@ namespace FitUtil {
          return -1.;
       }
 
-      static void EvalChi2Gradient(const IModelFunctionTempl<T> &, const BinData &, const double *, double *, unsigned int)
+      static double EvalPoissonLogL(const IModelFunctionTempl<T> &func, const BinData & data, const double * p, int iWeight,
+                                    bool extended, unsigned int &nPoints, const unsigned int &executionPolicy, unsigned nChunks = 0)
       {
-         Error("FitUtil::Evaluate<T>::EvalChi2Gradient", "The vectorized evaluation of the Chi2 with gradient is still not supported");
+         return FitUtil::EvaluatePoissonLogL(func, data, p, iWeight, extended, nPoints, executionPolicy, nChunks);
+      }
+
+      static double EvalPoissonBinPdf(const IModelFunctionTempl<T> &func, const BinData & data, const double * p, unsigned int i, double *g = 0)
+      {
+         return FitUtil::EvaluatePoissonBinPdf(func, data, p, i, g);
+      }
+
+      static void EvalChi2Gradient(const IModelFunctionTempl<T> &func, const BinData & data, const double * p, double * g, unsigned int &nPoints,
+                                   const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks = 0)
+      {
+         FitUtil::EvaluateChi2Gradient(func, data, p, g, nPoints, executionPolicy, nChunks);
+      }
+
+      static void EvalLogLGradient(const IModelFunctionTempl<T> &func, const UnBinData & data, const double * p, double * g, unsigned int &nPoints,
+                                   const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks = 0)
+      {
+         FitUtil::EvaluateLogLGradient(func, data, p, g, nPoints, executionPolicy, nChunks);
+      }
+
+      static void EvalPoissonLogLGradient(const IModelFunctionTempl<T> &func, const BinData & data, const double * p, double * g,
+                                          const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks = 0)
+      {
+         FitUtil::EvaluatePoissonLogLGradient(func, data, p, g, executionPolicy, nChunks);
       }
 
       static double EvalChi2Residual(const IModelFunctionTempl<T> &, const BinData &, const double *, unsigned int, double *)
@@ -664,9 +781,29 @@ namespace FitUtil {
       {
          return FitUtil::EvaluateChi2Effective(func, data, p, nPoints);
       }
-      static void EvalChi2Gradient(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, double * g, unsigned int &nPoints)
+      static double EvalPoissonLogL(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, int iWeight,
+                                    bool extended, unsigned int &nPoints, const unsigned int &executionPolicy, unsigned nChunks = 0)
+      {
+         return FitUtil::EvaluatePoissonLogL(func, data, p, iWeight, extended, nPoints, executionPolicy, nChunks);
+      }
+      static double EvalPoissonBinPdf(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, unsigned int i, double *g = 0)
+      {
+         return FitUtil::EvaluatePoissonBinPdf(func, data, p, i, g);
+      }
+      static void EvalChi2Gradient(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, double * g, unsigned int &nPoints,
+                                   const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks = 0)
+      {
+         FitUtil::EvaluateChi2Gradient(func, data, p, g, nPoints, executionPolicy, nChunks);
+      }
+      static void EvalLogLGradient(const IModelFunctionTempl<double> &func, const UnBinData & data, const double * p, double * g, unsigned int &nPoints,
+                                   const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks = 0)
+      {
+         FitUtil::EvaluateLogLGradient(func, data, p, g, nPoints, executionPolicy, nChunks);
+      }
+      static void EvalPoissonLogLGradient(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, double * g,
+                                          const unsigned int &executionPolicy = ROOT::Fit::kSerial, unsigned nChunks = 0)
       {
-          FitUtil::EvaluateChi2Gradient(func, data, p, g, nPoints);
+         FitUtil::EvaluatePoissonLogLGradient(func, data, p, g, executionPolicy, nChunks);
       }
       static double EvalChi2Residual(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, unsigned int i, double *g = 0)
       {
@@ -126,7 +126,12 @@ public:
    // need to be virtual to be instantited
    virtual void Gradient(const double *x, double *g) const {
       // evaluate the chi2 gradient
-      FitUtil::EvaluateLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints);
+      FitUtil::MultiProcessWorkers::Scope workers(fWorkers, fExecutionPolicy, FitUtil::MultiProcessWorkers::kGradient, x, this->NDim(), ReplayInWorkers());
+#ifdef R__HAS_VECCORE
+      FitUtil::Evaluate<T>::EvalLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints, fExecutionPolicy);
+#else
+      FitUtil::EvaluateLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints, fExecutionPolicy);
+#endif
    }
 
    /// get type of fit method function
@@ -153,6 +158,8 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
+      // with the kMultiprocess policy the data are split among the worker processes of this FCN
+      FitUtil::MultiProcessWorkers::Scope workers(fWorkers, fExecutionPolicy, FitUtil::MultiProcessWorkers::kValue, x, this->NDim(), ReplayInWorkers());
 
 #ifdef R__HAS_VECCORE
       return FitUtil::Evaluate<T>::EvalLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints, fExecutionPolicy);
@@ -161,6 +168,18 @@ private:
 #endif
    }
 
+   // evaluation of the value or of the gradient repeated by the kMultiprocess workers for their chunk of the data
+   FitUtil::MultiProcessWorkers::Replay_t ReplayInWorkers() const {
+      return [this](FitUtil::MultiProcessWorkers::ERequest request, const double * x) {
+         if (request == FitUtil::MultiProcessWorkers::kGradient) {
+            std::vector<double> g(this->NDim());
+            Gradient(x, g.data());
+         }
+         else
+            DoEval(x);
+      };
+   }
+
    // for derivatives
    virtual double  DoDerivative(const double * x, unsigned int icoord ) const {
       Gradient(x, &fGrad[0]);
@@ -178,6 +197,7 @@ private:
    mutable std::vector<double> fGrad; // for derivatives
 
    unsigned fExecutionPolicy;
+   mutable FitUtil::MultiProcessWorkers fWorkers; //! worker processes of the kMultiprocess policy
 
 };
       // define useful typedef's
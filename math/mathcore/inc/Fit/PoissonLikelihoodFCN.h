@@ -49,34 +49,37 @@ class PoissonLikelihoodFCN : public BasicFCN<DerivFunType,ModelFunType,BinData>
 
 public:
 
+   typedef typename ModelFunType::BackendType T;
    typedef  BasicFCN<DerivFunType,ModelFunType,BinData> BaseFCN;
 
    typedef  ::ROOT::Math::BasicFitMethodFunction<DerivFunType> BaseObjFunction;
    typedef typename  BaseObjFunction::BaseFunction BaseFunction;
 
-   typedef  ::ROOT::Math::IParamMultiFunction IModelFunction;
+   typedef  ::ROOT::Math::IParamMultiFunctionTempl<T> IModelFunction;
 
 
    /**
       Constructor from unbin data set and model function (pdf)
    */
-   PoissonLikelihoodFCN (const std::shared_ptr<BinData> & data, const std::shared_ptr<IModelFunction> & func, int weight = 0, bool extended = true ) :
+   PoissonLikelihoodFCN (const std::shared_ptr<BinData> & data, const std::shared_ptr<IModelFunction> & func, int weight = 0, bool extended = true, ROOT::Fit::ExecutionPolicy executionPolicy = ROOT::Fit::kSerial ) :
       BaseFCN( data, func),
       fIsExtended(extended),
       fWeight(weight),
       fNEffPoints(0),
-      fGrad ( std::vector<double> ( func->NPar() ) )
+      fGrad ( std::vector<double> ( func->NPar() ) ),
+      fExecutionPolicy(executionPolicy)
    { }
 
    /**
       Constructor from unbin data set and model function (pdf) managed by the users
    */
-   PoissonLikelihoodFCN (const BinData & data, const IModelFunction & func, int weight = 0, bool extended = true ) :
+   PoissonLikelihoodFCN (const BinData & data, const IModelFunction & func, int weight = 0, bool extended = true, ROOT::Fit::ExecutionPolicy executionPolicy = ROOT::Fit::kSerial ) :
       BaseFCN(std::shared_ptr<BinData>(const_cast<BinData*>(&data), DummyDeleter<BinData>()), std::shared_ptr<IModelFunction>(dynamic_cast<IModelFunction*>(func.Clone() ) ) ),
       fIsExtended(extended),
       fWeight(weight),
       fNEffPoints(0),
-      fGrad ( std::vector<double> ( func.NPar() ) )
+      fGrad ( std::vector<double> ( func.NPar() ) ),
+      fExecutionPolicy(executionPolicy)
    { }
 
 
@@ -93,7 +96,8 @@ public:
       fIsExtended(f.fIsExtended ),
       fWeight( f.fWeight ),
       fNEffPoints( f.fNEffPoints ),
-      fGrad( f.fGrad)
+      fGrad( f.fGrad),
+      fExecutionPolicy(f.fExecutionPolicy)
    {  }
 
    /**
@@ -106,6 +110,7 @@ public:
       fGrad = rhs.fGrad;
       fIsExtended = rhs.fIsExtended;
       fWeight = rhs.fWeight;
+      fExecutionPolicy = rhs.fExecutionPolicy;
    }
 
 
@@ -118,13 +123,22 @@ public:
    /// i-th likelihood element and its gradient
    virtual double DataElement(const double * x, unsigned int i, double * g) const {
       if (i==0) this->UpdateNCalls();
+#ifdef R__HAS_VECCORE
+      return FitUtil::Evaluate<T>::EvalPoissonBinPdf(BaseFCN::ModelFunction(), BaseFCN::Data(), x, i, g);
+#else
       return FitUtil::EvaluatePoissonBinPdf(BaseFCN::ModelFunction(), BaseFCN::Data(), x, i, g);
+#endif
    }
 
    /// evaluate gradient
    virtual void Gradient(const double *x, double *g) const {
       // evaluate the chi2 gradient
-      FitUtil::EvaluatePoissonLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g );
+      FitUtil::MultiProcessWorkers::Scope workers(fWorkers, fExecutionPolicy, FitUtil::MultiProcessWorkers::kGradient, x, this->NDim(), ReplayInWorkers());
+#ifdef R__HAS_VECCORE
+      FitUtil::Evaluate<T>::EvalPoissonLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fExecutionPolicy);
+#else
+      FitUtil::EvaluatePoissonLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fExecutionPolicy);
+#endif
    }
 
    /// get type of fit method function
@@ -157,7 +171,25 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
-      return FitUtil::EvaluatePoissonLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints);
+      // with the kMultiprocess policy the data are split among the worker processes of this FCN
+      FitUtil::MultiProcessWorkers::Scope workers(fWorkers, fExecutionPolicy, FitUtil::MultiProcessWorkers::kValue, x, this->NDim(), ReplayInWorkers());
+#ifdef R__HAS_VECCORE
+      return FitUtil::Evaluate<T>::EvalPoissonLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints, fExecutionPolicy);
+#else
+      return FitUtil::EvaluatePoissonLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints, fExecutionPolicy);
+#endif
+   }
+
+   // evaluation of the value or of the gradient repeated by the kMultiprocess workers for their chunk of the data
+   FitUtil::MultiProcessWorkers::Replay_t ReplayInWorkers() const {
+      return [this](FitUtil::MultiProcessWorkers::ERequest request, const double * x) {
+         if (request == FitUtil::MultiProcessWorkers::kGradient) {
+            std::vector<double> g(this->NDim());
+            Gradient(x, g.data());
+         }
+         else
+            DoEval(x);
+      };
    }
 
    // for derivatives
@@ -176,6 +208,9 @@ private:
 
    mutable std::vector<double> fGrad; // for derivatives
 
+   unsigned fExecutionPolicy;
+   mutable FitUtil::MultiProcessWorkers fWorkers; //! worker processes of the kMultiprocess policy
+
 };
 
       // define useful typedef's
@@ -18,6 +18,8 @@
 
 #include "Math/VirtualIntegrator.h"
 
+#include "Fit/FitExecutionPolicy.h"
+
 namespace ROOT {
 namespace Math {
 
@@ -71,6 +73,22 @@ For a more detailed description of the method see References.
      Some analysis or suitable transformations of the integral prior to
      numerical work may contribute to numerical efficiency.
 
+### Multi-thread integration:
+
+With the execution policy ROOT::Fit::kMultithread (see SetExecutionPolicy, it requires ROOT
+built with IMT) at each iteration several regions with the largest errors are subdivided
+(16 by default, see SetNRegionsPerIteration), and the function values at the nodes of the rule
+of all the new sub-regions are computed together, in parallel, using ROOT::TThreadExecutor.
+The function must then be thread safe. The integral and error are summed always in the same
+order, so the result does not depend on the number of threads, but it is slightly different
+from the one of the serial algorithm, which subdivides only one region at each iteration.
+The policy can also be set in the default extra options of the "ADAPTIVE" integrator, used by
+ROOT::Math::IntegratorMultiDim and TF1::IntegralMultiple, e.g.
+
+~~~ {.cpp}
+ROOT::Math::IntegratorMultiDimOptions::Default("ADAPTIVE").SetValue("ExecutionPolicy", 1);
+~~~
+
 ### References:
 
   1. A.C. Genz and A.A. Malik, Remarks on algorithm 006:
@@ -166,6 +184,15 @@ public:
    ///set max points
    void SetMaxPts(unsigned int n) { fMaxPts = n; }
 
+   /// set the execution policy: ROOT::Fit::kSerial (default) or ROOT::Fit::kMultithread
+   void SetExecutionPolicy(ROOT::Fit::ExecutionPolicy policy) { fExecutionPolicy = policy; }
+
+   /// return the execution policy
+   ROOT::Fit::ExecutionPolicy GetExecutionPolicy() const { return fExecutionPolicy; }
+
+   /// set the number of regions subdivided at each iteration of the multi-thread integration
+   void SetNRegionsPerIteration(unsigned int n) { fNRegionsPerIter = (n > 0) ? n : 1; }
+
    /// set the options
    void SetOptions(const ROOT::Math::IntegratorMultiDimOptions & opt);
 
@@ -177,6 +204,12 @@ protected:
    // internal function to compute the integral (if absVal is true compute abs value of function integral
    double DoIntegral(const double* xmin, const double * xmax, bool absVal = false);
 
+   // compute the integral subdividing several regions at each iteration and evaluating the function in parallel
+   double DoIntegralMT(const double* xmin, const double * xmax, bool absVal = false);
+
+   // read the execution policy from the extra options
+   void SetExtraOptions(const ROOT::Math::IOptions & opt);
+
  private:
 
    unsigned int fDim;     // dimensionality of integrand
@@ -192,6 +225,9 @@ protected:
    int    fNEval;         // number of function evaluation
    int fStatus;           // status of algorithm (error if not zero)
 
+   ROOT::Fit::ExecutionPolicy fExecutionPolicy; // serial or multi-thread integration
+   unsigned int fNRegionsPerIter;              // regions subdivided at each iteration in multi-thread mode
+
    const IMultiGenFunction* fFun;   // pointer to integrand function
 
 };
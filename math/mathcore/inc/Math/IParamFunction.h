@@ -21,6 +21,7 @@
 
 
 #include <cassert>
+#include <vector>
 
 /**
    @defgroup ParamFunc Parameteric Function Evaluation Interfaces.
@@ -120,6 +121,18 @@ namespace ROOT {
             return DoEvalPar(x, p);
          }
 
+         /**
+         Evaluate function at n points for given parameters p, storing the values in result.
+         The coordinates are given by one array of n values for each dimension: x[0][i], x[1][i], ...
+         are the coordinates of the point i.
+         Use the virtual function DoEvalParBatch, which evaluates one point at a time unless it is
+         re-implemented by the derived classes
+         */
+         void operator()(unsigned int n, const T * const *x, const double *p, T *result) const
+         {
+            DoEvalParBatch(n, x, p, result);
+         }
+
          using BaseFunc::operator();
 
       private:
@@ -129,6 +142,20 @@ namespace ROOT {
          */
          virtual T DoEvalPar(const T *x, const double *p) const = 0;
 
+         /**
+            Implementation of the evaluation at n points. The default calls DoEvalPar for each point
+         */
+         virtual void DoEvalParBatch(unsigned int n, const T * const *x, const double *p, T *result) const
+         {
+            const unsigned int ndim = this->NDim();
+            std::vector<T> xx(ndim);
+            for (unsigned int i = 0; i < n; ++i) {
+               for (unsigned int j = 0; j < ndim; ++j)
+                  xx[j] = x[j][i];
+               result[i] = DoEvalPar(xx.data(), p);
+            }
+         }
+
          /**
             Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
          */
@@ -108,13 +108,16 @@ namespace ROOT {
          /// set the generator seed
          void  SetSeed(Result_t seed);
 
+         /// set the generator seed and the independent stream of the sequence
+         void  SetStreamSeed(Result_t seed, uint32_t stream);
+
          // generate a random number (virtual interface)
          virtual double Rndm() { return Rndm_impl(); }
 
          /// generate a double random number (faster interface)
          inline double operator() () { return Rndm_impl(); }
 
-         /// generate an array of random numbers
+         /// generate an array of random numbers (same sequence as calling Rndm n times)
          void RndmArray (int n, double * array);
 
          /// generate a 64  bit integer number
@@ -0,0 +1,172 @@
+// @(#)root/mathcore:$Id$
+// Authors: L. Moneta    2017
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 , LCG ROOT MathLib Team                         *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+/**
+
+Vectorized versions of the most used special functions, probability density
+functions, cumulative distributions and quantiles of MathCore.
+
+Two interfaces are provided:
+
+- functions evaluating n points at once, taking the array of the n input values
+  and the array where the n results are written, e.g.
+  `ROOT::Math::normal_pdf(n, x, result, sigma, x0)`;
+- when ROOT is built with VecCore, overloads for the `ROOT::Double_v` type, which
+  evaluate all the vector lanes at once, e.g. `ROOT::Math::normal_pdf(xv, sigma, x0)`.
+
+The functions use the same algorithms (mainly from Cephes) as the scalar functions,
+written without branches on the input values, so the results agree with
+the scalar ones within few units of the last digit.
+The array functions use internally the `ROOT::Double_v` type when available,
+otherwise they are written in loops which can be vectorized by the compiler.
+
+@defgroup VecFunc Vectorized mathematical functions
+@ingroup StatFunc
+
+*/
+
+#ifndef ROOT_Math_VecFuncMathCore
+#define ROOT_Math_VecFuncMathCore
+
+#include "Math/Math_vectypes.hxx"
+
+namespace ROOT {
+namespace Math {
+
+   /** @name Special functions on arrays
+       Evaluate the function on the n values of x and write the results in result.
+       @ingroup VecFunc
+   */
+   //@{
+   void erf(unsigned int n, const double *x, double *result);
+   void erfc(unsigned int n, const double *x, double *result);
+   void lgamma(unsigned int n, const double *x, double *result);
+   //@}
+
+   /** @name Probability density functions on arrays
+       Evaluate the pdf on the n values of x and write the results in result.
+       The parameters have the same meaning as in the scalar functions.
+       @ingroup VecFunc
+   */
+   //@{
+   void breitwigner_pdf(unsigned int n, const double *x, double *result, double gamma, double x0 = 0);
+   void cauchy_pdf(unsigned int n, const double *x, double *result, double b = 1, double x0 = 0);
+   void chisquared_pdf(unsigned int n, const double *x, double *result, double r, double x0 = 0);
+   void exponential_pdf(unsigned int n, const double *x, double *result, double lambda, double x0 = 0);
+   void gamma_pdf(unsigned int n, const double *x, double *result, double alpha, double theta, double x0 = 0);
+   void lognormal_pdf(unsigned int n, const double *x, double *result, double m, double s, double x0 = 0);
+   void normal_pdf(unsigned int n, const double *x, double *result, double sigma = 1, double x0 = 0);
+   /// alternative name for same function
+   inline void gaussian_pdf(unsigned int n, const double *x, double *result, double sigma = 1, double x0 = 0) {
+      normal_pdf(n, x, result, sigma, x0);
+   }
+   /// Poisson probabilities of the n counts k with the corresponding means mu
+   void poisson_pdf(unsigned int n, const unsigned int *k, const double *mu, double *result);
+   //@}
+
+   /** @name Cumulative distribution functions on arrays
+       Evaluate the cdf on the n values of x and write the results in result.
+       @ingroup VecFunc
+   */
+   //@{
+   void exponential_cdf(unsigned int n, const double *x, double *result, double lambda, double x0 = 0);
+   void exponential_cdf_c(unsigned int n, const double *x, double *result, double lambda, double x0 = 0);
+   void lognormal_cdf(unsigned int n, const double *x, double *result, double m, double s, double x0 = 0);
+   void lognormal_cdf_c(unsigned int n, const double *x, double *result, double m, double s, double x0 = 0);
+   void normal_cdf(unsigned int n, const double *x, double *result, double sigma = 1, double x0 = 0);
+   void normal_cdf_c(unsigned int n, const double *x, double *result, double sigma = 1, double x0 = 0);
+   /// alternative name for same function
+   inline void gaussian_cdf(unsigned int n, const double *x, double *result, double sigma = 1, double x0 = 0) {
+      normal_cdf(n, x, result, sigma, x0);
+   }
+   /// alternative name for same function
+   inline void gaussian_cdf_c(unsigned int n, const double *x, double *result, double sigma = 1, double x0 = 0) {
+      normal_cdf_c(n, x, result, sigma, x0);
+   }
+   //@}
+
+   /** @name Quantile functions on arrays
+       Evaluate the quantile on the n probabilities z and write the results in result.
+       @ingroup VecFunc
+   */
+   //@{
+   void exponential_quantile(unsigned int n, const double *z, double *result, double lambda);
+   void exponential_quantile_c(unsigned int n, const double *z, double *result, double lambda);
+   void lognormal_quantile(unsigned int n, const double *z, double *result, double m, double s);
+   void lognormal_quantile_c(unsigned int n, const double *z, double *result, double m, double s);
+   void normal_quantile(unsigned int n, const double *z, double *result, double sigma);
+   void normal_quantile_c(unsigned int n, const double *z, double *result, double sigma);
+   /// alternative name for same function
+   inline void gaussian_quantile(unsigned int n, const double *z, double *result, double sigma) {
+      normal_quantile(n, z, result, sigma);
+   }
+   /// alternative name for same function
+   inline void gaussian_quantile_c(unsigned int n, const double *z, double *result, double sigma) {
+      normal_quantile_c(n, z, result, sigma);
+   }
+   //@}
+
+#ifdef R__HAS_VECCORE
+
+   /** @name Functions of ROOT::Double_v
+       Evaluate the function on all the lanes of the vector.
+       @ingroup VecFunc
+   */
+   //@{
+   ROOT::Double_v erf(const ROOT::Double_v &x);
+   ROOT::Double_v erfc(const ROOT::Double_v &x);
+   ROOT::Double_v lgamma(const ROOT::Double_v &x);
+
+   ROOT::Double_v breitwigner_pdf(const ROOT::Double_v &x, double gamma, double x0 = 0);
+   ROOT::Double_v cauchy_pdf(const ROOT::Double_v &x, double b = 1, double x0 = 0);
+   ROOT::Double_v chisquared_pdf(const ROOT::Double_v &x, double r, double x0 = 0);
+   ROOT::Double_v exponential_pdf(const ROOT::Double_v &x, double lambda, double x0 = 0);
+   ROOT::Double_v gamma_pdf(const ROOT::Double_v &x, double alpha, double theta, double x0 = 0);
+   ROOT::Double_v lognormal_pdf(const ROOT::Double_v &x, double m, double s, double x0 = 0);
+   ROOT::Double_v normal_pdf(const ROOT::Double_v &x, double sigma = 1, double x0 = 0);
+   inline ROOT::Double_v gaussian_pdf(const ROOT::Double_v &x, double sigma = 1, double x0 = 0) {
+      return normal_pdf(x, sigma, x0);
+   }
+   /// the counts k must be non-negative integer values
+   ROOT::Double_v poisson_pdf(const ROOT::Double_v &k, const ROOT::Double_v &mu);
+
+   ROOT::Double_v exponential_cdf(const ROOT::Double_v &x, double lambda, double x0 = 0);
+   ROOT::Double_v exponential_cdf_c(const ROOT::Double_v &x, double lambda, double x0 = 0);
+   ROOT::Double_v lognormal_cdf(const ROOT::Double_v &x, double m, double s, double x0 = 0);
+   ROOT::Double_v lognormal_cdf_c(const ROOT::Double_v &x, double m, double s, double x0 = 0);
+   ROOT::Double_v normal_cdf(const ROOT::Double_v &x, double sigma = 1, double x0 = 0);
+   ROOT::Double_v normal_cdf_c(const ROOT::Double_v &x, double sigma = 1, double x0 = 0);
+   inline ROOT::Double_v gaussian_cdf(const ROOT::Double_v &x, double sigma = 1, double x0 = 0) {
+      return normal_cdf(x, sigma, x0);
+   }
+   inline ROOT::Double_v gaussian_cdf_c(const ROOT::Double_v &x, double sigma = 1, double x0 = 0) {
+      return normal_cdf_c(x, sigma, x0);
+   }
+
+   ROOT::Double_v exponential_quantile(const ROOT::Double_v &z, double lambda);
+   ROOT::Double_v exponential_quantile_c(const ROOT::Double_v &z, double lambda);
+   ROOT::Double_v lognormal_quantile(const ROOT::Double_v &z, double m, double s);
+   ROOT::Double_v lognormal_quantile_c(const ROOT::Double_v &z, double m, double s);
+   ROOT::Double_v normal_quantile(const ROOT::Double_v &z, double sigma);
+   ROOT::Double_v normal_quantile_c(const ROOT::Double_v &z, double sigma);
+   inline ROOT::Double_v gaussian_quantile(const ROOT::Double_v &z, double sigma) {
+      return normal_quantile(z, sigma);
+   }
+   inline ROOT::Double_v gaussian_quantile_c(const ROOT::Double_v &z, double sigma) {
+      return normal_quantile_c(z, sigma);
+   }
+   //@}
+
+#endif
+
+} // namespace Math
+} // namespace ROOT
+
+#endif // ROOT_Math_VecFuncMathCore
@@ -25,6 +25,12 @@
 
 #include "TRandom.h"
 
+namespace ROOT {
+   namespace Math {
+      template<int N, int S> class MixMaxEngine;
+   }
+}
+
 template<class Engine>
 class TRandomGen : public TRandom {
 
@@ -45,11 +51,28 @@ public:
       for (int i = 0; i < n; ++i) array[i] = fEngine(); 
    }
    virtual  void     RndmArray(Int_t n, Double_t *array) {
-            for (int i = 0; i < n; ++i) array[i] = fEngine(); 
+      fEngine.RndmArray(n, array);
    }
    virtual  void     SetSeed(ULong_t seed=0) {
       fEngine.SetSeed(seed);
    }
+   virtual  void     SetStreamSeed(ULong_t seed, UInt_t stream) {
+      SetStreamSeedImpl(fEngine, seed, stream);
+   }
+
+private:
+
+   // engines providing independent streams
+   template<int N, int S>
+   void SetStreamSeedImpl(ROOT::Math::MixMaxEngine<N,S> & engine, ULong_t seed, UInt_t stream) {
+      engine.SetStreamSeed(seed, stream);
+   }
+   template<class OtherEngine>
+   void SetStreamSeedImpl(OtherEngine &, ULong_t seed, UInt_t stream) {
+      TRandom::SetStreamSeed(seed, stream);
+   }
+
+public:
 
    ClassDef(TRandomGen,1)  //Generic Random number generator template on the Engine type
 };
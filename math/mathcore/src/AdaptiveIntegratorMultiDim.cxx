@@ -4,14 +4,65 @@
 #include "Math/IFunction.h"
 #include "Math/AdaptiveIntegratorMultiDim.h"
 #include "Math/IntegratorOptions.h"
+#include "Math/GenAlgoOptions.h"
 #include "Math/Error.h"
 
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 namespace ROOT {
 namespace Math {
 
+namespace {
+
+// nodes and weights of the integration rule of degree seven (and of the rule of degree five used
+// for the error estimate), the ones depending on the dimension are for n = 2,...,15
+const double xl2 = 0.358568582800318073;//lambda_2
+const double xl4 = 0.948683298050513796;//lambda_4
+const double xl5 = 0.688247201611685289;//lambda_5
+const double w2  = 980./6561; //weights/2^n
+const double w4  = 200./19683;
+const double wp2 = 245./486;//error weights/2^n
+const double wp4 = 25./729;
+
+const double wn1[14] = {     -0.193872885230909911, -0.555606360818980835,
+                             -0.876695625666819078, -1.15714067977442459,  -1.39694152314179743,
+                             -1.59609815576893754,  -1.75461057765584494,  -1.87247878880251983,
+                             -1.94970278920896201,  -1.98628257887517146,  -1.98221815780114818,
+                             -1.93750952598689219,  -1.85215668343240347,  -1.72615963013768225};
+
+const double wn3[14] = {     0.0518213686937966768,  0.0314992633236803330,
+                             0.0111771579535639891,-0.00914494741655235473,-0.0294670527866686986,
+                             -0.0497891581567850424,-0.0701112635269013768, -0.0904333688970177241,
+                             -0.110755474267134071, -0.131077579637250419,  -0.151399685007366752,
+                             -0.171721790377483099, -0.192043895747599447,  -0.212366001117715794};
+
+const double wn5[14] = {         0.871183254585174982e-01,  0.435591627292587508e-01,
+                                 0.217795813646293754e-01,  0.108897906823146873e-01,  0.544489534115734364e-02,
+                                 0.272244767057867193e-02,  0.136122383528933596e-02,  0.680611917644667955e-03,
+                                 0.340305958822333977e-03,  0.170152979411166995e-03,  0.850764897055834977e-04,
+                                 0.425382448527917472e-04,  0.212691224263958736e-04,  0.106345612131979372e-04};
+
+const double wpn1[14] = {   -1.33196159122085045, -2.29218106995884763,
+                            -3.11522633744855959, -3.80109739368998611, -4.34979423868312742,
+                            -4.76131687242798352, -5.03566529492455417, -5.17283950617283939,
+                            -5.17283950617283939, -5.03566529492455417, -4.76131687242798352,
+                            -4.34979423868312742, -3.80109739368998611, -3.11522633744855959};
+
+const double wpn3[14] = {     0.0445816186556927292, -0.0240054869684499309,
+                              -0.0925925925925925875, -0.161179698216735251,  -0.229766803840877915,
+                              -0.298353909465020564,  -0.366941015089163228,  -0.435528120713305891,
+                              -0.504115226337448555,  -0.572702331961591218,  -0.641289437585733882,
+                              -0.709876543209876532,  -0.778463648834019195,  -0.847050754458161859};
+
+} // anonymous namespace
 
 
 AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double relTol, unsigned int maxpts, unsigned int size):
@@ -25,6 +76,8 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fExecutionPolicy(ROOT::Fit::kSerial),
+   fNRegionsPerIter(16),
    fFun(0)
 {
    // constructor - without passing a function
@@ -32,6 +85,9 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    if (fRelTol < 0) fRelTol = ROOT::Math::IntegratorMultiDimOptions::DefaultRelTolerance();
    if (fMaxPts == 0) fMaxPts = ROOT::Math::IntegratorMultiDimOptions::DefaultNCalls();
    if (fSize   == 0) fSize = ROOT::Math::IntegratorMultiDimOptions::DefaultWKSize();
+   // use the default extra options (e.g. the execution policy)
+   IOptions * opts = IntegratorMultiDimOptions::FindDefault("ADAPTIVE");
+   if (opts) SetExtraOptions(*opts);
 }
 
 AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction &f, double absTol, double relTol, unsigned int maxpts, unsigned int size):
@@ -45,6 +101,8 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fExecutionPolicy(ROOT::Fit::kSerial),
+   fNRegionsPerIter(16),
    fFun(&f)
 {
    // constructur passing a multi-dimensional function interface
@@ -53,6 +111,9 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    if (fRelTol < 0) fRelTol = ROOT::Math::IntegratorMultiDimOptions::DefaultRelTolerance();
    if (fMaxPts == 0) fMaxPts = ROOT::Math::IntegratorMultiDimOptions::DefaultNCalls();
    if (fSize   == 0) fSize = ROOT::Math::IntegratorMultiDimOptions::DefaultWKSize();
+   // use the default extra options (e.g. the execution policy)
+   IOptions * opts = IntegratorMultiDimOptions::FindDefault("ADAPTIVE");
+   if (opts) SetExtraOptions(*opts);
 }
 
 
@@ -83,6 +144,16 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    //   2.A. van Doren and L. de Ridder, An adaptive algorithm for numerical
    //     integration over an n-dimensional cube, J.Comput. Appl. Math. 2 (1976) 207-217.
 
+   if (fExecutionPolicy == ROOT::Fit::kMultithread) {
+#ifdef R__USE_IMT
+      return DoIntegralMT(xmin, xmax, absValue);
+#else
+      MATH_WARN_MSG("AdaptiveIntegratorMultiDim::Integral","The multi-thread integration requires IMT - use the serial one");
+#endif
+   }
+   else if (fExecutionPolicy != ROOT::Fit::kSerial)
+      MATH_WARN_MSG("AdaptiveIntegratorMultiDim::Integral","Execution policy not supported - use the serial integration");
+
    //to be changed later
    unsigned int n=fDim;
    bool kFALSE = false;
@@ -98,44 +169,6 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
 
    double ctr[15], wth[15], wthl[15], z[15];
 
-   static const double xl2 = 0.358568582800318073;//lambda_2
-   static const double xl4 = 0.948683298050513796;//lambda_4
-   static const double xl5 = 0.688247201611685289;//lambda_5
-   static const double w2  = 980./6561; //weights/2^n
-   static const double w4  = 200./19683;
-   static const double wp2 = 245./486;//error weights/2^n
-   static const double wp4 = 25./729;
-
-   static const double wn1[14] = {     -0.193872885230909911, -0.555606360818980835,
-                                       -0.876695625666819078, -1.15714067977442459,  -1.39694152314179743,
-                                       -1.59609815576893754,  -1.75461057765584494,  -1.87247878880251983,
-                                       -1.94970278920896201,  -1.98628257887517146,  -1.98221815780114818,
-                                       -1.93750952598689219,  -1.85215668343240347,  -1.72615963013768225};
-
-   static const double wn3[14] = {     0.0518213686937966768,  0.0314992633236803330,
-                                       0.0111771579535639891,-0.00914494741655235473,-0.0294670527866686986,
-                                       -0.0497891581567850424,-0.0701112635269013768, -0.0904333688970177241,
-                                       -0.110755474267134071, -0.131077579637250419,  -0.151399685007366752,
-                                       -0.171721790377483099, -0.192043895747599447,  -0.212366001117715794};
-
-   static const double wn5[14] = {         0.871183254585174982e-01,  0.435591627292587508e-01,
-                                           0.217795813646293754e-01,  0.108897906823146873e-01,  0.544489534115734364e-02,
-                                           0.272244767057867193e-02,  0.136122383528933596e-02,  0.680611917644667955e-03,
-                                           0.340305958822333977e-03,  0.170152979411166995e-03,  0.850764897055834977e-04,
-                                           0.425382448527917472e-04,  0.212691224263958736e-04,  0.106345612131979372e-04};
-
-   static const double wpn1[14] = {   -1.33196159122085045, -2.29218106995884763,
-                                      -3.11522633744855959, -3.80109739368998611, -4.34979423868312742,
-                                      -4.76131687242798352, -5.03566529492455417, -5.17283950617283939,
-                                      -5.17283950617283939, -5.03566529492455417, -4.76131687242798352,
-                                      -4.34979423868312742, -3.80109739368998611, -3.11522633744855959};
-
-   static const double wpn3[14] = {     0.0445816186556927292, -0.0240054869684499309,
-                                        -0.0925925925925925875, -0.161179698216735251,  -0.229766803840877915,
-                                        -0.298353909465020564,  -0.366941015089163228,  -0.435528120713305891,
-                                        -0.504115226337448555,  -0.572702331961591218,  -0.641289437585733882,
-                                        -0.709876543209876532,  -0.778463648834019195,  -0.847050754458161859};
-
    double result = 0;
    double abserr = 0;
    fStatus  = 3;
@@ -381,6 +414,216 @@ L160: //to divide or not
 }
 
 
+#ifdef R__USE_IMT
+namespace {
+
+// rectangular region used by the multi-thread integration
+struct IntegRegion {
+   std::vector<double> fCtr; // center
+   std::vector<double> fWth; // half widths
+   double fValue;            // integral estimate
+   double fError;            // error estimate
+   unsigned int fDivAxis;    // coordinate (from 1) along which the region is subdivided
+};
+
+// the region with the largest error is on top of the heap
+bool LessError(const IntegRegion & r1, const IntegRegion & r2) { return r1.fError < r2.fError; }
+
+// fill the nodes of the integration rule of the region in x, in the order used by ApplyRule
+void FillRuleNodes(const IntegRegion & r, unsigned int n, double * x)
+{
+   const double * ctr = r.fCtr.data();
+   const double * wth = r.fWth.data();
+   auto next = [&]() { std::copy(ctr, ctr + n, x); x += n; return x - n; };
+   next();
+   for (unsigned int j = 0; j < n; j++) {
+      next()[j] = ctr[j] - xl2*wth[j];
+      next()[j] = ctr[j] + xl2*wth[j];
+      next()[j] = ctr[j] - xl4*wth[j];
+      next()[j] = ctr[j] + xl4*wth[j];
+   }
+   for (unsigned int j = 0; j < n; j++) {
+      for (unsigned int k = j+1; k < n; k++) {
+         for (unsigned int l = 0; l < 4; l++) {
+            double * z = next();
+            z[j] = ctr[j] + ((l & 1) ? xl4 : -xl4)*wth[j];
+            z[k] = ctr[k] + ((l & 2) ? xl4 : -xl4)*wth[k];
+         }
+      }
+   }
+   for (unsigned int i = 0; i < (1u << n); i++) {
+      double * z = next();
+      for (unsigned int j = 0; j < n; j++)
+         z[j] = ctr[j] + (((i >> j) & 1) ? xl5 : -xl5)*wth[j];
+   }
+}
+
+// compute integral, error and subdivision axis of the region from the function values at the rule nodes
+void ApplyRule(IntegRegion & r, unsigned int n, const double * f)
+{
+   double rgnvol = std::pow(2.0,static_cast<int>(n));
+   for (unsigned int j = 0; j < n; j++) rgnvol *= r.fWth[j];
+
+   double sum1 = *f++;
+   double sum2 = 0, sum3 = 0, sum4 = 0, sum5 = 0;
+   double difmax = 0;
+   r.fDivAxis = 1;
+   for (unsigned int j = 0; j < n; j++) {
+      double f2 = f[0] + f[1];
+      double f3 = f[2] + f[3];
+      f += 4;
+      sum2 += f2;
+      sum3 += f3;
+      double dif = std::abs(7*f2-f3-12*sum1);
+      if (dif >= difmax) {
+         difmax = dif;
+         r.fDivAxis = j+1;
+      }
+   }
+   for (unsigned int i = 0; i < 2*n*(n-1); i++) sum4 += *f++;
+   for (unsigned int i = 0; i < (1u << n); i++) sum5 += *f++;
+
+   double rgncmp = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
+   r.fValue = rgnvol*(wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5);
+   r.fError = std::abs(r.fValue-rgncmp);
+}
+
+} // anonymous namespace
+#endif
+
+double AdaptiveIntegratorMultiDim::DoIntegralMT(const double* xmin, const double * xmax, bool absValue)
+{
+   // Same algorithm as DoIntegral, but subdividing at each iteration the fNRegionsPerIter regions with
+   // the largest errors. The function values at the nodes of the rules of all the new regions are
+   // computed in parallel, then integral and errors are summed serially in a fixed order, so that
+   // the result does not depend on the number of threads.
+
+#ifndef R__USE_IMT
+   // not used without IMT: DoIntegral uses the serial algorithm
+   return DoIntegral(xmin, xmax, absValue);
+#else
+   unsigned int n = fDim;
+   fStatus = 3;
+   fResult = 0;
+   fError = 0;
+   fRelError = 0;
+   fNEval = 0;
+   // does not work for 1D functions
+   if (n < 2 || n > 15) {
+      MATH_WARN_MSGVAL("AdaptiveIntegratorMultiDim::Integral","Wrong function dimension",n);
+      return 0;
+   }
+
+   unsigned int irgnst = 2*n+3;
+   unsigned int irlcls = (1u << n) +2*n*(n+1)+1;//minimal number of nodes in n dim
+   unsigned int minpts = fMinPts;
+   unsigned int maxpts = std::max(fMaxPts, irlcls);
+   if (minpts < 1)      minpts = irlcls;
+   if (maxpts < minpts) maxpts = 10*minpts;
+   // maximum number of regions, for the same working space size of the serial algorithm
+   unsigned int iwk = std::max( fSize, irgnst*(1 +maxpts/irlcls)/2 );
+   unsigned int maxrgn = iwk/irgnst;
+
+   std::vector<IntegRegion> regions;   // heap of the regions ordered by error
+   std::vector<IntegRegion> newRegions(1);
+   newRegions[0].fCtr.resize(n);
+   newRegions[0].fWth.resize(n);
+   for (unsigned int j=0; j<n; j++) {
+      newRegions[0].fCtr[j] = (xmax[j] + xmin[j])*0.5;
+      newRegions[0].fWth[j] = (xmax[j] - xmin[j])*0.5;
+   }
+
+   std::vector<double> x;
+   std::vector<double> fval;
+   ROOT::TThreadExecutor pool;
+   double result = 0;
+   double abserr = 0;
+   double relerr = 0;
+   unsigned int ifncls = 0;
+
+   while (true) {
+      unsigned int npts = newRegions.size()*irlcls;
+      x.resize(npts*n);
+      fval.resize(npts);
+      for (unsigned int i = 0; i < newRegions.size(); i++)
+         FillRuleNodes(newRegions[i], n, &x[i*irlcls*n]);
+
+      // evaluate the function in chunks of points, the values do not depend on the chunks
+      const unsigned int nChunks = std::min(npts, 64u);
+      auto evalChunk = [&](unsigned int ichunk) {
+         unsigned int end = (unsigned long long)npts * (ichunk + 1) / nChunks;
+         for (unsigned int i = (unsigned long long)npts * ichunk / nChunks; i < end; i++) {
+            fval[i] = (*fFun)(&x[i*n]);
+            if (absValue) fval[i] = std::abs(fval[i]);
+         }
+      };
+      pool.Foreach(evalChunk, ROOT::TSeq<unsigned int>(0, nChunks));
+
+      for (unsigned int i = 0; i < newRegions.size(); i++) {
+         ApplyRule(newRegions[i], n, &fval[i*irlcls]);
+         result += newRegions[i].fValue;
+         abserr += newRegions[i].fError;
+         regions.push_back(std::move(newRegions[i]));
+         std::push_heap(regions.begin(), regions.end(), LessError);
+      }
+      ifncls += npts;
+
+      // same stopping conditions as the serial algorithm
+      double aresult = std::abs(result);
+      relerr = abserr;
+      if (aresult != 0)  relerr = abserr/aresult;
+      fStatus = 3;
+      if (relerr < 1e-1 && aresult < 1e-20) fStatus = 0;
+      if (relerr < 1e-3 && aresult < 1e-10) fStatus = 0;
+      if (relerr < 1e-5 && aresult < 1e-5)  fStatus = 0;
+      if (regions.size() + 1 > maxrgn) fStatus = 2;
+      if (ifncls+2*irlcls > maxpts) fStatus = 1;
+      if ( ( relerr < fRelTol || abserr < fAbsTol ) && ifncls >= minpts) fStatus = 0;
+      if (fStatus != 3) break;
+
+      // subdivide in two halves the regions with the largest errors
+      unsigned int ndiv = std::min(fNRegionsPerIter, (unsigned int) regions.size());
+      ndiv = std::min(ndiv, (maxpts - ifncls)/(2*irlcls));
+      ndiv = std::min(ndiv, maxrgn - (unsigned int) regions.size());
+      newRegions.resize(2*ndiv);
+      for (unsigned int i = 0; i < ndiv; i++) {
+         std::pop_heap(regions.begin(), regions.end(), LessError);
+         IntegRegion & r1 = newRegions[2*i];
+         IntegRegion & r2 = newRegions[2*i+1];
+         r1 = std::move(regions.back());
+         regions.pop_back();
+         result -= r1.fValue;
+         abserr -= r1.fError;
+         unsigned int j = r1.fDivAxis - 1;
+         r1.fWth[j] *= 0.5;
+         r2 = r1;
+         r1.fCtr[j] -= r1.fWth[j];
+         r2.fCtr[j] += r2.fWth[j];
+      }
+   }
+
+   fResult = result;
+   fError = abserr;
+   fRelError = relerr;
+   fNEval = ifncls;
+   return result;
+#endif
+}
+
+void AdaptiveIntegratorMultiDim::SetExtraOptions(const IOptions & opt)
+{
+   // set the execution policy (0 = serial, 1 = multi-thread) and the number of regions
+   // subdivided at each iteration of the multi-thread integration
+   int executionPolicy = fExecutionPolicy;
+   opt.GetValue("ExecutionPolicy", executionPolicy);
+   if (executionPolicy == ROOT::Fit::kSerial || executionPolicy == ROOT::Fit::kMultithread)
+      fExecutionPolicy = ROOT::Fit::ExecutionPolicy(executionPolicy);
+   else
+      MATH_ERROR_MSGVAL("AdaptiveIntegratorMultiDim::SetOptions","Invalid execution policy - ignored",executionPolicy);
+   int nregions = fNRegionsPerIter;
+   opt.GetValue("NRegionsPerIteration", nregions);
+   SetNRegionsPerIteration(std::max(nregions, 1));
+}
 
 double AdaptiveIntegratorMultiDim::Integral(const IMultiGenFunction &f, const double* xmin, const double * xmax)
 {
@@ -398,6 +641,12 @@ ROOT::Math::IntegratorMultiDimOptions  AdaptiveIntegratorMultiDim::Options() con
    opt.SetNCalls(fMaxPts);
    opt.SetWKSize(fSize);
    opt.SetIntegrator("ADAPTIVE");
+   if (fExecutionPolicy != ROOT::Fit::kSerial) {
+      ROOT::Math::GenAlgoOptions extraOpt;
+      extraOpt.SetValue("ExecutionPolicy", int(fExecutionPolicy));
+      extraOpt.SetValue("NRegionsPerIteration", int(fNRegionsPerIter));
+      opt.SetExtraOptions(extraOpt);
+   }
    return opt;
 }
 
@@ -412,6 +661,7 @@ void AdaptiveIntegratorMultiDim::SetOptions(const ROOT::Math::IntegratorMultiDim
    SetRelTolerance( opt.RelTolerance() );
    SetMaxPts( opt.NCalls() );
    SetSize( opt.WKSize() );
+   if (opt.ExtraOptions()) SetExtraOptions(*opt.ExtraOptions());
 }
 
 } // namespace Math
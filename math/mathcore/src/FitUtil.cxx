@@ -26,6 +26,13 @@
 #include "Math/Error.h"
 #include "Math/Util.h"  // for safe log(x)
 
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "MPSendRecv.h"
+#include "TMPClient.h"
+#include "TMPWorker.h"
+#endif
+
 #include <limits>
 #include <cmath>
 #include <cassert>
@@ -210,6 +217,136 @@ namespace ROOT {
             }
          }
 
+         // return the coordinates of point i, copied in x when the data are multi-dimensional
+         // (thread safe replacement of FitData::Coords)
+         const double * GetCoords(const FitData & data, unsigned int i, std::vector<double> & x) {
+            if (data.NDim() == 1) return data.GetCoordComponent(i, 0);
+            x.resize(data.NDim());
+            for (unsigned int j = 0; j < data.NDim(); ++j)
+               x[j] = *data.GetCoordComponent(i, j);
+            return x.data();
+         }
+
+         // return the upper edges of bin i, copied in x2
+         // (thread safe replacement of BinData::BinUpEdge)
+         const double * GetBinUpEdge(const BinData & data, unsigned int i, std::vector<double> & x2) {
+            x2.resize(data.NDim());
+            for (unsigned int j = 0; j < data.NDim(); ++j)
+               x2[j] = data.GetBinUpEdgeComponent(i, j);
+            return x2.data();
+         }
+
+         // evaluate the model function at the points [begin, end) with a single call, storing the
+         // values in fval: the coordinates of the points are contiguous for each dimension
+         void EvaluateModel(const IModelFunction & func, const FitData & data, const double * p,
+                            unsigned int begin, unsigned int end, double * fval) {
+            if (begin >= end) return;
+            std::vector<const double *> x(data.NDim());
+            for (unsigned int j = 0; j < data.NDim(); ++j)
+               x[j] = data.GetCoordComponent(begin, j);
+            func(end - begin, x.data(), p, fval);
+         }
+
+         // element-wise sum of the results of the data chunks
+         std::vector<double> SumChunks(const std::vector<std::vector<double> > & grads) {
+            std::vector<double> g(grads.front());
+            for (unsigned int i = 1; i < grads.size(); ++i)
+               for (unsigned int k = 0; k < g.size(); ++k)
+                  g[k] += grads[i][k];
+            return g;
+         }
+
+         // evaluate the sums (e.g. the gradient) over the n data points with chunkGradient(begin, end),
+         // which returns them for the points in [begin, end): in one go for the serial policy, on
+         // chunks of the data summed afterwards for the multi-thread policy.
+         // With the multi-thread policy the first point is evaluated before dispatching the chunks, so
+         // that what the model function prepares on first use (e.g. the code of the analytic gradient
+         // of a TFormula) is prepared once, in this thread
+         template<class ChunkGradient>
+         std::vector<double> EvaluateChunks(const ChunkGradient & chunkGradient, unsigned int n,
+                                                    const unsigned int & executionPolicy, unsigned nChunks, const char * where) {
+            if (executionPolicy == ROOT::Fit::kSerial)
+               return chunkGradient(0, n);
+            if (executionPolicy == ROOT::Fit::kMultiprocess)
+               return EvaluateChunksMultiProcess(chunkGradient, n, nChunks);
+#ifdef R__USE_IMT
+            if (executionPolicy == ROOT::Fit::kMultithread) {
+               std::vector<double> first = chunkGradient(0, std::min(n, 1u));
+               if (n <= 1) return first;
+               const unsigned int nrest = n - 1;
+               if (nChunks == 0) nChunks = setAutomaticChunking(nrest);
+               nChunks = std::max(1u, std::min(nChunks, nrest));
+               auto mapFunction = [&](unsigned int ichunk) {
+                  return chunkGradient(1 + (unsigned long long)nrest * ichunk / nChunks,
+                                       1 + (unsigned long long)nrest * (ichunk + 1) / nChunks);
+               };
+               ROOT::TThreadExecutor pool;
+               return SumChunks({first, pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, nChunks), SumChunks)});
+            }
+#endif
+            Error(where, "Execution policy unknown. Avalaible choices:\n 0: Serial (default)\n 1: MultiThread (requires IMT)\n 2: MultiProcess\n");
+            return chunkGradient(0, 0);
+         }
+
+#ifdef R__HAS_VECCORE
+         // load the values of the points first, first+1, ... in the lanes of v, repeating
+         // the last of the n points in the lanes past it
+         void LoadLanes(ROOT::Double_v & v, const double * values, unsigned int n) {
+            const unsigned int vecSize = vecCore::VectorSize<ROOT::Double_v>();
+            if (n >= vecSize) {
+               vecCore::Load<ROOT::Double_v>(v, values);
+               return;
+            }
+            for (unsigned int l = 0; l < vecSize; ++l)
+               vecCore::Set(v, l, values[std::min(l, n - 1)]);
+         }
+
+         // load the coordinates of the points of the vector ivec in x and return the number of
+         // lanes holding a point, less than the vector size for the last vector
+         unsigned int LoadCoords(const FitData & data, unsigned int ivec, std::vector<ROOT::Double_v> & x) {
+            const unsigned int vecSize = vecCore::VectorSize<ROOT::Double_v>();
+            const unsigned int first = ivec * vecSize;
+            const unsigned int nlanes = std::min(vecSize, data.Size() - first);
+            x.resize(data.NDim());
+            for (unsigned int j = 0; j < data.NDim(); ++j) {
+               if (nlanes == vecSize)
+                  vecCore::Load<ROOT::Double_v>(x[j], data.GetCoordComponent(first, j));
+               else {
+                  for (unsigned int l = 0; l < vecSize; ++l)
+                     vecCore::Set(x[j], l, *data.GetCoordComponent(first + std::min(l, nlanes - 1), j));
+               }
+            }
+            return nlanes;
+         }
+
+         // vectorized ROOT::Math::Util::EvalLog, protecting against zero or negative values
+         ROOT::Double_v EvalLog(const ROOT::Double_v & x) {
+            const double epsilon = 2. * std::numeric_limits<double>::min();
+            ROOT::Double_v logx = vecCore::math::Log(vecCore::math::Max(x, ROOT::Double_v(epsilon)));
+            vecCore::MaskedAssign<ROOT::Double_v>(logx, x <= ROOT::Double_v(epsilon), x / epsilon + std::log(epsilon) - 1);
+            return logx;
+         }
+
+         // evaluate the vectorized model function at the points of the vector ivec and, for each of
+         // the nlanes points, its gradient with respect to the parameters
+         ROOT::Double_v EvalFunctionAndGradient(const IModelFunctionTempl<ROOT::Double_v> & func, const FitData & data,
+                                                const double * p, unsigned int ivec, unsigned int & nlanes,
+                                                std::vector<ROOT::Double_v> & x, std::vector<double> & xl, double * gradFunc) {
+            typedef ROOT::Math::IParamMultiGradFunctionTempl<ROOT::Double_v> IGradModelFunction_v;
+            const IGradModelFunction_v * gfunc = dynamic_cast<const IGradModelFunction_v *>(&func);
+            assert(gfunc != 0); // must be called by a gradient function
+            const unsigned int npar = func.NPar();
+            nlanes = LoadCoords(data, ivec, x);
+            xl.resize(data.NDim());
+            for (unsigned int l = 0; l < nlanes; ++l) {
+               for (unsigned int j = 0; j < data.NDim(); ++j)
+                  xl[j] = vecCore::Get(x[j], l);
+               gfunc->ParameterGradient(xl.data(), p, gradFunc + l * npar);
+            }
+            return func(x.data(), p);
+         }
+#endif
+
 
 
       } // end namespace  FitUtil
@@ -263,7 +400,8 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 
-   auto mapFunction = [&](const unsigned i){
+   // chi2 of the point i, with the model value at the point if it is already known
+   auto mapFunction = [&](const unsigned i, const double * modelValue){
 
       double chi2{};
       double fval{};
@@ -300,7 +438,10 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
       }
 
 
-      if (!useBinIntegral) {
+      if (modelValue) {
+         fval = *modelValue;
+      }
+      else if (!useBinIntegral) {
 #ifdef USE_PARAMCACHE
          fval = func ( x );
 #else
@@ -352,33 +493,21 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
       return chi2;
   };
 
-#ifdef R__USE_IMT
-  auto redFunction = [](const std::vector<double> & objs){
-                          return std::accumulate(objs.begin(), objs.end(), double{});
-  };
-#else
-  (void)nChunks;
-#endif
-
-  double res{};
-  if(executionPolicy == ROOT::Fit::kSerial){
-    for (unsigned int i=0; i<n; ++i) {
-      res += mapFunction(i);
+  // chi2 of the points in [begin, end): without bin integrals or volumes the model function
+  // is evaluated at all the points of the chunk with a single call
+  auto chunkChi2 = [&](unsigned int begin, unsigned int end) {
+    std::vector<double> chi2(1);
+    std::vector<double> fvalues;
+    if (!useBinIntegral && !useBinVolume) {
+      fvalues.resize(end - begin);
+      EvaluateModel(func, data, p, begin, end, fvalues.data());
     }
-#ifdef R__USE_IMT
-  } else if(executionPolicy == ROOT::Fit::kMultithread) {
-    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    ROOT::TThreadExecutor pool;
-    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
-#endif
-//   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
-    // ROOT::TProcessExecutor pool;
-    // res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction);
-  } else{
-    Error("FitUtil::EvaluateChi2","Execution policy unknown. Avalaible choices:\n 0: Serial (default)\n 1: MultiThread (requires IMT)\n");
-  }
+    for (unsigned int i = begin; i < end; ++i)
+      chi2[0] += mapFunction(i, fvalues.empty() ? nullptr : &fvalues[i - begin]);
+    return chi2;
+  };
 
-   return res;
+  return EvaluateChunks(chunkChi2, n, executionPolicy, nChunks, "FitUtil::EvaluateChi2")[0];
 }
 
 
@@ -610,7 +739,7 @@ double FitUtil::EvaluateChi2Residual(const IModelFunction & func, const BinData
 
 }
 
-void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int & nPoints) {
+void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int & nPoints, const unsigned int & executionPolicy, unsigned nChunks) {
    // evaluate the gradient of the chi2 function
    // this function is used when the model function knows how to calculate the derivative and we can
    // avoid that the minimizer re-computes them
@@ -621,8 +750,6 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
       MATH_ERROR_MSG("FitUtil::EvaluateChi2Residual","Error on the coordinates are not used in calculating Chi2 gradient");            return; // it will assert otherwise later in GetPoint
    }
 
-   unsigned int nRejected = 0;
-
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
    assert (fg != 0); // must be called by a gradient function
 
@@ -640,98 +767,99 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
    bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
 
    double wrefVolume = 1.0;
-   std::vector<double> xc;
    if (useBinVolume) {
       if (fitOpt.fNormBinVolume) wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
    }
 
-   IntegralEvaluator<> igEval( func, p, useBinIntegral);
-
-   //int nRejected = 0;
-   // set values of parameters
-
    unsigned int npar = func.NPar();
    //   assert (npar == NDim() );  // npar MUST be  Chi2 dimension
-   std::vector<double> gradFunc( npar );
-   // set all vector values to zero
-   std::vector<double> g( npar);
-
-   for (unsigned int i = 0; i < n; ++ i) {
 
-
-      double y, invError = 0;
-      const double * x1 = data.GetPoint(i,y, invError);
-
-      double fval = 0;
-      const double * x2 = 0;
-
-      double binVolume = 1;
-      if (useBinVolume) {
-         unsigned int ndim = data.NDim();
-         x2 = data.BinUpEdge(i);
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
+   // gradient of the points in [begin, end), followed by the number of rejected points
+   auto chunkGradient = [&](unsigned int begin, unsigned int end) {
+      std::vector<double> gradFunc( npar );
+      std::vector<double> g( npar + 1 );
+      std::vector<double> xc, x1c, x2c;
+      IntegralEvaluator<> igEval( func, p, useBinIntegral && begin < end);
+
+      for (unsigned int i = begin; i < end; ++ i) {
+
+         const double * x1 = GetCoords(data, i, x1c);
+         double y = data.Value(i);
+         double invError = data.Error(i);
+         invError = (invError != 0.0) ? 1.0/invError : 1;
+
+         double fval = 0;
+         const double * x2 = 0;
+
+         double binVolume = 1;
+         if (useBinVolume) {
+            unsigned int ndim = data.NDim();
+            x2 = GetBinUpEdge(data, i, x2c);
+            xc.resize(ndim);
+            for (unsigned int j = 0; j < ndim; ++j) {
+               binVolume *= std::abs( x2[j]-x1[j] );
+               xc[j] = 0.5*(x2[j]+ x1[j]);
+            }
+            // normalize the bin volume using a reference value
+            binVolume *= wrefVolume;
          }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+         const double * x = (useBinVolume) ? &xc.front() : x1;
 
-      if (!useBinIntegral ) {
-         fval = func ( x, p );
-         func.ParameterGradient(  x , p, &gradFunc[0] );
-      }
-      else {
-         x2 = data.BinUpEdge(i);
-         // calculate normalized integral and gradient (divided by bin volume)
-         // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x1, x2 ) ;
-         CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]);
-      }
-      if (useBinVolume) fval *= binVolume;
+         if (!useBinIntegral ) {
+            fval = func ( x, p );
+            func.ParameterGradient(  x , p, &gradFunc[0] );
+         }
+         else {
+            x2 = GetBinUpEdge(data, i, x2c);
+            // calculate normalized integral and gradient (divided by bin volume)
+            fval = igEval( x1, x2 ) ;
+            CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]);
+         }
+         if (useBinVolume) fval *= binVolume;
 
 #ifdef DEBUG
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
-      for (unsigned int ipar = 0; ipar < npar; ++ipar)
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << std::endl;
+         std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
+         for (unsigned int ipar = 0; ipar < npar; ++ipar)
+            std::cout << p[ipar] << "\t";
+         std::cout << "\tfval = " << fval << std::endl;
 #endif
-      if ( !CheckValue(fval) ) {
-         nRejected++;
-         continue;
-      }
+         if ( !CheckValue(fval) ) {
+            g[npar]++;
+            continue;
+         }
 
-      // loop on the parameters
-      unsigned int ipar = 0;
-      for ( ; ipar < npar ; ++ipar) {
+         // loop on the parameters
+         unsigned int ipar = 0;
+         for ( ; ipar < npar ; ++ipar) {
 
-         // correct gradient for bin volumes
-         if (useBinVolume) gradFunc[ipar] *= binVolume;
+            // correct gradient for bin volumes
+            if (useBinVolume) gradFunc[ipar] *= binVolume;
 
-         // avoid singularity in the function (infinity and nan ) in the chi2 sum
-         // eventually add possibility of excluding some points (like singularity)
-         double dfval = gradFunc[ipar];
-         if ( !CheckValue(dfval) ) {
-               break; // exit loop on parameters
-         }
+            // avoid singularity in the function (infinity and nan ) in the chi2 sum
+            // eventually add possibility of excluding some points (like singularity)
+            double dfval = gradFunc[ipar];
+            if ( !CheckValue(dfval) ) {
+                  break; // exit loop on parameters
+            }
 
-         // calculate derivative point contribution
-         double tmp = - 2.0 * ( y -fval )* invError * invError * gradFunc[ipar];
-         g[ipar] += tmp;
+            // calculate derivative point contribution
+            double tmp = - 2.0 * ( y -fval )* invError * invError * gradFunc[ipar];
+            g[ipar] += tmp;
 
-      }
+         }
 
-      if ( ipar < npar ) {
-          // case loop was broken for an overflow in the gradient calculation
-         nRejected++;
-         continue;
+         if ( ipar < npar ) {
+             // case loop was broken for an overflow in the gradient calculation
+            g[npar]++;
+            continue;
+         }
       }
+      return g;
+   };
 
-
-   }
+   std::vector<double> g = EvaluateChunks(chunkGradient, n, executionPolicy, nChunks, "FitUtil::EvaluateChi2Gradient");
+   unsigned int nRejected = g[npar];
 
    // correct the number of points
    nPoints = n;
@@ -742,9 +870,75 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
    }
 
    // copy result
-   std::copy(g.begin(), g.end(), grad);
+   std::copy(g.begin(), g.begin() + npar, grad);
+
+}
+
+#ifdef R__HAS_VECCORE
+void FitUtil::EvaluateChi2Gradient(const IModelFunctionTempl<ROOT::Double_v> & func, const BinData & data, const double * p, double * grad, unsigned int & nPoints, const unsigned int & executionPolicy, unsigned nChunks) {
+   // evaluate the gradient of the chi2 function with a vectorized model function:
+   // the function is evaluated on vectors of points, its gradient on each point
+
+   const DataOptions & fitOpt = data.Opt();
+   if ( data.HaveCoordErrors() || fitOpt.fIntegral || fitOpt.fBinVolume || fitOpt.fExpErrors) {
+      Error("FitUtil::EvaluateChi2Gradient", "The vectorized implementation doesn't support coordinate errors, Integrals, BinVolume or ExpErrors\n. Aborting operation.");
+      return;
+   }
+
+   unsigned int n = data.Size();
+   unsigned int npar = func.NPar();
+   const unsigned int vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   const unsigned int nvec = (n + vecSize - 1) / vecSize;
+
+   // gradient of the vectors of points in [begin, end), followed by the number of rejected points
+   auto chunkGradient = [&](unsigned int begin, unsigned int end) {
+      std::vector<double> gradFunc( npar * vecSize );
+      std::vector<double> g( npar + 1 );
+      std::vector<ROOT::Double_v> x;
+      std::vector<double> xl;
+      for (unsigned int ivec = begin; ivec < end; ++ivec) {
+         unsigned int nlanes = 0;
+         ROOT::Double_v fval = EvalFunctionAndGradient(func, data, p, ivec, nlanes, x, xl, gradFunc.data());
+         for (unsigned int l = 0; l < nlanes; ++l) {
+            unsigned int i = ivec * vecSize + l;
+            double y = data.Value(i);
+            double invError = data.Error(i);
+            invError = (invError != 0.0) ? 1.0/invError : 1;
+            double fl = vecCore::Get(fval, l);
+            if ( !CheckValue(fl) ) {
+               g[npar]++;
+               continue;
+            }
+            const double * gl = &gradFunc[l * npar];
+            unsigned int ipar = 0;
+            for ( ; ipar < npar; ++ipar) {
+               double dfval = gl[ipar];
+               if ( !CheckValue(dfval) ) break;
+            }
+            if ( ipar < npar ) {
+               g[npar]++;
+               continue;
+            }
+            for (ipar = 0; ipar < npar; ++ipar)
+               g[ipar] += - 2.0 * ( y - fl )* invError * invError * gl[ipar];
+         }
+      }
+      return g;
+   };
+
+   std::vector<double> g = EvaluateChunks(chunkGradient, nvec, executionPolicy, nChunks, "FitUtil::EvaluateChi2Gradient");
+   unsigned int nRejected = g[npar];
 
+   nPoints = n;
+   if (nRejected != 0)  {
+      assert(nRejected <= n);
+      nPoints = n - nRejected;
+      if (nPoints < npar)  MATH_ERROR_MSG("FitUtil::EvaluateChi2Gradient","Error - too many points rejected for overflow in gradient calculation");
+   }
+
+   std::copy(g.begin(), g.begin() + npar, grad);
 }
+#endif
 
 //______________________________________________________________________________________________________
 //
@@ -913,8 +1107,6 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double>  & func, const Un
                            return l1+l2;
                   });
   };
-#else
-  (void)nChunks;
 #endif
 
   double logl{};
@@ -936,11 +1128,23 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double>  & func, const Un
     sumW=resArray.weight;
     sumW2=resArray.weight2;
 #endif
-//   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
-    // ROOT::TProcessExecutor pool;
-    // res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction);
+  } else if(executionPolicy == ROOT::Fit::kMultiprocess){
+    auto chunkLogL = [&](unsigned int begin, unsigned int end) {
+      std::vector<double> sums(3);
+      for (unsigned int i = begin; i < end; ++i) {
+        auto resArray = mapFunction(i);
+        sums[0] += resArray.logvalue;
+        sums[1] += resArray.weight;
+        sums[2] += resArray.weight2;
+      }
+      return sums;
+    };
+    auto resArray = EvaluateChunksMultiProcess(chunkLogL, n, nChunks);
+    logl=resArray[0];
+    sumW=resArray[1];
+    sumW2=resArray[2];
   } else{
-    Error("FitUtil::EvaluateLogL","Execution policy unknown. Avalaible choices:\n 0: Serial (default)\n 1: MultiThread (requires IMT)\n");
+    Error("FitUtil::EvaluateLogL","Execution policy unknown. Avalaible choices:\n 0: Serial (default)\n 1: MultiThread (requires IMT)\n 2: MultiProcess\n");
   }
 
   if (extended) {
@@ -1001,11 +1205,49 @@ nPoints = 0;
 }
 
 #ifdef R__HAS_VECCORE
-void FitUtil::EvaluateLogLGradient(const IModelFunctionTempl<ROOT::Double_v> &, const UnBinData &, const double * , double *, unsigned int & ) {
+void FitUtil::EvaluateLogLGradient(const IModelFunctionTempl<ROOT::Double_v> & func, const UnBinData & data, const double * p, double * grad, unsigned int &, const unsigned int & executionPolicy, unsigned nChunks) {
+   // evaluate the gradient of the log likelihood function with a vectorized model function:
+   // the function is evaluated on vectors of points, its gradient on each point
+
+   unsigned int n = data.Size();
+   unsigned int npar = func.NPar();
+   const unsigned int vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   const unsigned int nvec = (n + vecSize - 1) / vecSize;
+
+   auto chunkGradient = [&](unsigned int begin, unsigned int end) {
+      std::vector<double> gradFunc( npar * vecSize );
+      std::vector<double> g( npar );
+      std::vector<ROOT::Double_v> x;
+      std::vector<double> xl;
+      for (unsigned int ivec = begin; ivec < end; ++ivec) {
+         unsigned int nlanes = 0;
+         ROOT::Double_v fval = EvalFunctionAndGradient(func, data, p, ivec, nlanes, x, xl, gradFunc.data());
+         for (unsigned int l = 0; l < nlanes; ++l) {
+            double fl = vecCore::Get(fval, l);
+            const double * gl = &gradFunc[l * npar];
+            for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
+               if (fl > 0)
+                  g[kpar] -= 1./fl * gl[ kpar ];
+               else if (gl [ kpar] != 0) {
+                  const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+                  const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+                  double gg = kdmax1 * gl[ kpar ];
+                  if ( gg > 0) gg = std::min( gg, kdmax2);
+                  else gg = std::max(gg, - kdmax2);
+                  g[kpar] -= gg;
+               }
+            }
+         }
+      }
+      return g;
+   };
+
+   std::vector<double> g = EvaluateChunks(chunkGradient, nvec, executionPolicy, nChunks, "FitUtil::EvaluateLogLGradient");
+   std::copy(g.begin(), g.end(), grad);
 }
 #endif
 
-void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & data, const double * p, double * grad, unsigned int & ) {
+void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & data, const double * p, double * grad, unsigned int &, const unsigned int & executionPolicy, unsigned nChunks) {
    // evaluate the gradient of the log likelihood function
 
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
@@ -1016,30 +1258,38 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & d
    //int nRejected = 0;
 
    unsigned int npar = func.NPar();
-   std::vector<double> gradFunc( npar );
-   std::vector<double> g( npar);
 
-   for (unsigned int i = 0; i < n; ++ i) {
-      const double * x = data.Coords(i);
-      double fval = func ( x , p);
-      func.ParameterGradient( x, p, &gradFunc[0] );
-      for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
-         if (fval > 0)
-            g[kpar] -= 1./fval * gradFunc[ kpar ];
-         else if (gradFunc [ kpar] != 0) {
-            const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
-            const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
-            double gg = kdmax1 * gradFunc[ kpar ];
-            if ( gg > 0) gg = std::min( gg, kdmax2);
-            else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
+   // gradient of the points in [begin, end)
+   auto chunkGradient = [&](unsigned int begin, unsigned int end) {
+      std::vector<double> gradFunc( npar );
+      std::vector<double> g( npar);
+      std::vector<double> xc;
+
+      for (unsigned int i = begin; i < end; ++ i) {
+         const double * x = GetCoords(data, i, xc);
+         double fval = func ( x , p);
+         func.ParameterGradient( x, p, &gradFunc[0] );
+         for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
+            if (fval > 0)
+               g[kpar] -= 1./fval * gradFunc[ kpar ];
+            else if (gradFunc [ kpar] != 0) {
+               const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+               const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+               double gg = kdmax1 * gradFunc[ kpar ];
+               if ( gg > 0) gg = std::min( gg, kdmax2);
+               else gg = std::max(gg, - kdmax2);
+               g[kpar] -= gg;
+            }
+            // if func derivative is zero term is also zero so do not add in g[kpar]
          }
-         // if func derivative is zero term is also zero so do not add in g[kpar]
       }
+      return g;
+   };
+
+   std::vector<double> g = EvaluateChunks(chunkGradient, n, executionPolicy, nChunks, "FitUtil::EvaluateLogLGradient");
 
-    // copy result
+   // copy result
    std::copy(g.begin(), g.end(), grad);
-   }
 }
 //_________________________________________________________________________________________________
 // for binned log likelihood functions
@@ -1047,6 +1297,57 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & d
 /// evaluate the pdf (Poisson) contribution to the logl (return actually log of pdf)
 /// and its gradient
 
+#ifdef R__HAS_VECCORE
+double FitUtil::EvaluatePoissonBinPdf(const IModelFunctionTempl<ROOT::Double_v> & func, const BinData & data, const double * p, unsigned int i, double * g ) {
+   // evaluate the Poisson bin pdf with a vectorized model function, on the single point i
+
+   const DataOptions & fitOpt = data.Opt();
+   if (fitOpt.fIntegral || fitOpt.fBinVolume) {
+      Error("FitUtil::EvaluatePoissonBinPdf", "The vectorized implementation doesn't support Integrals or BinVolume\n. Aborting operation.");
+      return -1.;
+   }
+
+   unsigned int ndim = data.NDim();
+   std::vector<double> xl(ndim);
+   std::vector<ROOT::Double_v> x(ndim);
+   for (unsigned int j = 0; j < ndim; ++j) {
+      xl[j] = *data.GetCoordComponent(i, j);
+      x[j] = ROOT::Double_v(xl[j]);
+   }
+   double y = data.Value(i);
+
+   double fval = vecCore::Get(func( x.data(), p ), 0);
+   fval = std::max(fval, 0.0);  // avoid negative or too small values
+   double logPdf =  - fval;
+   if (y > 0.0) {
+      // include also constants due to saturate model (see Baker-Cousins paper)
+      logPdf += y * ROOT::Math::Util::EvalLog( fval / y) + y;
+   }
+   if (g == 0) return logPdf;
+
+   typedef ROOT::Math::IParamMultiGradFunctionTempl<ROOT::Double_v> IGradModelFunction_v;
+   const IGradModelFunction_v * gfunc = dynamic_cast<const IGradModelFunction_v *>( &func);
+   if (gfunc == 0) {
+      Error("FitUtil::EvaluatePoissonBinPdf", "The vectorized model function doesn't provide a parameter gradient\n. Aborting operation.");
+      return logPdf;
+   }
+   gfunc->ParameterGradient( xl.data(), p, g );
+
+   // correct g[] do be derivative of poisson term
+   for (unsigned int k = 0; k < func.NPar(); ++k) {
+      if ( fval > 0)
+         g[k] *= ( y/fval - 1.) ;
+      else if (y > 0) {
+         const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+         g[k] *= kdmax1;
+      }
+      else   // y == 0 cannot have  negative y
+         g[k] *= -1;
+   }
+   return logPdf;
+}
+#endif
+
 double FitUtil::EvaluatePoissonBinPdf(const IModelFunction & func, const BinData & data, const double * p, unsigned int i, double * g ) {
    double y = 0;
    const double * x1 = data.GetPoint(i,y);
@@ -1151,7 +1452,8 @@ double FitUtil::EvaluatePoissonBinPdf(const IModelFunction & func, const BinData
 }
 
 double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData & data,
-                                    const double * p, int iWeight, bool extended,  unsigned int &   nPoints ) {
+                                    const double * p, int iWeight, bool extended,  unsigned int &   nPoints,
+                                    const unsigned int & executionPolicy, unsigned nChunks) {
    // evaluate the Poisson Log Likelihood
    // for binned likelihood fits
    // this is Sum ( f(x_i)  -  y_i * log( f (x_i) ) )
@@ -1175,10 +1477,6 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 #endif
 
-   double nloglike = 0;  // negative loglikelihood
-   nPoints = 0;  // npoints
-
-
    // get fit option and check case of using integral of bins
    const DataOptions & fitOpt = data.Opt();
    bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges();
@@ -1187,10 +1485,8 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
 
    // normalize if needed by a reference volume value
    double wrefVolume = 1.0;
-   std::vector<double> xc;
    if (useBinVolume) {
       if (fitOpt.fNormBinVolume) wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
    }
 
 #ifdef DEBUG
@@ -1200,129 +1496,112 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
              << useBinVolume << " useW2 " << useW2 << " wrefVolume = " << wrefVolume << std::endl;
 #endif
 
+   // negative log likelihood of the points in [begin, end), followed by their number of non empty bins
+   auto chunkLogL = [&](unsigned int begin, unsigned int end) {
+      std::vector<double> res(2);
+      std::vector<double> xc, x1c, x2c;
+
 #ifdef USE_PARAMCACHE
-   IntegralEvaluator<> igEval( func, 0, useBinIntegral);
+      IntegralEvaluator<> igEval( func, 0, useBinIntegral && begin < end);
 #else
-   IntegralEvaluator<> igEval( func, p, useBinIntegral);
+      IntegralEvaluator<> igEval( func, p, useBinIntegral && begin < end);
 #endif
-   // double nuTot = 0; // total number of expected events (needed for non-extended fits)
-   // double wTot = 0; // sum of all weights
-   // double w2Tot = 0; // sum of weight squared  (these are needed for useW2)
 
+      // without bin integrals or volumes the model function is evaluated at all the points of
+      // the chunk with a single call
+      std::vector<double> fvalues;
+      if (!useBinIntegral && !useBinVolume) {
+         fvalues.resize(end - begin);
+         EvaluateModel(func, data, p, begin, end, fvalues.data());
+      }
 
-   for (unsigned int i = 0; i < n; ++ i) {
-      const double * x1 = data.Coords(i);
-      double y = data.Value(i);
+      for (unsigned int i = begin; i < end; ++ i) {
+         const double * x1 = GetCoords(data, i, x1c);
+         double y = data.Value(i);
 
-      double fval = 0;
-      double binVolume = 1.0;
+         double fval = 0;
+         double binVolume = 1.0;
 
-      if (useBinVolume) {
-         unsigned int ndim = data.NDim();
-         const double * x2 = data.BinUpEdge(i);
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
+         if (useBinVolume) {
+            unsigned int ndim = data.NDim();
+            const double * x2 = GetBinUpEdge(data, i, x2c);
+            xc.resize(ndim);
+            for (unsigned int j = 0; j < ndim; ++j) {
+               binVolume *= std::abs( x2[j]-x1[j] );
+               xc[j] = 0.5*(x2[j]+ x1[j]);
+            }
+            // normalize the bin volume using a reference value
+            binVolume *= wrefVolume;
          }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+         const double * x = (useBinVolume) ? &xc.front() : x1;
 
-      if (!useBinIntegral) {
+         if (!fvalues.empty()) {
+            fval = fvalues[i - begin];
+         }
+         else if (!useBinIntegral) {
 #ifdef USE_PARAMCACHE
-         fval = func ( x );
+            fval = func ( x );
 #else
-         fval = func ( x, p );
+            fval = func ( x, p );
 #endif
-      }
-      else {
-         // calculate integral (normalized by bin volume)
-         // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x1, data.BinUpEdge(i)) ;
-      }
-      if (useBinVolume) fval *= binVolume;
-
-
+         }
+         else {
+            // calculate integral (normalized by bin volume)
+            fval = igEval( x1, GetBinUpEdge(data, i, x2c)) ;
+         }
+         if (useBinVolume) fval *= binVolume;
 
 #ifdef DEBUG
-      int NSAMPLE = 100;
-      if (i%NSAMPLE == 0) {
-         std::cout << "evt " << i << " x1 = [ ";
-         for (unsigned int j=0; j < func.NDim(); ++j) std::cout << x[j] << " , ";
-         std::cout << "]  ";
-         if (fitOpt.fIntegral) {
-            std::cout << "x2 = [ ";
-            for (unsigned int j=0; j < func.NDim(); ++j) std::cout << data.BinUpEdge(i)[j] << " , ";
-            std::cout << "] ";
+         int NSAMPLE = 100;
+         if (i%NSAMPLE == 0) {
+            std::cout << "evt " << i << " x1 = [ ";
+            for (unsigned int j=0; j < func.NDim(); ++j) std::cout << x[j] << " , ";
+            std::cout << "]  ";
+            std::cout << "  y = " << y << " fval = " << fval << std::endl;
          }
-         std::cout << "  y = " << y << " fval = " << fval << std::endl;
-      }
 #endif
 
-
-      // EvalLog protects against 0 values of fval but don't want to add in the -log sum
-      // negative values of fval
-      fval = std::max(fval, 0.0);
-
-
-      double tmp = 0;
-      if (useW2) {
-         // apply weight correction . Effective weight is error^2/ y
-         // and expected events in bins is fval/weight
-         // can apply correction only when y is not zero otherwise weight is undefined
-         // (in case of weighted likelihood I don't care about the constant term due to
-         // the saturated model)
-         if (y != 0) {
-            double error = data.Error(i);
-            double weight = (error*error)/y;  // this is the bin effective weight
-            if (extended) {
-               tmp = fval * weight;
-               // wTot  += weight;
-               // w2Tot += weight*weight;
+         // EvalLog protects against 0 values of fval but don't want to add in the -log sum
+         // negative values of fval
+         fval = std::max(fval, 0.0);
+
+         double tmp = 0;
+         if (useW2) {
+            // apply weight correction . Effective weight is error^2/ y
+            // and expected events in bins is fval/weight
+            // can apply correction only when y is not zero otherwise weight is undefined
+            // (in case of weighted likelihood I don't care about the constant term due to
+            // the saturated model)
+            if (y != 0) {
+               double error = data.Error(i);
+               double weight = (error*error)/y;  // this is the bin effective weight
+               if (extended) {
+                  tmp = fval * weight;
+               }
+               tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
             }
-            tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
          }
-
-         //  need to compute total weight and weight-square
-         // if (extended ) {
-         //    nuTot += fval;
-         // }
-
-      }
-      else {
-         // standard case no weights or iWeight=1
-         // this is needed for Poisson likelihood (which are extened and not for multinomial)
-         // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
-         // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
-         if (extended) tmp = fval -y ;
-         if (y >  0) {
-            tmp +=  y *  (ROOT::Math::Util::EvalLog( y) - ROOT::Math::Util::EvalLog(fval));
-            nPoints++;
+         else {
+            // standard case no weights or iWeight=1
+            // this is needed for Poisson likelihood (which are extened and not for multinomial)
+            // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
+            // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
+            if (extended) tmp = fval -y ;
+            if (y >  0) {
+               tmp +=  y *  (ROOT::Math::Util::EvalLog( y) - ROOT::Math::Util::EvalLog(fval));
+               res[1]++;
+            }
          }
-      }
-
-
-      nloglike +=  tmp;
-   }
 
-   // if (notExtended) {
-   //    // not extended : remove from the Likelihood the global Poisson term
-   //    if (!useW2)
-   //       nloglike -= nuTot - yTot * ROOT::Math::Util::EvalLog( nuTot);
-   //    else {
-   //       // this needs to be checked
-   //       nloglike -= wTot* nuTot - wTot* yTot * ROOT::Math::Util::EvalLog( nuTot);
-   //    }
-
-   // }
-
-   // if (extended && useW2) {
-   //    // effective total weight is total sum of weight square / sum of weights
-   //    //nloglike += (w2Tot/wTot) * nuTot;
-   // }
+         res[0] +=  tmp;
+      }
+      return res;
+   };
 
+   std::vector<double> res = EvaluateChunks(chunkLogL, n, executionPolicy, nChunks, "FitUtil::EvaluatePoissonLogL");
+   double nloglike = res[0];  // negative loglikelihood
+   nPoints = res[1];
 
 #ifdef DEBUG
    std::cout << "Loglikelihood  = " << nloglike << std::endl;
@@ -1331,7 +1610,74 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
    return nloglike;
 }
 
-void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad ) {
+#ifdef R__HAS_VECCORE
+double FitUtil::EvaluatePoissonLogL(const IModelFunctionTempl<ROOT::Double_v> & func, const BinData & data,
+                                    const double * p, int iWeight, bool extended,  unsigned int &   nPoints,
+                                    const unsigned int & executionPolicy, unsigned nChunks) {
+   // evaluate the Poisson Log Likelihood with a vectorized model function
+   // (see the scalar version for the formulas)
+
+   const DataOptions & fitOpt = data.Opt();
+   if (fitOpt.fIntegral || fitOpt.fBinVolume) {
+      Error("FitUtil::EvaluatePoissonLogL", "The vectorized implementation doesn't support Integrals or BinVolume\n. Aborting operation.");
+      return -1.;
+   }
+
+   unsigned int n = data.Size();
+   bool useW2 = (iWeight == 2);
+   const unsigned int vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   const unsigned int nvec = (n + vecSize - 1) / vecSize;
+
+   auto chunkLogL = [&](unsigned int begin, unsigned int end) {
+      std::vector<double> res(2);
+      std::vector<ROOT::Double_v> x;
+      ROOT::Double_v nloglike(0.);
+      for (unsigned int ivec = begin; ivec < end; ++ivec) {
+         const unsigned int first = ivec * vecSize;
+         const unsigned int nlanes = LoadCoords(data, ivec, x);
+         ROOT::Double_v y;
+         LoadLanes(y, data.ValuePtr(first), nlanes);
+
+         ROOT::Double_v fval = func( x.data(), p );
+         fval = vecCore::math::Max(fval, ROOT::Double_v(0.));
+
+         ROOT::Double_v tmp(0.);
+         if (useW2) {
+            // effective weight of the bins, zero for the empty bins
+            ROOT::Double_v weight(0.);
+            for (unsigned int l = 0; l < nlanes; ++l) {
+               double yl = vecCore::Get(y, l);
+               double error = data.Error(first + l);
+               if (yl != 0) vecCore::Set(weight, l, (error*error)/yl);
+            }
+            if (extended) tmp = fval * weight;
+            tmp -= weight * y * EvalLog( fval);
+         }
+         else {
+            if (extended) tmp = fval - y;
+            // the term of the saturated model only for the bins with y > 0, as in the scalar version
+            vecCore::MaskedAssign<ROOT::Double_v>(tmp, y > ROOT::Double_v(0.),
+                                                  tmp + y * (EvalLog( y) - EvalLog( fval)));
+            for (unsigned int l = 0; l < nlanes; ++l)
+               if (vecCore::Get(y, l) > 0) res[1]++;
+         }
+         for (unsigned int l = nlanes; l < vecSize; ++l)
+            vecCore::Set(tmp, l, 0.);
+         nloglike += tmp;
+      }
+      for (unsigned int l = 0; l < vecSize; ++l)
+         res[0] += vecCore::Get(nloglike, l);
+      return res;
+   };
+
+   std::vector<double> res = EvaluateChunks(chunkLogL, nvec, executionPolicy, nChunks, "FitUtil::EvaluatePoissonLogL");
+   nPoints = res[1];
+   return res[0];
+}
+#endif
+
+void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad,
+                                          const unsigned int & executionPolicy, unsigned nChunks) {
    // evaluate the gradient of the Poisson log likelihood function
 
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
@@ -1345,73 +1691,293 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinDat
    bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
 
    double wrefVolume = 1.0;
-   std::vector<double> xc;
    if (useBinVolume) {
       if (fitOpt.fNormBinVolume) wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
    }
 
-   IntegralEvaluator<> igEval( func, p, useBinIntegral);
-
    unsigned int npar = func.NPar();
-   std::vector<double> gradFunc( npar );
-   std::vector<double> g( npar);
 
-   for (unsigned int i = 0; i < n; ++ i) {
-      const double * x1 = data.Coords(i);
-      double y = data.Value(i);
-      double fval = 0;
-      const double * x2 = 0;
+   // gradient of the points in [begin, end)
+   auto chunkGradient = [&](unsigned int begin, unsigned int end) {
+      std::vector<double> gradFunc( npar );
+      std::vector<double> g( npar);
+      std::vector<double> xc, x1c, x2c;
+      IntegralEvaluator<> igEval( func, p, useBinIntegral && begin < end);
+
+      for (unsigned int i = begin; i < end; ++ i) {
+         const double * x1 = GetCoords(data, i, x1c);
+         double y = data.Value(i);
+         double fval = 0;
+         const double * x2 = 0;
+
+         double binVolume = 1.0;
+         if (useBinVolume) {
+            x2 = GetBinUpEdge(data, i, x2c);
+            unsigned int ndim = data.NDim();
+            xc.resize(ndim);
+            for (unsigned int j = 0; j < ndim; ++j) {
+               binVolume *= std::abs( x2[j]-x1[j] );
+               xc[j] = 0.5*(x2[j]+ x1[j]);
+            }
+            // normalize the bin volume using a reference value
+            binVolume *= wrefVolume;
+         }
 
-      double binVolume = 1.0;
-      if (useBinVolume) {
-         x2 = data.BinUpEdge(i);
-         unsigned int ndim = data.NDim();
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
+         const double * x = (useBinVolume) ? &xc.front() : x1;
+
+         if (!useBinIntegral) {
+            fval = func ( x, p );
+            func.ParameterGradient(  x , p, &gradFunc[0] );
+         }
+         else {
+            // calculate integral (normalized by bin volume)
+            x2 = GetBinUpEdge(data, i, x2c);
+            fval = igEval( x1, x2) ;
+            CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]);
+         }
+         if (useBinVolume) fval *= binVolume;
+
+         // correct the gradient
+         for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
+
+            // correct gradient for bin volumes
+            if (useBinVolume) gradFunc[kpar] *= binVolume;
+
+            // df/dp * (1.  - y/f )
+            if (fval > 0)
+               g[kpar] += gradFunc[ kpar ] * ( 1. - y/fval );
+            else if (gradFunc [ kpar] != 0) {
+               const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+               const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+               double gg = kdmax1 * gradFunc[ kpar ];
+               if ( gg > 0) gg = std::min( gg, kdmax2);
+               else gg = std::max(gg, - kdmax2);
+               g[kpar] -= gg;
+            }
          }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
       }
+      return g;
+   };
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+   std::vector<double> g = EvaluateChunks(chunkGradient, n, executionPolicy, nChunks, "FitUtil::EvaluatePoissonLogLGradient");
 
-      if (!useBinIntegral) {
-         fval = func ( x, p );
-         func.ParameterGradient(  x , p, &gradFunc[0] );
+   // copy result
+   std::copy(g.begin(), g.end(), grad);
+}
+
+#ifdef R__HAS_VECCORE
+void FitUtil::EvaluatePoissonLogLGradient(const IModelFunctionTempl<ROOT::Double_v> & func, const BinData & data, const double * p, double * grad,
+                                          const unsigned int & executionPolicy, unsigned nChunks) {
+   // evaluate the gradient of the Poisson log likelihood function with a vectorized model function:
+   // the function is evaluated on vectors of points, its gradient on each point
+
+   const DataOptions & fitOpt = data.Opt();
+   if (fitOpt.fIntegral || fitOpt.fBinVolume) {
+      Error("FitUtil::EvaluatePoissonLogLGradient", "The vectorized implementation doesn't support Integrals or BinVolume\n. Aborting operation.");
+      return;
+   }
+
+   unsigned int n = data.Size();
+   unsigned int npar = func.NPar();
+   const unsigned int vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   const unsigned int nvec = (n + vecSize - 1) / vecSize;
+
+   auto chunkGradient = [&](unsigned int begin, unsigned int end) {
+      std::vector<double> gradFunc( npar * vecSize );
+      std::vector<double> g( npar );
+      std::vector<ROOT::Double_v> x;
+      std::vector<double> xl;
+      for (unsigned int ivec = begin; ivec < end; ++ivec) {
+         unsigned int nlanes = 0;
+         ROOT::Double_v fval = EvalFunctionAndGradient(func, data, p, ivec, nlanes, x, xl, gradFunc.data());
+         for (unsigned int l = 0; l < nlanes; ++l) {
+            double y = data.Value(ivec * vecSize + l);
+            double fl = vecCore::Get(fval, l);
+            const double * gl = &gradFunc[l * npar];
+            for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
+               // df/dp * (1.  - y/f )
+               if (fl > 0)
+                  g[kpar] += gl[ kpar ] * ( 1. - y/fl );
+               else if (gl [ kpar] != 0) {
+                  const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+                  const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+                  double gg = kdmax1 * gl[ kpar ];
+                  if ( gg > 0) gg = std::min( gg, kdmax2);
+                  else gg = std::max(gg, - kdmax2);
+                  g[kpar] -= gg;
+               }
+            }
+         }
       }
-      else {
-         // calculate integral (normalized by bin volume)
-         // need to set function and parameters here in case loop is parallelized
-         x2 = data.BinUpEdge(i);
-         fval = igEval( x1, x2) ;
-         CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]);
+      return g;
+   };
+
+   std::vector<double> g = EvaluateChunks(chunkGradient, nvec, executionPolicy, nChunks, "FitUtil::EvaluatePoissonLogLGradient");
+   std::copy(g.begin(), g.end(), grad);
+}
+#endif
+
+namespace FitUtil {
+
+#ifndef R__WIN32
+namespace {
+   // message codes of the persistent workers (the codes below 1000 are left to the MultiProc applications)
+   enum EFitWorkerCode : unsigned { kEvalValue = 300, kEvalGradient, kPartialSums };
+
+   // worker process of MultiProcessWorkers: for each request it repeats the evaluation of the FCN
+   // for the received parameters, in its copy of the FCN, and sends back the sums of its chunk
+   class FitWorker : public TMPWorker {
+   public:
+      FitWorker(const MultiProcessWorkers::Replay_t & replay, unsigned nWorkers) : TMPWorker(nWorkers, 0), fReplay(replay) {}
+
+      void Init(int fd, unsigned workerN) override;
+
+      // sums over the chunk of this worker of the n data points
+      const std::vector<double> & EvaluateChunk(const std::function<std::vector<double>(unsigned int, unsigned int)> & chunkSums,
+                                                unsigned int n) {
+         fSums = chunkSums((unsigned long long)n * GetNWorker() / fNWorkers, (unsigned long long)n * (GetNWorker() + 1) / fNWorkers);
+         return fSums;
       }
-      if (useBinVolume) fval *= binVolume;
 
-      // correct the gradient
-      for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
-
-         // correct gradient for bin volumes
-         if (useBinVolume) gradFunc[kpar] *= binVolume;
-
-         // df/dp * (1.  - y/f )
-         if (fval > 0)
-            g[kpar] += gradFunc[ kpar ] * ( 1. - y/fval );
-         else if (gradFunc [ kpar] != 0) {
-            const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
-            const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
-            double gg = kdmax1 * gradFunc[ kpar ];
-            if ( gg > 0) gg = std::min( gg, kdmax2);
-            else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
+   private:
+      void HandleInput(MPCodeBufPair & msg) override;
+
+      MultiProcessWorkers::Replay_t fReplay;
+      std::vector<double> fSums;
+   };
+
+   // the worker running in this process, if it is a child forked by MultiProcessWorkers
+   FitWorker * gFitWorker = nullptr;
+
+   // innermost MultiProcessWorkers::Scope of the FCN evaluation in progress in this thread
+   thread_local MultiProcessWorkers::Scope * gWorkersScope = nullptr;
+
+   void FitWorker::Init(int fd, unsigned workerN) {
+      TMPWorker::Init(fd, workerN);
+      gFitWorker = this;
+   }
+
+   void FitWorker::HandleInput(MPCodeBufPair & msg) {
+      unsigned code = msg.first;
+      if (code != kEvalValue && code != kEvalGradient) {
+         SendError("unknown code received: " + std::to_string(code));
+         return;
+      }
+      std::vector<double> x = ReadBuffer<std::vector<double>>(msg.second.get());
+      fSums.clear();
+      fReplay(code == kEvalGradient ? MultiProcessWorkers::kGradient : MultiProcessWorkers::kValue, x.data());
+      MPSend(GetSocket(), kPartialSums, fSums);
+   }
+} // end anonymous namespace
+
+   // client of the worker processes, forked once
+   class MultiProcessWorkers::Impl : public TMPClient {
+   public:
+      Impl(unsigned nWorkers, unsigned int n, const Replay_t & replay);
+
+      // send the request for the parameters x to the workers and sum their partial sums,
+      // return an empty vector if a worker failed
+      std::vector<double> Evaluate(ERequest request, const double * x, unsigned int npar);
+   };
+
+   MultiProcessWorkers::Impl::Impl(unsigned nWorkers, unsigned int n, const Replay_t & replay) : TMPClient(nWorkers) {
+      SetNWorkers(std::max(1u, std::min(GetNWorkers(), n)));
+      FitWorker worker(replay, GetNWorkers());
+      // the children do not return from Fork
+      Fork(worker);
+   }
+
+   std::vector<double> MultiProcessWorkers::Impl::Evaluate(ERequest request, const double * x, unsigned int npar) {
+      // the same parameters to all the workers (and not one element of the vector to each)
+      unsigned nSent = Broadcast<std::vector<double> >(request == kGradient ? kEvalGradient : kEvalValue,
+                                                       std::vector<double>(x, x + npar), 0);
+      if (nSent < GetNWorkers()) return std::vector<double>();
+      std::vector<std::vector<double> > sums;
+      TMonitor & mon = GetMonitor();
+      mon.ActivateAll();
+      while (mon.GetActive() > 0) {
+         TSocket * s = mon.Select();
+         MPCodeBufPair msg = MPRecv(s);
+         if (msg.first == MPCode::kRecvError) {
+            Error("FitUtil::MultiProcessWorkers", "Lost connection to a worker");
+            Remove(s);
+         } else if (msg.first == kPartialSums) {
+            sums.push_back(ReadBuffer<std::vector<double>>(msg.second.get()));
+            DeActivate(s);
+         } else {
+            // errors and shutdown notices: no sums are coming from this worker
+            HandleMPCode(msg, s);
+            if (msg.first != MPCode::kShutdownNotice && msg.first != MPCode::kFatalError) DeActivate(s);
          }
       }
+      if (sums.size() < nSent) return std::vector<double>();
+      return SumChunks(sums);
+   }
+#else
+   class MultiProcessWorkers::Impl {};
+#endif
+
+   MultiProcessWorkers::MultiProcessWorkers() {}
+
+   MultiProcessWorkers::MultiProcessWorkers(const MultiProcessWorkers &) {}
 
-      // copy result
-      std::copy(g.begin(), g.end(), grad);
+   // the client shuts the workers down and waits for them
+   MultiProcessWorkers::~MultiProcessWorkers() {}
+
+   MultiProcessWorkers::Scope::Scope(MultiProcessWorkers & workers, unsigned executionPolicy, ERequest request, const double * x,
+                                     unsigned int npar, const Replay_t & replay) :
+      fWorkers(workers), fRequest(request), fX(x), fNPar(npar), fReplay(replay), fPrevious(nullptr)
+   {
+#ifndef R__WIN32
+      // in a worker the evaluation is the one of its chunk
+      if (executionPolicy != ROOT::Fit::kMultiprocess || gFitWorker) return;
+      fPrevious = gWorkersScope;
+      gWorkersScope = this;
+#else
+      (void)executionPolicy;
+#endif
    }
+
+   MultiProcessWorkers::Scope::~Scope() {
+#ifndef R__WIN32
+      if (gWorkersScope == this) gWorkersScope = fPrevious;
+#endif
+   }
+
+} // end namespace FitUtil
+
+std::vector<double> FitUtil::EvaluateChunksMultiProcess(const std::function<std::vector<double>(unsigned int, unsigned int)> & chunkSums,
+                                                        unsigned int n, unsigned nChunks) {
+   // evaluate the sums over the data points in forked worker processes, which get a copy of the data
+   // when they are forked and return only the sums of their chunks.
+   // Inside a MultiProcessWorkers::Scope the workers of the FCN are forked at its first evaluation and
+   // kept, each evaluation sends them only the parameters. Otherwise they are forked for this evaluation
+   // only, with a copy of the parameters, and reduce the sums themselves when they process several chunks
+#ifndef R__WIN32
+   if (gFitWorker)
+      return gFitWorker->EvaluateChunk(chunkSums, n);
+   if (gWorkersScope) {
+      MultiProcessWorkers::Scope & scope = *gWorkersScope;
+      std::unique_ptr<MultiProcessWorkers::Impl> & workers = scope.fWorkers.fImpl;
+      if (!workers) workers.reset(new MultiProcessWorkers::Impl(nChunks, n, scope.fReplay));
+      std::vector<double> sums = workers->Evaluate(scope.fRequest, scope.fX, scope.fNPar);
+      if (!sums.empty()) return sums;
+      Error("FitUtil::EvaluateChunksMultiProcess", "The worker processes failed, the evaluation is done in this process");
+      workers.reset();
+      return chunkSums(0, n);
+   }
+   ROOT::TProcessExecutor pool;
+   if (nChunks == 0) nChunks = pool.GetNWorkers();
+   nChunks = std::max(1u, std::min(nChunks, n));
+   auto mapFunction = [&](unsigned int ichunk) {
+      return chunkSums((unsigned long long)n * ichunk / nChunks, (unsigned long long)n * (ichunk + 1) / nChunks);
+   };
+   return pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, nChunks), SumChunks);
+#else
+   (void)nChunks;
+   Error("FitUtil::EvaluateChunksMultiProcess", "The MultiProcess execution policy is not available on Windows, the evaluation is serial");
+   return chunkSums(0, n);
+#endif
 }
 
 unsigned FitUtil::setAutomaticChunking(unsigned nEvents){
@@ -382,7 +382,7 @@ bool Fitter::DoLeastSquareFit(ROOT::Fit::ExecutionPolicy executionPolicy) {
             MATH_INFO_MSG("Fitter::DoLeastSquareFit","use gradient from model function");
          std::shared_ptr<IGradModelFunction> gradFun = std::dynamic_pointer_cast<IGradModelFunction>(fFunc);
          if (gradFun) {
-            Chi2FCN<BaseGradFunc> chi2(data,gradFun);
+            Chi2FCN<BaseGradFunc> chi2(data,gradFun, executionPolicy);
             fFitType = chi2.Type();
             return DoMinimization (chi2);
          }
@@ -392,7 +392,7 @@ bool Fitter::DoLeastSquareFit(ROOT::Fit::ExecutionPolicy executionPolicy) {
   return false;
 }
 
-bool Fitter::DoBinnedLikelihoodFit(bool extended) {
+bool Fitter::DoBinnedLikelihoodFit(bool extended, ROOT::Fit::ExecutionPolicy executionPolicy) {
    // perform a likelihood fit on a set of binned data
    // The fit is extended (Poisson logl_ by default
 
@@ -402,7 +402,7 @@ bool Fitter::DoBinnedLikelihoodFit(bool extended) {
    bool  useWeight = fConfig.UseWeightCorrection();
 
    // check function
-   if (!fFunc) {
+   if (!fFunc && !fFunc_v) {
       MATH_ERROR_MSG("Fitter::DoBinnedLikelihoodFit","model function is not set");
       return false;
    }
@@ -421,12 +421,30 @@ bool Fitter::DoBinnedLikelihoodFit(bool extended) {
    fBinFit = true;
    fDataSize = data->Size();
 
+#ifdef R__HAS_VECCORE
+   if (fFunc_v && !fFunc) {
+      if (fUseGradient)
+         MATH_WARN_MSG("Fitter::DoBinnedLikelihoodFit","gradient not supported for vectorized model functions - do the fit without it");
+      // create a chi2 function to be used for the equivalent chi-square
+      Chi2FCN<BaseFunc, IModelFunction_v> chi2(data, fFunc_v);
+      PoissonLikelihoodFCN<BaseFunc, IModelFunction_v> logl(data, fFunc_v, useWeight, extended, executionPolicy);
+      fFitType = logl.Type();
+      // do minimization
+      if (!DoMinimization (logl, &chi2) ) return false;
+      if (useWeight) {
+         logl.UseSumOfWeightSquare();
+         if (!ApplyWeightCorrection(logl) ) return false;
+      }
+      return true;
+   }
+#endif
+
    // create a chi2 function to be used for the equivalent chi-square
    Chi2FCN<BaseFunc> chi2(data,fFunc);
 
    if (!fUseGradient) {
       // do minimization without using the gradient
-      PoissonLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended);
+      PoissonLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended, executionPolicy);
       fFitType = logl.Type();
       // do minimization
       if (!DoMinimization (logl, &chi2) ) return false;
@@ -449,7 +467,7 @@ bool Fitter::DoBinnedLikelihoodFit(bool extended) {
       if (!extended) {
          MATH_WARN_MSG("Fitter::DoBinnedLikelihoodFit","Not-extended binned fit with gradient not yet supported - do an extended fit");
       }
-      PoissonLikelihoodFCN<BaseGradFunc> logl(data,gradFun, useWeight, true);
+      PoissonLikelihoodFCN<BaseGradFunc> logl(data,gradFun, useWeight, true, executionPolicy);
       fFitType = logl.Type();
       // do minimization
       if (!DoMinimization (logl, &chi2) ) return false;
@@ -470,8 +488,7 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended, ROOT::Fit::ExecutionPolicy e
 
    bool useWeight = fConfig.UseWeightCorrection();
 
-   if (!fFunc)
-     if(!fFunc_v) {
+   if (!fFunc && !fFunc_v) {
       MATH_ERROR_MSG("Fitter::DoUnbinnedLikelihoodFit","model function is not set");
       return false;
    }
@@ -531,7 +548,7 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended, ROOT::Fit::ExecutionPolicy e
          if (extended) {
             MATH_WARN_MSG("Fitter::DoUnbinnedLikelihoodFit","Extended unbinned fit with gradient not yet supported - do a not-extended fit");
          }
-         LogLikelihoodFCN<BaseGradFunc> logl(data,gradFun,useWeight, extended);
+         LogLikelihoodFCN<BaseGradFunc> logl(data,gradFun,useWeight, extended, executionPolicy);
          fFitType = logl.Type();
          if (!DoMinimization (logl) ) return false;
          if (useWeight) {
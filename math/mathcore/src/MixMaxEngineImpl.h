@@ -50,6 +50,7 @@ namespace ROOT {
       }
       ~MixMaxEngineImpl() {}
       void SetSeed(uint64_t) { }
+      void SetStreamSeed(uint64_t, uint32_t) { }
       double Rndm() { return -1; }
       double IntRndm() { return 0; }
       void SetState(const std::vector<uint64_t> &) { }
@@ -57,6 +58,7 @@ namespace ROOT {
       int Counter() { return -1; }
       void SetCounter(int) {}
       void Iterate() {} 
+      void IterateAndFill(double *) {}
    };
 
 
@@ -82,6 +84,9 @@ public:
       //seed_spbox(fRngState, seed);
       seed_uniquestream(fRngState, 0, 0, (uint32_t)(seed>>32), (uint32_t)seed );
    }
+   void SetStreamSeed(Result_t seed, uint32_t stream) {
+      seed_uniquestream(fRngState, stream, 0, (uint32_t)(seed>>32), (uint32_t)seed );
+   }
    double Rndm() {
        return get_next_float(fRngState);
    }
@@ -102,6 +107,11 @@ public:
    void Iterate() {
       iterate(fRngState); 
    }
+   // iterate the state and copy all its new numbers in the array (N-1 numbers)
+   void IterateAndFill(double * array) {
+      iterate_and_fill_array(fRngState, array);
+      fRngState->counter = rng_get_N();
+   }
    int Counter() const {
       return fRngState->counter; 
    }
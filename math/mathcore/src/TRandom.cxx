@@ -45,6 +45,8 @@ The following methods are provided to generate random numbers disctributed accor
 - `Integer(imax)`
 - `Gaus(mean,sigma)`
 - `Rndm()`
+- `RndmArray(n,array)`, `GausArray(n,array,mean,sigma)` and `ExpArray(n,array,tau)` to generate
+  blocks of numbers at once
 - `Uniform(x1)`
 - `Landau(mpv,sigma)`
 - `Poisson(mean)`
@@ -65,6 +67,10 @@ to the function you would like to generate.
   double r = u.Sample();
 \endcode
 
+To generate numbers in parallel in a reproducible way, every thread or task can use its own generator
+initialized with `SetStreamSeed(seed, stream)`, using the same seed and a different stream number
+(for example the task index). The sequence of every stream then does not depend on the number of threads.
+
 The techniques of using directly a TF1,2 or 3 function is powerful and
 can be used to generate numbers in the defined range of the function.
 Getting a number from a TF1,2,3 function is also quite fast.
@@ -216,6 +222,19 @@ Double_t TRandom::Exp(Double_t tau)
    return t;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate an array of n exponential deviates.
+/// The uniform numbers are generated in a single block with RndmArray and then
+/// transformed in a loop which can be vectorized by the compiler.
+/// The sequence is the same obtained by calling Exp(tau) n times.
+
+void TRandom::ExpArray(Int_t n, Double_t *array, Double_t tau)
+{
+   RndmArray(n, array);
+   for (Int_t i = 0; i < n; ++i)
+      array[i] = -tau * TMath::Log(array[i]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Samples a random number from the standard Normal (Gaussian) Distribution
 /// with the given mean and sigma.
@@ -314,6 +333,34 @@ Double_t TRandom::Gaus(Double_t mean, Double_t sigma)
    return mean + sigma * result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate an array of n numbers distributed following a gaussian with the given
+/// mean and sigma.
+/// The Box-Muller method is used: the uniform numbers are generated in blocks with
+/// RndmArray and transformed in loops without branches, which can be vectorized
+/// by the compiler. This is much faster than calling Gaus n times, but the
+/// resulting sequence is different.
+
+void TRandom::GausArray(Int_t n, Double_t *array, Double_t mean, Double_t sigma)
+{
+   const Int_t kBlock = 512;
+   Double_t u[kBlock];
+   for (Int_t i = 0; i < n; i += kBlock) {
+      // every pair of uniform numbers gives two gaussian numbers
+      const Int_t m = TMath::Min(kBlock, n - i);
+      const Int_t np = (m + 1) / 2;
+      RndmArray(2 * np, u);
+      for (Int_t k = 0; k < np; ++k) {
+         u[k] = sigma * TMath::Sqrt(-2 * TMath::Log(u[k]));
+         u[np + k] *= TMath::TwoPi();
+      }
+      for (Int_t k = 0; k < np; ++k)
+         array[i + k] = mean + u[k] * TMath::Cos(u[np + k]);
+      for (Int_t k = 0; k < m - np; ++k)
+         array[i + np + k] = mean + u[k] * TMath::Sin(u[np + k]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns a random integer on [ 0, imax-1 ].
 
@@ -577,6 +624,33 @@ void TRandom::SetSeed(ULong_t seed)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the seed of the generator for the given stream of a parallel generation.
+/// Generators initialized with the same seed and different stream numbers (for example
+/// the index of the thread or of the task) produce different sequences, and the
+/// sequence of each stream is reproducible independently of the number of threads.
+/// The stream 0 is the same sequence obtained with SetSeed(seed).
+/// In the default implementation the seed is combined with the stream number with a
+/// hash function (SplitMix64), so the streams are statistically independent but are
+/// not guaranteed to be disjoint. Generators with a proper stream splitting
+/// (e.g. TRandomMixMax) override this function.
+/// A seed equal to zero sets a random seed as in SetSeed(0).
+
+void TRandom::SetStreamSeed(ULong_t seed, UInt_t stream)
+{
+   if (seed == 0 || stream == 0) {
+      SetSeed(seed);
+      return;
+   }
+   ULong64_t z = ULong64_t(seed) + 0x9E3779B97F4A7C15ULL * (ULong64_t(stream) + 1);
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+   z = z ^ (z >> 31);
+   // the seed is kept on 32 bits since several generators use only the lowest bits
+   UInt_t s = UInt_t(z ^ (z >> 32));
+   SetSeed(s != 0 ? s : 1);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Generates random vectors, uniformly distributed over the surface
 /// of a sphere of given radius.
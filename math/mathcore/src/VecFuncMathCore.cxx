@@ -0,0 +1,705 @@
+// @(#)root/mathcore:$Id$
+// Authors: L. Moneta    2017
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 , LCG ROOT MathLib Team                         *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Implementation of the vectorized special and statistical functions.
+// The functions are written once as templates on the value type, used with double
+// (for the loops of the array functions without VecCore and for the remaining
+// elements) and with ROOT::Double_v. The branches of the scalar algorithms are
+// replaced by the evaluation of all the cases followed by a selection on a mask.
+
+#include "Math/VecFuncMathCore.h"
+#include "Math/Math.h"
+#include "Math/SpecFuncMathCore.h"
+
+#include <cmath>
+#include <limits>
+
+namespace ROOT {
+namespace Math {
+
+namespace {
+
+// elementary functions and selection for the two value types
+
+inline double Exp(double x) { return std::exp(x); }
+inline double Log(double x) { return std::log(x); }
+inline double Sqrt(double x) { return std::sqrt(x); }
+inline double Abs(double x) { return std::abs(x); }
+inline double Select(bool mask, double a, double b) { return mask ? a : b; }
+
+// evaluate the scalar function for the values where the vectorized algorithm is not valid
+inline double ScalarFallback(double result, double x, bool mask, double (*func)(double), bool (*)(double))
+{
+   return mask ? func(x) : result;
+}
+
+#ifdef R__HAS_VECCORE
+
+inline ROOT::Double_v Exp(const ROOT::Double_v &x) { return vecCore::math::Exp(x); }
+inline ROOT::Double_v Log(const ROOT::Double_v &x) { return vecCore::math::Log(x); }
+inline ROOT::Double_v Sqrt(const ROOT::Double_v &x) { return vecCore::math::Sqrt(x); }
+inline ROOT::Double_v Abs(const ROOT::Double_v &x) { return vecCore::math::Abs(x); }
+inline ROOT::Double_v Select(const vecCore::Mask_v<ROOT::Double_v> &mask, const ROOT::Double_v &a,
+                             const ROOT::Double_v &b)
+{
+   ROOT::Double_v result(b);
+   vecCore::MaskedAssign(result, mask, a);
+   return result;
+}
+
+inline ROOT::Double_v ScalarFallback(ROOT::Double_v result, const ROOT::Double_v &x,
+                                     const vecCore::Mask_v<ROOT::Double_v> &mask, double (*func)(double),
+                                     bool (*select)(double))
+{
+   if (vecCore::MaskEmpty(mask))
+      return result;
+   for (unsigned int l = 0; l < vecCore::VectorSize<ROOT::Double_v>(); ++l) {
+      double xl = vecCore::Get(x, l);
+      if (select(xl))
+         vecCore::Set(result, l, func(xl));
+   }
+   return result;
+}
+
+#endif
+
+template <class T>
+inline T Polynomialeval(const T &x, const double *a, unsigned int N)
+{
+   T pom(a[0]);
+   for (unsigned int i = 1; i <= N; i++)
+      pom = pom * x + a[i];
+   return pom;
+}
+
+template <class T>
+inline T Polynomial1eval(const T &x, const double *a, unsigned int N)
+{
+   T pom = x + a[0];
+   for (unsigned int i = 1; i < N; i++)
+      pom = pom * x + a[i];
+   return pom;
+}
+
+// coefficients of the Cephes functions (see SpecFuncCephes.cxx and SpecFuncCephesInv.cxx)
+
+const double kMaxLog = 709.782712893383973096206318587;
+const double kMaxLgm = 2.556348e305;
+const double kLS2Pi = 0.91893853320467274178;
+const double kS2Pi = 2.50662827463100050242E0;
+const double kSqrt2 = 1.41421356237309515;
+const double kInf = std::numeric_limits<double>::infinity();
+
+const double kErfP[] = {2.46196981473530512524E-10, 5.64189564831068821977E-1, 7.46321056442269912687E0,
+                        4.86371970985681366614E1,   1.96520832956077098242E2,  5.26445194995477358631E2,
+                        9.34528527171957607540E2,   1.02755188689515710272E3,  5.57535335369399327526E2};
+const double kErfQ[] = {1.32281951154744992508E1, 8.67072140885989742329E1, 3.54937778887819891062E2,
+                        9.75708501743205489753E2, 1.82390916687909736289E3, 2.24633760818710981792E3,
+                        1.65666309194161350182E3, 5.57535340817727675546E2};
+const double kErfR[] = {5.64189583547755073984E-1, 1.27536670759978104416E0, 5.01905042251180477414E0,
+                        6.16021097993053585195E0,  7.40974269950448939160E0, 2.97886665372100240670E0};
+const double kErfS[] = {2.26052863220117276590E0, 9.39603524938001434673E0, 1.20489539808096656605E1,
+                        1.70814450747565897222E1, 9.60896809063285878198E0, 3.36907645100081516050E0};
+const double kErfT[] = {9.60497373987051638749E0, 9.00260197203842689217E1, 2.23200534594684319226E3,
+                        7.00332514112805075473E3, 5.55923013010394962768E4};
+const double kErfU[] = {3.35617141647503099647E1, 5.21357949780152679795E2, 4.59432382970980127987E3,
+                        2.26290000613890934246E4, 4.92673942608635921086E4};
+
+const double kLgamA[] = {8.11614167470508450300E-4, -5.95061904284301438324E-4, 7.93650340457716943945E-4,
+                         -2.77777777730099687205E-3, 8.33333333333331927722E-2};
+const double kLgamB[] = {-1.37825152569120859100E3, -3.88016315134637840924E4, -3.31612992738871184744E5,
+                         -1.16237097492762307383E6, -1.72173700820839662146E6, -8.53555664245765465627E5};
+const double kLgamC[] = {-3.51815701436523470549E2, -1.70642106651881159223E4, -2.20528590553854454839E5,
+                         -1.13933444367982507207E6, -2.53252307177582951285E6, -2.01889141433532773231E6};
+
+const double kNdtriP0[] = {-5.99633501014107895267E1, 9.80010754185999661536E1, -5.66762857469070293439E1,
+                           1.39312609387279679503E1, -1.23916583867381258016E0};
+const double kNdtriQ0[] = {1.95448858338141759834E0,  4.67627912898881538453E0, 8.63602421390890590575E1,
+                           -2.25462687854119370527E2, 2.00260212380060660359E2, -8.20372256168333339912E1,
+                           1.59056225126211695515E1,  -1.18331621121330003142E0};
+const double kNdtriP1[] = {4.05544892305962419923E0,  3.15251094599893866154E1,  5.71628192246421288162E1,
+                           4.40805073893200834700E1,  1.46849561928858024014E1,  2.18663306850790267539E0,
+                           -1.40256079171354495875E-1, -3.50424626827848203418E-2, -8.57456785154685413611E-4};
+const double kNdtriQ1[] = {1.57799883256466749731E1,  4.53907635128879210584E1,  4.13172038254672030440E1,
+                           1.50425385692907503408E1,  2.50464946208309415979E0,  -1.42182922854787788574E-1,
+                           -3.80806407691578277194E-2, -9.33259480895457427372E-4};
+const double kNdtriP2[] = {3.23774891776946035970E0, 6.91522889068984211695E0, 3.93881025292474443415E0,
+                           1.33303460815807542389E0, 2.01485389549179081538E-1, 1.23716634817820021358E-2,
+                           3.01581553508235416007E-4, 2.65806974686737550832E-6, 6.23974539184983293730E-9};
+const double kNdtriQ2[] = {6.02427039364742014255E0, 3.67983563856160859403E0, 1.37702099489081330271E0,
+                           2.16236993594496635890E-1, 1.34204006088543189037E-2, 3.28014464682127739104E-4,
+                           2.89247864745380683936E-6, 6.79019408009981274425E-9};
+
+// erf(x) for |x| <= 1
+template <class T>
+T ErfSmall(const T &x)
+{
+   T z = x * x;
+   return x * Polynomialeval(z, kErfT, 4) / Polynomial1eval(z, kErfU, 5);
+}
+
+// erfc(x) for x >= 1
+template <class T>
+T ErfcLarge(const T &x)
+{
+   T z = -x * x;
+   T e = Exp(z);
+   T p = Select(x < T(8.0), Polynomialeval(x, kErfP, 8), Polynomialeval(x, kErfR, 5));
+   T q = Select(x < T(8.0), Polynomial1eval(x, kErfQ, 8), Polynomial1eval(x, kErfS, 6));
+   return Select(z < T(-kMaxLog), T(0.), (e * p) / q);
+}
+
+template <class T>
+T Erf(const T &x)
+{
+   T c = ErfcLarge(Abs(x));
+   T large = Select(x < T(0.), T(1.) - (T(2.) - c), T(1.) - c);
+   return Select(Abs(x) > T(1.), large, ErfSmall(x));
+}
+
+template <class T>
+T Erfc(const T &x)
+{
+   T c = ErfcLarge(Abs(x));
+   T large = Select(x < T(0.), T(2.) - c, c);
+   return Select(Abs(x) < T(1.), T(1.) - ErfSmall(x), large);
+}
+
+// values outside the domain of the vectorized lgamma (x <= 0, infinity, nan)
+bool LgammaScalarDomain(double x)
+{
+   return !(x > 0 && x < kInf);
+}
+
+double ScalarLgamma(double x)
+{
+   return ROOT::Math::lgamma(x);
+}
+
+template <class T>
+T Lgamma(const T &x)
+{
+   // x >= 13: Stirling formula
+   T q = (x - 0.5) * Log(x) - x + kLS2Pi;
+   T p = T(1.0) / (x * x);
+   T q1 = q + Polynomialeval(p, kLgamA, 4) / x;
+   T q2 = q + ((7.9365079365079365079365e-4 * p - 2.7777777777777777777778e-3) * p + 0.0833333333333333333333) / x;
+   T stirling = Select(x > T(1.0e8), q, Select(x >= T(1000.0), q2, q1));
+   stirling = Select(x > T(kMaxLgm), T(kInf), stirling);
+
+   // 0 < x < 13: reduction to the interval [2,3) with the recurrence relation
+   T z(1.0);
+   T shift(0.0);
+   for (int k = 1; k <= 10; ++k) {
+      // multiply by x-k while x-k+1 >= 3
+      auto m = (x + shift >= T(3.0));
+      shift = Select(m, shift - 1.0, shift);
+      z = Select(m, z * (x + shift), z);
+   }
+   for (int k = 0; k < 2; ++k) {
+      // divide by x+k while x+k < 2
+      auto m = (x + shift < T(2.0));
+      z = Select(m, z / (x + shift), z);
+      shift = Select(m, shift + 1.0, shift);
+   }
+   T u = x + (shift - 2.0);
+   T reduced = Log(z) + u * Polynomialeval(u, kLgamB, 5) / Polynomial1eval(u, kLgamC, 6);
+
+   T result = Select(x < T(13.0), reduced, stirling);
+   return ScalarFallback(result, x, !(x > T(0.) && x < T(kInf)), &ScalarLgamma, &LgammaScalarDomain);
+}
+
+// inverse of the normal cumulative distribution
+template <class T>
+T Ndtri(const T &y0)
+{
+   const double kExpm2 = 0.13533528323661269189; // exp(-2)
+   auto flip = (y0 > T(1.0 - kExpm2));
+   T y = Select(flip, T(1.0) - y0, y0);
+
+   // central region
+   T yc = y - 0.5;
+   T y2 = yc * yc;
+   T central = (yc + yc * (y2 * Polynomialeval(y2, kNdtriP0, 4) / Polynomial1eval(y2, kNdtriQ0, 8))) * kS2Pi;
+
+   // tails
+   T x = Sqrt(-2.0 * Log(y));
+   T x0 = x - Log(x) / x;
+   T z = T(1.0) / x;
+   T x1 = Select(x < T(8.0), z * Polynomialeval(z, kNdtriP1, 8) / Polynomial1eval(z, kNdtriQ1, 8),
+                 z * Polynomialeval(z, kNdtriP2, 8) / Polynomial1eval(z, kNdtriQ2, 8));
+   T tail = x0 - x1;
+   tail = Select(flip, tail, -tail);
+
+   T result = Select(y > T(kExpm2), central, tail);
+   result = Select(y0 <= T(0.0), T(-kInf), result);
+   return Select(y0 >= T(1.0), T(kInf), result);
+}
+
+// exp(x)-1 and log(1+x) with error cancellation for small x
+template <class T>
+T Expm1(const T &x)
+{
+   T u = Exp(x);
+   T um1 = u - 1.0;
+   T small = um1 * x / Log(u);
+   small = Select(u == T(1.0), x, small);
+   return Select(Abs(x) < T(1.0), small, um1);
+}
+
+template <class T>
+T Log1p(const T &x)
+{
+   T y = x + 1.0;
+   // the correction is not defined for y = 0, where the result is -inf
+   return Select(y == T(0.0), Log(y), Log(y) - ((y - 1.0) - x) / y);
+}
+
+// erf(z)/erfc(z) combinations used by the normal cdf, with a single exponential
+template <class T>
+T NormalCdfZ(const T &z)
+{
+   T c = ErfcLarge(Abs(z));
+   T result = Select(z > T(1.0), 0.5 * (1.0 + (1.0 - c)), 0.5 * (1.0 + ErfSmall(z)));
+   return Select(z < T(-1.0), 0.5 * c, result);
+}
+
+template <class T>
+T NormalCdfCZ(const T &z)
+{
+   T c = ErfcLarge(Abs(z));
+   T result = Select(z < T(-1.0), 0.5 * (1. - (1.0 - (2.0 - c))), 0.5 * (1. - ErfSmall(z)));
+   return Select(z > T(1.0), 0.5 * c, result);
+}
+
+// the functions with their parameters, to be evaluated on double or ROOT::Double_v
+
+struct ErfFunc {
+   template <class T> T operator()(const T &x) const { return Erf(x); }
+};
+struct ErfcFunc {
+   template <class T> T operator()(const T &x) const { return Erfc(x); }
+};
+struct LgammaFunc {
+   template <class T> T operator()(const T &x) const { return Lgamma(x); }
+};
+
+struct CauchyPdf {
+   double fB, fX0;
+   template <class T> T operator()(const T &x) const { return fB / (M_PI * ((x - fX0) * (x - fX0) + fB * fB)); }
+};
+
+struct ChisquaredPdf {
+   double fR, fX0, fLgamma;
+   ChisquaredPdf(double r, double x0) : fR(r), fX0(x0), fLgamma(ROOT::Math::lgamma(r / 2)) {}
+   template <class T> T operator()(const T &x) const
+   {
+      T y = x - fX0;
+      T result = Exp((fR / 2 - 1) * Log(y / 2) - y / 2 - fLgamma) / 2;
+      // return inf for x = x0 but treat the special case of r = 2, otherwise it returns nan
+      if (fR / 2 - 1. == 0) result = Select(y == T(0.), T(0.5), result);
+      return Select(y < T(0.), T(0.), result);
+   }
+};
+
+struct ExponentialPdf {
+   double fLambda, fX0;
+   template <class T> T operator()(const T &x) const
+   {
+      T y = x - fX0;
+      return Select(y < T(0.), T(0.), fLambda * Exp(-fLambda * y));
+   }
+};
+
+struct GammaPdf {
+   double fAlpha, fTheta, fX0, fLgamma;
+   GammaPdf(double alpha, double theta, double x0)
+      : fAlpha(alpha), fTheta(theta), fX0(x0), fLgamma(ROOT::Math::lgamma(alpha)) {}
+   template <class T> T operator()(const T &x) const
+   {
+      T y = x - fX0;
+      T result;
+      if (fAlpha == 1) {
+         result = Exp(-y / fTheta) / fTheta;
+         result = Select(y == T(0.), T(1.0 / fTheta), result);
+      } else {
+         result = Exp((fAlpha - 1) * Log(y / fTheta) - y / fTheta - fLgamma) / fTheta;
+         result = Select(y == T(0.), T(0.), result);
+      }
+      return Select(y < T(0.), T(0.), result);
+   }
+};
+
+struct LognormalPdf {
+   double fM, fS, fX0;
+   template <class T> T operator()(const T &x) const
+   {
+      T y = x - fX0;
+      T tmp = (Log(y) - fM) / fS;
+      T result = 1.0 / (y * std::abs(fS) * std::sqrt(2 * M_PI)) * Exp(-(tmp * tmp) / 2);
+      return Select(y <= T(0.), T(0.), result);
+   }
+};
+
+struct NormalPdf {
+   double fSigma, fX0;
+   template <class T> T operator()(const T &x) const
+   {
+      T tmp = (x - fX0) / fSigma;
+      return (1.0 / (std::sqrt(2 * M_PI) * std::abs(fSigma))) * Exp(-tmp * tmp / 2);
+   }
+};
+
+struct PoissonPdf {
+   template <class T> T operator()(const T &k, const T &mu) const
+   {
+      T result = Exp(k * Log(mu) - Lgamma(k + 1.0) - mu);
+      // when k = 0 and mu = 0, 1 is returned; nan for mu < 0
+      T result0 = Select(mu >= T(0.), Exp(-mu), Log(mu));
+      return Select(k > T(0.), result, result0);
+   }
+};
+
+struct ExponentialCdf {
+   double fLambda, fX0;
+   template <class T> T operator()(const T &x) const
+   {
+      T y = x - fX0;
+      return Select(y < T(0.), T(0.), -Expm1(-fLambda * y));
+   }
+};
+
+struct ExponentialCdfC {
+   double fLambda, fX0;
+   template <class T> T operator()(const T &x) const
+   {
+      T y = x - fX0;
+      return Select(y < T(0.), T(1.), Exp(-fLambda * y));
+   }
+};
+
+struct LognormalCdf {
+   double fM, fS, fX0;
+   template <class T> T operator()(const T &x) const { return NormalCdfZ((Log(x - fX0) - fM) / (fS * kSqrt2)); }
+};
+
+struct LognormalCdfC {
+   double fM, fS, fX0;
+   template <class T> T operator()(const T &x) const { return NormalCdfCZ((Log(x - fX0) - fM) / (fS * kSqrt2)); }
+};
+
+struct NormalCdf {
+   double fSigma, fX0;
+   template <class T> T operator()(const T &x) const { return NormalCdfZ((x - fX0) / (fSigma * kSqrt2)); }
+};
+
+struct NormalCdfC {
+   double fSigma, fX0;
+   template <class T> T operator()(const T &x) const { return NormalCdfCZ((x - fX0) / (fSigma * kSqrt2)); }
+};
+
+struct ExponentialQuantile {
+   double fLambda;
+   template <class T> T operator()(const T &z) const { return -Log1p(-z) / fLambda; }
+};
+
+struct ExponentialQuantileC {
+   double fLambda;
+   template <class T> T operator()(const T &z) const { return -Log(z) / fLambda; }
+};
+
+struct LognormalQuantile {
+   double fM, fS;
+   template <class T> T operator()(const T &z) const { return Exp(fS * Ndtri(z) + fM); }
+};
+
+struct LognormalQuantileC {
+   double fM, fS;
+   template <class T> T operator()(const T &z) const { return Exp(-fS * Ndtri(z) + fM); }
+};
+
+struct NormalQuantile {
+   double fSigma;
+   template <class T> T operator()(const T &z) const { return fSigma * Ndtri(z); }
+};
+
+struct NormalQuantileC {
+   double fSigma;
+   template <class T> T operator()(const T &z) const { return -fSigma * Ndtri(z); }
+};
+
+// evaluate the function on the array, using the vector type for the full vectors
+template <class Func>
+void EvalArray(const Func &func, unsigned int n, const double *x, double *result)
+{
+   unsigned int i = 0;
+#ifdef R__HAS_VECCORE
+   const unsigned int vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   for (; i + vecSize <= n; i += vecSize) {
+      ROOT::Double_v xv;
+      vecCore::Load<ROOT::Double_v>(xv, x + i);
+      vecCore::Store<ROOT::Double_v>(func(xv), result + i);
+   }
+#endif
+   for (; i < n; ++i)
+      result[i] = func(x[i]);
+}
+
+} // end anonymous namespace
+
+void erf(unsigned int n, const double *x, double *result)
+{
+   EvalArray(ErfFunc(), n, x, result);
+}
+
+void erfc(unsigned int n, const double *x, double *result)
+{
+   EvalArray(ErfcFunc(), n, x, result);
+}
+
+void lgamma(unsigned int n, const double *x, double *result)
+{
+   EvalArray(LgammaFunc(), n, x, result);
+}
+
+void breitwigner_pdf(unsigned int n, const double *x, double *result, double gamma, double x0)
+{
+   EvalArray(CauchyPdf{gamma / 2.0, x0}, n, x, result);
+}
+
+void cauchy_pdf(unsigned int n, const double *x, double *result, double b, double x0)
+{
+   EvalArray(CauchyPdf{b, x0}, n, x, result);
+}
+
+void chisquared_pdf(unsigned int n, const double *x, double *result, double r, double x0)
+{
+   EvalArray(ChisquaredPdf(r, x0), n, x, result);
+}
+
+void exponential_pdf(unsigned int n, const double *x, double *result, double lambda, double x0)
+{
+   EvalArray(ExponentialPdf{lambda, x0}, n, x, result);
+}
+
+void gamma_pdf(unsigned int n, const double *x, double *result, double alpha, double theta, double x0)
+{
+   EvalArray(GammaPdf(alpha, theta, x0), n, x, result);
+}
+
+void lognormal_pdf(unsigned int n, const double *x, double *result, double m, double s, double x0)
+{
+   EvalArray(LognormalPdf{m, s, x0}, n, x, result);
+}
+
+void normal_pdf(unsigned int n, const double *x, double *result, double sigma, double x0)
+{
+   EvalArray(NormalPdf{sigma, x0}, n, x, result);
+}
+
+void poisson_pdf(unsigned int n, const unsigned int *k, const double *mu, double *result)
+{
+   PoissonPdf func;
+   unsigned int i = 0;
+#ifdef R__HAS_VECCORE
+   const unsigned int vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   for (; i + vecSize <= n; i += vecSize) {
+      ROOT::Double_v kv, muv;
+      for (unsigned int l = 0; l < vecSize; ++l)
+         vecCore::Set(kv, l, k[i + l]);
+      vecCore::Load<ROOT::Double_v>(muv, mu + i);
+      vecCore::Store<ROOT::Double_v>(func(kv, muv), result + i);
+   }
+#endif
+   for (; i < n; ++i)
+      result[i] = func(double(k[i]), mu[i]);
+}
+
+void exponential_cdf(unsigned int n, const double *x, double *result, double lambda, double x0)
+{
+   EvalArray(ExponentialCdf{lambda, x0}, n, x, result);
+}
+
+void exponential_cdf_c(unsigned int n, const double *x, double *result, double lambda, double x0)
+{
+   EvalArray(ExponentialCdfC{lambda, x0}, n, x, result);
+}
+
+void lognormal_cdf(unsigned int n, const double *x, double *result, double m, double s, double x0)
+{
+   EvalArray(LognormalCdf{m, s, x0}, n, x, result);
+}
+
+void lognormal_cdf_c(unsigned int n, const double *x, double *result, double m, double s, double x0)
+{
+   EvalArray(LognormalCdfC{m, s, x0}, n, x, result);
+}
+
+void normal_cdf(unsigned int n, const double *x, double *result, double sigma, double x0)
+{
+   EvalArray(NormalCdf{sigma, x0}, n, x, result);
+}
+
+void normal_cdf_c(unsigned int n, const double *x, double *result, double sigma, double x0)
+{
+   EvalArray(NormalCdfC{sigma, x0}, n, x, result);
+}
+
+void exponential_quantile(unsigned int n, const double *z, double *result, double lambda)
+{
+   EvalArray(ExponentialQuantile{lambda}, n, z, result);
+}
+
+void exponential_quantile_c(unsigned int n, const double *z, double *result, double lambda)
+{
+   EvalArray(ExponentialQuantileC{lambda}, n, z, result);
+}
+
+void lognormal_quantile(unsigned int n, const double *z, double *result, double m, double s)
+{
+   EvalArray(LognormalQuantile{m, s}, n, z, result);
+}
+
+void lognormal_quantile_c(unsigned int n, const double *z, double *result, double m, double s)
+{
+   EvalArray(LognormalQuantileC{m, s}, n, z, result);
+}
+
+void normal_quantile(unsigned int n, const double *z, double *result, double sigma)
+{
+   EvalArray(NormalQuantile{sigma}, n, z, result);
+}
+
+void normal_quantile_c(unsigned int n, const double *z, double *result, double sigma)
+{
+   EvalArray(NormalQuantileC{sigma}, n, z, result);
+}
+
+#ifdef R__HAS_VECCORE
+
+ROOT::Double_v erf(const ROOT::Double_v &x)
+{
+   return Erf(x);
+}
+
+ROOT::Double_v erfc(const ROOT::Double_v &x)
+{
+   return Erfc(x);
+}
+
+ROOT::Double_v lgamma(const ROOT::Double_v &x)
+{
+   return Lgamma(x);
+}
+
+ROOT::Double_v breitwigner_pdf(const ROOT::Double_v &x, double gamma, double x0)
+{
+   return CauchyPdf{gamma / 2.0, x0}(x);
+}
+
+ROOT::Double_v cauchy_pdf(const ROOT::Double_v &x, double b, double x0)
+{
+   return CauchyPdf{b, x0}(x);
+}
+
+ROOT::Double_v chisquared_pdf(const ROOT::Double_v &x, double r, double x0)
+{
+   return ChisquaredPdf(r, x0)(x);
+}
+
+ROOT::Double_v exponential_pdf(const ROOT::Double_v &x, double lambda, double x0)
+{
+   return ExponentialPdf{lambda, x0}(x);
+}
+
+ROOT::Double_v gamma_pdf(const ROOT::Double_v &x, double alpha, double theta, double x0)
+{
+   return GammaPdf(alpha, theta, x0)(x);
+}
+
+ROOT::Double_v lognormal_pdf(const ROOT::Double_v &x, double m, double s, double x0)
+{
+   return LognormalPdf{m, s, x0}(x);
+}
+
+ROOT::Double_v normal_pdf(const ROOT::Double_v &x, double sigma, double x0)
+{
+   return NormalPdf{sigma, x0}(x);
+}
+
+ROOT::Double_v poisson_pdf(const ROOT::Double_v &k, const ROOT::Double_v &mu)
+{
+   return PoissonPdf()(k, mu);
+}
+
+ROOT::Double_v exponential_cdf(const ROOT::Double_v &x, double lambda, double x0)
+{
+   return ExponentialCdf{lambda, x0}(x);
+}
+
+ROOT::Double_v exponential_cdf_c(const ROOT::Double_v &x, double lambda, double x0)
+{
+   return ExponentialCdfC{lambda, x0}(x);
+}
+
+ROOT::Double_v lognormal_cdf(const ROOT::Double_v &x, double m, double s, double x0)
+{
+   return LognormalCdf{m, s, x0}(x);
+}
+
+ROOT::Double_v lognormal_cdf_c(const ROOT::Double_v &x, double m, double s, double x0)
+{
+   return LognormalCdfC{m, s, x0}(x);
+}
+
+ROOT::Double_v normal_cdf(const ROOT::Double_v &x, double sigma, double x0)
+{
+   return NormalCdf{sigma, x0}(x);
+}
+
+ROOT::Double_v normal_cdf_c(const ROOT::Double_v &x, double sigma, double x0)
+{
+   return NormalCdfC{sigma, x0}(x);
+}
+
+ROOT::Double_v exponential_quantile(const ROOT::Double_v &z, double lambda)
+{
+   return ExponentialQuantile{lambda}(z);
+}
+
+ROOT::Double_v exponential_quantile_c(const ROOT::Double_v &z, double lambda)
+{
+   return ExponentialQuantileC{lambda}(z);
+}
+
+ROOT::Double_v lognormal_quantile(const ROOT::Double_v &z, double m, double s)
+{
+   return LognormalQuantile{m, s}(z);
+}
+
+ROOT::Double_v lognormal_quantile_c(const ROOT::Double_v &z, double m, double s)
+{
+   return LognormalQuantileC{m, s}(z);
+}
+
+ROOT::Double_v normal_quantile(const ROOT::Double_v &z, double sigma)
+{
+   return NormalQuantile{sigma}(z);
+}
+
+ROOT::Double_v normal_quantile_c(const ROOT::Double_v &z, double sigma)
+{
+   return NormalQuantileC{sigma}(z);
+}
+
+#endif
+
+} // namespace Math
+} // namespace ROOT
@@ -47,6 +47,16 @@ int main()
    }
 #endif
 
+#ifndef R__WIN32
+   auto r5 = h1f.Fit(f, "MULTIPROC S");
+   if ((Int_t) r5 != 0) {
+      Error("testChi2ExecPolicy", "Multiprocess Fit failed!");
+      return -1;
+   } else {
+      compareResult(r5->Chi2(), r1->Chi2(), "Multiprocess Chi2 Fit: ");
+   }
+#endif
+
 #ifdef R__HAS_VECCORE
    TF1 *fvecCore = new TF1("fvCore", func<ROOT::Double_v>, 100, 200, 4);
    fvecCore->SetParameters(1, 1000, 7.5, 1.5);
@@ -0,0 +1,201 @@
+#include "Fit/BinData.h"
+#include "Fit/Chi2FCN.h"
+#include "Fit/FitUtil.h"
+#include "Fit/LogLikelihoodFCN.h"
+#include "Fit/PoissonLikelihoodFCN.h"
+#include "Fit/UnBinData.h"
+#include "HFitInterface.h"
+#include "Math/IParamFunction.h"
+#include "TF1.h"
+#include "TH1.h"
+#include "TRandom.h"
+#include "TROOT.h"
+#include "TError.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// compare the values and gradients of the FitUtil functions evaluated with the
+// different execution policies and with a vectorized model function
+
+constexpr unsigned int nPar = 4;
+
+int compareResult(double v1, double v2, std::string s = "", double tol = 1.E-10)
+{
+   // compare v1 with reference v2
+   if (std::abs(v1 - v2) <= tol * std::abs(v2) + tol) return 0;
+   std::cerr << s << " Failed comparison \t value = " << v1 << "   it should be = " << v2 << std::endl;
+   return -1;
+}
+
+int compareGradient(const std::vector<double> &g1, const std::vector<double> &g2, std::string s = "")
+{
+   int iret = 0;
+   for (unsigned int i = 0; i < g1.size(); ++i)
+      iret |= compareResult(g1[i], g2[i], s + " gradient[" + std::to_string(i) + "]");
+   return iret;
+}
+
+// Gaussian peak on an exponential background, with an analytic and thread safe parameter gradient
+template <class T>
+class GausExpFunction : public ROOT::Math::IParametricGradFunctionMultiDimTempl<T> {
+public:
+   GausExpFunction() : fParams(nPar) {}
+
+   ROOT::Math::IBaseFunctionMultiDimTempl<T> *Clone() const { return new GausExpFunction(*this); }
+   unsigned int NDim() const { return 1; }
+   const double *Parameters() const { return fParams.data(); }
+   void SetParameters(const double *p) { std::copy(p, p + nPar, fParams.begin()); }
+   unsigned int NPar() const { return nPar; }
+
+   void ParameterGradient(const double *x, const double *p, double *grad) const
+   {
+      double d = (x[0] - p[1]) / p[2];
+      double gaus = std::exp(-0.5 * d * d);
+      grad[0] = gaus;
+      grad[1] = p[0] * gaus * d / p[2];
+      grad[2] = p[0] * gaus * d * d / p[2];
+      grad[3] = std::exp(-0.02 * x[0]);
+   }
+
+private:
+   T DoEvalPar(const T *x, const double *p) const
+   {
+      T d = (x[0] - p[1]) / p[2];
+      return p[0] * exp(-0.5 * d * d) + p[3] * exp(-0.02 * x[0]);
+   }
+
+   double DoParameterDerivative(const double *x, const double *p, unsigned int ipar) const
+   {
+      double grad[nPar];
+      ParameterGradient(x, p, grad);
+      return grad[ipar];
+   }
+
+   std::vector<double> fParams;
+};
+
+// evaluate all the functions with the given model function and execution policy and
+// compare them with the reference values
+template <class T>
+int testFunctions(const ROOT::Math::IParamMultiFunctionTempl<T> &func, const ROOT::Fit::BinData &bdata,
+                  const ROOT::Fit::UnBinData &udata, const double *p, unsigned int executionPolicy, unsigned nChunks,
+                  std::string s)
+{
+   GausExpFunction<double> fref;
+   unsigned int n1 = 0, n2 = 0;
+   int iret = 0;
+
+   for (int iWeight : {0, 2}) {
+      double v1 = ROOT::Fit::FitUtil::EvaluatePoissonLogL(fref, bdata, p, iWeight, true, n1);
+      double v2 = ROOT::Fit::FitUtil::EvaluatePoissonLogL(func, bdata, p, iWeight, true, n2, executionPolicy, nChunks);
+      iret |= compareResult(v2, v1, s + " PoissonLogL iWeight=" + std::to_string(iWeight));
+      if (n1 != n2) {
+         std::cerr << s << " PoissonLogL: " << n2 << " points used instead of " << n1 << std::endl;
+         iret = -1;
+      }
+   }
+
+   std::vector<double> g1(nPar), g2(nPar);
+   ROOT::Fit::FitUtil::EvaluatePoissonLogLGradient(fref, bdata, p, g1.data());
+   ROOT::Fit::FitUtil::EvaluatePoissonLogLGradient(func, bdata, p, g2.data(), executionPolicy, nChunks);
+   iret |= compareGradient(g2, g1, s + " PoissonLogL");
+
+   ROOT::Fit::FitUtil::EvaluateChi2Gradient(fref, bdata, p, g1.data(), n1);
+   ROOT::Fit::FitUtil::EvaluateChi2Gradient(func, bdata, p, g2.data(), n2, executionPolicy, nChunks);
+   iret |= compareGradient(g2, g1, s + " Chi2");
+   if (n1 != n2) {
+      std::cerr << s << " Chi2 gradient: " << n2 << " points used instead of " << n1 << std::endl;
+      iret = -1;
+   }
+
+   ROOT::Fit::FitUtil::EvaluateLogLGradient(fref, udata, p, g1.data(), n1);
+   ROOT::Fit::FitUtil::EvaluateLogLGradient(func, udata, p, g2.data(), n2, executionPolicy, nChunks);
+   iret |= compareGradient(g2, g1, s + " LogL");
+
+   return iret;
+}
+
+// evaluate the value and the gradient of an FCN with the given execution policy for several sets of
+// parameters, as in a minimization, and compare them with the ones of the serial FCN
+template <class FCN>
+int testFCN(const FCN &fcnRef, const FCN &fcn, const double *p, std::string s)
+{
+   int iret = 0;
+   std::vector<double> x(p, p + nPar), g1(nPar), g2(nPar);
+   for (int i = 0; i < 3; ++i) {
+      iret |= compareResult(fcn(x.data()), fcnRef(x.data()), s + " step " + std::to_string(i));
+      fcnRef.Gradient(x.data(), g1.data());
+      fcn.Gradient(x.data(), g2.data());
+      iret |= compareGradient(g2, g1, s + " step " + std::to_string(i));
+      for (unsigned int k = 0; k < nPar; ++k)
+         x[k] *= 1.05;
+   }
+   return iret;
+}
+
+// the FCNs keep their worker processes between the evaluations
+int testFCNs(const ROOT::Fit::BinData &bdata, const ROOT::Fit::UnBinData &udata, const double *p,
+             ROOT::Fit::ExecutionPolicy executionPolicy, std::string s)
+{
+   GausExpFunction<double> func;
+   int iret = 0;
+   iret |= testFCN(ROOT::Fit::Chi2GradFunction(bdata, func), ROOT::Fit::Chi2GradFunction(bdata, func, executionPolicy),
+                   p, s + " Chi2FCN");
+   iret |= testFCN(ROOT::Fit::PoissonLLGradFunction(bdata, func, 2, true),
+                   ROOT::Fit::PoissonLLGradFunction(bdata, func, 2, true, executionPolicy), p, s + " PoissonLikelihoodFCN");
+   iret |= testFCN(ROOT::Fit::LogLikelihoodGradFunction(udata, func),
+                   ROOT::Fit::LogLikelihoodGradFunction(udata, func, 0, false, executionPolicy), p, s + " LogLikelihoodFCN");
+   return iret;
+}
+
+int main()
+{
+   // an odd number of points, to have a partial vector at the end of the vectorized loops
+   TH1D h1("h1", "h1", 1001, 0, 100);
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2)+[3]*exp(-0.02*x)", 0, 100);
+   f1.SetParameters(10, 50, 5, 20);
+   gRandom->SetSeed(1);
+   h1.FillRandom("f1", 20000);
+   // bins with negative content do not contribute to the saturated model term
+   h1.SetBinContent(10, -3);
+   h1.SetBinContent(501, -1);
+
+   ROOT::Fit::DataOptions opt;
+   opt.fUseEmpty = true;
+   ROOT::Fit::BinData bdata(opt);
+   ROOT::Fit::FillData(bdata, &h1);
+
+   ROOT::Fit::UnBinData udata(10001);
+   for (unsigned int i = 0; i < 10001; ++i)
+      udata.Add(f1.GetRandom());
+
+   const double p[nPar] = {12, 48, 6, 18};
+   GausExpFunction<double> func;
+   int iret = testFunctions<double>(func, bdata, udata, p, ROOT::Fit::kSerial, 0, "Serial");
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   iret |= testFunctions<double>(func, bdata, udata, p, ROOT::Fit::kMultithread, 0, "Multithread");
+   iret |= testFunctions<double>(func, bdata, udata, p, ROOT::Fit::kMultithread, 7, "Multithread (7 chunks)");
+#endif
+
+#ifndef R__WIN32
+   iret |= testFunctions<double>(func, bdata, udata, p, ROOT::Fit::kMultiprocess, 0, "Multiprocess");
+   iret |= testFunctions<double>(func, bdata, udata, p, ROOT::Fit::kMultiprocess, 7, "Multiprocess (7 chunks)");
+   iret |= testFCNs(bdata, udata, p, ROOT::Fit::kMultiprocess, "Multiprocess");
+#endif
+
+#ifdef R__HAS_VECCORE
+   GausExpFunction<ROOT::Double_v> func_v;
+   iret |= testFunctions<ROOT::Double_v>(func_v, bdata, udata, p, ROOT::Fit::kSerial, 0, "Vectorized");
+#ifdef R__USE_IMT
+   iret |= testFunctions<ROOT::Double_v>(func_v, bdata, udata, p, ROOT::Fit::kMultithread, 0, "Multithread vectorized");
+#endif
+#endif
+
+   if (iret != 0) Error("testFitUtilExecPolicy", "Test failed!");
+   return iret;
+}
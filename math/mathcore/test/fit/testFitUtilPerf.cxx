@@ -0,0 +1,123 @@
+#include "Fit/BinData.h"
+#include "Fit/FitUtil.h"
+#include "Math/IParamFunction.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+#include "TStopwatch.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// benchmark of the binned likelihood and of the gradients of the fit methods
+// for different data sizes and numbers of threads, with scalar and vectorized model functions
+
+constexpr unsigned int nPar = 4;
+constexpr int nRepeat = 20;
+
+// Gaussian peak on an exponential background, with an analytic parameter gradient
+template <class T>
+class GausExpFunction : public ROOT::Math::IParametricGradFunctionMultiDimTempl<T> {
+public:
+   GausExpFunction() : fParams(nPar) {}
+
+   ROOT::Math::IBaseFunctionMultiDimTempl<T> *Clone() const { return new GausExpFunction(*this); }
+   unsigned int NDim() const { return 1; }
+   const double *Parameters() const { return fParams.data(); }
+   void SetParameters(const double *p) { std::copy(p, p + nPar, fParams.begin()); }
+   unsigned int NPar() const { return nPar; }
+
+   void ParameterGradient(const double *x, const double *p, double *grad) const
+   {
+      double d = (x[0] - p[1]) / p[2];
+      double gaus = std::exp(-0.5 * d * d);
+      grad[0] = gaus;
+      grad[1] = p[0] * gaus * d / p[2];
+      grad[2] = p[0] * gaus * d * d / p[2];
+      grad[3] = std::exp(-0.02 * x[0]);
+   }
+
+private:
+   T DoEvalPar(const T *x, const double *p) const
+   {
+      T d = (x[0] - p[1]) / p[2];
+      return p[0] * exp(-0.5 * d * d) + p[3] * exp(-0.02 * x[0]);
+   }
+
+   double DoParameterDerivative(const double *x, const double *p, unsigned int ipar) const
+   {
+      double grad[nPar];
+      ParameterGradient(x, p, grad);
+      return grad[ipar];
+   }
+
+   std::vector<double> fParams;
+};
+
+// time in ms of one evaluation of the Poisson likelihood and of the gradients
+template <class T>
+void timeFunctions(const ROOT::Math::IParamMultiFunctionTempl<T> &func, const ROOT::Fit::BinData &data,
+                   unsigned int executionPolicy, std::string s)
+{
+   const double p[nPar] = {12, 48, 6, 18};
+   std::vector<double> g(nPar);
+   unsigned int nPoints = 0;
+   double times[3];
+   TStopwatch w;
+
+   w.Start();
+   for (int i = 0; i < nRepeat; ++i)
+      ROOT::Fit::FitUtil::EvaluatePoissonLogL(func, data, p, 0, true, nPoints, executionPolicy);
+   times[0] = w.RealTime();
+
+   w.Start();
+   for (int i = 0; i < nRepeat; ++i)
+      ROOT::Fit::FitUtil::EvaluatePoissonLogLGradient(func, data, p, g.data(), executionPolicy);
+   times[1] = w.RealTime();
+
+   w.Start();
+   for (int i = 0; i < nRepeat; ++i)
+      ROOT::Fit::FitUtil::EvaluateChi2Gradient(func, data, p, g.data(), nPoints, executionPolicy);
+   times[2] = w.RealTime();
+
+   std::cout << "  " << s;
+   for (double t : times)
+      std::cout << "\t" << 1000. * t / nRepeat;
+   std::cout << std::endl;
+}
+
+int main()
+{
+   TRandom3 rndm(1);
+   std::cout << "time (ms) of PoissonLogL, PoissonLogLGradient and Chi2Gradient" << std::endl;
+   for (unsigned int size : {1000, 10000, 100000, 1000000}) {
+      ROOT::Fit::BinData data(size, 1);
+      for (unsigned int i = 0; i < size; ++i) {
+         double x = 100. * (i + 0.5) / size;
+         double y = rndm.Poisson(10 * std::exp(-0.5 * (x - 50) * (x - 50) / 25) + 20 * std::exp(-0.02 * x));
+         data.Add(x, y, (y > 0) ? std::sqrt(y) : 1.);
+      }
+      std::cout << "data size = " << size << std::endl;
+
+      GausExpFunction<double> func;
+      timeFunctions<double>(func, data, ROOT::Fit::kSerial, "serial\t\t");
+#ifdef R__HAS_VECCORE
+      GausExpFunction<ROOT::Double_v> func_v;
+      timeFunctions<ROOT::Double_v>(func_v, data, ROOT::Fit::kSerial, "vectorized\t");
+#endif
+
+#ifdef R__USE_IMT
+      for (unsigned int nThreads : {2, 4, 8}) {
+         ROOT::EnableImplicitMT(nThreads);
+         std::string s = std::to_string(nThreads) + " threads";
+         timeFunctions<double>(func, data, ROOT::Fit::kMultithread, s + "\t");
+#ifdef R__HAS_VECCORE
+         timeFunctions<ROOT::Double_v>(func_v, data, ROOT::Fit::kMultithread, s + " vect.\t");
+#endif
+         ROOT::DisableImplicitMT();
+      }
+#endif
+   }
+   return 0;
+}
@@ -259,10 +259,25 @@ int main()
 #endif
 #endif
 
-//    //Multiprocessed
-//    auto seqMP = test.testMPFit();
-//    //Multiprocess + vectorized
-//    auto vecMP = test.testMPFitVec();
+#ifndef R__WIN32
+   //Multiprocessed
+   if (!test.testMPFit()) {
+      Error("testLogLExecPolicy", "Multiprocess Fit failed!");
+      return -1;
+   }
+   auto seqMP = test.GetFitter().Result().MinFcnValue();
+   compareResult(seqMP, seq, "Multiprocess LogL Fit: ");
+
+#ifdef R__HAS_VECCORE
+   //Multiprocess + vectorized
+   if (!test.testMPFitVec()) {
+      Error("testLogLExecPolicy", "Multiprocess + vectorized Fit failed!");
+      return -1;
+   }
+   auto vecMP = test.GetFitter().Result().MinFcnValue();
+   compareResult(vecMP, seq, "Multiprocess + vectorized LogL Fit: ");
+#endif
+#endif
 
    return 0;
 }
@@ -12,6 +12,7 @@
 #include "TStopwatch.h"
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 #include "Math/Integrator.h"
 #include "Math/Functor.h"
@@ -20,6 +21,7 @@
 #include "Math/AdaptiveIntegratorMultiDim.h"
 #include "Math/IFunctionfwd.h"
 #include "TF1.h"
+#include "RConfigure.h"
 
 // for graphical comparison of performance
 #include "TGraph.h"
@@ -138,6 +140,48 @@ double integral_TF1(unsigned int dim, double* a, double* b, double* p)
   return timeTF1;
 }
 
+#ifdef R__USE_IMT
+  // ################################################################
+  //
+  //      testing the multi-thread AdaptiveIntegratorMultiDim
+  //
+  // ################################################################
+int integral_MT()
+{
+  // the multi-thread integration must agree with the serial one within the errors
+  // and give always the same result
+  std::cout << "Testing multi-thread multidim integration\n";
+  int iret = 0;
+  for (int N = 2; N <= NMAX; N++) {
+     std::vector<double> a(N, -1.), b(N, 1.);
+     double p[1] = { double(N) };
+     ROOT::Math::WrappedParamFunction<> funptr1(&SimpleFun, N, p, p+1);
+     unsigned int nmax = (unsigned int) 1.E7;
+     ROOT::Math::AdaptiveIntegratorMultiDim ig1(funptr1, 1.E-5, 1.E-5, nmax);
+     TStopwatch timer;
+     double result = ig1.Integral(a.data(), b.data());
+     double tserial = timer.RealTime();
+
+     ROOT::Math::AdaptiveIntegratorMultiDim ig2(funptr1, 1.E-5, 1.E-5, nmax);
+     ig2.SetExecutionPolicy(ROOT::Fit::kMultithread);
+     timer.Start();
+     double resultMT = ig2.Integral(a.data(), b.data());
+     double tMT = timer.RealTime();
+     double resultMT2 = ig2.Integral(a.data(), b.data());
+
+     std::cout << "\tdim=" << N << "\t serial time " << tserial << "\t multi-thread time " << tMT << std::endl;
+     if (std::abs(resultMT - result) > ig1.Error() + ig2.Error() || ig2.Status() != ig1.Status() ||
+         resultMT2 != resultMT) {
+        std::cerr << "Error: multi-thread integral " << resultMT << " +/- " << ig2.Error() << " (status "
+                  << ig2.Status() << ") serial " << result << " +/- " << ig1.Error() << " (status " << ig1.Status()
+                  << ")" << std::endl;
+        iret = -1;
+     }
+  }
+  return iret;
+}
+#endif
+
 void performance()
 {
   //dimensionality
@@ -229,6 +273,11 @@ int main(int argc, char **argv)
 
    performance();
 
+   int iret = 0;
+#ifdef R__USE_IMT
+   iret |= integral_MT();
+#endif
+
    if ( showGraphics )
    {
       theApp->Run();
@@ -236,6 +285,6 @@ int main(int argc, char **argv)
       theApp = 0;
    }
 
-   return 0;
+   return iret;
 
 }
@@ -0,0 +1,215 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+// test the generation of blocks of random numbers (RndmArray, GausArray, ExpArray)
+// and the seeding of independent streams used for a parallel generation
+
+#include "TRandom.h"
+#include "TRandom1.h"
+#include "TRandom2.h"
+#include "TRandom3.h"
+#include "TRandomGen.h"
+#include "Math/ProbFuncMathCore.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// sizes not multiple of the engine states, to test the partial blocks
+const std::vector<int> gSizes = {1, 7, 239, 240, 623, 624, 1000, 10001};
+
+// the array must contain the same numbers returned by Rndm
+int testRndmArray(TRandom &r1, TRandom &r2, std::string s)
+{
+   int iret = 0;
+   for (int n : gSizes) {
+      std::vector<Double_t> v(n);
+      r1.RndmArray(n, v.data());
+      for (int i = 0; i < n; ++i) {
+         Double_t x = r2.Rndm();
+         if (v[i] != x) {
+            std::cerr << s << " RndmArray(" << n << "): element " << i << " = " << v[i] << " it should be " << x
+                      << std::endl;
+            iret = -1;
+            break;
+         }
+      }
+      // the generators must continue with the same sequence
+      if (r1.Rndm() != r2.Rndm()) {
+         std::cerr << s << " RndmArray(" << n << "): different sequence after the array" << std::endl;
+         iret = -1;
+      }
+   }
+   return iret;
+}
+
+int testExpArray(TRandom &r1, TRandom &r2, std::string s)
+{
+   const int n = 1001;
+   std::vector<Double_t> v(n);
+   r1.ExpArray(n, v.data(), 2.5);
+   for (int i = 0; i < n; ++i) {
+      Double_t x = r2.Exp(2.5);
+      if (std::abs(v[i] - x) > 1.E-14 * x) {
+         std::cerr << s << " ExpArray: element " << i << " = " << v[i] << " it should be " << x << std::endl;
+         return -1;
+      }
+   }
+   return 0;
+}
+
+int testGausArray(TRandom &r, std::string s)
+{
+   const int n = 1000001;
+   const Double_t mean = 1.5, sigma = 2.;
+   std::vector<Double_t> v(n);
+   r.GausArray(n, v.data(), mean, sigma);
+   Double_t sum = 0, sum2 = 0;
+   int nabove = 0;
+   for (Double_t x : v) {
+      sum += x;
+      sum2 += (x - mean) * (x - mean);
+      if (x > mean + sigma) nabove++;
+   }
+   Double_t m = sum / n;
+   Double_t s2 = std::sqrt(sum2 / n);
+   Double_t fabove = Double_t(nabove) / n;
+   Double_t fexp = ROOT::Math::normal_cdf_c(1.);
+   // 5 standard deviations
+   if (std::abs(m - mean) > 5 * sigma / std::sqrt(n) || std::abs(s2 - sigma) > 5 * sigma / std::sqrt(2. * n) ||
+       std::abs(fabove - fexp) > 5 * std::sqrt(fexp * (1 - fexp) / n)) {
+      std::cerr << s << " GausArray: mean = " << m << " sigma = " << s2 << " fraction above 1 sigma = " << fabove
+                << std::endl;
+      return -1;
+   }
+   return 0;
+}
+
+// the streams of the same seed must be reproducible and different
+template <class R>
+int testStreams(std::string s)
+{
+   int iret = 0;
+   const int n = 100;
+   std::vector<Double_t> v0(n), v1(n), v2(n);
+   R r1, r2;
+   r1.SetStreamSeed(111, 1);
+   r1.RndmArray(n, v1.data());
+   r2.SetStreamSeed(111, 1);
+   r2.RndmArray(n, v2.data());
+   if (v1 != v2) {
+      std::cerr << s << ": stream 1 is not reproducible" << std::endl;
+      iret = -1;
+   }
+   r2.SetStreamSeed(111, 2);
+   r2.RndmArray(n, v2.data());
+   if (v1 == v2) {
+      std::cerr << s << ": stream 1 and 2 give the same sequence" << std::endl;
+      iret = -1;
+   }
+   // stream 0 is the same as SetSeed
+   r1.SetStreamSeed(111, 0);
+   r1.RndmArray(n, v1.data());
+   r2.SetSeed(111);
+   r2.RndmArray(n, v0.data());
+   if (v1 != v0) {
+      std::cerr << s << ": stream 0 is different than the sequence given by SetSeed" << std::endl;
+      iret = -1;
+   }
+   return iret;
+}
+
+#ifdef R__USE_IMT
+// generate in parallel with one stream per task and compare with the serial generation
+int testParallelStreams()
+{
+   const unsigned int ntasks = 16;
+   const int n = 10000;
+   auto generate = [&](unsigned int task) {
+      TRandomMixMax r;
+      r.SetStreamSeed(4357, task);
+      std::vector<Double_t> v(n);
+      r.GausArray(n, v.data());
+      Double_t sum = 0;
+      for (Double_t x : v) sum += x;
+      return sum;
+   };
+   std::vector<unsigned int> tasks(ntasks);
+   for (unsigned int i = 0; i < ntasks; ++i) tasks[i] = i;
+   ROOT::TThreadExecutor pool(4);
+   auto result = pool.Map(generate, tasks);
+   for (unsigned int i = 0; i < ntasks; ++i) {
+      if (result[i] != generate(i)) {
+         std::cerr << "Parallel streams: task " << i << " gives " << result[i] << " it should be " << generate(i)
+                   << std::endl;
+         return -1;
+      }
+   }
+   return 0;
+}
+#endif
+
+int main()
+{
+   int iret = 0;
+   {
+      TRandom r1(1), r2(1);
+      iret |= testRndmArray(r1, r2, "TRandom");
+      iret |= testExpArray(r1, r2, "TRandom");
+   }
+   {
+      TRandom1 r1(1), r2(1);
+      iret |= testRndmArray(r1, r2, "TRandom1");
+   }
+   {
+      TRandom2 r1(1), r2(1);
+      iret |= testRndmArray(r1, r2, "TRandom2");
+   }
+   {
+      TRandom3 r1(1), r2(1);
+      iret |= testRndmArray(r1, r2, "TRandom3");
+      iret |= testExpArray(r1, r2, "TRandom3");
+      iret |= testGausArray(r1, "TRandom3");
+   }
+   {
+      TRandomMixMax r1(1), r2(1);
+      iret |= testRndmArray(r1, r2, "TRandomMixMax");
+      iret |= testExpArray(r1, r2, "TRandomMixMax");
+      iret |= testGausArray(r1, "TRandomMixMax");
+   }
+   {
+      TRandomMixMax256 r1(1), r2(1);
+      iret |= testRndmArray(r1, r2, "TRandomMixMax256");
+   }
+   {
+      TRandomMixMax17 r1(1), r2(1);
+      iret |= testRndmArray(r1, r2, "TRandomMixMax17");
+   }
+   {
+      TRandomMT64 r1(1), r2(1);
+      iret |= testRndmArray(r1, r2, "TRandomMT64");
+   }
+
+   iret |= testStreams<TRandom3>("TRandom3");
+   iret |= testStreams<TRandomMixMax>("TRandomMixMax");
+   iret |= testStreams<TRandomMixMax17>("TRandomMixMax17");
+   iret |= testStreams<TRandomMT64>("TRandomMT64");
+
+#ifdef R__USE_IMT
+   iret |= testParallelStreams();
+#endif
+
+   if (iret != 0) std::cerr << "testRandomArrays: FAILED" << std::endl;
+   return iret;
+}
@@ -0,0 +1,182 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+// compare the vectorized special and statistical functions (array and ROOT::Double_v
+// versions) with the corresponding scalar functions
+
+#include "Math/VecFuncMathCore.h"
+#include "Math/DistFuncMathCore.h"
+#include "Math/SpecFuncMathCore.h"
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+const double kTolerance = 1.E-13;
+
+// points spanning the ranges of the different algorithms, including the boundaries
+std::vector<double> GetPoints(double xmin, double xmax, unsigned int n, std::vector<double> extra)
+{
+   std::vector<double> x(extra);
+   for (unsigned int i = 0; i < n; ++i)
+      x.push_back(xmin + (xmax - xmin) * (i + 0.5) / n);
+   return x;
+}
+
+int compare(const std::vector<double> &x, const std::vector<double> &result, std::function<double(double)> func,
+            std::string s)
+{
+   for (unsigned int i = 0; i < x.size(); ++i) {
+      double ref = func(x[i]);
+      double r = result[i];
+      bool ok = (r == ref) || (std::isnan(r) && std::isnan(ref)) ||
+                std::abs(r - ref) <= kTolerance * std::abs(ref) + std::numeric_limits<double>::min();
+      if (!ok) {
+         std::cerr << s << "(" << x[i] << ") = " << r << " it should be " << ref << " (relative difference "
+                   << (r - ref) / ref << ")" << std::endl;
+         return -1;
+      }
+   }
+   return 0;
+}
+
+// check the array function, and the ROOT::Double_v one on the same points
+#ifdef R__HAS_VECCORE
+int testFunction(const std::vector<double> &x, std::function<void(unsigned int, const double *, double *)> farray,
+                 std::function<ROOT::Double_v(const ROOT::Double_v &)> fvec, std::function<double(double)> func,
+                 std::string s)
+#else
+int testFunction(const std::vector<double> &x, std::function<void(unsigned int, const double *, double *)> farray,
+                 std::function<double(double)> func, std::string s)
+#endif
+{
+   std::vector<double> result(x.size());
+   farray(x.size(), x.data(), result.data());
+   int iret = compare(x, result, func, s);
+
+#ifdef R__HAS_VECCORE
+   const unsigned int vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   for (unsigned int i = 0; i + vecSize <= x.size(); i += vecSize) {
+      ROOT::Double_v xv;
+      vecCore::Load<ROOT::Double_v>(xv, &x[i]);
+      vecCore::Store<ROOT::Double_v>(fvec(xv), &result[i]);
+   }
+   iret |= compare(std::vector<double>(x.begin(), x.begin() + x.size() / vecSize * vecSize), result, func,
+                   s + " (Double_v)");
+#endif
+   return iret;
+}
+
+#ifdef R__HAS_VECCORE
+#define TEST_FUNCTION(x, name, ...)                                                                   \
+   testFunction(x, [&](unsigned int n, const double *xx, double *r) { ROOT::Math::name(n, xx, r, ##__VA_ARGS__); }, \
+                [&](const ROOT::Double_v &xv) { return ROOT::Math::name(xv, ##__VA_ARGS__); },                     \
+                [&](double xs) { return ROOT::Math::name(xs, ##__VA_ARGS__); }, #name)
+#else
+#define TEST_FUNCTION(x, name, ...)                                                                   \
+   testFunction(x, [&](unsigned int n, const double *xx, double *r) { ROOT::Math::name(n, xx, r, ##__VA_ARGS__); }, \
+                [&](double xs) { return ROOT::Math::name(xs, ##__VA_ARGS__); }, #name)
+#endif
+
+int testSpecialFunctions()
+{
+   int iret = 0;
+   auto x = GetPoints(-10, 10, 1001, {0, 1, -1, 8, -8, 27, -27, 40, -40});
+   iret |= TEST_FUNCTION(x, erf);
+   iret |= TEST_FUNCTION(x, erfc);
+
+   auto xg = GetPoints(0, 20, 1001, {1, 2, 3, 13, 1000, 1.E-10, 1.E9, 1.E300, 0, -0.5, -2, -40.5,
+                                    std::numeric_limits<double>::infinity()});
+   for (double xi : {30., 123.4, 999.9, 5.E7})
+      xg.push_back(xi);
+   iret |= TEST_FUNCTION(xg, lgamma);
+   return iret;
+}
+
+int testPdf()
+{
+   int iret = 0;
+   auto x = GetPoints(-10, 10, 1001, {0, 1, 2});
+   auto xp = GetPoints(0, 50, 1001, {0, 1, 2});
+   iret |= TEST_FUNCTION(x, breitwigner_pdf, 1.5, 0.2);
+   iret |= TEST_FUNCTION(x, cauchy_pdf, 0.7, -0.3);
+   iret |= TEST_FUNCTION(xp, chisquared_pdf, 5.);
+   iret |= TEST_FUNCTION(xp, chisquared_pdf, 2., 1.);
+   iret |= TEST_FUNCTION(x, exponential_pdf, 0.3, -1.);
+   iret |= TEST_FUNCTION(xp, gamma_pdf, 2.5, 1.5);
+   iret |= TEST_FUNCTION(xp, gamma_pdf, 1., 2., 1.);
+   iret |= TEST_FUNCTION(x, gaussian_pdf, 2., 1.);
+   iret |= TEST_FUNCTION(xp, lognormal_pdf, 1., 0.5);
+   iret |= TEST_FUNCTION(x, normal_pdf, 0.5);
+
+   // Poisson probabilities for counts and means spanning the range of lgamma
+   std::vector<unsigned int> k;
+   std::vector<double> mu;
+   for (unsigned int i = 0; i < 1000; ++i) {
+      k.push_back(i % 50 + (i / 50) * (i / 50) * (i / 50));
+      mu.push_back(0.1 * i + (i % 7 == 0 ? 0 : 0.5));
+   }
+   std::vector<double> result(k.size());
+   ROOT::Math::poisson_pdf(k.size(), k.data(), mu.data(), result.data());
+   for (unsigned int i = 0; i < k.size(); ++i) {
+      double ref = ROOT::Math::poisson_pdf(k[i], mu[i]);
+      if (std::abs(result[i] - ref) > kTolerance * ref) {
+         std::cerr << "poisson_pdf(" << k[i] << "," << mu[i] << ") = " << result[i] << " it should be " << ref
+                   << std::endl;
+         iret = -1;
+         break;
+      }
+   }
+   return iret;
+}
+
+int testCdf()
+{
+   int iret = 0;
+   auto x = GetPoints(-40, 40, 2001, {0, 1, -1, 1.41421356237309515, -1.41421356237309515});
+   auto xp = GetPoints(0, 50, 1001, {0, 1, 2});
+   iret |= TEST_FUNCTION(x, exponential_cdf, 2., 1.);
+   iret |= TEST_FUNCTION(x, exponential_cdf_c, 0.5);
+   iret |= TEST_FUNCTION(x, gaussian_cdf, 2., 1.);
+   iret |= TEST_FUNCTION(x, gaussian_cdf_c, 2., 1.);
+   iret |= TEST_FUNCTION(xp, lognormal_cdf, 1., 0.5);
+   iret |= TEST_FUNCTION(xp, lognormal_cdf_c, 1., 0.5);
+   iret |= TEST_FUNCTION(x, normal_cdf);
+   iret |= TEST_FUNCTION(x, normal_cdf_c);
+   return iret;
+}
+
+int testQuantiles()
+{
+   int iret = 0;
+   auto z = GetPoints(0, 1, 2001, {0, 1, 1.E-300, 1.E-20, 1.E-10, 1 - 1.E-10, 0.13533528323661269189,
+                                   1 - 0.13533528323661269189});
+   iret |= TEST_FUNCTION(z, exponential_quantile, 2.);
+   iret |= TEST_FUNCTION(z, exponential_quantile_c, 2.);
+   iret |= TEST_FUNCTION(z, gaussian_quantile, 2.);
+   iret |= TEST_FUNCTION(z, gaussian_quantile_c, 2.);
+   iret |= TEST_FUNCTION(z, lognormal_quantile, 1., 0.5);
+   iret |= TEST_FUNCTION(z, lognormal_quantile_c, 1., 0.5);
+   iret |= TEST_FUNCTION(z, normal_quantile, 1.);
+   iret |= TEST_FUNCTION(z, normal_quantile_c, 1.);
+   return iret;
+}
+
+int main()
+{
+   int iret = 0;
+   iret |= testSpecialFunctions();
+   iret |= testPdf();
+   iret |= testCdf();
+   iret |= testQuantiles();
+   if (iret != 0) std::cerr << "testVecFuncMathCore: FAILED" << std::endl;
+   return iret;
+}
@@ -26,6 +26,13 @@
 
 #include "TDecompChol.h"
 #include "TMath.h"
+#include "TMatrixTParallel.h"
+
+namespace {
+   // number of rows computed together and number of columns updated together in Decompose
+   const Int_t kBlockRows = 32;
+   const Int_t kBlockCols = 256;
+}
 
 ClassImp(TDecompChol)
 
@@ -102,6 +109,11 @@ TDecompChol::TDecompChol(const TDecompChol &another) : TDecompBase(another)
 ////////////////////////////////////////////////////////////////////////////////
 /// Matrix A is decomposed in component U so that A = U^T * U
 /// If the decomposition succeeds, bit kDecomposed is set , otherwise kSingular
+///
+/// The rows of U are computed in blocks: the terms of the rows above a block are
+/// subtracted from all its rows at once, in parallel on ranges of columns when the
+/// implicit multi-threading is enabled. The terms of each element are subtracted
+/// in the same order as in the row by row algorithm.
 
 Bool_t TDecompChol::Decompose()
 {
@@ -112,34 +124,63 @@ Bool_t TDecompChol::Decompose()
       return kFALSE;
    }
 
-   Int_t i,j,icol,irow;
+   Int_t icol,irow;
    const Int_t     n  = fU.GetNrows();
          Double_t *pU = fU.GetMatrixArray();
-   for (icol = 0; icol < n; icol++) {
-      const Int_t rowOff = icol*n;
-
-      //Compute fU(j,j) and test for non-positive-definiteness.
-      Double_t ujj = pU[rowOff+icol];
-      for (irow = 0; irow < icol; irow++) {
-         const Int_t pos_ij = irow*n+icol;
-         ujj -= pU[pos_ij]*pU[pos_ij];
-      }
-      if (ujj <= 0) {
-         Error("Decompose()","matrix not positive definite");
-         return kFALSE;
-      }
-      ujj = TMath::Sqrt(ujj);
-      pU[rowOff+icol] = ujj;
-
-      if (icol < n-1) {
-         for (j = icol+1; j < n; j++) {
-            for (i = 0; i < icol; i++) {
-               const Int_t rowOff2 = i*n;
-               pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
+   for (Int_t icol0 = 0; icol0 < n; icol0 += kBlockRows) {
+      const Int_t icol1 = TMath::Min(icol0+kBlockRows,n);
+
+      // Subtract from the rows icol0,...,icol1-1 the terms of the rows above them
+      if (icol0 > 0) {
+         auto updateBlock = [&](Int_t first,Int_t last) {
+            for (Int_t j0 = icol0+1+first; j0 < icol0+1+last; j0 += kBlockCols) {
+               const Int_t j1 = TMath::Min(j0+kBlockCols,icol0+1+last);
+               for (Int_t i = 0; i < icol0; i++) {
+                  const Int_t rowOff2 = i*n;
+                  for (Int_t r = icol0; r < icol1; r++) {
+                     const Int_t rowOff = r*n;
+                     const Double_t uir = pU[rowOff2+r];
+                     for (Int_t j = TMath::Max(j0,r+1); j < j1; j++)
+                        pU[rowOff+j] -= pU[rowOff2+j]*uir;
+                  }
+               }
             }
+         };
+         TMatrixTParallel::ForEachRange(n-icol0-1,Double_t(icol0)*(icol1-icol0),updateBlock);
+      }
+
+      for (icol = icol0; icol < icol1; icol++) {
+         const Int_t rowOff = icol*n;
+
+         //Compute fU(j,j) and test for non-positive-definiteness.
+         Double_t ujj = pU[rowOff+icol];
+         for (irow = 0; irow < icol; irow++) {
+            const Int_t pos_ij = irow*n+icol;
+            ujj -= pU[pos_ij]*pU[pos_ij];
+         }
+         if (ujj <= 0) {
+            Error("Decompose()","matrix not positive definite");
+            return kFALSE;
+         }
+         ujj = TMath::Sqrt(ujj);
+         pU[rowOff+icol] = ujj;
+
+         // Subtract the terms of the rows of the block above icol and normalize
+         if (icol < n-1) {
+            auto updateRow = [&](Int_t first,Int_t last) {
+               const Int_t j0 = icol+1+first;
+               const Int_t j1 = icol+1+last;
+               for (Int_t i = icol0; i < icol; i++) {
+                  const Int_t rowOff2 = i*n;
+                  const Double_t uicol = pU[rowOff2+icol];
+                  for (Int_t j = j0; j < j1; j++)
+                     pU[rowOff+j] -= pU[rowOff2+j]*uicol;
+               }
+               for (Int_t j = j0; j < j1; j++)
+                  pU[rowOff+j] /= ujj;
+            };
+            TMatrixTParallel::ForEachRange(n-icol-1,icol-icol0+1,updateRow);
          }
-         for (j = icol+1; j < n; j++)
-            pU[rowOff+j] /= ujj;
       }
    }
 
@@ -337,6 +378,10 @@ void TDecompChol::Det(Double_t &d1,Double_t &d2)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// For a symmetric matrix A(m,m), its inverse A_inv(m,m) is returned .
+///
+/// The columns of the unit matrix are solved together, with the same operations as
+/// in Solve, and in parallel on ranges of columns when the implicit multi-threading
+/// is enabled.
 
 Bool_t TDecompChol::Invert(TMatrixDSym &inv)
 {
@@ -347,15 +392,62 @@ Bool_t TDecompChol::Invert(TMatrixDSym &inv)
 
    inv.UnitMatrix();
 
-   const Int_t colLwb = inv.GetColLwb();
-   const Int_t colUpb = inv.GetColUpb();
-   Bool_t status = kTRUE;
-   for (Int_t icol = colLwb; icol <= colUpb && status; icol++) {
-      TMatrixDColumn b(inv,icol);
-      status &= Solve(b);
+   if (TestBit(kSingular)) {
+      Error("Invert()","Matrix is singular");
+      return kFALSE;
+   }
+   if ( !TestBit(kDecomposed) ) {
+      if (!Decompose()) {
+         Error("Invert()","Decomposition failed");
+         return kFALSE;
+      }
+   }
+
+   const Int_t n = fU.GetNrows();
+   const Double_t *pU = fU.GetMatrixArray();
+         Double_t *pI = inv.GetMatrixArray();
+
+   for (Int_t i = 0; i < n; i++) {
+      const Int_t off_i = i*n;
+      if (pU[off_i+i] < fTol) {
+         Error("Invert(TMatrixDSym &","u[%d,%d]=%.4e < %.4e",i,i,pU[off_i+i],fTol);
+         return kFALSE;
+      }
    }
 
-   return status;
+   auto solveColumns = [&](Int_t first,Int_t last) {
+      Int_t i;
+      // step 1: Forward substitution on U^T
+      for (i = 0; i < n; i++) {
+         const Int_t off_i = i*n;
+         for (Int_t j = 0; j < i; j++) {
+            const Int_t off_j = j*n;
+            const Double_t uji = pU[off_j+i];
+            for (Int_t icol = first; icol < last; icol++)
+               pI[off_i+icol] -= uji*pI[off_j+icol];
+         }
+         const Double_t uii = pU[off_i+i];
+         for (Int_t icol = first; icol < last; icol++)
+            pI[off_i+icol] /= uii;
+      }
+
+      // step 2: Backward substitution on U
+      for (i = n-1; i >= 0; i--) {
+         const Int_t off_i = i*n;
+         for (Int_t j = i+1; j < n; j++) {
+            const Int_t off_j = j*n;
+            const Double_t uij = pU[off_i+j];
+            for (Int_t icol = first; icol < last; icol++)
+               pI[off_i+icol] -= uij*pI[off_j+icol];
+         }
+         const Double_t uii = pU[off_i+i];
+         for (Int_t icol = first; icol < last; icol++)
+            pI[off_i+icol] /= uii;
+      }
+   };
+   TMatrixTParallel::ForEachRange(n,Double_t(n)*n,solveColumns);
+
+   return kTRUE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -11,6 +11,14 @@
 
 #include "TDecompLU.h"
 #include "TMath.h"
+#include "TMatrixTParallel.h"
+
+namespace {
+   // number of columns processed together in DecomposeLUCrout and InvertLU,
+   // and number of columns updated together in DecomposeLUCrout
+   const Int_t kBlockLU   = 32;
+   const Int_t kBlockCols = 256;
+}
 
 ClassImp(TDecompLU)
 
@@ -595,6 +603,11 @@ TDecompLU &TDecompLU::operator=(const TDecompLU &source)
 /// and L is in multiplier form in the subdiagionals .
 /// Row permutations are mapped out in fIndex. fSign, used for calculating the
 /// determinant, is +/- 1 for even/odd row permutations. .
+///
+/// The columns are processed in blocks: before a block, the rows of U above it are
+/// completed and their terms are subtracted from the rows below, in parallel when
+/// the implicit multi-threading is enabled. The elements are computed with the same
+/// operations, in the same order, as in the column by column algorithm.
 
 Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
                                    Double_t tol,Int_t &nrZeros)
@@ -610,6 +623,11 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
       scale = new Double_t[n];
    }
 
+   // transposed block of U used to update the rows below a block of columns
+   Double_t *pUt = 0;
+   if (n > kBlockLU)
+      pUt = new Double_t[kBlockLU*n];
+
    sign    = 1.0;
    nrZeros = 0;
    // Find implicit scaling factors for each row
@@ -624,74 +642,142 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
       scale[i] = (max == 0.0 ? 0.0 : 1.0/max);
    }
 
-   for (Int_t j = 0; j < n; j++) {
-      const Int_t off_j = j*n;
-      // Run down jth column from top to diag, to form the elements of U.
-      for (Int_t i = 0; i < j; i++) {
-         const Int_t off_i = i*n;
-         Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < i; k++) {
+   for (Int_t j0 = 0; j0 < n; j0 += kBlockLU) {
+      const Int_t j1 = TMath::Min(j0+kBlockLU,n);
+
+      if (j0 > 0) {
+         // Form the rows i0,...,j0-1 of U in the columns j0,...,n-1
+         const Int_t i0 = j0-kBlockLU;
+         auto formRowsU = [&](Int_t first,Int_t last) {
+            for (Int_t c0 = j0+first; c0 < j0+last; c0 += kBlockCols) {
+               const Int_t c1 = TMath::Min(c0+kBlockCols,j0+last);
+               for (Int_t k = 0; k < j0-1; k++) {
+                  const Int_t off_k = k*n;
+                  for (Int_t i = TMath::Max(i0,k+1); i < j0; i++) {
+                     const Int_t off_i = i*n;
+                     const Double_t lik = pLU[off_i+k];
+                     for (Int_t c = c0; c < c1; c++)
+                        pLU[off_i+c] -= lik*pLU[off_k+c];
+                  }
+               }
+            }
+         };
+         TMatrixTParallel::ForEachRange(n-j0,Double_t(j0)*kBlockLU,formRowsU);
+
+         // Subtract from the rows j0,...,n-1 of the columns j0,...,j1-1 the terms
+         // of the rows 0,...,j0-1 of U
+         const Int_t nc = j1-j0;
+         for (Int_t k = 0; k < j0; k++) {
             const Int_t off_k = k*n;
-            r -= pLU[off_i+k]*pLU[off_k+j];
+            for (Int_t c = 0; c < nc; c++)
+               pUt[c*j0+k] = pLU[off_k+j0+c];
          }
-         pLU[off_i+j] = r;
+         auto updateRows = [&](Int_t first,Int_t last) {
+            for (Int_t i = j0+first; i < j0+last; i++) {
+               Double_t *pi = pLU+i*n;
+               Int_t c = 0;
+               for (; c+3 < nc; c += 4) {
+                  const Double_t *pu = pUt+c*j0;
+                  Double_t r0 = pi[j0+c];
+                  Double_t r1 = pi[j0+c+1];
+                  Double_t r2 = pi[j0+c+2];
+                  Double_t r3 = pi[j0+c+3];
+                  for (Int_t k = 0; k < j0; k++) {
+                     const Double_t lik = pi[k];
+                     r0 -= lik*pu[k];
+                     r1 -= lik*pu[j0+k];
+                     r2 -= lik*pu[2*j0+k];
+                     r3 -= lik*pu[3*j0+k];
+                  }
+                  pi[j0+c]   = r0;
+                  pi[j0+c+1] = r1;
+                  pi[j0+c+2] = r2;
+                  pi[j0+c+3] = r3;
+               }
+               for (; c < nc; c++) {
+                  const Double_t *pu = pUt+c*j0;
+                  Double_t r = pi[j0+c];
+                  for (Int_t k = 0; k < j0; k++)
+                     r -= pi[k]*pu[k];
+                  pi[j0+c] = r;
+               }
+            }
+         };
+         TMatrixTParallel::ForEachRange(n-j0,Double_t(j0)*nc,updateRows);
       }
 
-      // Run down jth subdiag to form the residuals after the elimination of
-      // the first j-1 subdiags.  These residuals divided by the appropriate
-      // diagonal term will become the multipliers in the elimination of the jth.
-      // subdiag. Find fIndex of largest scaled term in imax.
-
-      Double_t max = 0.0;
-      Int_t imax = 0;
-      for (Int_t i = j; i < n; i++) {
-         const Int_t off_i = i*n;
-         Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < j; k++) {
-            const Int_t off_k = k*n;
-            r -= pLU[off_i+k]*pLU[off_k+j];
-         }
-         pLU[off_i+j] = r;
-         const Double_t tmp = scale[i]*TMath::Abs(r);
-         if (tmp >= max) {
-            max = tmp;
-            imax = i;
+      for (Int_t j = j0; j < j1; j++) {
+         const Int_t off_j = j*n;
+         // Run down jth column from top to diag, to form the elements of U.
+         for (Int_t i = j0; i < j; i++) {
+            const Int_t off_i = i*n;
+            Double_t r = pLU[off_i+j];
+            for (Int_t k = j0; k < i; k++) {
+               const Int_t off_k = k*n;
+               r -= pLU[off_i+k]*pLU[off_k+j];
+            }
+            pLU[off_i+j] = r;
          }
-      }
 
-      // Permute current row with imax
-      if (j != imax) {
-         const Int_t off_imax = imax*n;
-         for (Int_t k = 0; k < n; k++ ) {
-            const Double_t tmp = pLU[off_imax+k];
-            pLU[off_imax+k] = pLU[off_j+k];
-            pLU[off_j+k]    = tmp;
+         // Run down jth subdiag to form the residuals after the elimination of
+         // the first j-1 subdiags.  These residuals divided by the appropriate
+         // diagonal term will become the multipliers in the elimination of the jth.
+         // subdiag. Find fIndex of largest scaled term in imax.
+
+         Double_t max = 0.0;
+         Int_t imax = 0;
+         for (Int_t i = j; i < n; i++) {
+            const Int_t off_i = i*n;
+            Double_t r = pLU[off_i+j];
+            for (Int_t k = j0; k < j; k++) {
+               const Int_t off_k = k*n;
+               r -= pLU[off_i+k]*pLU[off_k+j];
+            }
+            pLU[off_i+j] = r;
+            const Double_t tmp = scale[i]*TMath::Abs(r);
+            if (tmp >= max) {
+               max = tmp;
+               imax = i;
+            }
          }
-         sign = -sign;
-         scale[imax] = scale[j];
-      }
-      index[j] = imax;
 
-      // If diag term is not zero divide subdiag to form multipliers.
-      if (pLU[off_j+j] != 0.0) {
-         if (TMath::Abs(pLU[off_j+j]) < tol)
-            nrZeros++;
-         if (j != n-1) {
-            const Double_t tmp = 1.0/pLU[off_j+j];
-            for (Int_t i = j+1; i < n; i++) {
-               const Int_t off_i = i*n;
-               pLU[off_i+j] *= tmp;
+         // Permute current row with imax
+         if (j != imax) {
+            const Int_t off_imax = imax*n;
+            for (Int_t k = 0; k < n; k++ ) {
+               const Double_t tmp = pLU[off_imax+k];
+               pLU[off_imax+k] = pLU[off_j+k];
+               pLU[off_j+k]    = tmp;
             }
+            sign = -sign;
+            scale[imax] = scale[j];
+         }
+         index[j] = imax;
+
+         // If diag term is not zero divide subdiag to form multipliers.
+         if (pLU[off_j+j] != 0.0) {
+            if (TMath::Abs(pLU[off_j+j]) < tol)
+               nrZeros++;
+            if (j != n-1) {
+               const Double_t tmp = 1.0/pLU[off_j+j];
+               for (Int_t i = j+1; i < n; i++) {
+                  const Int_t off_i = i*n;
+                  pLU[off_i+j] *= tmp;
+               }
+            }
+         } else {
+            ::Error("TDecompLU::DecomposeLUCrout","matrix is singular");
+            if (isAllocated)  delete [] scale;
+            if (pUt) delete [] pUt;
+            return kFALSE;
          }
-      } else {
-         ::Error("TDecompLU::DecomposeLUCrout","matrix is singular");
-         if (isAllocated)  delete [] scale;
-         return kFALSE;
       }
    }
 
    if (isAllocated)
       delete [] scale;
+   if (pUt)
+      delete [] pUt;
 
    return kTRUE;
 }
@@ -771,6 +857,9 @@ Bool_t TDecompLU::DecomposeLUGauss(TMatrixD &lu,Int_t *index,Double_t &sign,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate matrix inversion through in place forward/backward substitution
+///
+/// The rows of the inverse are independent in each step, they are computed for blocks
+/// of columns at once and in parallel when the implicit multi-threading is enabled.
 
 Bool_t TDecompLU::InvertLU(TMatrixD &lu,Double_t tol,Double_t *det)
 {
@@ -811,89 +900,104 @@ Bool_t TDecompLU::InvertLU(TMatrixD &lu,Double_t tol,Double_t *det)
       *det = d1*TMath::Power(2.0,d2);
    }
 
+   // Work space for a block of columns
+   Double_t workd[kWorkMax];
+   Bool_t isAllocatedD = kFALSE;
+   Double_t *pWorkd = workd;
+   if (kBlockLU*n > kWorkMax) {
+      isAllocatedD = kTRUE;
+      pWorkd = new Double_t[kBlockLU*n];
+   }
+
    //  Form inv(U).
 
    Int_t j;
 
-   for (j = 0; j < n; j++) {
-      const Int_t off_j = j*n;
+   for (Int_t j0 = 0; j0 < n; j0 += kBlockLU) {
+      const Int_t j1 = TMath::Min(j0+kBlockLU,n);
 
-      pLU[off_j+j] = 1./pLU[off_j+j];
-      const Double_t mLU_jj = -pLU[off_j+j];
+      // Copy the elements 0:j-1 of the columns of U, and invert the diagonal terms
+      Double_t mLU_jj[kBlockLU];
+      for (j = j0; j < j1; j++) {
+         const Int_t off_j = j*n;
+         Double_t *pX = pWorkd+(j-j0)*n;
+         for (Int_t k = 0; k <= j-1; k++)
+            pX[k] = pLU[k*n+j];
+         pLU[off_j+j] = 1./pLU[off_j+j];
+         mLU_jj[j-j0] = -pLU[off_j+j];
+      }
 
-//    Compute elements 0:j-1 of j-th column.
+//    Compute elements 0:j-1 of j-th column, row by row.
 
-      Double_t *pX = pLU+j;
-      Int_t k;
-      for (k = 0; k <= j-1; k++) {
-         const Int_t off_k = k*n;
-         if ( pX[off_k] != 0.0 ) {
-            const Double_t tmp = pX[off_k];
-            for (Int_t i = 0; i <= k-1; i++) {
-               const Int_t off_i = i*n;
-               pX[off_i] += tmp*pLU[off_i+k];
+      auto formRows = [&](Int_t first,Int_t last) {
+         for (Int_t i = first; i < last; i++) {
+            const Int_t off_i = i*n;
+            for (Int_t jj = TMath::Max(j0,i+1); jj < j1; jj++) {
+               const Double_t *pX = pWorkd+(jj-j0)*n;
+               Double_t r = pX[i];
+               if (r != 0.0)
+                  r *= pLU[off_i+i];
+               for (Int_t k = i+1; k <= jj-1; k++) {
+                  if (pX[k] != 0.0)
+                     r += pX[k]*pLU[off_i+k];
+               }
+               pLU[off_i+jj] = r*mLU_jj[jj-j0];
             }
-            pX[off_k] *= pLU[off_k+k];
          }
-      }
-      for (k = 0; k <= j-1; k++) {
-         const Int_t off_k = k*n;
-         pX[off_k] *= mLU_jj;
-      }
+      };
+      TMatrixTParallel::ForEachRange(j1-1,Double_t(j1)*kBlockLU/2,formRows);
    }
 
    // Solve the equation inv(A)*L = inv(U) for inv(A).
 
-   Double_t workd[kWorkMax];
-   Bool_t isAllocatedD = kFALSE;
-   Double_t *pWorkd = workd;
-   if (n > kWorkMax) {
-      isAllocatedD = kTRUE;
-      pWorkd = new Double_t[n];
-   }
-
-   for (j = n-1; j >= 0; j--) {
+   for (Int_t j1 = n; j1 > 0; j1 -= kBlockLU) {
+      const Int_t j0 = TMath::Max(j1-kBlockLU,0);
 
-      // Copy current column j of L to WORK and replace with zeros.
-      for (Int_t i = j+1; i < n; i++) {
-         const Int_t off_i = i*n;
-         pWorkd[i] = pLU[off_i+j];
-         pLU[off_i+j] = 0.0;
+      // Copy current columns j of L to WORK and replace with zeros.
+      for (j = j0; j < j1; j++) {
+         Double_t *pL = pWorkd+(j-j0)*n;
+         for (Int_t i = j+1; i < n; i++) {
+            const Int_t off_i = i*n;
+            pL[i] = pLU[off_i+j];
+            pLU[off_i+j] = 0.0;
+         }
       }
 
-      // Compute current column of inv(A).
-
-      if (j < n-1) {
-         const Double_t *mp = pLU+j+1;  // Matrix row ptr
-         Double_t *tp = pLU+j;          // Target vector ptr
-
-         for (Int_t irow = 0; irow < n; irow++) {
-            Double_t sum = 0.;
-            const Double_t *sp = pWorkd+j+1; // Source vector ptr
-            for (Int_t icol = 0; icol < n-1-j ; icol++)
-               sum += *mp++ * *sp++;
-            *tp = -sum + *tp;
-            mp += j+1;
-            tp += n;
+      // Compute current columns of inv(A), row by row.
+
+      auto solveRows = [&](Int_t first,Int_t last) {
+         for (Int_t irow = first; irow < last; irow++) {
+            Double_t *pRow = pLU+irow*n;
+            for (Int_t jj = TMath::Min(j1,n-1)-1; jj >= j0; jj--) {
+               const Double_t *pL = pWorkd+(jj-j0)*n;
+               Double_t sum = 0.;
+               for (Int_t icol = jj+1; icol < n; icol++)
+                  sum += pRow[icol]*pL[icol];
+               pRow[jj] = -sum + pRow[jj];
+            }
          }
-      }
+      };
+      TMatrixTParallel::ForEachRange(n,Double_t(n-j0)*(j1-j0),solveRows);
    }
 
    if (isAllocatedD)
       delete [] pWorkd;
 
    // Apply column interchanges.
-   for (j = n-1; j >= 0; j--) {
-      const Int_t jperm = index[j];
-      if (jperm != j) {
-         for (Int_t i = 0; i < n; i++) {
-            const Int_t off_i = i*n;
-            const Double_t tmp = pLU[off_i+jperm];
-            pLU[off_i+jperm] = pLU[off_i+j];
-            pLU[off_i+j]     = tmp;
+   auto permuteRows = [&](Int_t first,Int_t last) {
+      for (Int_t i = first; i < last; i++) {
+         const Int_t off_i = i*n;
+         for (Int_t jj = n-1; jj >= 0; jj--) {
+            const Int_t jperm = index[jj];
+            if (jperm != jj) {
+               const Double_t tmp = pLU[off_i+jperm];
+               pLU[off_i+jperm] = pLU[off_i+jj];
+               pLU[off_i+jj]    = tmp;
+            }
          }
       }
-   }
+   };
+   TMatrixTParallel::ForEachRange(n,n,permuteRows);
 
    if (isAllocatedI)
       delete [] index;
@@ -29,6 +29,9 @@
 #include "TMatrixDEigen.h"
 #include "TClass.h"
 #include "TMath.h"
+#include "TMatrixTParallel.h"
+
+#include <algorithm>
 
 templateClassImp(TMatrixT)
 
@@ -3070,74 +3073,131 @@ TMatrixT<Element> &ElementDiv(TMatrixT<Element> &target,const TMatrixTSym<Elemen
    return target;
 }
 
+namespace {
+   // sizes of the blocks of the multiplication kernels, chosen for the blocks of B to stay in the cache
+   const Int_t kBlockRows = 64;
+   const Int_t kBlockCols = 256;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B
+///
+/// The product is computed in blocks of B, accumulating the terms a(i,k)*b(k,j)
+/// of each element in the order of k, so that the result is the same as for the
+/// plain row by column product. The rows of C are computed in parallel when the
+/// implicit multi-threading is enabled.
 
 template<class Element>
 void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *arp0 = ap;                     // Pointer to  A[i,0];
-   while (arp0 < ap+na) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *arp = arp0;                       // Pointer to the i-th row of A, reset to A[i,0]
-         Element cij = 0;
-         while (bcp < bp+nb) {                     // Scan the i-th row of A and
-            cij += *arp++ * *bcp;                   // the j-th col of B
-            bcp += ncolsb;
+   if (na == 0 || nb == 0) return;
+   const Int_t nrowsa = na/ncolsa;
+   auto multRows = [&](Int_t first,Int_t last) {
+      std::fill(cp+first*ncolsb,cp+last*ncolsb,Element(0));
+      for (Int_t j0 = 0; j0 < ncolsb; j0 += kBlockCols) {
+         const Int_t j1 = TMath::Min(j0+kBlockCols,ncolsb);
+         for (Int_t k0 = 0; k0 < ncolsa; k0 += kBlockRows) {
+            const Int_t k1 = TMath::Min(k0+kBlockRows,ncolsa);
+            for (Int_t i = first; i < last; i++) {
+               const Element *arp = ap+i*ncolsa;          // Pointer to the i-th row of A
+                     Element *crp = cp+i*ncolsb;          // Pointer to the i-th row of C
+               for (Int_t k = k0; k < k1; k++) {
+                  const Element aik = arp[k];
+                  const Element *brp = bp+k*ncolsb;       // Pointer to the k-th row of B
+                  for (Int_t j = j0; j < j1; j++)
+                     crp[j] += aik * brp[j];
+               }
+            }
          }
-         *cp++ = cij;
-         bcp -= nb-1;                              // Set bcp to the (j+1)-th col
       }
-      arp0 += ncolsa;                             // Set ap to the (i+1)-th row
-   }
+   };
+   TMatrixTParallel::ForEachRange(nrowsa,Double_t(ncolsa)*ncolsb,multRows);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A^T*B
+///
+/// Same blocked algorithm as AMultB, the element c(i,j) is the sum of the terms
+/// a(k,i)*b(k,j) in the order of k.
 
 template<class Element>
 void AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *acp0 = ap;           // Pointer to  A[i,0];
-   while (acp0 < ap+ncolsa) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *acp = acp0;                       // Pointer to the i-th column of A, reset to A[0,i]
-         Element cij = 0;
-         while (bcp < bp+nb) {           // Scan the i-th column of A and
-            cij += *acp * *bcp;           // the j-th col of B
-            acp += ncolsa;
-            bcp += ncolsb;
+   if (ncolsa == 0 || ncolsb == 0) return;
+   const Int_t nrowsb = nb/ncolsb;
+   auto multRows = [&](Int_t first,Int_t last) {
+      std::fill(cp+first*ncolsb,cp+last*ncolsb,Element(0));
+      for (Int_t j0 = 0; j0 < ncolsb; j0 += kBlockCols) {
+         const Int_t j1 = TMath::Min(j0+kBlockCols,ncolsb);
+         for (Int_t k0 = 0; k0 < nrowsb; k0 += kBlockRows) {
+            const Int_t k1 = TMath::Min(k0+kBlockRows,nrowsb);
+            for (Int_t i = first; i < last; i++) {
+               Element *crp = cp+i*ncolsb;                // Pointer to the i-th row of C
+               for (Int_t k = k0; k < k1; k++) {
+                  const Element aki = ap[k*ncolsa+i];
+                  const Element *brp = bp+k*ncolsb;       // Pointer to the k-th row of B
+                  for (Int_t j = j0; j < j1; j++)
+                     crp[j] += aki * brp[j];
+               }
+            }
          }
-         *cp++ = cij;
-         bcp -= nb-1;                    // Set bcp to the (j+1)-th col
       }
-      acp0++;                           // Set acp0 to the (i+1)-th col
-   }
+   };
+   TMatrixTParallel::ForEachRange(ncolsa,Double_t(nrowsb)*ncolsb,multRows);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B^T
+///
+/// The scalar products of the rows of A and B are computed in blocks of B,
+/// four at a time, keeping the order of the terms of each product.
 
 template<class Element>
 void AMultBt(const Element * const ap,Int_t na,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *arp0 = ap;                    // Pointer to  A[i,0];
-   while (arp0 < ap+na) {
-      const Element *brp0 = bp;                  // Pointer to  B[j,0];
-      while (brp0 < bp+nb) {
-         const Element *arp = arp0;               // Pointer to the i-th row of A, reset to A[i,0]
-         const Element *brp = brp0;               // Pointer to the j-th row of B, reset to B[j,0]
-         Element cij = 0;
-         while (brp < brp0+ncolsb)                 // Scan the i-th row of A and
-            cij += *arp++ * *brp++;                 // the j-th row of B
-         *cp++ = cij;
-         brp0 += ncolsb;                           // Set brp0 to the (j+1)-th row
+   if (na == 0 || nb == 0) return;
+   const Int_t nrowsa = na/ncolsa;
+   const Int_t nrowsb = nb/ncolsb;
+   auto multRows = [&](Int_t first,Int_t last) {
+      std::fill(cp+first*nrowsb,cp+last*nrowsb,Element(0));
+      for (Int_t j0 = 0; j0 < nrowsb; j0 += kBlockRows) {
+         const Int_t j1 = TMath::Min(j0+kBlockRows,nrowsb);
+         for (Int_t k0 = 0; k0 < ncolsb; k0 += kBlockCols) {
+            const Int_t k1 = TMath::Min(k0+kBlockCols,ncolsb);
+            for (Int_t i = first; i < last; i++) {
+               const Element *arp = ap+i*ncolsa;          // Pointer to the i-th row of A
+                     Element *crp = cp+i*nrowsb;          // Pointer to the i-th row of C
+               Int_t j = j0;
+               for (; j+4 <= j1; j += 4) {
+                  const Element *brp0 = bp+j*ncolsb;      // Pointers to the rows j,...,j+3 of B
+                  const Element *brp1 = brp0+ncolsb;
+                  const Element *brp2 = brp1+ncolsb;
+                  const Element *brp3 = brp2+ncolsb;
+                  Element c0 = crp[j], c1 = crp[j+1], c2 = crp[j+2], c3 = crp[j+3];
+                  for (Int_t k = k0; k < k1; k++) {
+                     const Element aik = arp[k];
+                     c0 += aik * brp0[k];
+                     c1 += aik * brp1[k];
+                     c2 += aik * brp2[k];
+                     c3 += aik * brp3[k];
+                  }
+                  crp[j] = c0; crp[j+1] = c1; crp[j+2] = c2; crp[j+3] = c3;
+               }
+               for (; j < j1; j++) {
+                  const Element *brp = bp+j*ncolsb;
+                  Element cij = crp[j];
+                  for (Int_t k = k0; k < k1; k++)
+                     cij += arp[k] * brp[k];
+                  crp[j] = cij;
+               }
+            }
+         }
       }
-      arp0 += ncolsa;                             // Set arp0 to the (i+1)-th row
-   }
+   };
+   TMatrixTParallel::ForEachRange(nrowsa,Double_t(ncolsa)*nrowsb,multRows);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
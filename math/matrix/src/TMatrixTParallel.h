@@ -0,0 +1,75 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMatrixTParallel
+#define ROOT_TMatrixTParallel
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMatrixTParallel                                                     //
+//                                                                      //
+// Private helper of the dense matrix kernels (multiplications and      //
+// decompositions) to split their independent rows or columns in ranges //
+// executed in parallel when the implicit multi-threading is enabled.   //
+//                                                                      //
+// The kernels compute every element with the same sequence of          //
+// operations whatever the ranges are, so that the results do not      //
+// depend on the number of threads and are identical to the serial     //
+// ones.                                                                //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "RConfigure.h"
+#include "Rtypes.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+#include <algorithm>
+
+namespace TMatrixTParallel {
+
+   // minimal number of multiply-adds of a parallel task
+   const Double_t kMinWorkPerTask = 50000;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Call func(first,last) on consecutive ranges covering [0,n), where the cost of
+   /// each index is about cost multiply-adds. The ranges are executed in parallel if
+   /// the implicit multi-threading is enabled and the total work is large enough,
+   /// otherwise func(0,n) is called.
+
+   template <class F>
+   void ForEachRange(Int_t n, Double_t cost, F func)
+   {
+#ifdef R__USE_IMT
+      if (n > 1 && ROOT::IsImplicitMTEnabled()) {
+         const Int_t maxTasks = std::min(n, Int_t(4 * ROOT::GetImplicitMTPoolSize()));
+         const Int_t nTasks = Int_t(std::min(Double_t(maxTasks), n * cost / kMinWorkPerTask));
+         if (nTasks > 1) {
+            auto task = [&](Int_t iTask) {
+               func(Int_t(Long64_t(n) * iTask / nTasks), Int_t(Long64_t(n) * (iTask + 1) / nTasks));
+            };
+            ROOT::TThreadExecutor pool;
+            pool.Foreach(task, ROOT::TSeq<Int_t>(0, nTasks));
+            return;
+         }
+      }
+#else
+      (void)cost;
+#endif
+      func(0, n);
+   }
+
+}
+
+#endif
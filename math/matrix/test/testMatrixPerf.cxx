@@ -0,0 +1,164 @@
+#include "TDecompChol.h"
+#include "TMatrixD.h"
+#include "TMatrixDSym.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+#include "TStopwatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// benchmark of the multiplications, of the Cholesky decomposition and of the inversions
+// of large dense matrices, serially and with the implicit multi-threading.
+// The results must be identical for any number of threads, and the products must be
+// identical to the ones of the plain row by column loops.
+
+struct Results {
+   TMatrixD fAB, fAtB, fABt, fCholU, fCholInv, fInv;
+};
+
+bool identical(const TMatrixD &m1, const TMatrixD &m2)
+{
+   return m1.GetNoElements() == m2.GetNoElements() &&
+          std::memcmp(m1.GetMatrixArray(), m2.GetMatrixArray(), m1.GetNoElements() * sizeof(Double_t)) == 0;
+}
+
+// plain row by column product
+TMatrixD multiply(const TMatrixD &a, const TMatrixD &b)
+{
+   TMatrixD c(a.GetNrows(), b.GetNcols());
+   for (Int_t i = 0; i < a.GetNrows(); i++) {
+      for (Int_t j = 0; j < b.GetNcols(); j++) {
+         Double_t cij = 0;
+         for (Int_t k = 0; k < a.GetNcols(); k++)
+            cij += a(i, k) * b(k, j);
+         c(i, j) = cij;
+      }
+   }
+   return c;
+}
+
+Double_t distanceFromUnit(const TMatrixD &m)
+{
+   Double_t dist = 0;
+   for (Int_t i = 0; i < m.GetNrows(); i++)
+      for (Int_t j = 0; j < m.GetNcols(); j++)
+         dist = std::max(dist, std::abs(m(i, j) - (i == j ? 1. : 0.)));
+   return dist;
+}
+
+Results timeOperations(const TMatrixD &a, const TMatrixD &b, const TMatrixDSym &s, std::string title)
+{
+   Results r;
+   double times[6];
+   TStopwatch w;
+
+   w.Start();
+   r.fAB.ResizeTo(a.GetNrows(), b.GetNcols());
+   r.fAB.Mult(a, b);
+   times[0] = w.RealTime();
+
+   w.Start();
+   r.fAtB.ResizeTo(a.GetNcols(), b.GetNcols());
+   r.fAtB.TMult(a, b);
+   times[1] = w.RealTime();
+
+   w.Start();
+   r.fABt.ResizeTo(a.GetNrows(), a.GetNrows());
+   r.fABt.MultT(a, a);
+   times[2] = w.RealTime();
+
+   w.Start();
+   TDecompChol chol(s);
+   chol.Decompose();
+   times[3] = w.RealTime();
+   r.fCholU.ResizeTo(s.GetNrows(), s.GetNcols());
+   r.fCholU = chol.GetU();
+
+   w.Start();
+   TMatrixDSym cholInv(s.GetNrows());
+   chol.Invert(cholInv);
+   times[4] = w.RealTime();
+   r.fCholInv.ResizeTo(s.GetNrows(), s.GetNcols());
+   r.fCholInv = cholInv;
+
+   w.Start();
+   r.fInv.ResizeTo(a);
+   r.fInv = a;
+   r.fInv.Invert();
+   times[5] = w.RealTime();
+
+   std::cout << "  " << title;
+   for (double t : times)
+      std::cout << "\t" << 1000. * t;
+   std::cout << std::endl;
+   return r;
+}
+
+int compare(const Results &r1, const Results &r2, std::string title)
+{
+   int iret = 0;
+   auto check = [&](const TMatrixD &m1, const TMatrixD &m2, const char *name) {
+      if (!identical(m1, m2)) {
+         std::cerr << title << ": " << name << " is different" << std::endl;
+         iret = -1;
+      }
+   };
+   check(r1.fAB, r2.fAB, "A*B");
+   check(r1.fAtB, r2.fAtB, "A^T*B");
+   check(r1.fABt, r2.fABt, "A*A^T");
+   check(r1.fCholU, r2.fCholU, "Cholesky U");
+   check(r1.fCholInv, r2.fCholInv, "Cholesky inverse");
+   check(r1.fInv, r2.fInv, "inverse");
+   return iret;
+}
+
+int main(int argc, char **argv)
+{
+   int iret = 0;
+   const Int_t nMax = (argc > 1) ? std::atoi(argv[1]) : 1000;
+
+   TRandom3 rndm(1);
+   std::cout << "time (ms) of A*B, A^T*B, A*A^T, Cholesky decomposition and inversion, inversion" << std::endl;
+   for (Int_t n = 10; n <= nMax; n *= 10) {
+      TMatrixD a(n, n);
+      TMatrixD b(n, n + 7);
+      for (Int_t i = 0; i < a.GetNoElements(); i++)
+         a.GetMatrixArray()[i] = rndm.Uniform(-1, 1);
+      for (Int_t i = 0; i < b.GetNoElements(); i++)
+         b.GetMatrixArray()[i] = rndm.Uniform(-1, 1);
+      TMatrixDSym s(n);
+      for (Int_t i = 0; i < n; i++)
+         for (Int_t j = 0; j <= i; j++)
+            s(i, j) = s(j, i) = (i == j ? n : 0.) + rndm.Uniform(-0.5, 0.5);
+
+      std::cout << "matrix size = " << n << std::endl;
+      Results serial = timeOperations(a, b, s, "serial\t");
+
+      if (!identical(serial.fAB, multiply(a, b))) {
+         std::cerr << "n = " << n << ": A*B differs from the row by column product" << std::endl;
+         iret = -1;
+      }
+      if (distanceFromUnit(TMatrixD(s, TMatrixD::kMult, serial.fCholInv)) > 1.E-10 ||
+          distanceFromUnit(TMatrixD(a, TMatrixD::kMult, serial.fInv)) > 1.E-6) {
+         std::cerr << "n = " << n << ": wrong inverse" << std::endl;
+         iret = -1;
+      }
+
+#ifdef R__USE_IMT
+      for (unsigned int nThreads : {2, 4, 8}) {
+         ROOT::EnableImplicitMT(nThreads);
+         std::string title = std::to_string(nThreads) + " threads";
+         Results mt = timeOperations(a, b, s, title);
+         iret |= compare(serial, mt, "n = " + std::to_string(n) + ", " + title);
+         ROOT::DisableImplicitMT();
+      }
+#endif
+   }
+   if (iret != 0) std::cerr << "testMatrixPerf: FAILED" << std::endl;
+   return iret;
+}
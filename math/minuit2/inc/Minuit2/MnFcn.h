@@ -13,6 +13,7 @@
 #include "Minuit2/MnConfig.h"
 #include "Minuit2/MnMatrix.h"
 
+#include <atomic>
 #include <vector>
 
 namespace ROOT {
@@ -27,6 +28,7 @@ class FCNBase;
    the function coordinates.
    The class counts also the number of function calls. By default counter strart from zero, but a different value
    might be given if the class is  instantiated later on, for example for a set of different minimizaitons
+   The counter is atomic, since the function can be called concurrently by the numerical gradient calculator
    Normally the derived class MnUserFCN should be instantiated with performs in addition the transformatiopn
    internal-> external parameters
  */
@@ -42,6 +44,9 @@ public:
   virtual double operator()(const MnAlgebraicVector&) const;
   unsigned int NumOfCalls() const {return fNumCall;}
 
+  /// add to the counter the calls made outside this object (e.g. in forked processes)
+  void AddNumOfCalls(unsigned int ncall) const {fNumCall += ncall;}
+
   //
   //forward interface
   //
@@ -56,7 +61,7 @@ private:
 
 protected:
 
-  mutable int fNumCall;
+  mutable std::atomic<int> fNumCall;
 };
 
   }  // namespace Minuit2
@@ -49,6 +49,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   unsigned int GradientExecutionPolicy() const { return fGradExecPolicy; }
+
    bool IsLow() const {return fStrategy == 0;}
    bool IsMedium() const {return fStrategy == 1;}
    bool IsHigh() const {return fStrategy >= 2;}
@@ -69,6 +71,11 @@ public:
    // set storage level of iteration quantities
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
+
+   // set how the numerical gradient evaluates the derivatives of the different parameters
+   // 0 = serially (default), 1 = concurrently on threads (needs a thread safe FCN and IMT),
+   // 2 = in forked processes (not on Windows). The values are the ones of ROOT::Fit::ExecutionPolicy
+   void SetGradientExecutionPolicy(unsigned int policy) { fGradExecPolicy = policy; }
 private:
 
    unsigned int fStrategy;
@@ -81,6 +88,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   unsigned int fGradExecPolicy;
 };
 
   }  // namespace Minuit2
@@ -13,6 +13,7 @@
 #include "Minuit2/MnConfig.h"
 
 #include "Minuit2/GradientCalculator.h"
+#include "Minuit2/MnMatrix.h"
 
 #include <vector>
 
@@ -65,6 +66,10 @@ public:
 
 private:
 
+  // calculate the derivative with respect to the internal parameter i, updating the values of the
+  // initial gradient given in grd, g2 and gstep. x is the position, its component i is restored on return
+  void ParameterDerivative(unsigned int i, MnAlgebraicVector& x, double fcnmin, double& grd, double& g2, double& gstep) const;
+
   const MnFcn& fFcn;
   const MnUserTransformation& fTransformation;
   const MnStrategy& fStrategy;
@@ -458,6 +458,11 @@ bool Minuit2Minimizer::Minimize() {
       strategy.SetHessianStepTolerance(hessStepTol);
       strategy.SetHessianG2Tolerance(hessStepTol);
 
+      // 0 = serial, 1 = multi-thread, 2 = multi-process evaluation of the numerical gradient
+      int gradExecPolicy = strategy.GradientExecutionPolicy();
+      minuit2Opt->GetValue("GradientExecutionPolicy",gradExecPolicy);
+      strategy.SetGradientExecutionPolicy(gradExecPolicy);
+
       int storageLevel = 1;
       bool ret = minuit2Opt->GetValue("StorageLevel",storageLevel);
       if (ret) SetStorageLevel(storageLevel);
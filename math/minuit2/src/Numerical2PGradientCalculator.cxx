@@ -33,6 +33,18 @@
 
 #include "Minuit2/MPIProcess.h"
 
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#include "TError.h"
+#include "ROOT/TSeq.hxx"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#endif
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -83,23 +95,59 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    double fcnmin = par.Fval();
    //   std::cout<<"fval: "<<fcnmin<<std::endl;
 
-   double eps2 = Precision().Eps2();
-   double eps = Precision().Eps();
-
-   double dfmin = 8.*eps2*(fabs(fcnmin)+Fcn().Up());
-   double vrysml = 8.*eps*eps;
-   //   double vrysml = std::max(1.e-4, eps2);
-   //    std::cout<<"dfmin= "<<dfmin<<std::endl;
-   //    std::cout<<"vrysml= "<<vrysml<<std::endl;
-   //    std::cout << " ncycle " << Ncycle() << std::endl;
-
    unsigned int n = (par.Vec()).size();
-   unsigned int ncycle = Ncycle();
    //   MnAlgebraicVector vgrd(n), vgrd2(n), vgstp(n);
    MnAlgebraicVector grd = Gradient.Grad();
    MnAlgebraicVector g2 = Gradient.G2();
    MnAlgebraicVector gstep = Gradient.Gstep();
 
+#ifdef USE_ROOT_ERROR
+   // the derivatives of the different parameters are independent: each one is computed from its own
+   // copy of the position, so that the result does not depend on the number of threads or processes
+   unsigned int executionPolicy = Strategy().GradientExecutionPolicy();
+   if (executionPolicy == 1) {
+#ifdef R__USE_IMT
+      auto derivative = [&](unsigned int i) {
+         MnAlgebraicVector x = par.Vec();
+         ParameterDerivative(i, x, fcnmin, grd(i), g2(i), gstep(i));
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(derivative, ROOT::TSeq<unsigned int>(0, n));
+      return FunctionGradient(grd, g2, gstep);
+#else
+      Error("Numerical2PGradientCalculator", "the multi-thread execution policy requires IMT, use the serial one");
+#endif
+   } else if (executionPolicy == 2) {
+#ifndef R__WIN32
+      // the workers send back the index of the parameter, since the results are received in any order,
+      // and the number of function calls, which are not counted by the function of this process
+      auto derivative = [&](unsigned int i) {
+         MnAlgebraicVector x = par.Vec();
+         unsigned int ncall = Fcn().NumOfCalls();
+         std::vector<double> result = {double(i), grd(i), g2(i), gstep(i), 0.};
+         ParameterDerivative(i, x, fcnmin, result[1], result[2], result[3]);
+         result[4] = Fcn().NumOfCalls() - ncall;
+         return result;
+      };
+      ROOT::TProcessExecutor pool;
+      unsigned int ncall = 0;
+      for (const std::vector<double> &result : pool.Map(derivative, ROOT::TSeq<unsigned int>(0, n))) {
+         unsigned int i = result[0];
+         grd(i) = result[1];
+         g2(i) = result[2];
+         gstep(i) = result[3];
+         ncall += result[4];
+      }
+      Fcn().AddNumOfCalls(ncall);
+      return FunctionGradient(grd, g2, gstep);
+#else
+      Error("Numerical2PGradientCalculator", "the multi-process execution policy is not supported on Windows, use the serial one");
+#endif
+   } else if (executionPolicy != 0) {
+      Error("Numerical2PGradientCalculator", "unknown execution policy %u, use the serial one", executionPolicy);
+   }
+#endif
+
 #ifndef _OPENMP
    MPIProcess mpiproc(n,0);
 #endif
@@ -142,62 +190,7 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       MnAlgebraicVector x = par.Vec();
 #endif
 
-      double xtf = x(i);
-      double epspri = eps2 + fabs(grd(i)*eps2);
-      double stepb4 = 0.;
-      for(unsigned int j = 0; j < ncycle; j++)  {
-         double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
-         double step = std::max(optstp, fabs(0.1*gstep(i)));
-         //       std::cout<<"step: "<<step;
-         if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
-            if(step > 0.5) step = 0.5;
-         }
-         double stpmax = 10.*fabs(gstep(i));
-         if(step > stpmax) step = stpmax;
-         //       std::cout<<" "<<step;
-         double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
-         if(step < stpmin) step = stpmin;
-         //       std::cout<<" "<<step<<std::endl;
-         //       std::cout<<"step: "<<step<<std::endl;
-         if(fabs((step-stepb4)/step) < StepTolerance()) {
-            //    std::cout<<"(step-stepb4)/step"<<std::endl;
-            //    std::cout<<"j= "<<j<<std::endl;
-            //    std::cout<<"step= "<<step<<std::endl;
-            break;
-         }
-         gstep(i) = step;
-         stepb4 = step;
-         //       MnAlgebraicVector pstep(n);
-         //       pstep(i) = step;
-         //       double fs1 = Fcn()(pstate + pstep);
-         //       double fs2 = Fcn()(pstate - pstep);
-
-         x(i) = xtf + step;
-         double fs1 = Fcn()(x);
-         x(i) = xtf - step;
-         double fs2 = Fcn()(x);
-         x(i) = xtf;
-
-         double grdb4 = grd(i);
-         grd(i) = 0.5*(fs1 - fs2)/step;
-         g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
-
-#ifdef DEBUG
-         pr = std::cout.precision(13);
-         std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
-                   << " grd " << grd(i) << " g2 " << g2(i) << std::endl;
-         std::cout.precision(pr);
-#endif
-
-         if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
-            //    std::cout<<"j= "<<j<<std::endl;
-            //    std::cout<<"step= "<<step<<std::endl;
-            //    std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
-            //    std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
-            break;
-         }
-      }
-
+      ParameterDerivative(i, x, fcnmin, grd(i), g2(i), gstep(i));
 
 #ifdef DEBUG_MP
 #pragma omp critical
@@ -228,6 +221,78 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    return FunctionGradient(grd, g2, gstep);
 }
 
+void Numerical2PGradientCalculator::ParameterDerivative(unsigned int i, MnAlgebraicVector& x, double fcnmin, double& grd, double& g2, double& gstep) const {
+   // calculate the derivative with respect to the internal parameter i, starting from the values of the
+   // initial gradient given in grd, g2 and gstep. Only the component i of x is changed (and restored)
+
+   double eps2 = Precision().Eps2();
+   double eps = Precision().Eps();
+
+   double dfmin = 8.*eps2*(fabs(fcnmin)+Fcn().Up());
+   double vrysml = 8.*eps*eps;
+   //   double vrysml = std::max(1.e-4, eps2);
+   //    std::cout<<"dfmin= "<<dfmin<<std::endl;
+   //    std::cout<<"vrysml= "<<vrysml<<std::endl;
+   //    std::cout << " ncycle " << Ncycle() << std::endl;
+   unsigned int ncycle = Ncycle();
+
+   double xtf = x(i);
+   double epspri = eps2 + fabs(grd*eps2);
+   double stepb4 = 0.;
+   for(unsigned int j = 0; j < ncycle; j++)  {
+      double optstp = sqrt(dfmin/(fabs(g2)+epspri));
+      double step = std::max(optstp, fabs(0.1*gstep));
+      //       std::cout<<"step: "<<step;
+      if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
+         if(step > 0.5) step = 0.5;
+      }
+      double stpmax = 10.*fabs(gstep);
+      if(step > stpmax) step = stpmax;
+      //       std::cout<<" "<<step;
+      double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
+      if(step < stpmin) step = stpmin;
+      //       std::cout<<" "<<step<<std::endl;
+      //       std::cout<<"step: "<<step<<std::endl;
+      if(fabs((step-stepb4)/step) < StepTolerance()) {
+         //    std::cout<<"(step-stepb4)/step"<<std::endl;
+         //    std::cout<<"j= "<<j<<std::endl;
+         //    std::cout<<"step= "<<step<<std::endl;
+         break;
+      }
+      gstep = step;
+      stepb4 = step;
+      //       MnAlgebraicVector pstep(n);
+      //       pstep(i) = step;
+      //       double fs1 = Fcn()(pstate + pstep);
+      //       double fs2 = Fcn()(pstate - pstep);
+
+      x(i) = xtf + step;
+      double fs1 = Fcn()(x);
+      x(i) = xtf - step;
+      double fs2 = Fcn()(x);
+      x(i) = xtf;
+
+      double grdb4 = grd;
+      grd = 0.5*(fs1 - fs2)/step;
+      g2 = (fs1 + fs2 - 2.*fcnmin)/step/step;
+
+#ifdef DEBUG
+      int pr = std::cout.precision(13);
+      std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
+                << " grd " << grd << " g2 " << g2 << std::endl;
+      std::cout.precision(pr);
+#endif
+
+      if(fabs(grdb4-grd)/(fabs(grd)+dfmin/step) < GradTolerance())  {
+         //    std::cout<<"j= "<<j<<std::endl;
+         //    std::cout<<"step= "<<step<<std::endl;
+         //    std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
+         //    std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
+         break;
+      }
+   }
+}
+
 const MnMachinePrecision& Numerical2PGradientCalculator::Precision() const {
    // return global precision (set in transformation)
    return fTransformation.Precision();
@@ -0,0 +1,92 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+// check that the numerical gradient evaluated on threads or in forked processes
+// gives exactly the same minimization as the serial one
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnUserParameters.h"
+#include "RConfigure.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ROOT::Minuit2;
+
+const int npar = 40;
+
+// coupled quadratic form with a non-linear term, thread safe
+struct CoupledFCN : public FCNBase {
+
+   double operator()(const std::vector<double> &p) const {
+      double f = 0;
+      for (int i = 0; i < npar; ++i) {
+         double d = p[i] - 0.1 * i;
+         f += d * d + 0.2 * d * (p[(i + 1) % npar] - 0.1 * ((i + 1) % npar)) + 0.1 * (1 - std::cos(d));
+      }
+      return f;
+   }
+   double Up() const { return 1.; }
+};
+
+FunctionMinimum doFit(unsigned int executionPolicy) {
+   CoupledFCN fcn;
+   MnUserParameters upar;
+   for (int i = 0; i < npar; ++i)
+      upar.Add("p" + std::to_string(i), 1., 0.1);
+   // a limited parameter, to use the internal transformation
+   upar.SetLimits("p0", -2., 2.);
+
+   MnStrategy strategy(1);
+   strategy.SetGradientExecutionPolicy(executionPolicy);
+   MnMigrad migrad(fcn, upar, strategy);
+   return migrad();
+}
+
+int compareMinimum(const FunctionMinimum &min, const FunctionMinimum &ref, std::string s) {
+   int iret = 0;
+   if (!min.IsValid()) {
+      std::cerr << s << ": invalid minimum" << std::endl;
+      iret = -1;
+   }
+   if (min.Fval() != ref.Fval() || min.NFcn() != ref.NFcn()) {
+      std::cerr << s << ": fval = " << min.Fval() << " (" << min.NFcn() << " calls) it should be " << ref.Fval()
+                << " (" << ref.NFcn() << " calls)" << std::endl;
+      iret = -1;
+   }
+   for (int i = 0; i < npar; ++i) {
+      if (min.UserState().Value(i) != ref.UserState().Value(i)) {
+         std::cerr << s << ": p" << i << " = " << min.UserState().Value(i) << " it should be "
+                   << ref.UserState().Value(i) << std::endl;
+         iret = -1;
+      }
+   }
+   return iret;
+}
+
+int main() {
+   FunctionMinimum ref = doFit(0);
+   int iret = 0;
+   if (!ref.IsValid()) {
+      std::cerr << "Serial: invalid minimum" << std::endl;
+      iret = -1;
+   }
+#ifdef R__USE_IMT
+   iret |= compareMinimum(doFit(1), ref, "Multithread");
+#endif
+#ifndef R__WIN32
+   iret |= compareMinimum(doFit(2), ref, "Multiprocess");
+#endif
+   if (iret != 0) std::cerr << "testGradientExecPolicy: FAILED" << std::endl;
+   return iret;
+}
@@ -143,6 +143,9 @@ public:
    /** mark reply as 404 error - page/request not exists or refused */
    void Set404() { SetContentType("_404_"); }
 
+   /** mark reply as 304 - content, known to the client, was not modified */
+   void Set304() { SetContentType("_304_"); }
+
    /** mark reply as postponed - submitting thread will not be inform */
    void SetPostponed() { SetContentType("_postponed_"); }
 
@@ -197,6 +200,7 @@ public:
 
    Bool_t IsContentType(const char *typ) const { return fContentType == typ; }
    Bool_t Is404() const { return IsContentType("_404_"); }
+   Bool_t Is304() const { return IsContentType("_304_"); }
    Bool_t IsFile() const { return IsContentType("_file_"); }
    Bool_t IsPostponed() const { return IsContentType("_postponed_"); }
    const char *GetContentType() const { return fContentType.Data(); }
@@ -16,6 +16,10 @@
 
 #include "TList.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 class TFolder;
 class TMemFile;
 class TBufferFile;
@@ -126,6 +130,21 @@ protected:
    TString fCurrentAllowedMethods; ///<! list of allowed methods, extracted when analyzed object restrictions
    TList fRestrictions;            ///<! list of restrictions for different locations
    TString fAutoLoad;              ///<! scripts names, which are add as _autoload parameter to h.json request
+   TBufferFile *fHashBuf;          ///<! buffer used to stream objects when calculating content hash
+   Long_t fCacheLimit;             ///<! maximal total size of cached replies, 0 - caching disabled
+   Long_t fCacheSize;              ///<! current total size of cached replies
+   Bool_t fInMulti;                ///<! true when items of multi.json/multi.bin request are produced
+
+   /** Reply produced for an object, reused as long as object content does not change */
+   struct TCachedReply {
+      ULong64_t fHash = 0;                                ///<! content hash of object when reply was produced
+      TString fETag;                                      ///<! ETag, built from content hash
+      std::string fBin;                                   ///<! binary reply
+      TString fStr;                                       ///<! string reply
+      std::vector<std::pair<TString, TString>> fHeaders; ///<! extra http headers set when reply was produced
+   };
+
+   std::map<std::string, TCachedReply> fCache; ///<! cached replies, key is file name, item path and options
 
    void ScanObjectMembers(TRootSnifferScanRec &rec, TClass *cl, char *ptr);
 
@@ -156,6 +175,11 @@ protected:
 
    Int_t WithCurrentUserName(const char *option);
 
+   Bool_t IsCacheableFile(const char *file) const;
+
+   Bool_t ProduceCached(const char *path, const char *file, const char *options, void *&ptr, Long_t &length,
+                        TString &str);
+
 public:
    TRootSniffer(const char *name, const char *objpath = "Objects");
    virtual ~TRootSniffer();
@@ -216,6 +240,15 @@ public:
 
    ULong_t GetItemHash(const char *itemname);
 
+   ULong64_t GetItemContentHash(const char *itemname);
+
+   void SetCacheLimit(Long_t limit);
+
+   /** Returns maximal total size of cached replies */
+   Long_t GetCacheLimit() const { return fCacheLimit; }
+
+   void ClearCache();
+
    Bool_t ProduceJson(const char *path, const char *options, TString &res);
 
    Bool_t ProduceXml(const char *path, const char *options, TString &res);
@@ -246,7 +246,7 @@ static int begin_request_handler(struct mg_connection *conn, void *)
       }
    }
 
-   if (!execres || arg.Is404()) {
+   if (!execres || arg.Is404() || arg.Is304()) {
       TString hdr;
       arg.FillHttpHeader(hdr, "HTTP/1.1");
       mg_printf(conn, "%s", hdr.Data());
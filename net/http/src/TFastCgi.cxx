@@ -266,7 +266,7 @@ void *TFastCgi::run_func(void *args)
 
       TString hdr;
 
-      if (!engine->GetServer()->ExecuteHttp(&arg) || arg.Is404()) {
+      if (!engine->GetServer()->ExecuteHttp(&arg) || arg.Is404() || arg.Is304()) {
          arg.FillHttpHeader(hdr, "Status:");
          FCGX_FPrintF(request.out, hdr.Data());
       } else if (arg.IsFile()) {
@@ -242,6 +242,11 @@ void THttpCallArg::FillHttpHeader(TString &hdr, const char *kind)
                "Content-Length: 0\r\n"
                "Connection: close\r\n\r\n",
                kind);
+   } else if (Is304()) {
+      hdr.Form("%s 304 Not Modified\r\n"
+               "Connection: keep-alive\r\n"
+               "%s\r\n",
+               kind, fHeader.Data());
    } else {
       hdr.Form("%s 200 OK\r\n"
                "Content-Type: %s\r\n"
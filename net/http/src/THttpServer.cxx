@@ -850,8 +850,9 @@ void THttpServer::ProcessRequest(THttpCallArg *arg)
                                 arg->fContent)) {
       if (bindata != 0) arg->SetBinData(bindata, bindatalen);
 
-      // define content type base on extension
-      arg->SetContentType(GetMimeType(filename.Data()));
+      // define content type base on extension,
+      // sniffer marks reply as 304 when client already has actual version of the object
+      if (!arg->Is304()) arg->SetContentType(GetMimeType(filename.Data()));
    } else {
       // request is not processed
       arg->Set404();
@@ -859,7 +860,7 @@ void THttpServer::ProcessRequest(THttpCallArg *arg)
 
    if (arg->Is404()) return;
 
-   if (iszip) arg->SetZipping(3);
+   if (iszip && !arg->Is304()) arg->SetZipping(3);
 
    if (filename == "root.bin") {
       // only for binary data master version is important
@@ -868,9 +869,14 @@ void THttpServer::ProcessRequest(THttpCallArg *arg)
       arg->AddHeader(parname, Form("%u", (unsigned)fSniffer->GetStreamerInfoHash()));
    }
 
-   // try to avoid caching on the browser
-   arg->AddHeader("Cache-Control",
-                  "private, no-cache, no-store, must-revalidate, max-age=0, proxy-revalidate, s-maxage=0");
+   if (arg->GetHeader("ETag").Length() > 0) {
+      // browser may keep reply, but must always check with ETag if it is still valid
+      arg->AddHeader("Cache-Control", "private, no-cache, must-revalidate, max-age=0");
+   } else {
+      // try to avoid caching on the browser
+      arg->AddHeader("Cache-Control",
+                     "private, no-cache, no-store, must-revalidate, max-age=0, proxy-revalidate, s-maxage=0");
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
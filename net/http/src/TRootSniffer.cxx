@@ -401,7 +401,8 @@ ClassImp(TRootSniffer)
 
    TRootSniffer::TRootSniffer(const char *name, const char *objpath)
    : TNamed(name, "sniffer of root objects"), fObjectsPath(objpath), fMemFile(0), fSinfo(0), fReadOnly(kTRUE),
-     fScanGlobalDir(kTRUE), fCurrentArg(0), fCurrentRestrict(0), fCurrentAllowedMethods(0), fRestrictions(), fAutoLoad()
+     fScanGlobalDir(kTRUE), fCurrentArg(0), fCurrentRestrict(0), fCurrentAllowedMethods(0), fRestrictions(), fAutoLoad(),
+     fHashBuf(0), fCacheLimit(100000000), fCacheSize(0), fInMulti(kFALSE), fCache()
 {
    fRestrictions.SetOwner(kTRUE);
 }
@@ -420,6 +421,8 @@ TRootSniffer::~TRootSniffer()
       delete fMemFile;
       fMemFile = 0;
    }
+
+   delete fHashBuf;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1034,6 +1037,181 @@ ULong_t TRootSniffer::GetItemHash(const char *itemname)
    return obj == 0 ? 0 : TString::Hash(obj, obj->IsA()->Size());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Get hash of the content of specified item
+///
+/// Object is streamed with TBufferFile and CRC32 of produced buffer
+/// (combined with buffer length) is returned. This is much cheaper than
+/// JSON/XML conversion or compression and reliably detects any change in the
+/// object data, therefore used as ETag for the http replies.
+/// Returns 0 if item not found or access to it is not allowed.
+
+ULong64_t TRootSniffer::GetItemContentHash(const char *itemname)
+{
+   if ((itemname == 0) || (*itemname == 0) || IsStreamerInfoItem(itemname)) return 0;
+
+   if (*itemname == '/') itemname++;
+
+   TClass *obj_cl(0);
+   TDataMember *member(0);
+   void *obj_ptr = FindInHierarchy(itemname, &obj_cl, &member);
+   if ((obj_ptr == 0) || (obj_cl == 0) || (member != 0)) return 0;
+
+   if (fHashBuf == 0) fHashBuf = new TBufferFile(TBuffer::kWrite, 100000);
+
+   TDirectory *olddir = gDirectory;
+   gDirectory = 0;
+   TFile *oldfile = gFile;
+   gFile = 0;
+
+   fHashBuf->Reset();
+   fHashBuf->ResetMap();
+   fHashBuf->MapObject(obj_ptr, obj_cl);
+   obj_cl->Streamer(obj_ptr, *fHashBuf);
+
+   gDirectory = olddir;
+   gFile = oldfile;
+
+   ULong64_t len = fHashBuf->Length();
+   ULong64_t crc = R__crc32(0, NULL, 0);
+   crc = R__crc32(crc, (const unsigned char *)fHashBuf->Buffer(), fHashBuf->Length());
+
+   // do not keep too large buffer between requests
+   if (fHashBuf->BufferSize() > 10000000) {
+      delete fHashBuf;
+      fHashBuf = 0;
+   }
+
+   // hash should also change when same object is replaced by instance of other class
+   return ((len << 32) | (crc & 0xffffffff)) ^ TString::Hash(obj_cl->GetName(), strlen(obj_cl->GetName()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set maximal total size of replies, cached by the sniffer
+///
+/// Replies for "root.bin", "root.json" and "root.xml" requests are kept
+/// together with content hash of the object (see GetItemContentHash()).
+/// As long as object content does not change, cached reply is returned
+/// without new JSON/XML conversion or compression of the binary data.
+/// When limit is exceeded, cache is cleared. Default limit is 100 MB,
+/// 0 disables caching.
+
+void TRootSniffer::SetCacheLimit(Long_t limit)
+{
+   fCacheLimit = limit > 0 ? limit : 0;
+   if (fCacheSize > fCacheLimit) ClearCache();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all cached replies
+
+void TRootSniffer::ClearCache()
+{
+   fCache.clear();
+   fCacheSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if reply for specified file name can be cached
+
+Bool_t TRootSniffer::IsCacheableFile(const char *file) const
+{
+   return (strcmp(file, "root.bin") == 0) || (strcmp(file, "root.json") == 0) || (strcmp(file, "root.xml") == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produce reply for the object item, using cache of previous replies
+///
+/// Content hash of the object is its version and is set as "ETag" header of
+/// current http request. If request has matching "If-None-Match" header,
+/// client already has actual version of the object - request is marked as
+/// "304 Not Modified" and no reply is produced or copied at all.
+/// If object content was not changed since reply with same file name and
+/// options was produced, copy of that reply is returned.
+
+Bool_t TRootSniffer::ProduceCached(const char *path, const char *file, const char *options, void *&ptr,
+                                   Long_t &length, TString &str)
+{
+   ULong64_t hash = GetItemContentHash(path);
+   if (hash == 0) return kFALSE;
+
+   std::string key = file;
+   key.append(":");
+   key.append(path);
+   key.append("?");
+   if (options) key.append(options);
+
+   auto iter = fCache.find(key);
+
+   TString etag;
+   if ((iter != fCache.end()) && (iter->second.fHash == hash))
+      etag = iter->second.fETag;
+   else
+      etag.Form("\"%llx\"", hash);
+
+   if (fCurrentArg) {
+      fCurrentArg->AddHeader("ETag", etag.Data());
+      if (fCurrentArg->GetRequestHeader("If-None-Match") == etag) {
+         fCurrentArg->Set304();
+         return kTRUE;
+      }
+   }
+
+   if ((iter != fCache.end()) && (iter->second.fHash == hash)) {
+      TCachedReply &entry = iter->second;
+      if (strcmp(file, "root.bin") == 0) {
+         length = entry.fBin.length();
+         ptr = malloc(length);
+         memcpy(ptr, entry.fBin.data(), length);
+      } else {
+         str = entry.fStr;
+      }
+
+      if (fCurrentArg)
+         for (auto &hdr : entry.fHeaders) fCurrentArg->AddHeader(hdr.first.Data(), hdr.second.Data());
+   } else {
+      if (iter != fCache.end()) {
+         fCacheSize -= iter->second.fBin.length() + iter->second.fStr.Length();
+         fCache.erase(iter);
+      }
+
+      Int_t nhdr = fCurrentArg ? fCurrentArg->NumHeader() : 0;
+
+      Bool_t res = kFALSE;
+      if (strcmp(file, "root.bin") == 0)
+         res = ProduceBinary(path, options, ptr, length);
+      else if (strcmp(file, "root.json") == 0)
+         res = ProduceJson(path, options, str);
+      else
+         res = ProduceXml(path, options, str);
+
+      if (!res) return kFALSE;
+
+      Long_t size = (strcmp(file, "root.bin") == 0) ? length : str.Length();
+
+      if (size <= fCacheLimit) {
+         if (fCacheSize + size > fCacheLimit) ClearCache();
+
+         TCachedReply &entry = fCache[key];
+         entry.fHash = hash;
+         entry.fETag = etag;
+         if (strcmp(file, "root.bin") == 0)
+            entry.fBin.assign((const char *)ptr, length);
+         else
+            entry.fStr = str;
+         fCacheSize += size;
+
+         Int_t nlast = fCurrentArg ? fCurrentArg->NumHeader() : 0;
+         for (Int_t n = nhdr; n < nlast; n++) {
+            TString name = fCurrentArg->GetHeaderName(n);
+            entry.fHeaders.emplace_back(name, fCurrentArg->GetHeader(name));
+         }
+      }
+   }
+
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Method verifies if object can be drawn
 
@@ -1663,8 +1841,10 @@ Bool_t TRootSniffer::ProduceMulti(const char *path, const char *options, void *&
       Long_t len1 = 0;
       TString str1;
 
-      // produce next item request
+      // produce next item request, item replies do not provide http headers
+      fInMulti = kTRUE;
       Produce(path1, file1, opt1, ptr1, len1, str1);
+      fInMulti = kFALSE;
 
       if (asjson) {
          if (n > 0) str.Append(", ");
@@ -1726,14 +1906,30 @@ Bool_t TRootSniffer::IsStreamerInfoItem(const char *itemname)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// produce binary data for specified item
-/// if "zipped" option specified in query, buffer will be compressed
-
-Bool_t TRootSniffer::ProduceBinary(const char *path, const char * /*query*/, void *&ptr, Long_t &length)
+///
+/// Reply is TBufferFile representation of the object.
+/// If "zipped" option specified in query, buffer will be compressed with
+/// compression settings of the sniffer memory file. Compression settings can
+/// be also specified explicitly like "compress=101" (zlib, level 1) or
+/// "compress=404" (lz4, level 4). Compressed buffer has the same format as
+/// object data in the ROOT file keys, uncompressed length is provided in the
+/// "RootObjLen" header.
+
+Bool_t TRootSniffer::ProduceBinary(const char *path, const char *query, void *&ptr, Long_t &length)
 {
    if ((path == 0) || (*path == 0)) return kFALSE;
 
    if (*path == '/') path++;
 
+   Int_t compress = 0;
+   if ((query != 0) && (*query != 0)) {
+      TUrl url;
+      url.SetOptions(query);
+      url.ParseOptions();
+      if (url.GetValueFromOptions("compress")) compress = url.GetIntValueFromOptions("compress");
+      else if (url.HasOption("zipped")) compress = -1;
+   }
+
    TClass *obj_cl(0);
    void *obj_ptr = FindInHierarchy(path, &obj_cl);
    if ((obj_ptr == 0) || (obj_cl == 0)) return kFALSE;
@@ -1764,12 +1960,48 @@ Bool_t TRootSniffer::ProduceBinary(const char *path, const char * /*query*/, voi
    fMemFile->WriteStreamerInfo();
    fSinfo = fMemFile->GetStreamerInfoList();
 
+   if (compress < 0) compress = fMemFile->GetCompressionSettings();
+
    gDirectory = olddir;
    gFile = oldfile;
 
-   ptr = malloc(sbuf->Length());
-   memcpy(ptr, sbuf->Buffer(), sbuf->Length());
-   length = sbuf->Length();
+   Int_t objlen = sbuf->Length();
+   Int_t cxlevel = compress % 100, cxalgorithm = compress / 100;
+
+   length = 0;
+
+   if ((cxlevel > 0) && (objlen > 256)) {
+      Int_t nbuffers = 1 + (objlen - 1) / kMAXZIPBUF;
+      Int_t buflen = objlen + 9 * nbuffers + 28;
+      ptr = malloc(buflen);
+      char *objbuf = sbuf->Buffer();
+      char *bufcur = (char *)ptr;
+      for (Int_t n = 0; n < nbuffers; ++n) {
+         Int_t bufmax = (n == nbuffers - 1) ? objlen - n * kMAXZIPBUF : kMAXZIPBUF;
+         // all compressed blocks together must remain smaller than the object
+         Int_t tgtmax = objlen - 1 - length;
+         Int_t nout = 0;
+         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &tgtmax, bufcur, &nout, cxalgorithm);
+         if ((nout == 0) || (length + nout >= objlen)) {
+            // buffer cannot be compressed, provide it as is
+            free(ptr);
+            length = 0;
+            break;
+         }
+         bufcur += nout;
+         length += nout;
+         objbuf += kMAXZIPBUF;
+      }
+   }
+
+   if (length > 0) {
+      if (fCurrentArg && !fInMulti)
+         fCurrentArg->SetExtraHeader("RootObjLen", TString::Format("%d", objlen).Data());
+   } else {
+      ptr = malloc(objlen);
+      memcpy(ptr, sbuf->Buffer(), objlen);
+      length = objlen;
+   }
 
    delete sbuf;
 
@@ -1894,12 +2126,18 @@ Bool_t TRootSniffer::ProduceImage(Int_t kind, const char *path, const char *opti
 ///   "cmd.json"  - execution of registered commands
 /// Result returned either as string or binary buffer,
 /// which should be released with free() call
+/// Replies for "root.bin", "root.xml" and "root.json" are cached
+/// (except items of multi requests), see SetCacheLimit() for details
 
 Bool_t TRootSniffer::Produce(const char *path, const char *file, const char *options, void *&ptr, Long_t &length,
                              TString &str)
 {
    if ((file == 0) || (*file == 0)) return kFALSE;
 
+   if ((fCacheLimit > 0) && !fInMulti && IsCacheableFile(file) &&
+       ProduceCached(path, file, options, ptr, length, str))
+      return kTRUE;
+
    if (strcmp(file, "root.bin") == 0) return ProduceBinary(path, options, ptr, length);
 
    if (strcmp(file, "root.png") == 0) return ProduceImage(TImage::kPng, path, options, ptr, length);
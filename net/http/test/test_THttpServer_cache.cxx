@@ -0,0 +1,141 @@
+#include "THttpServer.h"
+#include "THttpCallArg.h"
+#include "TRootSniffer.h"
+#include "TH1.h"
+#include "RZip.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+// Sniffer counting the lookups of the objects, one lookup is done to get the
+// content hash of the object and one more when reply is really produced.
+class TCountingSniffer : public TRootSniffer {
+public:
+   Int_t fNFind = 0;
+
+   TCountingSniffer() : TRootSniffer("sniff") { SetScanGlobalDir(kFALSE); }
+
+   void *FindInHierarchy(const char *path, TClass **cl = 0, TDataMember **member = 0, Int_t *chld = 0) override
+   {
+      ++fNFind;
+      return TRootSniffer::FindInHierarchy(path, cl, member, chld);
+   }
+};
+
+class THttpServerCache : public ::testing::Test {
+protected:
+   THttpServer fServ{""};
+   TCountingSniffer *fSniffer = new TCountingSniffer();
+   TH1F fHist{"hpx", "hpx", 10000, 0., 1.};
+
+   void SetUp() override
+   {
+      fServ.SetSniffer(fSniffer);
+      fHist.SetDirectory(nullptr);
+      fHist.Fill(0.5);
+      fServ.Register("hists", &fHist);
+   }
+
+   void TearDown() override { fServ.Unregister(&fHist); }
+
+   // process request for the histogram, returns number of object lookups done
+   Int_t Request(std::unique_ptr<THttpCallArg> &arg, const char *file, const char *query = "",
+                 const TString &etag = "")
+   {
+      arg.reset(new THttpCallArg());
+      arg->SetPathName("hists/hpx");
+      arg->SetFileName(file);
+      arg->SetQuery(query);
+      if (etag.Length() > 0) arg->SetRequestHeader(TString::Format("If-None-Match: %s\r\n", etag.Data()));
+      Int_t nfind = fSniffer->fNFind;
+      fServ.SubmitHttp(arg.get());
+      fServ.ProcessRequests();
+      return fSniffer->fNFind - nfind;
+   }
+};
+
+TEST_F(THttpServerCache, NotModified)
+{
+   std::unique_ptr<THttpCallArg> arg;
+   Request(arg, "root.json");
+   TString etag = arg->GetHeader("ETag");
+   ASSERT_LT(0, etag.Length());
+   EXPECT_LT(0, arg->GetContentLength());
+   EXPECT_FALSE(arg->Is304());
+   // reply may be kept by the browser, but must be revalidated
+   EXPECT_EQ(kNPOS, arg->GetHeader("Cache-Control").Index("no-store"));
+
+   // the client already has the actual version, reply is neither produced nor copied
+   fSniffer->ClearCache();
+   EXPECT_EQ(1, Request(arg, "root.json", "", etag));
+   EXPECT_TRUE(arg->Is304());
+   EXPECT_EQ(0, arg->GetContentLength());
+   EXPECT_EQ(etag, arg->GetHeader("ETag"));
+
+   // the client has an outdated version
+   fHist.Fill(0.5);
+   Request(arg, "root.json", "", etag);
+   EXPECT_FALSE(arg->Is304());
+   EXPECT_LT(0, arg->GetContentLength());
+   EXPECT_NE(etag, arg->GetHeader("ETag"));
+}
+
+TEST_F(THttpServerCache, HitAndMiss)
+{
+   std::unique_ptr<THttpCallArg> arg1, arg2, arg3;
+
+   EXPECT_EQ(2, Request(arg1, "root.json"));
+   EXPECT_EQ(1, Request(arg2, "root.json"));
+   EXPECT_EQ(arg1->GetHeader("ETag"), arg2->GetHeader("ETag"));
+   EXPECT_EQ(TString((const char *)arg1->GetContent(), arg1->GetContentLength()),
+             TString((const char *)arg2->GetContent(), arg2->GetContentLength()));
+
+   // other options are another reply
+   EXPECT_EQ(2, Request(arg3, "root.json", "compact=3"));
+
+   // object was modified
+   fHist.Fill(0.25);
+   EXPECT_EQ(2, Request(arg3, "root.json"));
+   EXPECT_NE(arg1->GetHeader("ETag"), arg3->GetHeader("ETag"));
+   EXPECT_NE(TString((const char *)arg1->GetContent(), arg1->GetContentLength()),
+             TString((const char *)arg3->GetContent(), arg3->GetContentLength()));
+
+   // caching disabled, no ETag provided
+   fSniffer->SetCacheLimit(0);
+   EXPECT_EQ(1, Request(arg3, "root.json"));
+   EXPECT_EQ(0, arg3->GetHeader("ETag").Length());
+}
+
+TEST_F(THttpServerCache, CompressedBinary)
+{
+   std::unique_ptr<THttpCallArg> plain, zipped;
+   Request(plain, "root.bin");
+   ASSERT_LT(0, plain->GetContentLength());
+   Int_t objlen = plain->GetContentLength();
+   EXPECT_EQ(0, plain->GetHeader("RootObjLen").Length());
+
+   for (const char *query : {"compress=101", "compress=404", "zipped"}) {
+      Request(zipped, "root.bin", query);
+      ASSERT_LT(0, zipped->GetContentLength());
+      EXPECT_EQ(objlen, zipped->GetHeader("RootObjLen").Atoi()) << query;
+      EXPECT_GT(objlen / 10, zipped->GetContentLength()) << query;
+
+      // compressed blocks have the same format as the object data in the keys
+      std::vector<unsigned char> buf(objlen);
+      unsigned char *src = (unsigned char *)zipped->GetContent();
+      Int_t nread = 0, nunzip = 0;
+      while (nread < zipped->GetContentLength()) {
+         Int_t srcsize = 0, tgtsize = 0, irep = 0;
+         ASSERT_EQ(0, R__unzip_header(&srcsize, src + nread, &tgtsize));
+         ASSERT_LE(nunzip + tgtsize, objlen);
+         R__unzip(&srcsize, src + nread, &tgtsize, buf.data() + nunzip, &irep);
+         ASSERT_EQ(tgtsize, irep);
+         nread += srcsize;
+         nunzip += tgtsize;
+      }
+      EXPECT_EQ(objlen, nunzip);
+      EXPECT_EQ(0, memcmp(buf.data(), plain->GetContent(), objlen)) << query;
+   }
+}
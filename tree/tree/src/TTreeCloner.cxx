@@ -34,8 +34,10 @@ Class implementing or helping  the various TTree cloning method
 #include "TLeafO.h"
 #include "TLeafC.h"
 #include "TFileCacheRead.h"
+#include "TFileCacheWrite.h"
 
 #include <algorithm>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -693,6 +695,10 @@ void TTreeCloner::SortBaskets()
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill the file cache with the next set of basket.
 ///
+/// The baskets of all the branches that fit in the cache are registered at
+/// once; the cache sorts them by offset and reads them with a single vectored
+/// read (TFile::ReadBuffers) when the first of them is requested.
+///
 /// \param from index of the first lement of fFromBranches to start caching
 /// \return The index of first element of fFromBranches that is not in the cache
 UInt_t TTreeCloner::FillCache(UInt_t from)
@@ -711,7 +717,9 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
       if (pos && len) {
          size += len;
          if (size > fFileCache->GetBufferSize()) {
-            return j;
+            // A basket larger than the cache is read directly; skip it
+            // rather than leaving all the following baskets uncached.
+            return j == from ? j + 1 : j;
          }
          fFileCache->Prefetch(pos,len);
       }
@@ -721,9 +729,26 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Transfer the basket from the input file to the output file
+///
+/// Unless they already have one, a write cache of the same size as the read
+/// cache is attached to the output files (the file of the tree and the files
+/// set with TBranch::SetFile) while the baskets are copied: the baskets, which
+/// are allocated one after the other at the end of each output file, are then
+/// queued and written in large sequential blocks instead of one write per basket.
 
 void TTreeCloner::WriteBaskets()
 {
+   std::vector<TFile*> writeCacheFiles;
+   if (fCacheSize) {
+      for (Int_t i = 0; i < fToBranches.GetEntriesFast(); ++i) {
+         TFile *tofile = ((TBranch*)fToBranches.UncheckedAt(i))->GetFile(0);
+         if (tofile && !tofile->GetCacheWrite()) {
+            new TFileCacheWrite(tofile, fCacheSize);
+            writeCacheFiles.push_back(tofile);
+         }
+      }
+   }
+
    TBasket *basket = new TBasket();
    for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
@@ -759,4 +784,9 @@ void TTreeCloner::WriteBaskets()
       }
    }
    delete basket;
+
+   for (TFile *tofile : writeCacheFiles) {
+      tofile->GetCacheWrite()->Flush();
+      tofile->SetCacheWrite(nullptr);
+   }
 }
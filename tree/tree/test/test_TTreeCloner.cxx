@@ -0,0 +1,123 @@
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+// A file counting the low level write calls.
+class TWriteCountingFile : public TFile {
+public:
+   Int_t fNWrites = 0;
+
+   TWriteCountingFile(const char *fname) : TFile(fname, "RECREATE") {}
+
+protected:
+   Int_t SysWrite(Int_t fd, const void *buf, Int_t len) override
+   {
+      ++fNWrites;
+      return TFile::SysWrite(fd, buf, len);
+   }
+};
+
+static const Int_t kNEntries = 50000;
+
+// Write a tree with many small baskets.
+static void WriteInput(const char *filename)
+{
+   TFile f(filename, "RECREATE");
+   TTree t("t", "t");
+   Int_t i;
+   Double_t x;
+   t.Branch("i", &i, "i/I", 1000);
+   t.Branch("x", &x, "x/D", 1000);
+   for (i = 0; i < kNEntries; ++i) {
+      x = 0.5 * i;
+      t.Fill();
+   }
+   t.Write();
+}
+
+// Fast clone the tree of `input` into `output`, storing the branch x in `xfile` if given,
+// and return the number of write calls done during the copy of the baskets.
+// The branch takes the ownership of `xfile`, which is closed when `output` is.
+static Int_t FastClone(const char *input, TWriteCountingFile &output, const char *option,
+                       TWriteCountingFile *xfile = nullptr)
+{
+   std::unique_ptr<TFile> in(TFile::Open(input));
+   TTree *tin = (TTree *)in->Get("t");
+   output.cd();
+   TTree *tout = tin->CloneTree(0);
+   if (xfile) tout->GetBranch("x")->SetFile(xfile);
+   Int_t nwrites = output.fNWrites + (xfile ? xfile->fNWrites : 0);
+   EXPECT_LT(0, tout->CopyEntries(tin, -1, option));
+   EXPECT_EQ(kNEntries, tout->GetEntries());
+   nwrites = output.fNWrites + (xfile ? xfile->fNWrites : 0) - nwrites;
+   output.Write();
+   return nwrites;
+}
+
+static void CheckOutput(const char *filename)
+{
+   std::unique_ptr<TFile> f(TFile::Open(filename));
+   TTree *t = (TTree *)f->Get("t");
+   ASSERT_NE(nullptr, t);
+   ASSERT_EQ(kNEntries, t->GetEntries());
+   Int_t i;
+   Double_t x;
+   t->SetBranchAddress("i", &i);
+   t->SetBranchAddress("x", &x);
+   for (Long64_t entry = 0; entry < kNEntries; ++entry) {
+      t->GetEntry(entry);
+      ASSERT_EQ(entry, i);
+      ASSERT_EQ(0.5 * entry, x);
+   }
+}
+
+TEST(TTreeCloner, WriteCache)
+{
+   WriteInput("testTTreeClonerIn.root");
+   Int_t nwritesCache, nwritesNoCache;
+   {
+      TWriteCountingFile out("testTTreeClonerCache.root");
+      nwritesCache = FastClone("testTTreeClonerIn.root", out, "fast");
+   }
+   {
+      TWriteCountingFile out("testTTreeClonerNoCache.root");
+      nwritesNoCache = FastClone("testTTreeClonerIn.root", out, "fast cachesize=0");
+   }
+   CheckOutput("testTTreeClonerCache.root");
+   CheckOutput("testTTreeClonerNoCache.root");
+   // without cache each basket is written with its own call
+   EXPECT_LT(10 * nwritesCache, nwritesNoCache);
+
+   gSystem->Unlink("testTTreeClonerIn.root");
+   gSystem->Unlink("testTTreeClonerCache.root");
+   gSystem->Unlink("testTTreeClonerNoCache.root");
+}
+
+TEST(TTreeCloner, WriteCacheBranchFile)
+{
+   WriteInput("testTTreeClonerIn2.root");
+   Int_t nwritesCache, nwritesNoCache;
+   {
+      TWriteCountingFile out("testTTreeClonerCache2.root");
+      auto xfile = new TWriteCountingFile("testTTreeClonerCache2x.root");
+      nwritesCache = FastClone("testTTreeClonerIn2.root", out, "fast", xfile);
+      // the baskets of x are in the branch file
+      EXPECT_LT(out.GetEND(), xfile->GetEND());
+   }
+   {
+      TWriteCountingFile out("testTTreeClonerNoCache2.root");
+      auto xfile = new TWriteCountingFile("testTTreeClonerNoCache2x.root");
+      nwritesNoCache = FastClone("testTTreeClonerIn2.root", out, "fast cachesize=0", xfile);
+   }
+   CheckOutput("testTTreeClonerCache2.root");
+   CheckOutput("testTTreeClonerNoCache2.root");
+   EXPECT_LT(10 * nwritesCache, nwritesNoCache);
+
+   for (const char *name : {"testTTreeClonerIn2.root", "testTTreeClonerCache2.root", "testTTreeClonerCache2x.root",
+                            "testTTreeClonerNoCache2.root", "testTTreeClonerNoCache2x.root"})
+      gSystem->Unlink(name);
+}